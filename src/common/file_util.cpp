@@ -42,7 +42,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <dirent.h>
+#include <fcntl.h>
 #include <pwd.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -976,4 +978,112 @@ bool IOFile::Resize(u64 size) {
         ;
 }
 
+MappedFile::MappedFile() = default;
+
+MappedFile::MappedFile(const std::string& filename) {
+    Open(filename);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    Swap(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    Swap(other);
+    return *this;
+}
+
+void MappedFile::Swap(MappedFile& other) noexcept {
+    std::swap(data, other.data);
+    std::swap(size, other.size);
+    std::swap(is_open, other.is_open);
+#ifdef _WIN32
+    std::swap(file_handle, other.file_handle);
+    std::swap(mapping_handle, other.mapping_handle);
+#endif
+}
+
+bool MappedFile::Open(const std::string& filename) {
+    Close();
+#ifdef _WIN32
+    // Allow other handles to append to, rename or delete the file while it's mapped
+    const HANDLE file = CreateFileW(Common::UTF8ToUTF16W(filename).c_str(), GENERIC_READ,
+                                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        return false;
+    }
+    file_handle = file;
+    size = static_cast<u64>(file_size.QuadPart);
+    if (size > 0) {
+        mapping_handle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* const view =
+            mapping_handle ? MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            LOG_ERROR(Common_Filesystem, "Failed to map {}: {}", filename, GetLastErrorMsg());
+            Close();
+            return false;
+        }
+        data = static_cast<const u8*>(view);
+    }
+#else
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat file_info;
+    if (fstat(fd, &file_info) != 0 || !S_ISREG(file_info.st_mode)) {
+        close(fd);
+        return false;
+    }
+    size = static_cast<u64>(file_info.st_size);
+    if (size > 0) {
+        void* const view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (view == MAP_FAILED) {
+            LOG_ERROR(Common_Filesystem, "Failed to map {}: {}", filename, GetLastErrorMsg());
+            close(fd);
+            size = 0;
+            return false;
+        }
+        data = static_cast<const u8*>(view);
+    }
+    // The mapping keeps its own reference to the file
+    close(fd);
+#endif
+    is_open = true;
+    return true;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+    if (mapping_handle) {
+        CloseHandle(mapping_handle);
+    }
+    if (file_handle) {
+        CloseHandle(file_handle);
+    }
+    file_handle = nullptr;
+    mapping_handle = nullptr;
+#else
+    if (data) {
+        munmap(const_cast<u8*>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    is_open = false;
+}
+
 } // namespace FileUtil
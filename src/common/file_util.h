@@ -281,6 +281,46 @@ private:
     std::FILE* m_file = nullptr;
 };
 
+/// Read-only mapping of a whole file into memory. The file contents are paged in on demand.
+class MappedFile : public NonCopyable {
+public:
+    MappedFile();
+    explicit MappedFile(const std::string& filename);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    void Swap(MappedFile& other) noexcept;
+
+    /// Maps the file, returns false if it can't be opened or mapped.
+    bool Open(const std::string& filename);
+    void Close();
+
+    bool IsOpen() const {
+        return is_open;
+    }
+
+    /// Returns a pointer to the mapped contents, null for empty files.
+    const u8* GetData() const {
+        return data;
+    }
+
+    u64 GetSize() const {
+        return size;
+    }
+
+private:
+    const u8* data = nullptr;
+    u64 size = 0;
+    bool is_open = false;
+#ifdef _WIN32
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#endif
+};
+
 } // namespace FileUtil
 
 // To deal with Windows being dumb at unicode:
@@ -0,0 +1,58 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cmath>
+#include <fmt/format.h>
+#include "common/bit_util.h"
+#include "common/latency_histogram.h"
+
+namespace Common {
+
+void LatencyHistogram::Record(std::chrono::nanoseconds latency) {
+    const u64 us =
+        static_cast<u64>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+    const std::size_t bucket =
+        us == 0 ? 0 : std::min<std::size_t>(MostSignificantBit64(us) + 1, NUM_BUCKETS - 1);
+
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_us.fetch_add(us, std::memory_order_relaxed);
+
+    u64 max = max_us.load(std::memory_order_relaxed);
+    while (us > max && !max_us.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+    }
+}
+
+std::chrono::microseconds LatencyHistogram::Mean() const {
+    const u64 samples = Count();
+    if (samples == 0) {
+        return {};
+    }
+    return std::chrono::microseconds{total_us.load(std::memory_order_relaxed) / samples};
+}
+
+std::chrono::microseconds LatencyHistogram::Percentile(double percentile) const {
+    const u64 samples = Count();
+    if (samples == 0) {
+        return {};
+    }
+    const u64 target = std::max<u64>(static_cast<u64>(std::ceil(samples * percentile / 100.0)), 1);
+    u64 accumulated = 0;
+    for (std::size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+        accumulated += buckets[bucket].load(std::memory_order_relaxed);
+        if (accumulated >= target) {
+            return std::chrono::microseconds{u64{1} << bucket};
+        }
+    }
+    return Max();
+}
+
+std::string LatencyHistogram::Summary() const {
+    return fmt::format("{} samples, mean {}us, p50 <{}us, p99 <{}us, max {}us", Count(),
+                       Mean().count(), Percentile(50).count(), Percentile(99).count(),
+                       Max().count());
+}
+
+} // namespace Common
@@ -0,0 +1,57 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Histogram of latencies in power of two buckets of microseconds. Recording is cheap enough for
+ * hot paths, and the histogram may be read from other threads while samples are recorded.
+ */
+class LatencyHistogram final {
+public:
+    /// Adds a sample to the histogram.
+    void Record(std::chrono::nanoseconds latency);
+
+    /// Returns the number of recorded samples.
+    u64 Count() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the mean of the recorded samples.
+    std::chrono::microseconds Mean() const;
+
+    /// Returns the largest recorded sample.
+    std::chrono::microseconds Max() const {
+        return std::chrono::microseconds{max_us.load(std::memory_order_relaxed)};
+    }
+
+    /**
+     * Returns an upper bound of the given percentile, the end of the bucket that contains it.
+     * @param percentile Percentile in the range (0, 100].
+     */
+    std::chrono::microseconds Percentile(double percentile) const;
+
+    /// Formats the sample count, mean, median, 99th percentile and maximum for logging.
+    std::string Summary() const;
+
+private:
+    /// Bucket 0 holds samples under 1us, bucket i holds samples in [2^(i-1), 2^i) us.
+    static constexpr std::size_t NUM_BUCKETS = 32;
+
+    std::array<std::atomic<u64>, NUM_BUCKETS> buckets{};
+    std::atomic<u64> count{};
+    std::atomic<u64> total_us{};
+    std::atomic<u64> max_us{};
+};
+
+} // namespace Common
@@ -61,10 +61,15 @@ std::vector<u8> CompressDataLZ4HCMax(const u8* source, std::size_t source_size)
 
 std::vector<u8> DecompressDataLZ4(const std::vector<u8>& compressed,
                                   std::size_t uncompressed_size) {
+    return DecompressDataLZ4(compressed.data(), compressed.size(), uncompressed_size);
+}
+
+std::vector<u8> DecompressDataLZ4(const u8* source, std::size_t source_size,
+                                  std::size_t uncompressed_size) {
     std::vector<u8> uncompressed(uncompressed_size);
-    const int size_check = LZ4_decompress_safe(reinterpret_cast<const char*>(compressed.data()),
+    const int size_check = LZ4_decompress_safe(reinterpret_cast<const char*>(source),
                                                reinterpret_cast<char*>(uncompressed.data()),
-                                               static_cast<int>(compressed.size()),
+                                               static_cast<int>(source_size),
                                                static_cast<int>(uncompressed.size()));
     if (static_cast<int>(uncompressed_size) != size_check) {
         // Decompression failed
@@ -54,4 +54,16 @@ std::vector<u8> CompressDataLZ4HCMax(const u8* source, std::size_t source_size);
  */
 std::vector<u8> DecompressDataLZ4(const std::vector<u8>& compressed, std::size_t uncompressed_size);
 
+/**
+ * Decompresses a source memory region with LZ4 and returns the uncompressed data in a vector.
+ *
+ * @param source the compressed source memory region.
+ * @param source_size the size in bytes of the compressed source memory region.
+ * @param uncompressed_size the size in bytes of the uncompressed data.
+ *
+ * @return the decompressed data.
+ */
+std::vector<u8> DecompressDataLZ4(const u8* source, std::size_t source_size,
+                                  std::size_t uncompressed_size);
+
 } // namespace Common::Compression
\ No newline at end of file
@@ -26,6 +26,11 @@ void PageTable::Resize(std::size_t address_space_width_in_bits) {
     pointers.shrink_to_fit();
     attributes.shrink_to_fit();
     backing_addr.shrink_to_fit();
+
+    if (!cached_counts.empty()) {
+        cached_counts.resize(num_page_table_entries);
+        cached_counts.shrink_to_fit();
+    }
 }
 
 } // namespace Common
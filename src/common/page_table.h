@@ -76,8 +76,21 @@ struct PageTable {
      */
     std::vector<PageType> attributes;
 
+    /**
+     * Vector of addresses backing each page. For GPU page tables this is the CPU address backing
+     * the page. For CPU page tables this is the host pointer of the page minus its virtual address,
+     * so the host pointer of any address in a page can be computed without looking up its VMA. It
+     * stays valid for pages of type `RasterizerCachedMemory`, whose `pointers` entry is null.
+     */
     std::vector<u64> backing_addr;
 
+    /**
+     * Number of rasterizer cache objects overlapping each page. Pages with a non-zero count are of
+     * type `RasterizerCachedMemory`. Allocated on first use, most page tables never have cached
+     * pages.
+     */
+    std::vector<u16> cached_counts;
+
     const std::size_t page_size_in_bits{};
 };
 
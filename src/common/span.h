@@ -0,0 +1,75 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace Common {
+
+/**
+ * Non-owning view of a contiguous sequence of objects, a minimal stand-in for C++20's std::span.
+ * @tparam T Element type, const-qualified for read-only views.
+ */
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() = default;
+    constexpr Span(T* data, std::size_t size) : data_{data}, size_{size} {}
+
+    /// Allows passing a mutable span where a read-only one is expected.
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) : data_{other.data()}, size_{other.size()} {}
+
+    /// Views the elements of a contiguous container, such as std::vector or std::array.
+    template <typename Container,
+              typename = std::enable_if_t<std::is_convertible_v<
+                  std::remove_pointer_t<decltype(std::declval<Container&>().data())> (*)[],
+                  T (*)[]>>>
+    constexpr Span(Container& container) : data_{container.data()}, size_{container.size()} {}
+
+    constexpr T* data() const {
+        return data_;
+    }
+
+    constexpr std::size_t size() const {
+        return size_;
+    }
+
+    constexpr std::size_t size_bytes() const {
+        return size_ * sizeof(T);
+    }
+
+    constexpr bool empty() const {
+        return size_ == 0;
+    }
+
+    constexpr T& operator[](std::size_t index) const {
+        return data_[index];
+    }
+
+    constexpr iterator begin() const {
+        return data_;
+    }
+
+    constexpr iterator end() const {
+        return data_ + size_;
+    }
+
+    /// Returns a view of count elements starting at offset.
+    constexpr Span subspan(std::size_t offset, std::size_t count) const {
+        return Span{data_ + offset, count};
+    }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace Common
@@ -0,0 +1,100 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "common/thread.h"
+#include "common/thread_pool.h"
+
+namespace Common {
+
+ThreadPool::ThreadPool(std::size_t num_workers, std::string name) : name{std::move(name)} {
+    threads.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        threads.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{queue_mutex};
+        stop_requested = true;
+    }
+    work_available.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::QueueWork(std::function<void()> work) {
+    {
+        std::lock_guard lock{queue_mutex};
+        work_queue.push(std::move(work));
+    }
+    work_available.notify_one();
+}
+
+void ThreadPool::ParallelFor(std::size_t count, const std::function<void(std::size_t)>& func) {
+    // The state outlives this call, workers that start after every index has been claimed still
+    // have to read the index counter.
+    struct State {
+        const std::function<void(std::size_t)>* func;
+        std::size_t count;
+        std::atomic<std::size_t> next_index{};
+        std::atomic<std::size_t> num_completed{};
+        std::mutex mutex;
+        std::condition_variable completed;
+    };
+    const auto state = std::make_shared<State>();
+    state->func = &func;
+    state->count = count;
+
+    const auto run = [state] {
+        std::size_t num_completed = 0;
+        for (std::size_t index = state->next_index++; index < state->count;
+             index = state->next_index++) {
+            (*state->func)(index);
+            ++num_completed;
+        }
+        if (num_completed == 0) {
+            return;
+        }
+        if (state->num_completed.fetch_add(num_completed) + num_completed == state->count) {
+            std::lock_guard lock{state->mutex};
+            state->completed.notify_all();
+        }
+    };
+
+    const std::size_t num_helpers = std::min(count > 0 ? count - 1 : 0, NumWorkers());
+    for (std::size_t i = 0; i < num_helpers; ++i) {
+        QueueWork(run);
+    }
+    run();
+
+    // Waiting on completed indices instead of queued work keeps nested calls from deadlocking.
+    std::unique_lock lock{state->mutex};
+    state->completed.wait(lock, [&state] { return state->num_completed == state->count; });
+}
+
+void ThreadPool::WorkerLoop() {
+    SetCurrentThreadName(name.c_str());
+    while (true) {
+        std::function<void()> work;
+        {
+            std::unique_lock lock{queue_mutex};
+            work_available.wait(lock, [this] { return stop_requested || !work_queue.empty(); });
+            if (stop_requested && work_queue.empty()) {
+                return;
+            }
+            work = std::move(work_queue.front());
+            work_queue.pop();
+        }
+        work();
+    }
+}
+
+} // namespace Common
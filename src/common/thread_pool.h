@@ -0,0 +1,56 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Common {
+
+/// Pool of worker threads that execute independent pieces of work in parallel.
+class ThreadPool final {
+public:
+    /**
+     * Creates the pool and starts its worker threads.
+     * @param num_workers Number of worker threads to start.
+     * @param name        Name given to the worker threads, for debugging purposes.
+     */
+    explicit ThreadPool(std::size_t num_workers, std::string name);
+    ~ThreadPool();
+
+    /// Returns the number of worker threads owned by the pool.
+    std::size_t NumWorkers() const {
+        return threads.size();
+    }
+
+    /// Queues a function to be executed by one of the worker threads.
+    void QueueWork(std::function<void()> work);
+
+    /**
+     * Calls func once for every index in [0, count), distributing the calls across the worker
+     * threads and the calling thread. Returns once all the calls have finished. It's safe to call
+     * this from a worker thread of the same pool.
+     */
+    void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& func);
+
+private:
+    void WorkerLoop();
+
+    std::string name;
+    std::vector<std::thread> threads;
+
+    std::mutex queue_mutex;
+    std::condition_variable work_available;
+    std::queue<std::function<void()>> work_queue;
+    bool stop_requested = false;
+};
+
+} // namespace Common
@@ -7,12 +7,20 @@
 // a simple lockless thread-safe,
 // single reader, single writer queue
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
 #include <utility>
 
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#endif
+
 namespace Common {
 template <typename T>
 class SPSCQueue {
@@ -124,6 +132,176 @@ private:
     std::condition_variable cv;
 };
 
+// a bounded lockless single reader, single writer queue
+//
+// Elements are constructed in place inside a preallocated ring, so pushing and popping never
+// allocates. The read and write indices live on separate cache lines to avoid false sharing.
+// When the queue is empty (or full) the waiting side spins for a short while before parking on a
+// condition variable, and the other side only takes the mutex when somebody is actually parked.
+
+template <typename T, std::size_t Capacity>
+class BoundedSPSCQueue {
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+public:
+    BoundedSPSCQueue() = default;
+    ~BoundedSPSCQueue() {
+        Clear();
+    }
+
+    BoundedSPSCQueue(const BoundedSPSCQueue&) = delete;
+    BoundedSPSCQueue& operator=(const BoundedSPSCQueue&) = delete;
+
+    std::size_t Size() const {
+        return write_index.load(std::memory_order_acquire) -
+               read_index.load(std::memory_order_acquire);
+    }
+
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+    /// Constructs an element in place. Returns false when the queue is full.
+    template <typename... Args>
+    bool TryEmplace(Args&&... args) {
+        const std::size_t write = write_index.load(std::memory_order_relaxed);
+        if (write - cached_read_index == Capacity) {
+            cached_read_index = read_index.load(std::memory_order_acquire);
+            if (write - cached_read_index == Capacity) {
+                return false;
+            }
+        }
+        new (Slot(write)) T(std::forward<Args>(args)...);
+        Publish(write_index, write + 1, consumer_waiting, not_empty);
+        return true;
+    }
+
+    /// Constructs an element in place, waiting for a free slot if the queue is full.
+    template <typename... Args>
+    void Emplace(Args&&... args) {
+        while (!TryEmplace(std::forward<Args>(args)...)) {
+            Wait(producer_waiting, not_full, [this] { return Size() < Capacity; });
+        }
+    }
+
+    template <typename Arg>
+    void Push(Arg&& t) {
+        Emplace(std::forward<Arg>(t));
+    }
+
+    bool Pop(T& t) {
+        const std::size_t read = read_index.load(std::memory_order_relaxed);
+        if (read == cached_write_index) {
+            cached_write_index = write_index.load(std::memory_order_acquire);
+            if (read == cached_write_index) {
+                return false;
+            }
+        }
+        T* const element = Slot(read);
+        t = std::move(*element);
+        element->~T();
+        Publish(read_index, read + 1, producer_waiting, not_full);
+        return true;
+    }
+
+    T PopWait() {
+        T t;
+        while (!Pop(t)) {
+            WaitNotEmpty();
+        }
+        return t;
+    }
+
+    /// Blocks the reader until there is at least one element in the queue.
+    void WaitNotEmpty() {
+        Wait(consumer_waiting, not_empty, [this] { return !Empty(); });
+    }
+
+    // not thread-safe
+    void Clear() {
+        std::size_t read = read_index.load(std::memory_order_relaxed);
+        const std::size_t write = write_index.load(std::memory_order_relaxed);
+        for (; read != write; ++read) {
+            Slot(read)->~T();
+        }
+        read_index.store(read, std::memory_order_relaxed);
+        cached_write_index = read;
+        cached_read_index = read;
+    }
+
+private:
+    /// Number of polls before the waiting side starts yielding its time slice.
+    static constexpr int SpinIterations = 1024;
+    /// Number of time slice yields before the waiting side parks on the condition variable.
+    static constexpr int YieldIterations = 16;
+
+    static constexpr std::size_t CacheLineSize = 64;
+
+    T* Slot(std::size_t index) {
+        return std::launder(reinterpret_cast<T*>(&slots[index & (Capacity - 1)]));
+    }
+
+    static void CpuRelax() {
+#ifdef ARCHITECTURE_x86_64
+        _mm_pause();
+#endif
+    }
+
+    /// Makes a new index visible to the other side and wakes it up if it is parked.
+    void Publish(std::atomic_size_t& index, std::size_t value, std::atomic_bool& other_waiting,
+                 std::condition_variable& other_cv) {
+        // Sequentially consistent so the store can't be reordered with the load of the other
+        // side's waiting flag, which would lose a wake up.
+        index.store(value, std::memory_order_seq_cst);
+        if (other_waiting.load(std::memory_order_seq_cst)) {
+            std::lock_guard lock{wait_mutex};
+            other_cv.notify_one();
+        }
+    }
+
+    template <typename Predicate>
+    void Wait(std::atomic_bool& waiting, std::condition_variable& cv, Predicate&& predicate) {
+        for (int i = 0; i < SpinIterations; ++i) {
+            if (predicate()) {
+                return;
+            }
+            CpuRelax();
+        }
+        for (int i = 0; i < YieldIterations; ++i) {
+            if (predicate()) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        std::unique_lock lock{wait_mutex};
+        waiting.store(true, std::memory_order_seq_cst);
+        // Pairs with the store in Publish, the predicate must observe the latest index.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        cv.wait(lock, predicate);
+        waiting.store(false, std::memory_order_relaxed);
+    }
+
+    // Written by the producer, read by the consumer.
+    alignas(CacheLineSize) std::atomic_size_t write_index{0};
+    /// Producer's copy of read_index, refreshed only when the queue looks full.
+    std::size_t cached_read_index{0};
+
+    // Written by the consumer, read by the producer.
+    alignas(CacheLineSize) std::atomic_size_t read_index{0};
+    /// Consumer's copy of write_index, refreshed only when the queue looks empty.
+    std::size_t cached_write_index{0};
+
+    alignas(CacheLineSize) std::atomic_bool consumer_waiting{false};
+    std::atomic_bool producer_waiting{false};
+    std::mutex wait_mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+
+    alignas(CacheLineSize) std::array<std::aligned_storage_t<sizeof(T), alignof(T)>, Capacity>
+        slots;
+};
+
 // a simple thread-safe,
 // single reader, multiple writer queue
 
@@ -41,4 +41,14 @@ std::vector<u8> CompressDataZSTDDefault(const u8* source, std::size_t source_siz
  */
 std::vector<u8> DecompressDataZSTD(const std::vector<u8>& compressed);
 
+/**
+ * Decompresses a source memory region with Zstandard and returns the uncompressed data in a vector.
+ *
+ * @param source the source data to decompress
+ * @param source_size the size of the source data
+ *
+ * @return the decompressed data.
+ */
+std::vector<u8> DecompressDataZSTD(const u8* source, std::size_t source_size);
+
 } // namespace Common::Compression
\ No newline at end of file
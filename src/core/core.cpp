@@ -240,6 +240,44 @@ struct System::Impl {
         return status;
     }
 
+    ResultStatus InitGPU(System& system, std::unique_ptr<VideoCore::RendererBase> renderer_) {
+        core_timing.Initialize();
+
+        renderer = std::move(renderer_);
+        if (!renderer->Init()) {
+            return ResultStatus::ErrorVideoCore;
+        }
+        gpu_core = VideoCore::CreateGPU(system);
+        gpu_core->Start();
+
+        is_powered_on = true;
+
+        LOG_DEBUG(Core, "Initialized GPU OK");
+
+        return ResultStatus::Success;
+    }
+
+    void ShutdownGPU() {
+        is_powered_on = false;
+        gpu_core->WaitIdle();
+
+        renderer.reset();
+        gpu_core.reset();
+        core_timing.Shutdown();
+    }
+
+    void InitCpuCores() {
+        core_timing.Initialize();
+        cpu_core_manager.Initialize();
+        kernel.Initialize();
+    }
+
+    void ShutdownCpuCores() {
+        cpu_core_manager.Shutdown();
+        kernel.Shutdown();
+        core_timing.Shutdown();
+    }
+
     void Shutdown() {
         // Log last frame performance stats if game was loded
         if (perf_stats) {
@@ -262,6 +300,9 @@ struct System::Impl {
 
         gpu_core->WaitIdle();
 
+        // Finish the service requests in flight before the state they use is torn down
+        kernel.StopServiceThreads();
+
         // Shutdown emulation session
         renderer.reset();
         GDBStub::Shutdown();
@@ -403,6 +444,22 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
     return impl->Load(*this, emu_window, filepath);
 }
 
+System::ResultStatus System::InitGPU(std::unique_ptr<VideoCore::RendererBase> renderer) {
+    return impl->InitGPU(*this, std::move(renderer));
+}
+
+void System::ShutdownGPU() {
+    impl->ShutdownGPU();
+}
+
+void System::InitCpuCores() {
+    impl->InitCpuCores();
+}
+
+void System::ShutdownCpuCores() {
+    impl->ShutdownCpuCores();
+}
+
 bool System::IsPoweredOn() const {
     return impl->is_powered_on;
 }
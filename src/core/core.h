@@ -174,6 +174,26 @@ public:
      */
     ResultStatus Load(Frontend::EmuWindow& emu_window, const std::string& filepath);
 
+    /**
+     * Initializes only the GPU, without the CPU, kernel or services, so that recorded command
+     * lists can be executed without loading an application.
+     * @param renderer Renderer to execute the GPU commands with.
+     * @returns ResultStatus code, indicating if the operation succeeded.
+     */
+    ResultStatus InitGPU(std::unique_ptr<VideoCore::RendererBase> renderer);
+
+    /// Shuts down the GPU and the renderer brought up by InitGPU.
+    void ShutdownGPU();
+
+    /**
+     * Initializes only the CPU cores and the kernel, without the GPU or services, so that
+     * scheduling can be exercised without loading an application. The cores are not started.
+     */
+    void InitCpuCores();
+
+    /// Shuts down the CPU cores and the kernel brought up by InitCpuCores.
+    void ShutdownCpuCores();
+
     /**
      * Indicates if the emulated system is powered on (all subsystems initialized and able to run an
      * application).
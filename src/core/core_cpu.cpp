@@ -6,6 +6,7 @@
 #include <mutex>
 
 #include "common/logging/log.h"
+#include "common/microprofile.h"
 #ifdef ARCHITECTURE_x86_64
 #include "core/arm/dynarmic/arm_dynarmic.h"
 #endif
@@ -14,46 +15,100 @@
 #include "core/core.h"
 #include "core/core_cpu.h"
 #include "core/core_timing.h"
+#include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/scheduler.h"
 #include "core/hle/kernel/thread.h"
 #include "core/hle/lock.h"
 #include "core/settings.h"
 
+MICROPROFILE_DEFINE(Core_CpuBarrier, "Core", "CPU Barrier", MP_RGB(128, 128, 192));
+
 namespace Core {
 
+namespace {
+/// Number of ticks a core may run ahead of the slowest core in relaxed multi-core mode, four time
+/// slices.
+constexpr u64 MAX_RELAXED_SKEW_TICKS = 40000;
+} // Anonymous namespace
+
+CpuBarrier::CpuBarrier(Timing::CoreTiming& core_timing) : core_timing{core_timing} {}
+
 void CpuBarrier::NotifyEnd() {
     std::unique_lock lock{mutex};
     end = true;
     condition.notify_all();
 }
 
-bool CpuBarrier::Rendezvous() {
+bool CpuBarrier::Rendezvous(std::size_t core_index) {
     if (!Settings::values.use_multi_core) {
         // Meaningless when running in single-core mode
         return true;
     }
 
-    if (!end) {
-        std::unique_lock lock{mutex};
+    if (end) {
+        return false;
+    }
 
-        --cores_waiting;
-        if (!cores_waiting) {
-            cores_waiting = NUM_CPU_CORES;
-            condition.notify_all();
-            return true;
-        }
+    MICROPROFILE_SCOPE(Core_CpuBarrier);
+    const auto wait_start = std::chrono::steady_clock::now();
+    if (Settings::values.use_relaxed_multi_core) {
+        WaitForSlowerCores(core_index);
+    } else {
+        WaitForAllCores();
+    }
+    const auto wait_time = std::chrono::steady_clock::now() - wait_start;
+    wait_time_ns[core_index].fetch_add(
+        static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(wait_time).count()),
+        std::memory_order_relaxed);
 
-        condition.wait(lock);
-        return true;
+    return !end;
+}
+
+void CpuBarrier::WaitForAllCores() {
+    std::unique_lock lock{mutex};
+
+    --cores_waiting;
+    if (!cores_waiting) {
+        cores_waiting = NUM_CPU_CORES;
+        condition.notify_all();
+        return;
     }
 
+    condition.wait(lock);
+}
+
+void CpuBarrier::WaitForSlowerCores(std::size_t core_index) {
+    // This core has finished a slice since it last got here, which may allow cores that are ahead
+    // of it to continue.
+    if (relaxed_waiters.load() != 0) {
+        std::lock_guard lock{mutex};
+        condition.notify_all();
+    }
+
+    if (!IsTooFarAhead(core_index)) {
+        return;
+    }
+
+    std::unique_lock lock{mutex};
+    ++relaxed_waiters;
+    condition.wait(lock, [this, core_index] { return end || !IsTooFarAhead(core_index); });
+    --relaxed_waiters;
+}
+
+bool CpuBarrier::IsTooFarAhead(std::size_t core_index) const {
+    const u64 ticks = core_timing.GetCoreTicks(core_index);
+    for (std::size_t core = 0; core < NUM_CPU_CORES; ++core) {
+        if (core_timing.GetCoreTicks(core) + MAX_RELAXED_SKEW_TICKS < ticks) {
+            return true;
+        }
+    }
     return false;
 }
 
 Cpu::Cpu(System& system, ExclusiveMonitor& exclusive_monitor, CpuBarrier& cpu_barrier,
          std::size_t core_index)
     : cpu_barrier{cpu_barrier}, global_scheduler{system.GlobalScheduler()},
-      core_timing{system.CoreTiming()}, core_index{core_index} {
+      kernel{system.Kernel()}, core_timing{system.CoreTiming()}, core_index{core_index} {
 #ifdef ARCHITECTURE_x86_64
     arm_interface = std::make_unique<ARM_Dynarmic>(system, exclusive_monitor, core_index);
 #else
@@ -77,12 +132,22 @@ std::unique_ptr<ExclusiveMonitor> Cpu::MakeExclusiveMonitor(
 }
 
 void Cpu::RunLoop(bool tight_loop) {
-    // Wait for all other CPU cores to complete the previous slice, such that they run in lock-step
-    if (!cpu_barrier.Rendezvous()) {
+    if (Settings::values.use_multi_core) {
+        // Each core runs its own time slices on its own host thread
+        core_timing.SwitchContext(core_index);
+    }
+
+    // Wait for the other CPU cores to complete their previous slice, such that they run in
+    // lock-step or, in relaxed mode, within a bounded distance of each other
+    if (!cpu_barrier.Rendezvous(core_index)) {
         // If rendezvous failed, session has been killed
         return;
     }
 
+    if (Settings::values.use_multi_core) {
+        core_timing.ResetContextRun();
+    }
+
     Reschedule();
 
     // If we don't have a currently active thread then don't execute instructions,
@@ -116,8 +181,15 @@ void Cpu::Reschedule() {
     // Lock the global kernel mutex when we manipulate the HLE state
     std::lock_guard lock(HLE::g_hle_lock);
 
+    Kernel::Thread* const previous_thread = scheduler->GetCurrentThread();
     global_scheduler.SelectThread(core_index);
     scheduler->TryDoContextSwitch();
+
+    // Requests on service threads are handled once the thread that sent them has been switched out
+    if (previous_thread != nullptr && !previous_thread->IsRunning() &&
+        previous_thread->GetStatus() == Kernel::ThreadStatus::WaitIPC) {
+        kernel.NotifyThreadUnloaded(*previous_thread);
+    }
 }
 
 void Cpu::Shutdown() {
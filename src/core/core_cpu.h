@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <memory>
@@ -13,6 +15,7 @@
 
 namespace Kernel {
 class GlobalScheduler;
+class KernelCore;
 class Scheduler;
 } // namespace Kernel
 
@@ -35,21 +38,51 @@ class ExclusiveMonitor;
 
 constexpr unsigned NUM_CPU_CORES{4};
 
+/**
+ * Keeps the CPU cores synchronized in multi-core mode. By default all cores wait for each other at
+ * the end of every time slice. In relaxed mode cores advance independently and a core only waits
+ * when it has run too far ahead of the slowest core.
+ */
 class CpuBarrier {
 public:
+    explicit CpuBarrier(Timing::CoreTiming& core_timing);
+
     bool IsAlive() const {
         return !end;
     }
 
     void NotifyEnd();
 
-    bool Rendezvous();
+    /**
+     * Waits until the given core is allowed to start a new time slice.
+     * @param core_index Index of the core that finished its previous slice.
+     * @returns false if the session has been killed.
+     */
+    bool Rendezvous(std::size_t core_index);
+
+    /// Returns the total time the given core has spent waiting for other cores.
+    std::chrono::nanoseconds GetWaitTime(std::size_t core_index) const {
+        return std::chrono::nanoseconds{wait_time_ns[core_index].load(std::memory_order_relaxed)};
+    }
 
 private:
+    /// Waits for all cores to finish their slice.
+    void WaitForAllCores();
+
+    /// Waits until the given core is no longer too far ahead of the slowest core.
+    void WaitForSlowerCores(std::size_t core_index);
+
+    bool IsTooFarAhead(std::size_t core_index) const;
+
+    Timing::CoreTiming& core_timing;
+
     unsigned cores_waiting{NUM_CPU_CORES};
+    std::atomic<unsigned> relaxed_waiters{};
     std::mutex mutex;
     std::condition_variable condition;
     std::atomic<bool> end{};
+
+    std::array<std::atomic<u64>, NUM_CPU_CORES> wait_time_ns{};
 };
 
 class Cpu {
@@ -64,6 +97,10 @@ public:
 
     void PrepareReschedule();
 
+    /// Selects the thread this core should run next and switches to it. Called by the run loop at
+    /// the start and end of every slice.
+    void Reschedule();
+
     ARM_Interface& ArmInterface() {
         return *arm_interface;
     }
@@ -105,11 +142,10 @@ public:
                                                                   std::size_t num_cores);
 
 private:
-    void Reschedule();
-
     std::unique_ptr<ARM_Interface> arm_interface;
     CpuBarrier& cpu_barrier;
     Kernel::GlobalScheduler& global_scheduler;
+    Kernel::KernelCore& kernel;
     std::unique_ptr<Kernel::Scheduler> scheduler;
     Timing::CoreTiming& core_timing;
 
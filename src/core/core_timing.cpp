@@ -12,32 +12,51 @@
 #include "common/assert.h"
 #include "common/thread.h"
 #include "core/core_timing_util.h"
+#include "core/settings.h"
 
 namespace Core::Timing {
 
 constexpr int MAX_SLICE_LENGTH = 10000;
 
+/// Number of events the pool and queue can hold before they have to grow.
+constexpr std::size_t INITIAL_EVENT_CAPACITY = 256;
+
+/// Minimum number of cancelled entries in the queue before it is worth compacting.
+constexpr std::size_t MIN_STALE_ENTRIES_TO_COMPACT = 64;
+
 std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callback) {
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
 
 struct CoreTiming::Event {
+    u64 userdata = 0;
+    std::weak_ptr<EventType> type;
+    // Incremented every time the slot is released, invalidating its handles and queue entries.
+    u32 generation = 0;
+    // Neighbours in the list of pending events of the same type.
+    u32 prev_of_type = INVALID_EVENT_SLOT;
+    u32 next_of_type = INVALID_EVENT_SLOT;
+};
+
+struct CoreTiming::QueueEntry {
     s64 time;
     u64 fifo_order;
-    u64 userdata;
-    std::weak_ptr<EventType> type;
+    u32 slot;
+    u32 generation;
 
     // Sort by time, unless the times are the same, in which case sort by
     // the order added to the queue
-    friend bool operator>(const Event& left, const Event& right) {
+    friend bool operator>(const QueueEntry& left, const QueueEntry& right) {
         return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
     }
 
-    friend bool operator<(const Event& left, const Event& right) {
+    friend bool operator<(const QueueEntry& left, const QueueEntry& right) {
         return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
     }
 };
 
+thread_local u64 CoreTiming::current_context = CoreTiming::NO_CONTEXT;
+
 CoreTiming::CoreTiming() = default;
 CoreTiming::~CoreTiming() = default;
 
@@ -47,7 +66,11 @@ void CoreTiming::Initialize() {
     slice_length = MAX_SLICE_LENGTH;
     global_timer = 0;
     idled_cycles = 0;
-    current_context = 0;
+    accumulated_ticks.fill(0);
+    for (auto& ticks : core_ticks) {
+        ticks.store(0, std::memory_order_relaxed);
+    }
+    is_multicore = Settings::values.use_multi_core;
 
     // The time between CoreTiming being initialized and the first call to Advance() is considered
     // the slice boundary between slice -1 and slice 0. Dispatcher loops must call Advance() before
@@ -56,6 +79,9 @@ void CoreTiming::Initialize() {
     is_global_timer_sane = true;
 
     event_fifo_id = 0;
+    event_pool.reserve(INITIAL_EVENT_CAPACITY);
+    free_slots.reserve(INITIAL_EVENT_CAPACITY);
+    event_queue.reserve(INITIAL_EVENT_CAPACITY);
 
     const auto empty_timed_callback = [](u64, s64) {};
     ev_lost = CreateEvent("_lost_event", empty_timed_callback);
@@ -65,8 +91,8 @@ void CoreTiming::Shutdown() {
     ClearPendingEvents();
 }
 
-void CoreTiming::ScheduleEvent(s64 cycles_into_future, const std::shared_ptr<EventType>& event_type,
-                               u64 userdata) {
+EventHandle CoreTiming::ScheduleEvent(s64 cycles_into_future,
+                                      const std::shared_ptr<EventType>& event_type, u64 userdata) {
     std::lock_guard guard{inner_mutex};
     const s64 timeout = GetTicks() + cycles_into_future;
 
@@ -75,29 +101,62 @@ void CoreTiming::ScheduleEvent(s64 cycles_into_future, const std::shared_ptr<Eve
         ForceExceptionCheck(cycles_into_future);
     }
 
-    event_queue.emplace_back(Event{timeout, event_fifo_id++, userdata, event_type});
+    u32 slot;
+    if (free_slots.empty()) {
+        slot = static_cast<u32>(event_pool.size());
+        event_pool.emplace_back();
+    } else {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    }
 
+    Event& event = event_pool[slot];
+    event.userdata = userdata;
+    event.type = event_type;
+    event.prev_of_type = INVALID_EVENT_SLOT;
+    event.next_of_type = event_type->first_pending;
+    if (event.next_of_type != INVALID_EVENT_SLOT) {
+        event_pool[event.next_of_type].prev_of_type = slot;
+    }
+    event_type->first_pending = slot;
+
+    event_queue.push_back(QueueEntry{timeout, event_fifo_id++, slot, event.generation});
     std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+
+    return EventHandle{slot, event.generation};
 }
 
 void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type, u64 userdata) {
     std::lock_guard guard{inner_mutex};
 
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get() && e.userdata == userdata;
-    });
+    u32 slot = event_type->first_pending;
+    while (slot != INVALID_EVENT_SLOT) {
+        const u32 next_slot = event_pool[slot].next_of_type;
+        if (event_pool[slot].userdata == userdata) {
+            CancelEvent(slot, event_type.get());
+        }
+        slot = next_slot;
+    }
+}
+
+void CoreTiming::UnscheduleEvent(EventHandle handle) {
+    std::lock_guard guard{inner_mutex};
 
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    if (handle.slot >= event_pool.size() ||
+        event_pool[handle.slot].generation != handle.generation) {
+        // The event has already fired or has been cancelled
+        return;
     }
+
+    const auto event_type = event_pool[handle.slot].type.lock();
+    CancelEvent(handle.slot, event_type.get());
 }
 
 u64 CoreTiming::GetTicks() const {
-    u64 ticks = static_cast<u64>(global_timer);
-    if (!is_global_timer_sane) {
-        ticks += accumulated_ticks;
+    u64 ticks = static_cast<u64>(global_timer.load());
+    // Ticks a core has executed in its current slice are only visible to its own thread
+    if (current_context != NO_CONTEXT && !is_global_timer_sane) {
+        ticks += accumulated_ticks[current_context];
     }
     return ticks;
 }
@@ -107,29 +166,85 @@ u64 CoreTiming::GetIdleTicks() const {
 }
 
 void CoreTiming::AddTicks(u64 ticks) {
-    accumulated_ticks += ticks;
+    DEBUG_ASSERT(current_context != NO_CONTEXT);
+    accumulated_ticks[current_context] += ticks;
     downcounts[current_context] -= static_cast<s64>(ticks);
 }
 
 void CoreTiming::ClearPendingEvents() {
+    for (const Event& event : event_pool) {
+        if (const auto event_type = event.type.lock()) {
+            event_type->first_pending = INVALID_EVENT_SLOT;
+        }
+    }
+    event_pool.clear();
+    free_slots.clear();
     event_queue.clear();
+    stale_entries = 0;
 }
 
 void CoreTiming::RemoveEvent(const std::shared_ptr<EventType>& event_type) {
     std::lock_guard guard{inner_mutex};
 
-    const auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type.lock().get() == event_type.get();
-    });
+    while (event_type->first_pending != INVALID_EVENT_SLOT) {
+        CancelEvent(event_type->first_pending, event_type.get());
+    }
+}
 
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+const CoreTiming::QueueEntry* CoreTiming::NextEvent() {
+    while (!event_queue.empty()) {
+        const QueueEntry& entry = event_queue.front();
+        if (event_pool[entry.slot].generation == entry.generation) {
+            return &entry;
+        }
+        std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+        event_queue.pop_back();
+        --stale_entries;
     }
+    return nullptr;
+}
+
+void CoreTiming::ReleaseEvent(u32 slot, EventType* event_type) {
+    Event& event = event_pool[slot];
+    if (event.prev_of_type != INVALID_EVENT_SLOT) {
+        event_pool[event.prev_of_type].next_of_type = event.next_of_type;
+    } else if (event_type != nullptr) {
+        event_type->first_pending = event.next_of_type;
+    }
+    if (event.next_of_type != INVALID_EVENT_SLOT) {
+        event_pool[event.next_of_type].prev_of_type = event.prev_of_type;
+    }
+
+    event.type.reset();
+    event.prev_of_type = INVALID_EVENT_SLOT;
+    event.next_of_type = INVALID_EVENT_SLOT;
+    ++event.generation;
+    free_slots.push_back(slot);
+}
+
+void CoreTiming::CancelEvent(u32 slot, EventType* event_type) {
+    ReleaseEvent(slot, event_type);
+
+    // The queue entry stays behind until it reaches the top of the heap. Drop all of them at once
+    // when they make up most of the queue, so the heap doesn't keep growing.
+    ++stale_entries;
+    if (stale_entries < MIN_STALE_ENTRIES_TO_COMPACT || stale_entries * 2 < event_queue.size()) {
+        return;
+    }
+    const auto itr =
+        std::remove_if(event_queue.begin(), event_queue.end(), [this](const QueueEntry& entry) {
+            return event_pool[entry.slot].generation != entry.generation;
+        });
+    event_queue.erase(itr, event_queue.end());
+    std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    stale_entries = 0;
 }
 
 void CoreTiming::ForceExceptionCheck(s64 cycles) {
+    if (current_context == NO_CONTEXT) {
+        // Events scheduled by other host threads are seen when the cores next advance
+        return;
+    }
     cycles = std::max<s64>(0, cycles);
     if (downcounts[current_context] <= cycles) {
         return;
@@ -156,21 +271,34 @@ std::optional<u64> CoreTiming::NextAvailableCore(const s64 needed_ticks) const {
 
 void CoreTiming::Advance() {
     std::unique_lock<std::mutex> guard(inner_mutex);
-
-    const u64 cycles_executed = accumulated_ticks;
-    time_slice[current_context] = std::max<s64>(0, time_slice[current_context] - accumulated_ticks);
-    global_timer += cycles_executed;
+    DEBUG_ASSERT(current_context != NO_CONTEXT);
+
+    const u64 cycles_executed = accumulated_ticks[current_context];
+    time_slice[current_context] = std::max<s64>(0, time_slice[current_context] - cycles_executed);
+    if (is_multicore) {
+        // Cores run concurrently, so global time only advances as far as every core has reached.
+        core_ticks[current_context] += cycles_executed;
+        global_timer = std::max(global_timer.load(), GetSlowestCoreTicks());
+    } else {
+        global_timer += static_cast<s64>(cycles_executed);
+    }
 
     is_global_timer_sane = true;
 
-    while (!event_queue.empty() && event_queue.front().time <= global_timer) {
-        Event evt = std::move(event_queue.front());
+    for (const QueueEntry* next = NextEvent(); next != nullptr && next->time <= global_timer;
+         next = NextEvent()) {
+        const s64 event_time = next->time;
+        const u32 slot = next->slot;
         std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
         event_queue.pop_back();
+
+        const u64 userdata = event_pool[slot].userdata;
+        const auto event_type = event_pool[slot].type.lock();
+        ReleaseEvent(slot, event_type.get());
         inner_mutex.unlock();
 
-        if (auto event_type{evt.type.lock()}) {
-            event_type->callback(evt.userdata, global_timer - evt.time);
+        if (event_type) {
+            event_type->callback(userdata, global_timer - event_time);
         }
 
         inner_mutex.lock();
@@ -179,16 +307,20 @@ void CoreTiming::Advance() {
     is_global_timer_sane = false;
 
     // Still events left (scheduled in the future)
-    if (!event_queue.empty()) {
-        const s64 needed_ticks =
-            std::min<s64>(event_queue.front().time - global_timer, MAX_SLICE_LENGTH);
-        const auto next_core = NextAvailableCore(needed_ticks);
-        if (next_core) {
-            downcounts[*next_core] = needed_ticks;
+    if (const QueueEntry* next = NextEvent()) {
+        const s64 needed_ticks = std::min<s64>(next->time - global_timer, MAX_SLICE_LENGTH);
+        if (is_multicore) {
+            // Other cores are running, each one only shortens its own slice.
+            time_slice[current_context] = std::min(time_slice[current_context], needed_ticks);
+        } else {
+            const auto next_core = NextAvailableCore(needed_ticks);
+            if (next_core) {
+                downcounts[*next_core] = needed_ticks;
+            }
         }
     }
 
-    accumulated_ticks = 0;
+    accumulated_ticks[current_context] = 0;
 
     downcounts[current_context] = time_slice[current_context];
 }
@@ -198,18 +330,30 @@ void CoreTiming::ResetRun() {
     time_slice.fill(MAX_SLICE_LENGTH);
     current_context = 0;
     // Still events left (scheduled in the future)
-    if (!event_queue.empty()) {
-        const s64 needed_ticks =
-            std::min<s64>(event_queue.front().time - global_timer, MAX_SLICE_LENGTH);
+    if (const QueueEntry* next = NextEvent()) {
+        const s64 needed_ticks = std::min<s64>(next->time - global_timer, MAX_SLICE_LENGTH);
         downcounts[current_context] = needed_ticks;
     }
 
     is_global_timer_sane = false;
-    accumulated_ticks = 0;
+    accumulated_ticks.fill(0);
+}
+
+void CoreTiming::ResetContextRun() {
+    std::lock_guard guard{inner_mutex};
+
+    time_slice[current_context] = MAX_SLICE_LENGTH;
+    downcounts[current_context] = MAX_SLICE_LENGTH;
+    if (const QueueEntry* next = NextEvent()) {
+        const s64 needed_ticks = std::min<s64>(next->time - global_timer, MAX_SLICE_LENGTH);
+        downcounts[current_context] = needed_ticks;
+    }
+
+    accumulated_ticks[current_context] = 0;
 }
 
 void CoreTiming::Idle() {
-    accumulated_ticks += downcounts[current_context];
+    accumulated_ticks[current_context] += downcounts[current_context];
     idled_cycles += downcounts[current_context];
     downcounts[current_context] = 0;
 }
@@ -222,4 +366,12 @@ s64 CoreTiming::GetDowncount() const {
     return downcounts[current_context];
 }
 
+s64 CoreTiming::GetSlowestCoreTicks() const {
+    u64 slowest = core_ticks[0].load();
+    for (std::size_t core = 1; core < num_cpu_cores; ++core) {
+        slowest = std::min(slowest, core_ticks[core].load());
+    }
+    return static_cast<s64>(slowest);
+}
+
 } // namespace Core::Timing
@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -20,6 +23,9 @@ namespace Core::Timing {
 /// A callback that may be scheduled for a particular core timing event.
 using TimedCallback = std::function<void(u64 userdata, s64 cycles_late)>;
 
+/// Index of an unused slot in the event pool.
+constexpr u32 INVALID_EVENT_SLOT = std::numeric_limits<u32>::max();
+
 /// Contains the characteristics of a particular event.
 struct EventType {
     EventType(TimedCallback&& callback, std::string&& name)
@@ -29,6 +35,18 @@ struct EventType {
     TimedCallback callback;
     /// A pointer to the name of the event.
     const std::string name;
+
+private:
+    friend class CoreTiming;
+
+    /// First pending event of this type, the rest are linked through the event pool.
+    u32 first_pending = INVALID_EVENT_SLOT;
+};
+
+/// Identifies a single scheduled event, so that it can be cancelled without searching for it.
+struct EventHandle {
+    u32 slot = INVALID_EVENT_SLOT;
+    u32 generation = 0;
 };
 
 /**
@@ -65,18 +83,24 @@ public:
     /// event is scheduled earlier than the current values.
     ///
     /// Scheduling from a callback will not update the downcount until the Advance() completes.
-    void ScheduleEvent(s64 cycles_into_future, const std::shared_ptr<EventType>& event_type,
-                       u64 userdata = 0);
+    ///
+    /// @returns A handle that can be used to cancel this particular event.
+    EventHandle ScheduleEvent(s64 cycles_into_future, const std::shared_ptr<EventType>& event_type,
+                              u64 userdata = 0);
 
     void UnscheduleEvent(const std::shared_ptr<EventType>& event_type, u64 userdata);
 
+    /// Cancels a scheduled event in constant time. Does nothing if the event has already fired or
+    /// has been cancelled.
+    void UnscheduleEvent(EventHandle handle);
+
     /// We only permit one event of each type in the queue at a time.
     void RemoveEvent(const std::shared_ptr<EventType>& event_type);
 
     void ForceExceptionCheck(s64 cycles);
 
-    /// This should only be called from the emu thread, if you are calling it any other thread,
-    /// you are doing something evil
+    /// Returns the current time as seen by the calling host thread. Threads that don't run a core
+    /// see the time that the cores have reached at their last Advance().
     u64 GetTicks() const;
 
     u64 GetIdleTicks() const;
@@ -97,8 +121,19 @@ public:
 
     void ResetRun();
 
+    /// Starts a new time slice for the current context only. Used instead of ResetRun() in
+    /// multi-core mode, where each core runs its slices on its own host thread.
+    void ResetContextRun();
+
     s64 GetDowncount() const;
 
+    /// Returns the number of ticks executed by the given core. Only tracked in multi-core mode.
+    u64 GetCoreTicks(std::size_t core) const {
+        return core_ticks[core].load();
+    }
+
+    /// Sets the core that is executing on the calling host thread. Other host threads, like the
+    /// GPU, audio and service threads, don't run a core and only read the global time.
     void SwitchContext(u64 new_context) {
         current_context = new_context;
     }
@@ -111,31 +146,61 @@ public:
 
 private:
     struct Event;
+    struct QueueEntry;
 
     /// Clear all pending events. This should ONLY be done on exit.
     void ClearPendingEvents();
 
+    /// Returns the queue entry of the event that fires next, or nullptr if there are no events.
+    /// Cancelled entries on top of the queue are discarded along the way.
+    const QueueEntry* NextEvent();
+
+    /// Returns an event to the pool. Queue entries that still refer to it become stale.
+    void ReleaseEvent(u32 slot, EventType* event_type);
+
+    /// Cancels a pending event, leaving its queue entry behind to be discarded lazily.
+    void CancelEvent(u32 slot, EventType* event_type);
+
+    /// Returns the number of ticks executed by the core that is furthest behind.
+    s64 GetSlowestCoreTicks() const;
+
     static constexpr u64 num_cpu_cores = 4;
 
-    s64 global_timer = 0;
+    /// Context of host threads that don't run a core.
+    static constexpr u64 NO_CONTEXT = std::numeric_limits<u64>::max();
+
+    // Read without the lock by GetTicks() on every host thread
+    std::atomic<s64> global_timer{0};
     s64 idled_cycles = 0;
     s64 slice_length = 0;
-    u64 accumulated_ticks = 0;
+    std::array<u64, num_cpu_cores> accumulated_ticks{};
     std::array<s64, num_cpu_cores> downcounts{};
     // Slice of time assigned to each core per run.
     std::array<s64, num_cpu_cores> time_slice{};
-    u64 current_context = 0;
+    // Ticks executed by each core, in multi-core mode global time is the time all cores reached.
+    std::array<std::atomic<u64>, num_cpu_cores> core_ticks{};
+    // Core executing on each host thread. In single-core mode all cores run on the same thread.
+    // Per-core state is only accessed by the thread running that core.
+    static thread_local u64 current_context;
+
+    bool is_multicore = false;
 
     // Are we in a function that has been called from Advance()
     // If events are scheduled from a function that gets called from Advance(),
     // don't change slice_length and downcount.
     bool is_global_timer_sane = false;
 
-    // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-    // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-    // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't
-    // accomodated by the standard adaptor class.
-    std::vector<Event> event_queue;
+    // Scheduled events live in a pool of reusable slots, so scheduling doesn't allocate once the
+    // pool has grown to the number of events in flight. Events of the same type are linked
+    // together, so they can be found without scanning the whole queue.
+    std::vector<Event> event_pool;
+    std::vector<u32> free_slots;
+
+    // The queue is a min-heap of (time, slot) entries using std::push_heap/pop_heap. Cancelled
+    // events bump the generation of their slot and their entries are skipped when they reach the
+    // top of the heap, or compacted away when they outnumber the live ones.
+    std::vector<QueueEntry> event_queue;
+    std::size_t stale_entries = 0;
     u64 event_fifo_id = 0;
 
     std::shared_ptr<EventType> ev_lost;
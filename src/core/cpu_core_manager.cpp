@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/core_cpu.h"
@@ -24,7 +25,7 @@ CpuCoreManager::CpuCoreManager(System& system) : system{system} {}
 CpuCoreManager::~CpuCoreManager() = default;
 
 void CpuCoreManager::Initialize() {
-    barrier = std::make_unique<CpuBarrier>();
+    barrier = std::make_unique<CpuBarrier>(system.CoreTiming());
     exclusive_monitor = Cpu::MakeExclusiveMonitor(system.Memory(), cores.size());
 
     for (std::size_t index = 0; index < cores.size(); ++index) {
@@ -51,9 +52,19 @@ void CpuCoreManager::Shutdown() {
     barrier->NotifyEnd();
     if (Settings::values.use_multi_core) {
         for (auto& thread : core_threads) {
+            // The threads aren't started when only the cores are initialized
+            if (thread == nullptr) {
+                continue;
+            }
             thread->join();
             thread.reset();
         }
+
+        for (std::size_t index = 0; index < cores.size(); ++index) {
+            const auto wait_time = GetBarrierWaitTime(index);
+            LOG_INFO(Core, "Core-{} waited {} ms for other cores", index,
+                     std::chrono::duration_cast<std::chrono::milliseconds>(wait_time).count());
+        }
     }
 
     thread_to_cpu.clear();
@@ -74,6 +85,10 @@ const Cpu& CpuCoreManager::GetCore(std::size_t index) const {
     return *cores.at(index);
 }
 
+std::chrono::nanoseconds CpuCoreManager::GetBarrierWaitTime(std::size_t index) const {
+    return barrier->GetWaitTime(index);
+}
+
 ExclusiveMonitor& CpuCoreManager::GetExclusiveMonitor() {
     return *exclusive_monitor;
 }
@@ -124,19 +139,24 @@ void CpuCoreManager::RunLoop(bool tight_loop) {
         }
     }
 
-    auto& core_timing = system.CoreTiming();
-    core_timing.ResetRun();
-    bool keep_running{};
-    do {
-        keep_running = false;
-        for (active_core = 0; active_core < NUM_CPU_CORES; ++active_core) {
-            core_timing.SwitchContext(active_core);
-            if (core_timing.CanCurrentContextRun()) {
-                cores[active_core]->RunLoop(tight_loop);
+    if (Settings::values.use_multi_core) {
+        // Cores 1-3 run on their own host threads, only core 0 runs on this one
+        cores[0]->RunLoop(tight_loop);
+    } else {
+        auto& core_timing = system.CoreTiming();
+        core_timing.ResetRun();
+        bool keep_running{};
+        do {
+            keep_running = false;
+            for (active_core = 0; active_core < NUM_CPU_CORES; ++active_core) {
+                core_timing.SwitchContext(active_core);
+                if (core_timing.CanCurrentContextRun()) {
+                    cores[active_core]->RunLoop(tight_loop);
+                }
+                keep_running |= core_timing.CanCurrentContextRun();
             }
-            keep_running |= core_timing.CanCurrentContextRun();
-        }
-    } while (keep_running);
+        } while (keep_running);
+    }
 
     if (GDBStub::IsServerEnabled()) {
         GDBStub::SetCpuStepFlag(false);
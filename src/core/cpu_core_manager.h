@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <thread>
@@ -40,6 +41,9 @@ public:
     ExclusiveMonitor& GetExclusiveMonitor();
     const ExclusiveMonitor& GetExclusiveMonitor() const;
 
+    /// Returns the total time the given core has spent waiting for other cores in multi-core mode.
+    std::chrono::nanoseconds GetBarrierWaitTime(std::size_t index) const;
+
     void RunLoop(bool tight_loop);
 
     void InvalidateAllInstructionCaches();
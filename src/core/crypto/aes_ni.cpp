@@ -0,0 +1,296 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include "common/assert.h"
+#include "core/crypto/aes_ni.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#include "common/swap.h"
+#include "common/x64/cpu_detect.h"
+#endif
+
+namespace Core::Crypto::AESNI {
+
+#ifdef ARCHITECTURE_x86_64
+
+// Lets GCC and Clang emit AES-NI instructions in these functions only, the CPU is checked at
+// runtime. Helpers are force inlined so the blocks they work on stay in registers.
+#if defined(__GNUC__) || defined(__clang__)
+#define AESNI_TARGET __attribute__((target("aes")))
+#define AESNI_INLINE inline __attribute__((always_inline, target("aes")))
+#else
+#define AESNI_TARGET
+#define AESNI_INLINE __forceinline
+#endif
+
+namespace {
+
+constexpr std::size_t NUM_ROUNDS = 10;
+constexpr std::size_t BLOCK_SIZE = 16;
+
+// Independent blocks encrypted together, hiding the latency of each AES round instruction
+constexpr std::size_t PARALLEL_BLOCKS = 8;
+
+struct RoundKeys {
+    __m128i keys[NUM_ROUNDS + 1];
+};
+
+template <int Rcon>
+AESNI_INLINE __m128i ExpandRound(__m128i key) {
+    __m128i keygened = _mm_aeskeygenassist_si128(key, Rcon);
+    keygened = _mm_shuffle_epi32(keygened, _MM_SHUFFLE(3, 3, 3, 3));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, keygened);
+}
+
+AESNI_INLINE RoundKeys LoadKeys(const std::array<u8, 11 * 16>& bytes) {
+    RoundKeys round_keys;
+    for (std::size_t i = 0; i <= NUM_ROUNDS; ++i) {
+        round_keys.keys[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(&bytes[i * 16]));
+    }
+    return round_keys;
+}
+
+template <std::size_t... I>
+AESNI_INLINE void EncryptBlocks(const RoundKeys& round_keys, __m128i* blocks,
+                                std::index_sequence<I...>) {
+    ((blocks[I] = _mm_xor_si128(blocks[I], round_keys.keys[0])), ...);
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        const __m128i key = round_keys.keys[round];
+        ((blocks[I] = _mm_aesenc_si128(blocks[I], key)), ...);
+    }
+    ((blocks[I] = _mm_aesenclast_si128(blocks[I], round_keys.keys[NUM_ROUNDS])), ...);
+}
+
+template <std::size_t... I>
+AESNI_INLINE void DecryptBlocks(const RoundKeys& round_keys, __m128i* blocks,
+                                std::index_sequence<I...>) {
+    ((blocks[I] = _mm_xor_si128(blocks[I], round_keys.keys[0])), ...);
+    for (std::size_t round = 1; round < NUM_ROUNDS; ++round) {
+        const __m128i key = round_keys.keys[round];
+        ((blocks[I] = _mm_aesdec_si128(blocks[I], key)), ...);
+    }
+    ((blocks[I] = _mm_aesdeclast_si128(blocks[I], round_keys.keys[NUM_ROUNDS])), ...);
+}
+
+/// Runs the rounds of N blocks interleaved.
+template <std::size_t N>
+AESNI_INLINE void EncryptBlocks(const RoundKeys& round_keys, __m128i* blocks) {
+    EncryptBlocks(round_keys, blocks, std::make_index_sequence<N>{});
+}
+
+template <std::size_t N>
+AESNI_INLINE void TranscodeBlocks(const RoundKeys& round_keys, __m128i* blocks, bool encrypt) {
+    if (encrypt) {
+        EncryptBlocks(round_keys, blocks, std::make_index_sequence<N>{});
+    } else {
+        DecryptBlocks(round_keys, blocks, std::make_index_sequence<N>{});
+    }
+}
+
+/// Big-endian 128-bit counter of CTR mode, kept in host order.
+class Counter {
+public:
+    explicit Counter(const std::array<u8, 16>& iv) {
+        std::memcpy(&high, iv.data(), sizeof(high));
+        std::memcpy(&low, iv.data() + sizeof(high), sizeof(low));
+        high = Common::swap64(high);
+        low = Common::swap64(low);
+    }
+
+    /// Returns the current counter block and increments the counter.
+    AESNI_INLINE __m128i Next() {
+        const __m128i block = _mm_set_epi64x(static_cast<s64>(Common::swap64(low)),
+                                             static_cast<s64>(Common::swap64(high)));
+        if (++low == 0) {
+            ++high;
+        }
+        return block;
+    }
+
+private:
+    u64 high;
+    u64 low;
+};
+
+/// Multiplies an XTS tweak by x in GF(2^128).
+AESNI_INLINE __m128i MultiplyByAlpha(__m128i tweak) {
+    // Shift each dword left and carry their top bits into the next one, the top bit of the tweak
+    // is reduced with the polynomial x^7 + x^2 + x + 1
+    const __m128i carry =
+        _mm_and_si128(_mm_srai_epi32(tweak, 31), _mm_set_epi32(0x87, 1, 1, 1));
+    return _mm_xor_si128(_mm_slli_epi32(tweak, 1),
+                         _mm_shuffle_epi32(carry, _MM_SHUFFLE(2, 1, 0, 3)));
+}
+
+AESNI_INLINE __m128i Load(const u8* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+AESNI_INLINE void Store(u8* data, __m128i value) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value);
+}
+
+} // Anonymous namespace
+
+bool IsSupported() {
+    return Common::GetCPUCaps().aes;
+}
+
+AESNI_TARGET void ExpandKey(const u8* key, KeySchedule& schedule) {
+    __m128i keys[NUM_ROUNDS + 1];
+    keys[0] = Load(key);
+    keys[1] = ExpandRound<0x01>(keys[0]);
+    keys[2] = ExpandRound<0x02>(keys[1]);
+    keys[3] = ExpandRound<0x04>(keys[2]);
+    keys[4] = ExpandRound<0x08>(keys[3]);
+    keys[5] = ExpandRound<0x10>(keys[4]);
+    keys[6] = ExpandRound<0x20>(keys[5]);
+    keys[7] = ExpandRound<0x40>(keys[6]);
+    keys[8] = ExpandRound<0x80>(keys[7]);
+    keys[9] = ExpandRound<0x1B>(keys[8]);
+    keys[10] = ExpandRound<0x36>(keys[9]);
+
+    // The equivalent inverse cipher takes the round keys in reverse order, with InvMixColumns
+    // applied to all but the first and last
+    for (std::size_t i = 0; i <= NUM_ROUNDS; ++i) {
+        const __m128i decrypt_key = i == 0 || i == NUM_ROUNDS
+                                        ? keys[NUM_ROUNDS - i]
+                                        : _mm_aesimc_si128(keys[NUM_ROUNDS - i]);
+        Store(&schedule.encrypt_keys[i * 16], keys[i]);
+        Store(&schedule.decrypt_keys[i * 16], decrypt_key);
+    }
+}
+
+AESNI_TARGET void CTRTranscode(const KeySchedule& schedule, const u8* src, std::size_t size,
+                               u8* dest, const std::array<u8, 16>& iv, std::size_t skip) {
+    ASSERT(skip < BLOCK_SIZE);
+    const RoundKeys round_keys = LoadKeys(schedule.encrypt_keys);
+    Counter counter(iv);
+    alignas(16) std::array<u8, BLOCK_SIZE> keystream;
+
+    if (skip != 0 && size != 0) {
+        // Finish the block the data starts in
+        __m128i block = counter.Next();
+        EncryptBlocks<1>(round_keys, &block);
+        Store(keystream.data(), block);
+        const std::size_t count = std::min(size, BLOCK_SIZE - skip);
+        for (std::size_t i = 0; i < count; ++i) {
+            dest[i] = src[i] ^ keystream[skip + i];
+        }
+        src += count;
+        dest += count;
+        size -= count;
+    }
+
+    for (; size >= PARALLEL_BLOCKS * BLOCK_SIZE; size -= PARALLEL_BLOCKS * BLOCK_SIZE) {
+        __m128i blocks[PARALLEL_BLOCKS];
+        for (std::size_t i = 0; i < PARALLEL_BLOCKS; ++i) {
+            blocks[i] = counter.Next();
+        }
+        EncryptBlocks<PARALLEL_BLOCKS>(round_keys, blocks);
+        for (std::size_t i = 0; i < PARALLEL_BLOCKS; ++i) {
+            Store(dest + i * BLOCK_SIZE, _mm_xor_si128(blocks[i], Load(src + i * BLOCK_SIZE)));
+        }
+        src += PARALLEL_BLOCKS * BLOCK_SIZE;
+        dest += PARALLEL_BLOCKS * BLOCK_SIZE;
+    }
+
+    for (; size >= BLOCK_SIZE; size -= BLOCK_SIZE) {
+        __m128i block = counter.Next();
+        EncryptBlocks<1>(round_keys, &block);
+        Store(dest, _mm_xor_si128(block, Load(src)));
+        src += BLOCK_SIZE;
+        dest += BLOCK_SIZE;
+    }
+
+    if (size != 0) {
+        __m128i block = counter.Next();
+        EncryptBlocks<1>(round_keys, &block);
+        Store(keystream.data(), block);
+        for (std::size_t i = 0; i < size; ++i) {
+            dest[i] = src[i] ^ keystream[i];
+        }
+    }
+}
+
+AESNI_TARGET void XTSTranscode(const KeySchedule& data_schedule,
+                               const KeySchedule& tweak_schedule, const u8* src, std::size_t size,
+                               u8* dest, std::size_t sector_id, std::size_t sector_size,
+                               bool encrypt) {
+    ASSERT(sector_size != 0 && sector_size % BLOCK_SIZE == 0 && size % sector_size == 0);
+    const RoundKeys round_keys =
+        LoadKeys(encrypt ? data_schedule.encrypt_keys : data_schedule.decrypt_keys);
+    const RoundKeys tweak_keys = LoadKeys(tweak_schedule.encrypt_keys);
+
+    for (std::size_t sector = 0; sector < size; sector += sector_size, ++sector_id) {
+        // The tweak is the sector index as a big-endian 128-bit number
+        __m128i tweak = _mm_set_epi64x(static_cast<s64>(Common::swap64(sector_id)), 0);
+        EncryptBlocks<1>(tweak_keys, &tweak);
+
+        const u8* sector_src = src + sector;
+        u8* sector_dest = dest + sector;
+        std::size_t remaining = sector_size;
+        for (; remaining >= PARALLEL_BLOCKS * BLOCK_SIZE;
+             remaining -= PARALLEL_BLOCKS * BLOCK_SIZE) {
+            __m128i tweaks[PARALLEL_BLOCKS];
+            __m128i blocks[PARALLEL_BLOCKS];
+            for (std::size_t i = 0; i < PARALLEL_BLOCKS; ++i) {
+                tweaks[i] = tweak;
+                blocks[i] = _mm_xor_si128(Load(sector_src + i * BLOCK_SIZE), tweak);
+                tweak = MultiplyByAlpha(tweak);
+            }
+            TranscodeBlocks<PARALLEL_BLOCKS>(round_keys, blocks, encrypt);
+            for (std::size_t i = 0; i < PARALLEL_BLOCKS; ++i) {
+                Store(sector_dest + i * BLOCK_SIZE, _mm_xor_si128(blocks[i], tweaks[i]));
+            }
+            sector_src += PARALLEL_BLOCKS * BLOCK_SIZE;
+            sector_dest += PARALLEL_BLOCKS * BLOCK_SIZE;
+        }
+
+        for (; remaining >= BLOCK_SIZE; remaining -= BLOCK_SIZE) {
+            __m128i block = _mm_xor_si128(Load(sector_src), tweak);
+            TranscodeBlocks<1>(round_keys, &block, encrypt);
+            Store(sector_dest, _mm_xor_si128(block, tweak));
+            tweak = MultiplyByAlpha(tweak);
+            sector_src += BLOCK_SIZE;
+            sector_dest += BLOCK_SIZE;
+        }
+    }
+}
+
+#undef AESNI_TARGET
+#undef AESNI_INLINE
+
+#else
+
+bool IsSupported() {
+    return false;
+}
+
+void ExpandKey(const u8* key, KeySchedule& schedule) {
+    UNREACHABLE();
+}
+
+void CTRTranscode(const KeySchedule& schedule, const u8* src, std::size_t size, u8* dest,
+                  const std::array<u8, 16>& iv, std::size_t skip) {
+    UNREACHABLE();
+}
+
+void XTSTranscode(const KeySchedule& data_schedule, const KeySchedule& tweak_schedule,
+                  const u8* src, std::size_t size, u8* dest, std::size_t sector_id,
+                  std::size_t sector_size, bool encrypt) {
+    UNREACHABLE();
+}
+
+#endif
+
+} // namespace Core::Crypto::AESNI
@@ -0,0 +1,56 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "common/common_types.h"
+
+namespace Core::Crypto::AESNI {
+
+/// Round keys of AES-128 for both directions.
+struct KeySchedule {
+    alignas(16) std::array<u8, 11 * 16> encrypt_keys;
+    alignas(16) std::array<u8, 11 * 16> decrypt_keys;
+};
+
+/// Returns whether the host CPU supports AES-NI. The other functions must only be called if so.
+bool IsSupported();
+
+/// Expands a 128-bit key into its round keys.
+void ExpandKey(const u8* key, KeySchedule& schedule);
+
+/**
+ * XORs a source memory region with the AES-CTR keystream. Encryption and decryption are the same
+ * operation. The source and destination may be the same region.
+ *
+ * @param schedule the expanded key.
+ * @param src the source memory region.
+ * @param size the size in bytes of the source memory region.
+ * @param dest the destination memory region.
+ * @param iv the big-endian 128-bit counter block the keystream starts at.
+ * @param skip the bytes of the first keystream block to skip, less than 16.
+ */
+void CTRTranscode(const KeySchedule& schedule, const u8* src, std::size_t size, u8* dest,
+                  const std::array<u8, 16>& iv, std::size_t skip);
+
+/**
+ * Transcodes whole sectors with AES-XTS, using the big-endian sector index as the tweak like the
+ * Switch does. The source and destination may be the same region.
+ *
+ * @param data_schedule the expanded data key, the first half of the XTS key.
+ * @param tweak_schedule the expanded tweak key, the second half of the XTS key.
+ * @param src the source memory region.
+ * @param size the size in bytes of the source memory region, a multiple of sector_size.
+ * @param dest the destination memory region.
+ * @param sector_id the index of the first sector.
+ * @param sector_size the size in bytes of each sector, a multiple of 16.
+ * @param encrypt true to encrypt, false to decrypt.
+ */
+void XTSTranscode(const KeySchedule& data_schedule, const KeySchedule& tweak_schedule,
+                  const u8* src, std::size_t size, u8* dest, std::size_t sector_id,
+                  std::size_t sector_size, bool encrypt);
+
+} // namespace Core::Crypto::AESNI
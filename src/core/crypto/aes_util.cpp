@@ -2,9 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "common/scope_exit.h"
+#include "core/crypto/aes_ni.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
@@ -18,6 +22,15 @@ std::vector<u8> CalculateNintendoTweak(std::size_t sector_id) {
     }
     return out;
 }
+
+/// Adds a number of blocks to a big-endian 128-bit counter.
+void IncrementCounter(std::array<u8, 16>& counter, std::size_t blocks) {
+    for (std::size_t i = counter.size(); i-- > 0 && blocks != 0;) {
+        blocks += counter[i];
+        counter[i] = static_cast<u8>(blocks);
+        blocks >>= 8;
+    }
+}
 } // Anonymous namespace
 
 static_assert(static_cast<std::size_t>(Mode::CTR) ==
@@ -34,6 +47,16 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+    // AES-NI replaces mbedtls for AES-128 in CTR and XTS mode when the host supports it. The key
+    // schedules are the CTR key or the XTS data and tweak keys.
+    bool use_aesni = false;
+    Mode mode;
+    std::array<AESNI::KeySchedule, 2> aesni_keys;
+    std::array<u8, 16> iv{};
+
+    // Key of the cipher, CTRTranscode sets up its own mbedtls context with it
+    std::array<u8, 0x20> key{};
 };
 
 template <typename Key, std::size_t KeySize>
@@ -55,6 +78,19 @@ Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
     ASSERT(
         !mbedtls_cipher_setkey(&ctx->decryption_context, key.data(), KeySize * 8, MBEDTLS_DECRYPT));
     //"Failed to set key on mbedtls ciphers.");
+
+    std::copy_n(key.begin(), KeySize, ctx->key.begin());
+    ctx->mode = mode;
+    if (AESNI::IsSupported()) {
+        if (mode == Mode::CTR && KeySize == 0x10) {
+            AESNI::ExpandKey(key.data(), ctx->aesni_keys[0]);
+            ctx->use_aesni = true;
+        } else if (mode == Mode::XTS && KeySize == 0x20) {
+            AESNI::ExpandKey(key.data(), ctx->aesni_keys[0]);
+            AESNI::ExpandKey(key.data() + 0x10, ctx->aesni_keys[1]);
+            ctx->use_aesni = true;
+        }
+    }
 }
 
 template <typename Key, std::size_t KeySize>
@@ -65,6 +101,11 @@ AESCipher<Key, KeySize>::~AESCipher() {
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::SetIV(std::vector<u8> iv) {
+    if (ctx->use_aesni) {
+        ASSERT_MSG(iv.size() >= ctx->iv.size(), "Failed to set IV on AES-NI cipher.");
+        std::copy_n(iv.begin(), ctx->iv.size(), ctx->iv.begin());
+        return;
+    }
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, iv.data(), iv.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, iv.data(), iv.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
@@ -72,7 +113,18 @@ void AESCipher<Key, KeySize>::SetIV(std::vector<u8> iv) {
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
+    if (ctx->use_aesni && ctx->mode == Mode::CTR) {
+        AESNI::CTRTranscode(ctx->aesni_keys[0], src, size, dest, ctx->iv, 0);
+        // Continue the keystream from the next block like mbedtls does
+        IncrementCounter(ctx->iv, (size + 0xF) / 0x10);
+        return;
+    }
+
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
+    if (ctx->use_aesni) {
+        // A single XTS data unit, mbedtls handles its partial blocks
+        mbedtls_cipher_set_iv(context, ctx->iv.data(), ctx->iv.size());
+    }
 
     mbedtls_cipher_reset(context);
 
@@ -113,11 +165,48 @@ void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* des
     mbedtls_cipher_finish(context, nullptr, nullptr);
 }
 
+template <typename Key, std::size_t KeySize>
+void AESCipher<Key, KeySize>::CTRTranscode(const u8* src, std::size_t size, u8* dest,
+                                           const std::array<u8, 16>& iv, std::size_t skip) const {
+    ASSERT(ctx->mode == Mode::CTR && skip < 0x10);
+    if (ctx->use_aesni) {
+        AESNI::CTRTranscode(ctx->aesni_keys[0], src, size, dest, iv, skip);
+        return;
+    }
+
+    // The IV and the keystream position are per call, so the contexts shared with SetIV and
+    // Transcode can't be used. A context of its own keeps this safe to call from several threads.
+    mbedtls_cipher_context_t context;
+    mbedtls_cipher_init(&context);
+    SCOPE_EXIT({ mbedtls_cipher_free(&context); });
+    ASSERT(!mbedtls_cipher_setup(
+        &context, mbedtls_cipher_info_from_type(static_cast<mbedtls_cipher_type_t>(ctx->mode))));
+    ASSERT(!mbedtls_cipher_setkey(&context, ctx->key.data(), KeySize * 8, MBEDTLS_ENCRYPT));
+    mbedtls_cipher_set_iv(&context, iv.data(), iv.size());
+
+    // mbedtls keeps the position within the keystream block, advance it over the skipped bytes
+    std::array<u8, 0x10> discard{};
+    std::size_t written = 0;
+    mbedtls_cipher_update(&context, discard.data(), skip, discard.data(), &written);
+    mbedtls_cipher_update(&context, src, size, dest, &written);
+    if (written != size) {
+        LOG_WARNING(Crypto, "Not all data was decrypted requested={:016X}, actual={:016X}.", size,
+                    written);
+    }
+    mbedtls_cipher_finish(&context, nullptr, nullptr);
+}
+
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8* dest,
                                            std::size_t sector_id, std::size_t sector_size, Op op) {
     ASSERT_MSG(size % sector_size == 0, "XTS decryption size must be a multiple of sector size.");
 
+    if (ctx->use_aesni && sector_size % 0x10 == 0) {
+        AESNI::XTSTranscode(ctx->aesni_keys[0], ctx->aesni_keys[1], src, size, dest, sector_id,
+                            sector_size, op == Op::Encrypt);
+        return;
+    }
+
     for (std::size_t i = 0; i < size; i += sector_size) {
         SetIV(CalculateNintendoTweak(sector_id++));
         Transcode<u8, u8>(src + i, sector_size, dest + i, op);
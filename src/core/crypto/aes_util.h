@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -46,6 +47,19 @@ public:
 
     void Transcode(const u8* src, std::size_t size, u8* dest, Op op) const;
 
+    /**
+     * Transcodes data in CTR mode without the IV set by SetIV, which has to be set again before
+     * the next call to Transcode. Only valid for ciphers in CTR mode.
+     *
+     * @param src the source memory region, may be the same as dest.
+     * @param size the size in bytes of the source memory region.
+     * @param dest the destination memory region.
+     * @param iv the counter block the keystream starts at.
+     * @param skip the bytes of the first keystream block to skip, less than 16.
+     */
+    void CTRTranscode(const u8* src, std::size_t size, u8* dest, const std::array<u8, 16>& iv,
+                      std::size_t skip) const;
+
     template <typename Source, typename Dest>
     void XTSTranscode(const Source* src, std::size_t size, Dest* dest, std::size_t sector_id,
                       std::size_t sector_size, Op op) {
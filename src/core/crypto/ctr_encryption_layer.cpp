@@ -2,7 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <cstring>
+#include <algorithm>
 #include "common/assert.h"
 #include "core/crypto/ctr_encryption_layer.h"
 
@@ -10,46 +10,38 @@ namespace Core::Crypto {
 
 CTREncryptionLayer::CTREncryptionLayer(FileSys::VirtualFile base_, Key128 key_,
                                        std::size_t base_offset)
-    : EncryptionLayer(std::move(base_)), base_offset(base_offset), cipher(key_, Mode::CTR),
-      iv(16, 0) {}
+    : EncryptionLayer(std::move(base_)), base_offset(base_offset), cipher(key_, Mode::CTR) {}
 
 std::size_t CTREncryptionLayer::Read(u8* data, std::size_t length, std::size_t offset) const {
     if (length == 0)
         return 0;
 
-    const auto sector_offset = offset & 0xF;
-    if (sector_offset == 0) {
-        UpdateIV(base_offset + offset);
-        std::vector<u8> raw = base->ReadBytes(length, offset);
-        cipher.Transcode(raw.data(), raw.size(), data, Op::Decrypt);
-        return length;
+    // Decrypt straight from the base file when it's in host memory, otherwise in place
+    const u8* source = base->GetDataView(length, offset);
+    std::size_t read = length;
+    if (source == nullptr) {
+        read = base->Read(data, length, offset);
+        source = data;
     }
 
-    // offset does not fall on block boundary (0x10)
-    std::vector<u8> block = base->ReadBytes(0x10, offset - sector_offset);
-    UpdateIV(base_offset + offset - sector_offset);
-    cipher.Transcode(block.data(), block.size(), block.data(), Op::Decrypt);
-    std::size_t read = 0x10 - sector_offset;
-
-    if (length + sector_offset < 0x10) {
-        std::memcpy(data, block.data() + sector_offset, std::min<u64>(length, read));
-        return std::min<u64>(length, read);
-    }
-    std::memcpy(data, block.data() + sector_offset, read);
-    return read + Read(data + read, length - read, offset + read);
+    const auto sector_offset = offset & 0xF;
+    cipher.CTRTranscode(source, read, data, CalculateCounter(offset - sector_offset),
+                        sector_offset);
+    return read;
 }
 
 void CTREncryptionLayer::SetIV(const std::vector<u8>& iv_) {
     const auto length = std::min(iv_.size(), iv.size());
-    iv.assign(iv_.cbegin(), iv_.cbegin() + length);
+    std::copy_n(iv_.cbegin(), length, iv.begin());
 }
 
-void CTREncryptionLayer::UpdateIV(std::size_t offset) const {
-    offset >>= 4;
+std::array<u8, 16> CTREncryptionLayer::CalculateCounter(std::size_t offset) const {
+    std::array<u8, 16> counter = iv;
+    offset = (base_offset + offset) >> 4;
     for (std::size_t i = 0; i < 8; ++i) {
-        iv[16 - i - 1] = offset & 0xFF;
+        counter[16 - i - 1] = offset & 0xFF;
         offset >>= 8;
     }
-    cipher.SetIV(iv);
+    return counter;
 }
 } // namespace Core::Crypto
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 #include "core/crypto/aes_util.h"
 #include "core/crypto/encryption_layer.h"
@@ -23,11 +24,11 @@ public:
 private:
     std::size_t base_offset;
 
-    // Must be mutable as operations modify cipher contexts.
-    mutable AESCipher<Key128> cipher;
-    mutable std::vector<u8> iv;
+    AESCipher<Key128> cipher;
+    std::array<u8, 16> iv{};
 
-    void UpdateIV(std::size_t offset) const;
+    /// Returns the counter block of the 16 byte block at offset.
+    std::array<u8, 16> CalculateCounter(std::size_t offset) const;
 };
 
 } // namespace Core::Crypto
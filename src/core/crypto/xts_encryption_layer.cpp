@@ -3,56 +3,73 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include "common/assert.h"
 #include "core/crypto/xts_encryption_layer.h"
 
 namespace Core::Crypto {
 
-constexpr u64 XTS_SECTOR_SIZE = 0x4000;
+constexpr std::size_t XTS_SECTOR_SIZE = 0x4000;
 
 XTSEncryptionLayer::XTSEncryptionLayer(FileSys::VirtualFile base_, Key256 key_)
     : EncryptionLayer(std::move(base_)), cipher(key_, Mode::XTS) {}
 
 std::size_t XTSEncryptionLayer::Read(u8* data, std::size_t length, std::size_t offset) const {
-    if (length == 0)
-        return 0;
-
-    const auto sector_offset = offset & 0x3FFF;
-    if (sector_offset == 0) {
-        if (length % XTS_SECTOR_SIZE == 0) {
-            std::vector<u8> raw = base->ReadBytes(length, offset);
-            cipher.XTSTranscode(raw.data(), raw.size(), data, offset / XTS_SECTOR_SIZE,
-                                XTS_SECTOR_SIZE, Op::Decrypt);
-            return raw.size();
+    std::size_t read = 0;
+    while (read < length) {
+        const std::size_t position = offset + read;
+        const std::size_t remaining = length - read;
+        if (position % XTS_SECTOR_SIZE == 0 && remaining >= XTS_SECTOR_SIZE) {
+            const std::size_t sectors_read =
+                ReadSectors(data + read, remaining - remaining % XTS_SECTOR_SIZE, position);
+            if (sectors_read != 0) {
+                read += sectors_read;
+                continue;
+            }
         }
-        if (length > XTS_SECTOR_SIZE) {
-            const auto rem = length % XTS_SECTOR_SIZE;
-            const auto read = length - rem;
-            return Read(data, read, offset) + Read(data + read, rem, offset + read);
+        const std::size_t partial_read = ReadPartialSector(data + read, remaining, position);
+        if (partial_read == 0) {
+            break;
         }
-        std::vector<u8> buffer = base->ReadBytes(XTS_SECTOR_SIZE, offset);
-        if (buffer.size() < XTS_SECTOR_SIZE)
-            buffer.resize(XTS_SECTOR_SIZE);
-        cipher.XTSTranscode(buffer.data(), buffer.size(), buffer.data(), offset / XTS_SECTOR_SIZE,
-                            XTS_SECTOR_SIZE, Op::Decrypt);
-        std::memcpy(data, buffer.data(), std::min(buffer.size(), length));
-        return std::min(buffer.size(), length);
+        read += partial_read;
+    }
+    return read;
+}
+
+std::size_t XTSEncryptionLayer::ReadSectors(u8* data, std::size_t length,
+                                            std::size_t offset) const {
+    // Decrypt straight from the base file when it's in host memory, otherwise in place
+    const u8* source = base->GetDataView(length, offset);
+    std::size_t read = length;
+    if (source == nullptr) {
+        read = base->Read(data, length, offset);
+        source = data;
     }
 
-    // offset does not fall on block boundary (0x4000)
-    std::vector<u8> block = base->ReadBytes(0x4000, offset - sector_offset);
-    if (block.size() < XTS_SECTOR_SIZE)
-        block.resize(XTS_SECTOR_SIZE);
-    cipher.XTSTranscode(block.data(), block.size(), block.data(),
-                        (offset - sector_offset) / XTS_SECTOR_SIZE, XTS_SECTOR_SIZE, Op::Decrypt);
-    const std::size_t read = XTS_SECTOR_SIZE - sector_offset;
-
-    if (length + sector_offset < XTS_SECTOR_SIZE) {
-        std::memcpy(data, block.data() + sector_offset, std::min<u64>(length, read));
-        return std::min<u64>(length, read);
+    // A sector cut by the end of the base file is left to ReadPartialSector
+    read -= read % XTS_SECTOR_SIZE;
+    cipher.XTSTranscode(source, read, data, offset / XTS_SECTOR_SIZE, XTS_SECTOR_SIZE,
+                        Op::Decrypt);
+    return read;
+}
+
+std::size_t XTSEncryptionLayer::ReadPartialSector(u8* data, std::size_t length,
+                                                  std::size_t offset) const {
+    const std::size_t sector_offset = offset % XTS_SECTOR_SIZE;
+    const std::size_t sector_start = offset - sector_offset;
+
+    std::array<u8, XTS_SECTOR_SIZE> sector;
+    const std::size_t available = base->Read(sector.data(), sector.size(), sector_start);
+    if (available <= sector_offset) {
+        return 0;
     }
-    std::memcpy(data, block.data() + sector_offset, read);
-    return read + Read(data + read, length - read, offset + read);
+    std::fill(sector.begin() + available, sector.end(), u8{0});
+    cipher.XTSTranscode(sector.data(), sector.size(), sector.data(),
+                        sector_start / XTS_SECTOR_SIZE, XTS_SECTOR_SIZE, Op::Decrypt);
+
+    const std::size_t read = std::min(length, available - sector_offset);
+    std::memcpy(data, sector.data() + sector_offset, read);
+    return read;
 }
 } // namespace Core::Crypto
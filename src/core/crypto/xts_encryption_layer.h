@@ -18,6 +18,12 @@ public:
     std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
 
 private:
+    /// Decrypts whole sectors, returns the size of the ones read from the base file.
+    std::size_t ReadSectors(u8* data, std::size_t length, std::size_t offset) const;
+
+    /// Decrypts the sector containing offset and copies out the data from offset up to length.
+    std::size_t ReadPartialSector(u8* data, std::size_t length, std::size_t offset) const;
+
     // Must be mutable as operations modify cipher contexts.
     mutable AESCipher<Key256> cipher;
 };
@@ -14,6 +14,7 @@
 #include "core/file_sys/nca_patch.h"
 #include "core/file_sys/partition_filesystem.h"
 #include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs_cached.h"
 #include "core/file_sys/vfs_offset.h"
 #include "core/loader/loader.h"
 
@@ -353,10 +354,14 @@ bool NCA::ReadRomFSSection(const NCASectionHeader& section, const NCASectionTabl
             section.raw.section_ctr);
 
         // BKTR applies to entire IVFC, so make an offset version to level 6
-        files.push_back(std::make_shared<OffsetVfsFile>(
-            bktr, romfs_size, section.romfs.ivfc.levels[IVFC_MAX_LEVEL - 1].offset));
-    } else {
+        files.push_back(std::make_shared<CachedVfsFile>(std::make_shared<OffsetVfsFile>(
+            bktr, romfs_size, section.romfs.ivfc.levels[IVFC_MAX_LEVEL - 1].offset)));
+    } else if (dec->GetDataView(dec->GetSize()) != nullptr) {
+        // Unencrypted sections of mapped images are already in host memory
         files.push_back(std::move(dec));
+    } else {
+        // Cache decrypted blocks, RomFS is read in many small unaligned chunks
+        files.push_back(std::make_shared<CachedVfsFile>(std::move(dec)));
     }
 
     romfs = files.back();
@@ -20,8 +20,8 @@ BKTR::BKTR(VirtualFile base_romfs_, VirtualFile bktr_romfs_, RelocationBlock rel
     : relocation(relocation_), relocation_buckets(std::move(relocation_buckets_)),
       subsection(subsection_), subsection_buckets(std::move(subsection_buckets_)),
       base_romfs(std::move(base_romfs_)), bktr_romfs(std::move(bktr_romfs_)),
-      encrypted(is_encrypted_), key(key_), base_offset(base_offset_), ivfc_offset(ivfc_offset_),
-      section_ctr(section_ctr_) {
+      encrypted(is_encrypted_), cipher(key_, Core::Crypto::Mode::CTR), base_offset(base_offset_),
+      ivfc_offset(ivfc_offset_), section_ctr(section_ctr_) {
     for (std::size_t i = 0; i < relocation.number_buckets - 1; ++i) {
         relocation_buckets[i].entries.push_back({relocation.base_offsets[i + 1], 0, 0});
     }
@@ -63,10 +63,9 @@ std::size_t BKTR::Read(u8* data, std::size_t length, std::size_t offset) const {
     }
 
     const auto subsection = GetSubsectionEntry(section_offset);
-    Core::Crypto::AESCipher<Core::Crypto::Key128> cipher(key, Core::Crypto::Mode::CTR);
 
     // Calculate AES IV
-    std::vector<u8> iv(16);
+    std::array<u8, 16> iv{};
     auto subsection_ctr = subsection.ctr;
     auto offset_iv = section_offset + base_offset;
     for (std::size_t i = 0; i < section_ctr.size(); ++i)
@@ -80,7 +79,6 @@ std::size_t BKTR::Read(u8* data, std::size_t length, std::size_t offset) const {
         iv[0x7 - i] = static_cast<u8>(subsection_ctr & 0xFF);
         subsection_ctr >>= 8;
     }
-    cipher.SetIV(iv);
 
     const auto next_subsection = GetNextSubsectionEntry(section_offset);
 
@@ -90,22 +88,8 @@ std::size_t BKTR::Read(u8* data, std::size_t length, std::size_t offset) const {
                Read(data + partition, length - partition, offset + partition);
     }
 
-    const auto block_offset = section_offset & 0xF;
-    if (block_offset != 0) {
-        auto block = bktr_romfs->ReadBytes(0x10, section_offset & ~0xF);
-        cipher.Transcode(block.data(), block.size(), block.data(), Core::Crypto::Op::Decrypt);
-        if (length + block_offset < 0x10) {
-            std::memcpy(data, block.data() + block_offset, std::min(length, block.size()));
-            return std::min(length, block.size());
-        }
-
-        const auto read = 0x10 - block_offset;
-        std::memcpy(data, block.data() + block_offset, read);
-        return read + Read(data + read, length - read, offset + read);
-    }
-
     const auto raw_read = bktr_romfs->Read(data, length, section_offset);
-    cipher.Transcode(data, raw_read, data, Core::Crypto::Op::Decrypt);
+    cipher.CTRTranscode(data, raw_read, data, iv, section_offset & 0xF);
     return raw_read;
 }
 
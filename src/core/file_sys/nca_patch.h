@@ -11,6 +11,7 @@
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/swap.h"
+#include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
 namespace FileSys {
@@ -138,7 +139,7 @@ private:
     VirtualFile bktr_romfs;
 
     bool encrypted;
-    Core::Crypto::Key128 key;
+    Core::Crypto::AESCipher<Core::Crypto::Key128> cipher;
 
     // Base offset into NCA, used for IV calculation.
     u64 base_offset;
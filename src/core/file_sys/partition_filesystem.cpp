@@ -46,13 +46,16 @@ PartitionFilesystem::PartitionFilesystem(std::shared_ptr<VfsFile> file) {
     std::size_t metadata_size =
         sizeof(Header) + (pfs_header.num_entries * entry_size) + pfs_header.strtab_size;
 
-    // Actually read in now...
-    std::vector<u8> file_data = file->ReadBytes(metadata_size);
-    const std::size_t total_size = file_data.size();
-
-    if (total_size != metadata_size) {
-        status = Loader::ResultStatus::ErrorIncorrectPFSFileSize;
-        return;
+    // Actually read in now, in place if the file is in host memory
+    std::vector<u8> read_data;
+    const u8* file_data = file->GetDataView(metadata_size);
+    if (file_data == nullptr) {
+        read_data = file->ReadBytes(metadata_size);
+        if (read_data.size() != metadata_size) {
+            status = Loader::ResultStatus::ErrorIncorrectPFSFileSize;
+            return;
+        }
+        file_data = read_data.data();
     }
 
     std::size_t entries_offset = sizeof(Header);
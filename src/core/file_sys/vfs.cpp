@@ -187,6 +187,10 @@ std::vector<u8> VfsFile::ReadAllBytes() const {
     return ReadBytes(GetSize());
 }
 
+const u8* VfsFile::GetDataView(std::size_t size, std::size_t offset) const {
+    return nullptr;
+}
+
 bool VfsFile::WriteByte(u8 data, std::size_t offset) {
     return Write(&data, 1, offset) == 1;
 }
@@ -112,6 +112,10 @@ public:
     // Reads all the bytes from the file into a vector. Equivalent to 'file->Read(file->GetSize(),
     // 0)'
     virtual std::vector<u8> ReadAllBytes() const;
+    // Returns a pointer to the size bytes starting at offset if the file keeps them contiguously in
+    // host memory, allowing them to be used without a copy. Returns nullptr if they aren't or the
+    // range is out of bounds. The pointer is valid while the file is alive and isn't written to.
+    virtual const u8* GetDataView(std::size_t size, std::size_t offset = 0) const;
 
     // Reads an array of type T, size number_elements starting at offset.
     // Returns the number of bytes (sizeof(T)*number_elements) read successfully.
@@ -0,0 +1,165 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "common/assert.h"
+#include "core/file_sys/vfs_cached.h"
+
+namespace FileSys {
+
+CachedVfsFile::CachedVfsFile(VirtualFile file_, std::size_t block_size_, std::size_t num_blocks_,
+                             std::size_t readahead_blocks_)
+    : file(std::move(file_)), block_size(block_size_), num_blocks(num_blocks_),
+      readahead_blocks(std::min(readahead_blocks_, num_blocks_ - 1)) {
+    ASSERT(block_size > 0 && num_blocks > 0);
+}
+
+CachedVfsFile::~CachedVfsFile() = default;
+
+std::string CachedVfsFile::GetName() const {
+    return file->GetName();
+}
+
+std::size_t CachedVfsFile::GetSize() const {
+    return file->GetSize();
+}
+
+bool CachedVfsFile::Resize(std::size_t new_size) {
+    std::lock_guard lock{mutex};
+    blocks.clear();
+    block_map.clear();
+    return file->Resize(new_size);
+}
+
+std::shared_ptr<VfsDirectory> CachedVfsFile::GetContainingDirectory() const {
+    return file->GetContainingDirectory();
+}
+
+bool CachedVfsFile::IsWritable() const {
+    return file->IsWritable();
+}
+
+bool CachedVfsFile::IsReadable() const {
+    return file->IsReadable();
+}
+
+std::size_t CachedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    std::lock_guard lock{mutex};
+    const std::size_t size = file->GetSize();
+    if (offset >= size) {
+        return 0;
+    }
+    length = std::min(length, size - offset);
+    if (length >= block_size * num_blocks / 2) {
+        // Large reads would evict most of the cache, send them straight to the wrapped file
+        ++num_backing_reads;
+        return file->Read(data, length, offset);
+    }
+
+    const bool sequential = offset == next_sequential_offset;
+    next_sequential_offset = offset + length;
+
+    std::size_t read = 0;
+    while (read < length) {
+        const std::size_t position = offset + read;
+        const Block& block = GetBlock(position / block_size, sequential);
+        const std::size_t block_offset = position % block_size;
+        if (block_offset >= block.data.size()) {
+            // The wrapped file returned less data than its size
+            break;
+        }
+        const std::size_t to_copy = std::min(length - read, block.data.size() - block_offset);
+        std::memcpy(data + read, block.data.data() + block_offset, to_copy);
+        read += to_copy;
+    }
+    return read;
+}
+
+std::size_t CachedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    std::lock_guard lock{mutex};
+    InvalidateBlocks(offset, length);
+    return file->Write(data, length, offset);
+}
+
+const u8* CachedVfsFile::GetDataView(std::size_t length, std::size_t offset) const {
+    return file->GetDataView(length, offset);
+}
+
+bool CachedVfsFile::Rename(std::string_view name) {
+    return file->Rename(name);
+}
+
+std::size_t CachedVfsFile::GetNumBackingReads() const {
+    std::lock_guard lock{mutex};
+    return num_backing_reads;
+}
+
+const CachedVfsFile::Block& CachedVfsFile::GetBlock(std::size_t index, bool sequential) const {
+    if (const auto it = block_map.find(index); it != block_map.end()) {
+        // Move the block to the front as the most recently used
+        blocks.splice(blocks.begin(), blocks, it->second);
+        return *it->second;
+    }
+
+    // Fetch the requested block and, on sequential access, the uncached ones following it with a
+    // single read
+    const std::size_t file_size = file->GetSize();
+    const std::size_t last_block = (file_size - 1) / block_size;
+    std::size_t count = 1;
+    if (sequential) {
+        while (count <= readahead_blocks && index + count <= last_block &&
+               block_map.find(index + count) == block_map.end()) {
+            ++count;
+        }
+    }
+    const std::size_t offset = index * block_size;
+    const std::size_t length = std::min(count * block_size, file_size - offset);
+    std::vector<u8> buffer(length);
+    const std::size_t read = file->Read(buffer.data(), length, offset);
+    ++num_backing_reads;
+
+    // Insert in reverse so the requested block ends up as the most recently used
+    for (std::size_t i = count; i-- > 0;) {
+        Block& block = InsertBlock(index + i);
+        const std::size_t begin = std::min(i * block_size, read);
+        const std::size_t end = std::min(begin + block_size, read);
+        block.data.assign(buffer.begin() + begin, buffer.begin() + end);
+    }
+    return blocks.front();
+}
+
+CachedVfsFile::Block& CachedVfsFile::InsertBlock(std::size_t index) const {
+    if (blocks.size() >= num_blocks) {
+        // Recycle the least recently used block
+        block_map.erase(blocks.back().index);
+        blocks.splice(blocks.begin(), blocks, std::prev(blocks.end()));
+        blocks.front().index = index;
+    } else {
+        blocks.push_front(Block{index, {}});
+    }
+    block_map.insert_or_assign(index, blocks.begin());
+    return blocks.front();
+}
+
+void CachedVfsFile::InvalidateBlocks(std::size_t offset, std::size_t length) {
+    if (length == 0) {
+        return;
+    }
+    const std::size_t first = offset / block_size;
+    const std::size_t last = (offset + length - 1) / block_size;
+    for (auto it = blocks.begin(); it != blocks.end();) {
+        if (it->index >= first && it->index <= last) {
+            block_map.erase(it->index);
+            it = blocks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace FileSys
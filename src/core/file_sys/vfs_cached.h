@@ -0,0 +1,83 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/file_sys/vfs.h"
+
+namespace FileSys {
+
+// An implementation of VfsFile that caches fixed size blocks of another VfsFile.
+// Reads are served from the most recently used blocks and misses fetch whole blocks from the
+// wrapped file. When reads are sequential, the blocks following a miss are fetched along with it.
+// It's meant to sit on top of layers where small reads are expensive, like decryption layers.
+// Reads of at least half the cache capacity bypass it.
+// Writes go through to the wrapped file, discarding the cached blocks they overlap.
+class CachedVfsFile : public VfsFile {
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 0x4000;
+    static constexpr std::size_t DEFAULT_NUM_BLOCKS = 256;
+    static constexpr std::size_t DEFAULT_READAHEAD_BLOCKS = 8;
+
+    /**
+     * @param file             File to cache.
+     * @param block_size       Size in bytes of each cached block.
+     * @param num_blocks       Maximum number of blocks kept in memory.
+     * @param readahead_blocks Blocks fetched after a miss when reads are sequential, 0 disables
+     *                         readahead.
+     */
+    explicit CachedVfsFile(VirtualFile file, std::size_t block_size = DEFAULT_BLOCK_SIZE,
+                           std::size_t num_blocks = DEFAULT_NUM_BLOCKS,
+                           std::size_t readahead_blocks = DEFAULT_READAHEAD_BLOCKS);
+    ~CachedVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    std::shared_ptr<VfsDirectory> GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    const u8* GetDataView(std::size_t length, std::size_t offset) const override;
+    bool Rename(std::string_view name) override;
+
+    /// Returns the number of reads issued to the wrapped file.
+    std::size_t GetNumBackingReads() const;
+
+private:
+    struct Block {
+        std::size_t index;
+        std::vector<u8> data;
+    };
+    using BlockList = std::list<Block>;
+
+    /// Returns a cached block, fetching it if needed. Invalidates iterators to evicted blocks.
+    const Block& GetBlock(std::size_t index, bool sequential) const;
+
+    /// Inserts a block as the most recently used one, evicting the least recently used if full.
+    Block& InsertBlock(std::size_t index) const;
+
+    void InvalidateBlocks(std::size_t offset, std::size_t length);
+
+    VirtualFile file;
+    std::size_t block_size;
+    std::size_t num_blocks;
+    std::size_t readahead_blocks;
+
+    mutable std::mutex mutex;
+    mutable BlockList blocks; ///< Most recently used first.
+    mutable std::unordered_map<std::size_t, BlockList::iterator> block_map;
+    mutable std::size_t next_sequential_offset = 0;
+    mutable std::size_t num_backing_reads = 0;
+};
+
+} // namespace FileSys
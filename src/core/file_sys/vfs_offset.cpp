@@ -83,6 +83,12 @@ std::size_t OffsetVfsFile::WriteBytes(const std::vector<u8>& data, std::size_t r
     return file->Write(data.data(), TrimToFit(data.size(), r_offset), offset + r_offset);
 }
 
+const u8* OffsetVfsFile::GetDataView(std::size_t r_size, std::size_t r_offset) const {
+    if (r_offset > size || r_size > size - r_offset)
+        return nullptr;
+    return file->GetDataView(r_size, offset + r_offset);
+}
+
 bool OffsetVfsFile::Rename(std::string_view name) {
     return file->Rename(name);
 }
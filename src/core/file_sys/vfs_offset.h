@@ -34,6 +34,7 @@ public:
     std::vector<u8> ReadAllBytes() const override;
     bool WriteByte(u8 data, std::size_t offset) override;
     std::size_t WriteBytes(const std::vector<u8>& data, std::size_t offset) override;
+    const u8* GetDataView(std::size_t r_size, std::size_t r_offset) const override;
 
     bool Rename(std::string_view name) override;
 
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
 #include <utility>
 #include "common/assert.h"
@@ -73,6 +74,33 @@ VirtualFile RealVfsFilesystem::OpenFile(std::string_view path_, Mode perms) {
         }
     }
 
+    if ((perms & Mode::WriteAppend) != 0) {
+        // The file may be resized or rewritten, read-only opens from now on map it again
+        ForgetMappings(path, false);
+    } else if (perms == Mode::Read) {
+        // Read-only files are mapped, game images are then read without going through stdio
+        std::shared_ptr<FileUtil::MappedFile> mapping;
+        if (const auto iter = mapped_cache.find(path); iter != mapped_cache.end()) {
+            mapping = iter->second.lock();
+        }
+        if (mapping != nullptr && mapping->GetSize() != FileUtil::GetSize(path)) {
+            // Changed outside of the VFS since it was mapped
+            mapping = nullptr;
+        }
+        if (mapping == nullptr) {
+            mapping = std::make_shared<FileUtil::MappedFile>(path);
+            if (mapping->IsOpen()) {
+                mapped_cache[path] = mapping;
+            } else {
+                mapping = nullptr;
+            }
+        }
+        if (mapping != nullptr) {
+            // Cannot use make_shared as MappedVfsFile constructor is private
+            return std::shared_ptr<MappedVfsFile>(new MappedVfsFile(*this, mapping, path));
+        }
+    }
+
     if (!FileUtil::Exists(path) && (perms & Mode::WriteAppend) != 0)
         FileUtil::CreateEmptyFile(path);
 
@@ -116,6 +144,7 @@ VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_
         FileUtil::IsDirectory(old_path) || !FileUtil::Rename(old_path, new_path))
         return nullptr;
 
+    ForgetMappings(old_path, false);
     if (cache.find(old_path) != cache.end()) {
         auto cached = cache[old_path];
         if (!cached.expired()) {
@@ -130,6 +159,7 @@ VirtualFile RealVfsFilesystem::MoveFile(std::string_view old_path_, std::string_
 
 bool RealVfsFilesystem::DeleteFile(std::string_view path_) {
     const auto path = FileUtil::SanitizePath(path_, FileUtil::DirectorySeparator::PlatformDefault);
+    ForgetMappings(path, false);
     if (cache.find(path) != cache.end()) {
         if (!cache[path].expired())
             cache[path].lock()->Close();
@@ -179,6 +209,7 @@ VirtualDir RealVfsFilesystem::MoveDirectory(std::string_view old_path_,
         FileUtil::IsDirectory(old_path) || !FileUtil::Rename(old_path, new_path))
         return nullptr;
 
+    ForgetMappings(old_path, true);
     for (auto& kv : cache) {
         // Path in cache starts with old_path
         if (kv.first.rfind(old_path, 0) == 0) {
@@ -202,6 +233,7 @@ VirtualDir RealVfsFilesystem::MoveDirectory(std::string_view old_path_,
 
 bool RealVfsFilesystem::DeleteDirectory(std::string_view path_) {
     const auto path = FileUtil::SanitizePath(path_, FileUtil::DirectorySeparator::PlatformDefault);
+    ForgetMappings(path, true);
     for (auto& kv : cache) {
         // Path in cache starts with old_path
         if (kv.first.rfind(path, 0) == 0) {
@@ -213,6 +245,18 @@ bool RealVfsFilesystem::DeleteDirectory(std::string_view path_) {
     return FileUtil::DeleteDirRecursively(path);
 }
 
+void RealVfsFilesystem::ForgetMappings(const std::string& path, bool recursive) {
+    // Open MappedVfsFiles keep their mapping, later opens map the file again
+    for (auto iter = mapped_cache.begin(); iter != mapped_cache.end();) {
+        const bool matches = recursive ? iter->first.rfind(path, 0) == 0 : iter->first == path;
+        if (matches || iter->second.expired()) {
+            iter = mapped_cache.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
 RealVfsFile::RealVfsFile(RealVfsFilesystem& base_, std::shared_ptr<FileUtil::IOFile> backing_,
                          const std::string& path_, Mode perms_)
     : base(base_), backing(std::move(backing_)), path(path_),
@@ -267,6 +311,63 @@ bool RealVfsFile::Close() {
     return backing->Close();
 }
 
+MappedVfsFile::MappedVfsFile(RealVfsFilesystem& base_,
+                             std::shared_ptr<FileUtil::MappedFile> mapping_,
+                             const std::string& path_)
+    : base(base_), mapping(std::move(mapping_)), path(path_),
+      parent_path(FileUtil::GetParentPath(path_)),
+      name(FileUtil::SplitPathComponents(path_).back()) {}
+
+MappedVfsFile::~MappedVfsFile() = default;
+
+std::string MappedVfsFile::GetName() const {
+    return name;
+}
+
+std::size_t MappedVfsFile::GetSize() const {
+    return static_cast<std::size_t>(mapping->GetSize());
+}
+
+bool MappedVfsFile::Resize(std::size_t new_size) {
+    return false;
+}
+
+std::shared_ptr<VfsDirectory> MappedVfsFile::GetContainingDirectory() const {
+    return base.OpenDirectory(parent_path, Mode::Read);
+}
+
+bool MappedVfsFile::IsWritable() const {
+    return false;
+}
+
+bool MappedVfsFile::IsReadable() const {
+    return true;
+}
+
+std::size_t MappedVfsFile::Read(u8* data, std::size_t length, std::size_t offset) const {
+    const std::size_t size = GetSize();
+    if (offset >= size)
+        return 0;
+    const std::size_t read = std::min(length, size - offset);
+    std::memcpy(data, mapping->GetData() + offset, read);
+    return read;
+}
+
+std::size_t MappedVfsFile::Write(const u8* data, std::size_t length, std::size_t offset) {
+    return 0;
+}
+
+const u8* MappedVfsFile::GetDataView(std::size_t length, std::size_t offset) const {
+    const std::size_t size = GetSize();
+    if (offset > size || length > size - offset)
+        return nullptr;
+    return mapping->GetData() + offset;
+}
+
+bool MappedVfsFile::Rename(std::string_view name) {
+    return base.MoveFile(path, parent_path + DIR_SEP + std::string(name)) != nullptr;
+}
+
 // TODO(DarkLordZach): MSVC would not let me combine the following two functions using 'if
 // constexpr' because there is a compile error in the branch not used.
 
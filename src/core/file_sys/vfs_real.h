@@ -11,7 +11,8 @@
 
 namespace FileUtil {
 class IOFile;
-}
+class MappedFile;
+} // namespace FileUtil
 
 namespace FileSys {
 
@@ -36,7 +37,11 @@ public:
     bool DeleteDirectory(std::string_view path) override;
 
 private:
+    /// Drops the mappings of the files at path or, if recursive, under it from the mapping cache.
+    void ForgetMappings(const std::string& path, bool recursive);
+
     boost::container::flat_map<std::string, std::weak_ptr<FileUtil::IOFile>> cache;
+    boost::container::flat_map<std::string, std::weak_ptr<FileUtil::MappedFile>> mapped_cache;
 };
 
 // An implmentation of VfsFile that represents a file on the user's computer.
@@ -72,6 +77,38 @@ private:
     Mode perms;
 };
 
+// An implementation of VfsFile that represents a read-only file on the user's computer, mapped into
+// host memory. Reads are copies out of the mapping and GetDataView returns pointers into it.
+// The mapping keeps the size the file had when it was opened. Files aren't mapped while they are
+// open for writing, and mappings are shared only until the file is opened for writing or resized.
+class MappedVfsFile : public VfsFile {
+    friend class RealVfsFilesystem;
+
+public:
+    ~MappedVfsFile() override;
+
+    std::string GetName() const override;
+    std::size_t GetSize() const override;
+    bool Resize(std::size_t new_size) override;
+    std::shared_ptr<VfsDirectory> GetContainingDirectory() const override;
+    bool IsWritable() const override;
+    bool IsReadable() const override;
+    std::size_t Read(u8* data, std::size_t length, std::size_t offset) const override;
+    std::size_t Write(const u8* data, std::size_t length, std::size_t offset) override;
+    const u8* GetDataView(std::size_t length, std::size_t offset) const override;
+    bool Rename(std::string_view name) override;
+
+private:
+    MappedVfsFile(RealVfsFilesystem& base, std::shared_ptr<FileUtil::MappedFile> mapping,
+                  const std::string& path);
+
+    RealVfsFilesystem& base;
+    std::shared_ptr<FileUtil::MappedFile> mapping;
+    std::string path;
+    std::string parent_path;
+    std::string name;
+};
+
 // An implementation of VfsDirectory that represents a directory on the user's computer.
 class RealVfsDirectory : public VfsDirectory {
     friend class RealVfsFilesystem;
@@ -51,6 +51,12 @@ std::size_t VectorVfsFile::Write(const u8* data_, std::size_t length, std::size_
     return write;
 }
 
+const u8* VectorVfsFile::GetDataView(std::size_t length, std::size_t offset) const {
+    if (offset > data.size() || length > data.size() - offset)
+        return nullptr;
+    return data.data() + offset;
+}
+
 bool VectorVfsFile::Rename(std::string_view name_) {
     name = name_;
     return true;
@@ -136,6 +136,8 @@ public:
 
     template <class T>
     void PushIpcInterface(std::shared_ptr<T> iface) {
+        // The interface is serviced on the same host thread as the service that created it
+        iface->SetServiceThread(context->Session()->GetServiceThread());
         if (context->Session()->IsDomain()) {
             context->AddDomainObject(std::move(iface));
         } else {
@@ -2,9 +2,6 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <algorithm>
-#include <vector>
-
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "core/core.h"
@@ -18,24 +15,23 @@
 
 namespace Kernel {
 
-// Wake up num_to_wake (or all) threads in a vector.
-void AddressArbiter::WakeThreads(const std::vector<std::shared_ptr<Thread>>& waiting_threads,
-                                 s32 num_to_wake) {
+// Wake up num_to_wake (or all) threads waiting on an address.
+void AddressArbiter::WakeThreads(VAddr address, s32 num_to_wake) {
     // Only process up to 'target' threads, unless 'target' is <= 0, in which case process
     // them all.
-    std::size_t last = waiting_threads.size();
-    if (num_to_wake > 0) {
-        last = std::min(last, static_cast<std::size_t>(num_to_wake));
-    }
+    for (s32 woken = 0; num_to_wake <= 0 || woken < num_to_wake; ++woken) {
+        Thread* const thread = arb_threads.Front(address);
+        if (thread == nullptr) {
+            break;
+        }
 
-    // Signal the waiting threads.
-    for (std::size_t i = 0; i < last; i++) {
-        ASSERT(waiting_threads[i]->GetStatus() == ThreadStatus::WaitArb);
-        waiting_threads[i]->SetWaitSynchronizationResult(RESULT_SUCCESS);
-        RemoveThread(waiting_threads[i]);
-        waiting_threads[i]->SetArbiterWaitAddress(0);
-        waiting_threads[i]->ResumeFromWait();
-        system.PrepareReschedule(waiting_threads[i]->GetProcessorID());
+        // Signal the waiting thread.
+        ASSERT(thread->GetStatus() == ThreadStatus::WaitArb);
+        thread->SetWaitSynchronizationResult(RESULT_SUCCESS);
+        RemoveThread(thread);
+        thread->SetArbiterWaitAddress(0);
+        thread->ResumeFromWait();
+        system.PrepareReschedule(thread->GetProcessorID());
     }
 }
 
@@ -57,9 +53,7 @@ ResultCode AddressArbiter::SignalToAddress(VAddr address, SignalType type, s32 v
 }
 
 ResultCode AddressArbiter::SignalToAddressOnly(VAddr address, s32 num_to_wake) {
-    const std::vector<std::shared_ptr<Thread>> waiting_threads =
-        GetThreadsWaitingOnAddress(address);
-    WakeThreads(waiting_threads, num_to_wake);
+    WakeThreads(address, num_to_wake);
     return RESULT_SUCCESS;
 }
 
@@ -89,22 +83,21 @@ ResultCode AddressArbiter::ModifyByWaitingCountAndSignalToAddressIfEqual(VAddr a
         return ERR_INVALID_ADDRESS_STATE;
     }
 
-    // Get threads waiting on the address.
-    const std::vector<std::shared_ptr<Thread>> waiting_threads =
-        GetThreadsWaitingOnAddress(address);
+    // Get the number of threads waiting on the address.
+    const std::size_t num_waiting = arb_threads.Count(address);
 
     // Determine the modified value depending on the waiting count.
     s32 updated_value;
     if (num_to_wake <= 0) {
-        if (waiting_threads.empty()) {
+        if (num_waiting == 0) {
             updated_value = value + 1;
         } else {
             updated_value = value - 1;
         }
     } else {
-        if (waiting_threads.empty()) {
+        if (num_waiting == 0) {
             updated_value = value + 1;
-        } else if (waiting_threads.size() <= static_cast<u32>(num_to_wake)) {
+        } else if (num_waiting <= static_cast<u32>(num_to_wake)) {
             updated_value = value - 1;
         } else {
             updated_value = value;
@@ -116,7 +109,7 @@ ResultCode AddressArbiter::ModifyByWaitingCountAndSignalToAddressIfEqual(VAddr a
     }
 
     memory.Write32(address, static_cast<u32>(updated_value));
-    WakeThreads(waiting_threads, num_to_wake);
+    WakeThreads(address, num_to_wake);
     return RESULT_SUCCESS;
 }
 
@@ -184,7 +177,7 @@ ResultCode AddressArbiter::WaitForAddressIfEqual(VAddr address, s32 value, s64 t
 ResultCode AddressArbiter::WaitForAddressImpl(VAddr address, s64 timeout) {
     Thread* current_thread = system.CurrentScheduler().GetCurrentThread();
     current_thread->SetArbiterWaitAddress(address);
-    InsertThread(SharedFrom(current_thread));
+    InsertThread(current_thread);
     current_thread->SetStatus(ThreadStatus::WaitArb);
     current_thread->InvalidateWakeupCallback();
     current_thread->WakeAfterDelay(timeout);
@@ -195,49 +188,16 @@ ResultCode AddressArbiter::WaitForAddressImpl(VAddr address, s64 timeout) {
 
 void AddressArbiter::HandleWakeupThread(std::shared_ptr<Thread> thread) {
     ASSERT(thread->GetStatus() == ThreadStatus::WaitArb);
-    RemoveThread(thread);
+    RemoveThread(thread.get());
     thread->SetArbiterWaitAddress(0);
 }
 
-void AddressArbiter::InsertThread(std::shared_ptr<Thread> thread) {
-    const VAddr arb_addr = thread->GetArbiterWaitAddress();
-    std::list<std::shared_ptr<Thread>>& thread_list = arb_threads[arb_addr];
-    auto it = thread_list.begin();
-    while (it != thread_list.end()) {
-        const std::shared_ptr<Thread>& current_thread = *it;
-        if (current_thread->GetPriority() >= thread->GetPriority()) {
-            thread_list.insert(it, thread);
-            return;
-        }
-        ++it;
-    }
-    thread_list.push_back(std::move(thread));
+void AddressArbiter::InsertThread(Thread* thread) {
+    arb_threads.Insert(thread->GetArbiterWaitAddress(), thread);
 }
 
-void AddressArbiter::RemoveThread(std::shared_ptr<Thread> thread) {
-    const VAddr arb_addr = thread->GetArbiterWaitAddress();
-    std::list<std::shared_ptr<Thread>>& thread_list = arb_threads[arb_addr];
-    auto it = thread_list.begin();
-    while (it != thread_list.end()) {
-        const std::shared_ptr<Thread>& current_thread = *it;
-        if (current_thread.get() == thread.get()) {
-            thread_list.erase(it);
-            return;
-        }
-        ++it;
-    }
-    UNREACHABLE();
+void AddressArbiter::RemoveThread(Thread* thread) {
+    arb_threads.Remove(thread->GetArbiterWaitAddress(), thread);
 }
 
-std::vector<std::shared_ptr<Thread>> AddressArbiter::GetThreadsWaitingOnAddress(VAddr address) {
-    std::vector<std::shared_ptr<Thread>> result;
-    std::list<std::shared_ptr<Thread>>& thread_list = arb_threads[address];
-    auto it = thread_list.begin();
-    while (it != thread_list.end()) {
-        std::shared_ptr<Thread> current_thread = *it;
-        result.push_back(std::move(current_thread));
-        ++it;
-    }
-    return result;
-}
 } // namespace Kernel
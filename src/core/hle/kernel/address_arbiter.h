@@ -4,12 +4,10 @@
 
 #pragma once
 
-#include <list>
 #include <memory>
-#include <unordered_map>
-#include <vector>
 
 #include "common/common_types.h"
+#include "core/hle/kernel/address_wait_queue.h"
 
 union ResultCode;
 
@@ -76,20 +74,17 @@ private:
     // Waits on the given address with a timeout in nanoseconds
     ResultCode WaitForAddressImpl(VAddr address, s64 timeout);
 
-    /// Wake up num_to_wake (or all) threads in a vector.
-    void WakeThreads(const std::vector<std::shared_ptr<Thread>>& waiting_threads, s32 num_to_wake);
+    /// Wake up num_to_wake (or all) threads waiting on an address.
+    void WakeThreads(VAddr address, s32 num_to_wake);
 
     /// Insert a thread into the address arbiter container
-    void InsertThread(std::shared_ptr<Thread> thread);
+    void InsertThread(Thread* thread);
 
     /// Removes a thread from the address arbiter container
-    void RemoveThread(std::shared_ptr<Thread> thread);
+    void RemoveThread(Thread* thread);
 
-    // Gets the threads waiting on an address.
-    std::vector<std::shared_ptr<Thread>> GetThreadsWaitingOnAddress(VAddr address);
-
-    /// List of threads waiting for a address arbiter
-    std::unordered_map<VAddr, std::list<std::shared_ptr<Thread>>> arb_threads;
+    /// Threads waiting for a address arbiter, equal priorities are signaled last in first out
+    AddressWaitQueue arb_threads{AddressWaitQueue::TieOrder::Lifo};
 
     Core::System& system;
 };
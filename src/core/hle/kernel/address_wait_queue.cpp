@@ -0,0 +1,151 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/assert.h"
+#include "core/hle/kernel/address_wait_queue.h"
+#include "core/hle/kernel/thread.h"
+
+namespace Kernel {
+
+namespace {
+constexpr std::size_t INITIAL_SLOTS = 16;
+}
+
+AddressWaitQueue::AddressWaitQueue(TieOrder tie_order) : tie_order{tie_order} {}
+AddressWaitQueue::~AddressWaitQueue() = default;
+
+void AddressWaitQueue::Insert(VAddr address, Thread* thread) {
+    Slot& slot = FindOrInsertSlot(address);
+    const u32 priority = thread->GetPriority();
+    const auto goes_after = [this, priority](const Thread* waiting) {
+        return tie_order == TieOrder::Fifo ? waiting->GetPriority() <= priority
+                                           : waiting->GetPriority() < priority;
+    };
+
+    Thread* prev = nullptr;
+    Thread* next = slot.front;
+    while (next != nullptr && goes_after(next)) {
+        prev = next;
+        next = next->GetAddressWaitNode().next;
+    }
+
+    thread->GetAddressWaitNode() = {prev, next};
+    if (prev != nullptr) {
+        prev->GetAddressWaitNode().next = thread;
+    } else {
+        slot.front = thread;
+    }
+    if (next != nullptr) {
+        next->GetAddressWaitNode().prev = thread;
+    }
+    ++slot.count;
+}
+
+void AddressWaitQueue::Remove(VAddr address, Thread* thread) {
+    const std::size_t index = FindSlot(address);
+    ASSERT_MSG(index != slots.size(), "No thread is waiting on address 0x{:016X}", address);
+    Slot& slot = slots[index];
+
+    AddressWaitNode& node = thread->GetAddressWaitNode();
+    if (node.prev != nullptr) {
+        node.prev->GetAddressWaitNode().next = node.next;
+    } else {
+        ASSERT_MSG(slot.front == thread, "Thread is not waiting on address 0x{:016X}", address);
+        slot.front = node.next;
+    }
+    if (node.next != nullptr) {
+        node.next->GetAddressWaitNode().prev = node.prev;
+    }
+    node = {};
+
+    if (--slot.count == 0) {
+        EraseSlot(index);
+    }
+}
+
+Thread* AddressWaitQueue::Front(VAddr address) const {
+    const std::size_t index = FindSlot(address);
+    return index != slots.size() ? slots[index].front : nullptr;
+}
+
+std::size_t AddressWaitQueue::Count(VAddr address) const {
+    const std::size_t index = FindSlot(address);
+    return index != slots.size() ? slots[index].count : 0;
+}
+
+std::size_t AddressWaitQueue::HomeSlot(VAddr address) const {
+    // Fibonacci hashing, addresses are at least word aligned
+    const u64 hash = (address >> 2) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(hash >> 32) & (slots.size() - 1);
+}
+
+std::size_t AddressWaitQueue::FindSlot(VAddr address) const {
+    if (num_addresses == 0) {
+        return slots.size();
+    }
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t index = HomeSlot(address);; index = (index + 1) & mask) {
+        const Slot& slot = slots[index];
+        if (slot.front == nullptr) {
+            return slots.size();
+        }
+        if (slot.address == address) {
+            return index;
+        }
+    }
+}
+
+AddressWaitQueue::Slot& AddressWaitQueue::FindOrInsertSlot(VAddr address) {
+    if (const std::size_t index = FindSlot(address); index != slots.size()) {
+        return slots[index];
+    }
+
+    // Keep the table at most half full so probe sequences stay short
+    if ((num_addresses + 1) * 2 > slots.size()) {
+        Grow();
+    }
+    const std::size_t mask = slots.size() - 1;
+    std::size_t index = HomeSlot(address);
+    while (slots[index].front != nullptr) {
+        index = (index + 1) & mask;
+    }
+    slots[index].address = address;
+    ++num_addresses;
+    return slots[index];
+}
+
+void AddressWaitQueue::EraseSlot(std::size_t index) {
+    const std::size_t mask = slots.size() - 1;
+    std::size_t hole = index;
+    for (std::size_t next = (hole + 1) & mask; slots[next].front != nullptr;
+         next = (next + 1) & mask) {
+        // An entry can fill the hole if the hole lies between its home slot and where it is
+        const std::size_t home = HomeSlot(slots[next].address);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+    }
+    slots[hole] = {};
+    --num_addresses;
+}
+
+void AddressWaitQueue::Grow() {
+    std::vector<Slot> old_slots(slots.empty() ? INITIAL_SLOTS : slots.size() * 2);
+    slots.swap(old_slots);
+
+    const std::size_t mask = slots.size() - 1;
+    for (const Slot& slot : old_slots) {
+        if (slot.front == nullptr) {
+            continue;
+        }
+        std::size_t index = HomeSlot(slot.address);
+        while (slots[index].front != nullptr) {
+            index = (index + 1) & mask;
+        }
+        slots[index] = slot;
+    }
+}
+
+} // namespace Kernel
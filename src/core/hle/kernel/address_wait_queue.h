@@ -0,0 +1,92 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Kernel {
+
+class Thread;
+
+/// Links of a thread in the AddressWaitQueue it is waiting in.
+struct AddressWaitNode {
+    Thread* prev = nullptr;
+    Thread* next = nullptr;
+};
+
+/**
+ * Priority ordered queues of threads waiting on guest addresses, used by condition variables and
+ * the address arbiter. Threads are linked through their own AddressWaitNode and the queues are
+ * found through an open addressing table that forgets addresses nobody waits on anymore, so
+ * waiting and signaling don't allocate once the table has grown to the working set.
+ *
+ * The queue only keeps raw pointers, waiting threads are kept alive by the global scheduler.
+ */
+class AddressWaitQueue final {
+public:
+    /// Order of threads of the same priority.
+    enum class TieOrder {
+        Fifo, ///< Threads are signaled in the order they started waiting.
+        Lifo, ///< The last thread to start waiting is signaled first.
+    };
+
+    explicit AddressWaitQueue(TieOrder tie_order);
+    ~AddressWaitQueue();
+
+    AddressWaitQueue(const AddressWaitQueue&) = delete;
+    AddressWaitQueue& operator=(const AddressWaitQueue&) = delete;
+
+    AddressWaitQueue(AddressWaitQueue&&) = default;
+    AddressWaitQueue& operator=(AddressWaitQueue&&) = default;
+
+    /// Makes a thread wait on an address, behind the waiting threads of higher priority.
+    void Insert(VAddr address, Thread* thread);
+
+    /// Removes a thread from the threads waiting on an address.
+    void Remove(VAddr address, Thread* thread);
+
+    /// Returns the next thread to signal on an address, or nullptr if no thread waits on it.
+    Thread* Front(VAddr address) const;
+
+    /// Returns the number of threads waiting on an address.
+    std::size_t Count(VAddr address) const;
+
+    /// Returns the number of distinct addresses threads are waiting on.
+    std::size_t NumAddresses() const {
+        return num_addresses;
+    }
+
+private:
+    /// Queue of an address, unused while front is nullptr.
+    struct Slot {
+        VAddr address = 0;
+        Thread* front = nullptr;
+        std::size_t count = 0;
+    };
+
+    /// Returns the slot addresses are first probed at.
+    std::size_t HomeSlot(VAddr address) const;
+
+    /// Returns the slot holding an address, or slots.size() if nobody waits on it.
+    std::size_t FindSlot(VAddr address) const;
+
+    /// Returns the slot holding an address, claiming a free one if needed.
+    Slot& FindOrInsertSlot(VAddr address);
+
+    /// Frees a slot, moving back the entries probed past it.
+    void EraseSlot(std::size_t index);
+
+    /// Doubles the number of slots and rehashes the addresses being waited on.
+    void Grow();
+
+    std::vector<Slot> slots;
+    std::size_t num_addresses = 0;
+    TieOrder tie_order;
+};
+
+} // namespace Kernel
@@ -87,6 +87,34 @@ HLERequestContext::HLERequestContext(std::shared_ptr<Kernel::ServerSession> serv
 
 HLERequestContext::~HLERequestContext() = default;
 
+void HLERequestContext::Reset(std::shared_ptr<ServerSession> session,
+                              std::shared_ptr<Thread> thread_) {
+    server_session = std::move(session);
+    thread = std::move(thread_);
+    cmd_buf[0] = 0;
+
+    move_objects.clear();
+    copy_objects.clear();
+    domain_objects.clear();
+    scratch_buffers.clear();
+
+    command_header.reset();
+    handle_descriptor_header.reset();
+    data_payload_header.reset();
+    domain_message_header.reset();
+    buffer_x_desciptors.clear();
+    buffer_a_desciptors.clear();
+    buffer_b_desciptors.clear();
+    buffer_w_desciptors.clear();
+    buffer_c_desciptors.clear();
+
+    data_payload_offset = 0;
+    buffer_c_offset = 0;
+    command = 0;
+    domain_request_handlers = nullptr;
+    is_thread_waiting = false;
+}
+
 void HLERequestContext::ParseCommandBuffer(const HandleTable& handle_table, u32_le* src_cmdbuf,
                                            bool incoming) {
     IPC::RequestParser rp(src_cmdbuf);
@@ -262,6 +290,14 @@ ResultCode HLERequestContext::WriteToOutgoingCommandBuffer(Thread& thread) {
 
     // TODO(Subv): Translate the X/A/B/W buffers.
 
+    // Output buffers that couldn't be written in place were written to scratch copies instead
+    for (const auto& scratch : scratch_buffers) {
+        if (scratch.write_back) {
+            memory.WriteBlock(scratch.address, scratch.data.data(), scratch.data.size());
+        }
+    }
+    scratch_buffers.clear();
+
     if (Session()->IsDomain() && domain_message_header) {
         ASSERT(domain_message_header->num_objects == domain_objects.size());
         // Write the domain objects to the command buffer, these go after the raw untranslated data.
@@ -323,6 +359,44 @@ std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
     return size;
 }
 
+Common::Span<const u8> HLERequestContext::ReadBufferSpan(int buffer_index) {
+    const bool is_buffer_a{BufferDescriptorA().size() && BufferDescriptorA()[buffer_index].Size()};
+    if (is_buffer_a) {
+        return GetBufferSpan(BufferDescriptorA()[buffer_index].Address(),
+                             BufferDescriptorA()[buffer_index].Size(), false);
+    }
+    return GetBufferSpan(BufferDescriptorX()[buffer_index].Address(),
+                         BufferDescriptorX()[buffer_index].Size(), false);
+}
+
+Common::Span<u8> HLERequestContext::WriteBufferSpan(int buffer_index) {
+    const bool is_buffer_b{BufferDescriptorB().size() && BufferDescriptorB()[buffer_index].Size()};
+    if (is_buffer_b) {
+        return GetBufferSpan(BufferDescriptorB()[buffer_index].Address(),
+                             BufferDescriptorB()[buffer_index].Size(), true);
+    }
+    return GetBufferSpan(BufferDescriptorC()[buffer_index].Address(),
+                         BufferDescriptorC()[buffer_index].Size(), true);
+}
+
+Common::Span<u8> HLERequestContext::GetBufferSpan(VAddr address, std::size_t size,
+                                                  bool write_back) {
+    if (size == 0) {
+        return {};
+    }
+
+    auto& memory = Core::System::GetInstance().Memory();
+    if (u8* const pointer = memory.GetContiguousPointer(address, size)) {
+        return {pointer, size};
+    }
+
+    // Output buffers are read as well, so the bytes the handler doesn't write are preserved
+    ScratchBuffer& scratch =
+        scratch_buffers.emplace_back(ScratchBuffer{address, std::vector<u8>(size), write_back});
+    memory.ReadBlock(address, scratch.data.data(), size);
+    return scratch.data;
+}
+
 std::size_t HLERequestContext::GetReadBufferSize(int buffer_index) const {
     const bool is_buffer_a{BufferDescriptorA().size() && BufferDescriptorA()[buffer_index].Size()};
     return is_buffer_a ? BufferDescriptorA()[buffer_index].Size()
@@ -13,6 +13,7 @@
 #include <vector>
 #include <boost/container/small_vector.hpp>
 #include "common/common_types.h"
+#include "common/span.h"
 #include "common/swap.h"
 #include "core/hle/ipc.h"
 #include "core/hle/kernel/object.h"
@@ -30,6 +31,7 @@ class HandleTable;
 class HLERequestContext;
 class Process;
 class ServerSession;
+class ServiceThread;
 class Thread;
 class ReadableEvent;
 class WritableEvent;
@@ -70,11 +72,27 @@ public:
      */
     void ClientDisconnected(const std::shared_ptr<ServerSession>& server_session);
 
+    /// Returns the host thread the sessions of this handler are serviced on, if any.
+    std::weak_ptr<ServiceThread> GetServiceThread() const {
+        return service_thread;
+    }
+
+    /**
+     * Services the sessions of this handler on the given host thread instead of the emulated CPU
+     * thread. Interfaces returned by this handler inherit the thread.
+     */
+    void SetServiceThread(std::weak_ptr<ServiceThread> service_thread_) {
+        service_thread = std::move(service_thread_);
+    }
+
 protected:
     /// List of sessions that are connected to this handler.
     /// A ServerSession whose server endpoint is an HLE implementation is kept alive by this list
     /// for the duration of the connection.
     std::vector<std::shared_ptr<ServerSession>> connected_sessions;
+
+    /// Host thread servicing the sessions of this handler, owned by the kernel.
+    std::weak_ptr<ServiceThread> service_thread;
 };
 
 /**
@@ -98,10 +116,22 @@ protected:
  */
 class HLERequestContext {
 public:
+    /// Buffer descriptors of a request, stored inline for the common case of a few buffers.
+    template <typename Descriptor>
+    using DescriptorList = boost::container::small_vector<Descriptor, 4>;
+
     explicit HLERequestContext(std::shared_ptr<ServerSession> session,
                                std::shared_ptr<Thread> thread);
     ~HLERequestContext();
 
+    /**
+     * Prepares the context for another request, dropping the state and object references of the
+     * previous one but keeping the storage allocated for it.
+     * @param session The session of the new request, null while the context is not in use.
+     * @param thread The thread that made the new request, null while the context is not in use.
+     */
+    void Reset(std::shared_ptr<ServerSession> session, std::shared_ptr<Thread> thread);
+
     /// Returns a pointer to the IPC command buffer for this request.
     u32* CommandBuffer() {
         return cmd_buf.data();
@@ -154,19 +184,19 @@ public:
         return data_payload_offset;
     }
 
-    const std::vector<IPC::BufferDescriptorX>& BufferDescriptorX() const {
+    const DescriptorList<IPC::BufferDescriptorX>& BufferDescriptorX() const {
         return buffer_x_desciptors;
     }
 
-    const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorA() const {
+    const DescriptorList<IPC::BufferDescriptorABW>& BufferDescriptorA() const {
         return buffer_a_desciptors;
     }
 
-    const std::vector<IPC::BufferDescriptorABW>& BufferDescriptorB() const {
+    const DescriptorList<IPC::BufferDescriptorABW>& BufferDescriptorB() const {
         return buffer_b_desciptors;
     }
 
-    const std::vector<IPC::BufferDescriptorC>& BufferDescriptorC() const {
+    const DescriptorList<IPC::BufferDescriptorC>& BufferDescriptorC() const {
         return buffer_c_desciptors;
     }
 
@@ -204,6 +234,26 @@ public:
                            buffer_index);
     }
 
+    /**
+     * Gets a view of an input buffer without copying it when possible. The view points directly
+     * into guest memory, unless the buffer crosses unmapped pages, pages cached by the rasterizer
+     * or is not contiguous in host memory. Then it points to a scratch copy owned by this context.
+     *
+     * @param buffer_index The buffer in particular to read from.
+     * @returns A view that stays valid until the context is destroyed.
+     */
+    Common::Span<const u8> ReadBufferSpan(int buffer_index = 0);
+
+    /**
+     * Gets a view of an output buffer that the request handler can write to directly. When the
+     * buffer can't be accessed directly, the view points to a scratch copy of it instead, which is
+     * written back to guest memory along with the response.
+     *
+     * @param buffer_index The buffer in particular to write to.
+     * @returns A view that stays valid until the context is destroyed.
+     */
+    Common::Span<u8> WriteBufferSpan(int buffer_index = 0);
+
     /// Helper function to get the size of the input buffer
     std::size_t GetReadBufferSize(int buffer_index = 0) const;
 
@@ -234,12 +284,14 @@ public:
 
     template <typename T>
     std::shared_ptr<T> GetDomainRequestHandler(std::size_t index) const {
-        return std::static_pointer_cast<T>(domain_request_handlers.at(index));
+        return std::static_pointer_cast<T>(domain_request_handlers->at(index));
     }
 
+    /// Sets the handlers of the domain the request was sent to. They are referenced, not copied,
+    /// so they must outlive the request, as the handlers of its session do.
     void SetDomainRequestHandlers(
         const std::vector<std::shared_ptr<SessionRequestHandler>>& handlers) {
-        domain_request_handlers = handlers;
+        domain_request_handlers = &handlers;
     }
 
     /// Clears the list of objects so that no lingering objects are written accidentally to the
@@ -279,6 +331,17 @@ public:
 private:
     void ParseCommandBuffer(const HandleTable& handle_table, u32_le* src_cmdbuf, bool incoming);
 
+    /// Returns a view of a guest buffer, copying it into a new scratch buffer if needed.
+    Common::Span<u8> GetBufferSpan(VAddr address, std::size_t size, bool write_back);
+
+    /// Copy of a guest buffer that can't be accessed directly.
+    struct ScratchBuffer {
+        VAddr address;
+        std::vector<u8> data;
+        /// Whether the buffer is an output buffer that has to be written back to guest memory.
+        bool write_back;
+    };
+
     std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf;
     std::shared_ptr<Kernel::ServerSession> server_session;
     std::shared_ptr<Thread> thread;
@@ -286,22 +349,23 @@ private:
     boost::container::small_vector<std::shared_ptr<Object>, 8> move_objects;
     boost::container::small_vector<std::shared_ptr<Object>, 8> copy_objects;
     boost::container::small_vector<std::shared_ptr<SessionRequestHandler>, 8> domain_objects;
+    boost::container::small_vector<ScratchBuffer, 2> scratch_buffers;
 
     std::optional<IPC::CommandHeader> command_header;
     std::optional<IPC::HandleDescriptorHeader> handle_descriptor_header;
     std::optional<IPC::DataPayloadHeader> data_payload_header;
     std::optional<IPC::DomainMessageHeader> domain_message_header;
-    std::vector<IPC::BufferDescriptorX> buffer_x_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_a_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_b_desciptors;
-    std::vector<IPC::BufferDescriptorABW> buffer_w_desciptors;
-    std::vector<IPC::BufferDescriptorC> buffer_c_desciptors;
+    DescriptorList<IPC::BufferDescriptorX> buffer_x_desciptors;
+    DescriptorList<IPC::BufferDescriptorABW> buffer_a_desciptors;
+    DescriptorList<IPC::BufferDescriptorABW> buffer_b_desciptors;
+    DescriptorList<IPC::BufferDescriptorABW> buffer_w_desciptors;
+    DescriptorList<IPC::BufferDescriptorC> buffer_c_desciptors;
 
     unsigned data_payload_offset{};
     unsigned buffer_c_offset{};
     u32_le command{};
 
-    std::vector<std::shared_ptr<SessionRequestHandler>> domain_request_handlers;
+    const std::vector<std::shared_ptr<SessionRequestHandler>>* domain_request_handlers{};
     bool is_thread_waiting{};
 };
 
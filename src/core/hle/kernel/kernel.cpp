@@ -20,6 +20,7 @@
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/resource_limit.h"
 #include "core/hle/kernel/scheduler.h"
+#include "core/hle/kernel/service_thread.h"
 #include "core/hle/kernel/thread.h"
 #include "core/hle/lock.h"
 #include "core/hle/result.h"
@@ -65,7 +66,7 @@ static void ThreadWakeupCallback(u64 thread_handle, [[maybe_unused]] s64 cycles_
         thread->SetMutexWaitAddress(0);
         thread->SetWaitHandle(0);
         if (thread->GetStatus() == ThreadStatus::WaitCondVar) {
-            thread->GetOwnerProcess()->RemoveConditionVariableThread(thread);
+            thread->GetOwnerProcess()->RemoveConditionVariableThread(thread.get());
             thread->SetCondVarWaitAddress(0);
         }
 
@@ -104,6 +105,8 @@ struct KernelCore::Impl {
     }
 
     void Shutdown() {
+        service_threads.clear();
+
         next_object_id = 0;
         next_kernel_process_id = Process::InitialKIPIDMin;
         next_user_process_id = Process::ProcessIDMin;
@@ -186,6 +189,9 @@ struct KernelCore::Impl {
     /// the ConnectToPort SVC.
     NamedPortTable named_ports;
 
+    /// Host threads handling the requests of HLE services, when enabled.
+    std::vector<std::shared_ptr<ServiceThread>> service_threads;
+
     // System context
     Core::System& system;
 };
@@ -257,6 +263,21 @@ bool KernelCore::IsValidNamedPort(NamedPortTable::const_iterator port) const {
     return port != impl->named_ports.cend();
 }
 
+std::weak_ptr<ServiceThread> KernelCore::CreateServiceThread(std::string name) {
+    return impl->service_threads.emplace_back(
+        std::make_shared<ServiceThread>(*this, std::move(name)));
+}
+
+void KernelCore::StopServiceThreads() {
+    impl->service_threads.clear();
+}
+
+void KernelCore::NotifyThreadUnloaded(const Thread& thread) {
+    for (const auto& service_thread : impl->service_threads) {
+        service_thread->OnThreadUnloaded(thread);
+    }
+}
+
 u32 KernelCore::CreateNewObjectID() {
     return impl->next_object_id++;
 }
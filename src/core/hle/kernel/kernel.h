@@ -27,6 +27,7 @@ class GlobalScheduler;
 class HandleTable;
 class Process;
 class ResourceLimit;
+class ServiceThread;
 class Thread;
 
 /// Represents a single instance of the kernel.
@@ -96,6 +97,16 @@ public:
     /// Determines whether or not the given port is a valid named port.
     bool IsValidNamedPort(NamedPortTable::const_iterator port) const;
 
+    /// Creates a host thread to handle HLE requests on, owned by the kernel until it is stopped.
+    std::weak_ptr<ServiceThread> CreateServiceThread(std::string name);
+
+    /// Stops all service threads, waiting for the requests they are handling to complete.
+    void StopServiceThreads();
+
+    /// Hands the requests of a thread waiting for IPC to the service threads, once the thread has
+    /// been switched out of its core.
+    void NotifyThreadUnloaded(const Thread& thread);
+
 private:
     friend class Object;
     friend class Process;
@@ -8,10 +8,10 @@
 #include <cstddef>
 #include <list>
 #include <string>
-#include <unordered_map>
 #include <vector>
 #include "common/common_types.h"
 #include "core/hle/kernel/address_arbiter.h"
+#include "core/hle/kernel/address_wait_queue.h"
 #include "core/hle/kernel/handle_table.h"
 #include "core/hle/kernel/mutex.h"
 #include "core/hle/kernel/process_capability.h"
@@ -238,13 +238,13 @@ public:
     }
 
     /// Insert a thread into the condition variable wait container
-    void InsertConditionVariableThread(std::shared_ptr<Thread> thread);
+    void InsertConditionVariableThread(Thread* thread);
 
     /// Remove a thread from the condition variable wait container
-    void RemoveConditionVariableThread(std::shared_ptr<Thread> thread);
+    void RemoveConditionVariableThread(Thread* thread);
 
-    /// Obtain all condition variable threads waiting for some address
-    std::vector<std::shared_ptr<Thread>> GetConditionVariableThreads(VAddr cond_var_addr);
+    /// Obtain the next thread to signal on a condition variable, or nullptr if none is waiting
+    Thread* GetConditionVariableThread(VAddr cond_var_addr) const;
 
     /// Registers a thread as being created under this process,
     /// adding it to this process' thread list.
@@ -387,7 +387,7 @@ private:
     std::list<const Thread*> thread_list;
 
     /// List of threads waiting for a condition variable
-    std::unordered_map<VAddr, std::list<std::shared_ptr<Thread>>> cond_var_threads;
+    AddressWaitQueue cond_var_threads{AddressWaitQueue::TieOrder::Fifo};
 
     /// System context
     Core::System& system;
@@ -18,8 +18,10 @@
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/server_session.h"
+#include "core/hle/kernel/service_thread.h"
 #include "core/hle/kernel/session.h"
 #include "core/hle/kernel/thread.h"
+#include "core/hle/lock.h"
 #include "core/memory.h"
 
 namespace Kernel {
@@ -32,8 +34,12 @@ ResultVal<std::shared_ptr<ServerSession>> ServerSession::Create(KernelCore& kern
                                                                 std::string name) {
     std::shared_ptr<ServerSession> session{std::make_shared<ServerSession>(kernel)};
 
-    session->request_event = Core::Timing::CreateEvent(
-        name, [session](u64 userdata, s64 cycles_late) { session->CompleteSyncRequest(); });
+    session->request_event =
+        Core::Timing::CreateEvent(name, [session](u64 userdata, s64 cycles_late) {
+            // Lock the global kernel mutex, other services may be running on service threads
+            std::lock_guard lock{HLE::g_hle_lock};
+            session->CompleteSyncRequest();
+        });
     session->name = std::move(name);
     session->parent = std::move(parent);
 
@@ -76,6 +82,13 @@ void ServerSession::ClientDisconnected() {
     currently_handling = nullptr;
 }
 
+std::weak_ptr<ServiceThread> ServerSession::GetServiceThread() const {
+    if (hle_handler == nullptr) {
+        return {};
+    }
+    return hle_handler->GetServiceThread();
+}
+
 void ServerSession::AppendDomainRequestHandler(std::shared_ptr<SessionRequestHandler> handler) {
     domain_request_handlers.push_back(std::move(handler));
 }
@@ -124,22 +137,55 @@ ResultCode ServerSession::HandleDomainSyncRequest(Kernel::HLERequestContext& con
     return RESULT_SUCCESS;
 }
 
+std::shared_ptr<HLERequestContext> ServerSession::AcquireContext(std::shared_ptr<Thread> thread) {
+    if (free_contexts.empty()) {
+        return std::make_shared<HLERequestContext>(SharedFrom(this), std::move(thread));
+    }
+    std::shared_ptr<HLERequestContext> context = std::move(free_contexts.back());
+    free_contexts.pop_back();
+    context->Reset(SharedFrom(this), std::move(thread));
+    return context;
+}
+
+void ServerSession::ReleaseContext(std::shared_ptr<HLERequestContext> context) {
+    // A few contexts cover the requests a session has in flight at once
+    constexpr std::size_t MAX_FREE_CONTEXTS = 4;
+    if (context.use_count() != 1 || free_contexts.size() >= MAX_FREE_CONTEXTS) {
+        return;
+    }
+    // Pooled contexts must not keep the session alive
+    context->Reset(nullptr, nullptr);
+    free_contexts.push_back(std::move(context));
+}
+
 ResultCode ServerSession::QueueSyncRequest(std::shared_ptr<Thread> thread, Memory::Memory& memory) {
     u32* cmd_buf{reinterpret_cast<u32*>(memory.GetPointer(thread->GetTLSAddress()))};
-    std::shared_ptr<Kernel::HLERequestContext> context{
-        std::make_shared<Kernel::HLERequestContext>(SharedFrom(this), std::move(thread))};
+    std::shared_ptr<HLERequestContext> context = AcquireContext(std::move(thread));
 
     context->PopulateFromIncomingCommandBuffer(kernel.CurrentProcess()->GetHandleTable(), cmd_buf);
-    request_queue.Push(std::move(context));
+
+    if (const auto service_thread = GetServiceThread().lock()) {
+        service_thread->QueueSyncRequest(SharedFrom(this), std::move(context));
+    } else {
+        Core::System::GetInstance().CoreTiming().ScheduleEvent(20000, request_event, {});
+        request_queue.push_back(std::move(context));
+    }
 
     return RESULT_SUCCESS;
 }
 
 ResultCode ServerSession::CompleteSyncRequest() {
-    ASSERT(!request_queue.Empty());
+    ASSERT(!request_queue.empty());
 
-    auto& context = *request_queue.Front();
+    std::shared_ptr<HLERequestContext> context = std::move(request_queue.front());
+    request_queue.erase(request_queue.begin());
 
+    const ResultCode result = CompleteSyncRequest(*context);
+    ReleaseContext(std::move(context));
+    return result;
+}
+
+ResultCode ServerSession::CompleteSyncRequest(HLERequestContext& context) {
     ResultCode result = RESULT_SUCCESS;
     // If the session has been converted to a domain, handle the domain request
     if (IsDomain() && context.HasDomainMessageHeader()) {
@@ -162,14 +208,11 @@ ResultCode ServerSession::CompleteSyncRequest() {
         context.GetThread().SetWaitSynchronizationResult(result);
     }
 
-    request_queue.Pop();
-
     return result;
 }
 
 ResultCode ServerSession::HandleSyncRequest(std::shared_ptr<Thread> thread,
                                             Memory::Memory& memory) {
-    Core::System::GetInstance().CoreTiming().ScheduleEvent(20000, request_event, {});
     return QueueSyncRequest(std::move(thread), memory);
 }
 
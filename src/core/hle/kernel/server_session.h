@@ -9,7 +9,6 @@
 #include <utility>
 #include <vector>
 
-#include "common/threadsafe_queue.h"
 #include "core/hle/kernel/wait_object.h"
 #include "core/hle/result.h"
 
@@ -25,6 +24,7 @@ namespace Kernel {
 
 class HLERequestContext;
 class KernelCore;
+class ServiceThread;
 class Session;
 class SessionRequestHandler;
 class Thread;
@@ -46,6 +46,7 @@ public:
     explicit ServerSession(KernelCore& kernel);
     ~ServerSession() override;
 
+    friend class ServiceThread;
     friend class Session;
 
     static ResultVal<std::shared_ptr<ServerSession>> Create(KernelCore& kernel,
@@ -82,6 +83,10 @@ public:
         hle_handler = std::move(hle_handler_);
     }
 
+    /// Returns the host thread requests to this session are handled on, if the HLE handler has
+    /// one. Otherwise requests are handled in a CoreTiming event on the emulated CPU thread.
+    std::weak_ptr<ServiceThread> GetServiceThread() const;
+
     /**
      * Handle a sync request from the emulated application.
      *
@@ -126,9 +131,18 @@ private:
     /// Queues a sync request from the emulated application.
     ResultCode QueueSyncRequest(std::shared_ptr<Thread> thread, Memory::Memory& memory);
 
-    /// Completes a sync request from the emulated application.
+    /// Completes the oldest sync request queued to be handled on the emulated CPU thread.
     ResultCode CompleteSyncRequest();
 
+    /// Completes a sync request from the emulated application.
+    ResultCode CompleteSyncRequest(HLERequestContext& context);
+
+    /// Returns a context for a new request, reusing the context of a completed request if any.
+    std::shared_ptr<HLERequestContext> AcquireContext(std::shared_ptr<Thread> thread);
+
+    /// Keeps the context of a completed request for reuse, unless something still references it.
+    void ReleaseContext(std::shared_ptr<HLERequestContext> context);
+
     /// Handles a SyncRequest to a domain, forwarding the request to the proper object or closing an
     /// object handle.
     ResultCode HandleDomainSyncRequest(Kernel::HLERequestContext& context);
@@ -161,8 +175,12 @@ private:
     /// Core timing event used to schedule the service request at some point in the future
     std::shared_ptr<Core::Timing::EventType> request_event;
 
-    /// Queue of scheduled service requests
-    Common::MPSCQueue<std::shared_ptr<Kernel::HLERequestContext>> request_queue;
+    /// Queue of scheduled service requests, unless they are handled on a service thread. It's only
+    /// accessed with the HLE lock held, in the order requests were sent.
+    std::vector<std::shared_ptr<Kernel::HLERequestContext>> request_queue;
+
+    /// Contexts of completed requests, recycled so that steady state IPC doesn't allocate
+    std::vector<std::shared_ptr<Kernel::HLERequestContext>> free_contexts;
 };
 
 } // namespace Kernel
@@ -0,0 +1,73 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <utility>
+
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/server_session.h"
+#include "core/hle/kernel/service_thread.h"
+#include "core/hle/kernel/thread.h"
+#include "core/hle/lock.h"
+
+namespace Kernel {
+
+ServiceThread::ServiceThread(KernelCore& kernel, std::string name)
+    : kernel{kernel}, name{std::move(name)}, worker{1, "yuzu:HLE:" + this->name} {}
+
+ServiceThread::~ServiceThread() {
+    // Requests still queued are dropped, the emulated threads that sent them are going away too
+    stop_requested = true;
+    LOG_INFO(Service, "{} requests: {}", name, latency.Summary());
+}
+
+void ServiceThread::QueueSyncRequest(std::shared_ptr<ServerSession> session,
+                                     std::shared_ptr<HLERequestContext> context) {
+    const bool is_running = context->GetThread().IsRunning();
+    Request request{std::move(session), std::move(context), std::chrono::steady_clock::now()};
+
+    // The core running the thread has already been asked to reschedule when the request was sent,
+    // it posts the request once the current slice ends
+    if (is_running) {
+        unloading_requests.push_back(std::move(request));
+        return;
+    }
+    PostRequest(std::move(request));
+}
+
+void ServiceThread::OnThreadUnloaded(const Thread& thread) {
+    const auto it = std::find_if(
+        unloading_requests.begin(), unloading_requests.end(),
+        [&thread](const Request& request) { return &request.context->GetThread() == &thread; });
+    if (it == unloading_requests.end()) {
+        return;
+    }
+    PostRequest(std::move(*it));
+    unloading_requests.erase(it);
+}
+
+void ServiceThread::PostRequest(Request request) {
+    worker.QueueWork([this, request = std::move(request)]() mutable {
+        if (stop_requested) {
+            return;
+        }
+        {
+            std::lock_guard lock{HLE::g_hle_lock};
+            request.session->CompleteSyncRequest(*request.context);
+
+            // The requesting thread may have become ready, let its core pick it up
+            Core::System::GetInstance().PrepareReschedule(
+                static_cast<u32>(request.context->GetThread().GetProcessorID()));
+            request.session->ReleaseContext(std::move(request.context));
+        }
+        latency.Record(std::chrono::steady_clock::now() - request.queued);
+    });
+}
+
+} // namespace Kernel
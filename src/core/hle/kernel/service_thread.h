@@ -0,0 +1,83 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/latency_histogram.h"
+#include "common/thread_pool.h"
+
+namespace Kernel {
+
+class HLERequestContext;
+class KernelCore;
+class ServerSession;
+class Thread;
+
+/**
+ * Host thread that handles the HLE requests of a group of sessions, so that heavy services run
+ * concurrently with the emulated CPU cores instead of in a CoreTiming event on them. Handlers
+ * still run under the global HLE lock, they only overlap with guest code.
+ *
+ * Service threads are owned by the kernel and stopped on shutdown, handlers only keep weak
+ * references to them.
+ */
+class ServiceThread final {
+public:
+    explicit ServiceThread(KernelCore& kernel, std::string name);
+    ~ServiceThread();
+
+    /**
+     * Queues a parsed request to be handled on this thread. The requesting thread must already be
+     * waiting for IPC. The request is handled once the thread has been switched out of its core,
+     * and the thread is resumed once the reply has been written to its command buffer. Must be
+     * called with the HLE lock held.
+     */
+    void QueueSyncRequest(std::shared_ptr<ServerSession> session,
+                          std::shared_ptr<HLERequestContext> context);
+
+    /**
+     * Hands the requests sent by the given thread to the worker, called by its core once it has
+     * switched the thread out so that its context can be written. Must be called with the HLE
+     * lock held.
+     */
+    void OnThreadUnloaded(const Thread& thread);
+
+    /// Returns the name of the thread, usually the name of the service it was created for.
+    const std::string& GetName() const {
+        return name;
+    }
+
+    /// Returns the time requests took from being queued to being replied to.
+    const Common::LatencyHistogram& GetLatency() const {
+        return latency;
+    }
+
+private:
+    struct Request {
+        std::shared_ptr<ServerSession> session;
+        std::shared_ptr<HLERequestContext> context;
+        std::chrono::steady_clock::time_point queued;
+    };
+
+    /// Queues a request whose thread has been switched out on the worker.
+    void PostRequest(Request request);
+
+    KernelCore& kernel;
+    std::string name;
+    Common::LatencyHistogram latency;
+    std::atomic_bool stop_requested{false};
+
+    /// Requests whose thread was still running on its core, guarded by the HLE lock.
+    std::vector<Request> unloading_requests;
+
+    /// Single worker, handling requests in the order they were sent. Destroyed first.
+    Common::ThreadPool worker;
+};
+
+} // namespace Kernel
@@ -43,15 +43,15 @@ std::shared_ptr<SharedMemory> SharedMemory::Create(KernelCore& kernel, Process*
         // The memory is already available and mapped in the owner process.
         const auto vma = vm_manager.FindVMA(address);
         ASSERT_MSG(vm_manager.IsValidHandle(vma), "Invalid memory address");
-        ASSERT_MSG(vma->second.backing_block, "Backing block doesn't exist for address");
+        ASSERT_MSG(vma->backing_block, "Backing block doesn't exist for address");
 
         // The returned VMA might be a bigger one encompassing the desired address.
-        const auto vma_offset = address - vma->first;
-        ASSERT_MSG(vma_offset + size <= vma->second.size,
+        const auto vma_offset = address - vma->base;
+        ASSERT_MSG(vma_offset + size <= vma->size,
                    "Shared memory exceeds bounds of mapped block");
 
-        shared_memory->backing_block = vma->second.backing_block;
-        shared_memory->backing_block_offset = vma->second.offset + vma_offset;
+        shared_memory->backing_block = vma->backing_block;
+        shared_memory->backing_block_offset = vma->offset + vma_offset;
     }
 
     shared_memory->base_address = address;
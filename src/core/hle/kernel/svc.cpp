@@ -1639,7 +1639,7 @@ static ResultCode WaitProcessWideKeyAtomic(Core::System& system, VAddr mutex_add
     current_thread->SetWaitHandle(thread_handle);
     current_thread->SetStatus(ThreadStatus::WaitCondVar);
     current_thread->InvalidateWakeupCallback();
-    current_process->InsertConditionVariableThread(SharedFrom(current_thread));
+    current_process->InsertConditionVariableThread(current_thread);
 
     current_thread->WakeAfterDelay(nano_seconds);
 
@@ -1656,24 +1656,23 @@ static void SignalProcessWideKey(Core::System& system, VAddr condition_variable_
 
     ASSERT(condition_variable_addr == Common::AlignDown(condition_variable_addr, 4));
 
-    // Retrieve a list of all threads that are waiting for this condition variable.
     auto* const current_process = system.Kernel().CurrentProcess();
-    std::vector<std::shared_ptr<Thread>> waiting_threads =
-        current_process->GetConditionVariableThreads(condition_variable_addr);
 
     // Only process up to 'target' threads, unless 'target' is less equal 0, in which case process
     // them all.
-    std::size_t last = waiting_threads.size();
-    if (target > 0)
-        last = std::min(waiting_threads.size(), static_cast<std::size_t>(target));
-
-    for (std::size_t index = 0; index < last; ++index) {
-        auto& thread = waiting_threads[index];
+    for (s32 woken = 0; target <= 0 || woken < target; ++woken) {
+        // Retrieve the next thread waiting for this condition variable.
+        Thread* const waiting_thread =
+            current_process->GetConditionVariableThread(condition_variable_addr);
+        if (waiting_thread == nullptr) {
+            break;
+        }
+        const std::shared_ptr<Thread> thread = SharedFrom(waiting_thread);
 
         ASSERT(thread->GetCondVarWaitAddress() == condition_variable_addr);
 
         // liberate Cond Var Thread.
-        current_process->RemoveConditionVariableThread(thread);
+        current_process->RemoveConditionVariableThread(thread.get());
         thread->SetCondVarWaitAddress(0);
 
         const std::size_t current_core = system.CurrentCoreIndex();
@@ -10,6 +10,8 @@
 
 #include "common/common_types.h"
 #include "core/arm/arm_interface.h"
+#include "core/core_timing.h"
+#include "core/hle/kernel/address_wait_queue.h"
 #include "core/hle/kernel/object.h"
 #include "core/hle/kernel/wait_object.h"
 #include "core/hle/result.h"
@@ -376,6 +378,11 @@ public:
         arb_wait_address = address;
     }
 
+    /// Gets the links of the thread in the condition variable or address arbiter queue it waits in.
+    AddressWaitNode& GetAddressWaitNode() {
+        return address_wait_node;
+    }
+
     bool HasWakeupCallback() const {
         return wakeup_callback != nullptr;
     }
@@ -512,9 +519,15 @@ private:
     /// If waiting for an AddressArbiter, this is the address being waited on.
     VAddr arb_wait_address{0};
 
+    /// Links in the queue of the condition variable or arbiter address being waited on.
+    AddressWaitNode address_wait_node;
+
     /// Handle used as userdata to reference this object when inserting into the CoreTiming queue.
     Handle callback_handle = 0;
 
+    /// Pending wakeup event scheduled by WakeAfterDelay, used to cancel it without a search.
+    Core::Timing::EventHandle wakeup_event;
+
     /// Callback that will be invoked when the thread is resumed from a waiting state. If the thread
     /// was waiting via WaitSynchronization then the object will be the last object that became
     /// available. In case of a timeout, the object will be nullptr.
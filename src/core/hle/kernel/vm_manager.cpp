@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <iterator>
 #include <utility>
 #include "common/alignment.h"
@@ -85,8 +86,9 @@ void VMManager::Reset(FileSys::ProgramAddressSpaceType type) {
     // Initialize the map with a single free region covering the entire managed space.
     VirtualMemoryArea initial_vma;
     initial_vma.size = address_space_end;
-    vma_map.emplace(initial_vma.base, initial_vma);
+    vma_map.push_back(initial_vma);
 
+    PageTableBatch batch{*this};
     UpdatePageTableForVMA(initial_vma);
 }
 
@@ -94,7 +96,9 @@ VMManager::VMAHandle VMManager::FindVMA(VAddr target) const {
     if (target >= address_space_end) {
         return vma_map.end();
     } else {
-        return std::prev(vma_map.upper_bound(target));
+        return std::prev(std::upper_bound(
+            vma_map.begin(), vma_map.end(), target,
+            [](VAddr address, const VirtualMemoryArea& vma) { return address < vma.base; }));
     }
 }
 
@@ -110,8 +114,9 @@ ResultVal<VMManager::VMAHandle> VMManager::MapMemoryBlock(VAddr target,
     ASSERT(offset + size <= block->size());
 
     // This is the appropriately sized VMA that will turn into our allocation.
+    PageTableBatch batch{*this};
     CASCADE_RESULT(VMAIter vma_handle, CarveVMA(target, size));
-    VirtualMemoryArea& final_vma = vma_handle->second;
+    VirtualMemoryArea& final_vma = *vma_handle;
     ASSERT(final_vma.size == size);
 
     final_vma.type = VMAType::AllocatedMemoryBlock;
@@ -129,8 +134,9 @@ ResultVal<VMManager::VMAHandle> VMManager::MapBackingMemory(VAddr target, u8* me
     ASSERT(memory != nullptr);
 
     // This is the appropriately sized VMA that will turn into our allocation.
+    PageTableBatch batch{*this};
     CASCADE_RESULT(VMAIter vma_handle, CarveVMA(target, size));
-    VirtualMemoryArea& final_vma = vma_handle->second;
+    VirtualMemoryArea& final_vma = *vma_handle;
     ASSERT(final_vma.size == size);
 
     final_vma.type = VMAType::BackingMemory;
@@ -152,11 +158,11 @@ ResultVal<VAddr> VMManager::FindFreeRegion(VAddr begin, VAddr end, u64 size) con
 
     const VMAHandle vma_handle =
         std::find_if(vma_map.begin(), vma_map.end(), [begin, end, size](const auto& vma) {
-            if (vma.second.type != VMAType::Free) {
+            if (vma.type != VMAType::Free) {
                 return false;
             }
-            const VAddr vma_base = vma.second.base;
-            const VAddr vma_end = vma_base + vma.second.size;
+            const VAddr vma_base = vma.base;
+            const VAddr vma_end = vma_base + vma.size;
             const VAddr assumed_base = (begin < vma_base) ? vma_base : begin;
             const VAddr used_range = assumed_base + size;
 
@@ -169,7 +175,7 @@ ResultVal<VAddr> VMManager::FindFreeRegion(VAddr begin, VAddr end, u64 size) con
         return RESULT_UNKNOWN;
     }
 
-    const VAddr target = std::max(begin, vma_handle->second.base);
+    const VAddr target = std::max(begin, vma_handle->base);
     return MakeResult<VAddr>(target);
 }
 
@@ -177,8 +183,9 @@ ResultVal<VMManager::VMAHandle> VMManager::MapMMIO(VAddr target, PAddr paddr, u6
                                                    MemoryState state,
                                                    Common::MemoryHookPointer mmio_handler) {
     // This is the appropriately sized VMA that will turn into our allocation.
+    PageTableBatch batch{*this};
     CASCADE_RESULT(VMAIter vma_handle, CarveVMA(target, size));
-    VirtualMemoryArea& final_vma = vma_handle->second;
+    VirtualMemoryArea& final_vma = *vma_handle;
     ASSERT(final_vma.size == size);
 
     final_vma.type = VMAType::MMIO;
@@ -192,7 +199,7 @@ ResultVal<VMManager::VMAHandle> VMManager::MapMMIO(VAddr target, PAddr paddr, u6
 }
 
 VMManager::VMAIter VMManager::Unmap(VMAIter vma_handle) {
-    VirtualMemoryArea& vma = vma_handle->second;
+    VirtualMemoryArea& vma = *vma_handle;
     vma.type = VMAType::Free;
     vma.permissions = VMAPermission::None;
     vma.state = MemoryState::Unmapped;
@@ -209,25 +216,26 @@ VMManager::VMAIter VMManager::Unmap(VMAIter vma_handle) {
 }
 
 ResultCode VMManager::UnmapRange(VAddr target, u64 size) {
+    PageTableBatch batch{*this};
     CASCADE_RESULT(VMAIter vma, CarveVMARange(target, size));
     const VAddr target_end = target + size;
 
-    const VMAIter end = vma_map.end();
     // The comparison against the end of the range must be done using addresses since VMAs can be
     // merged during this process, causing invalidation of the iterators.
-    while (vma != end && vma->second.base < target_end) {
+    while (vma != vma_map.end() && vma->base < target_end) {
         vma = std::next(Unmap(vma));
     }
 
-    ASSERT(FindVMA(target)->second.size >= size);
+    ASSERT(FindVMA(target)->size >= size);
 
     return RESULT_SUCCESS;
 }
 
 VMManager::VMAHandle VMManager::Reprotect(VMAHandle vma_handle, VMAPermission new_perms) {
+    PageTableBatch batch{*this};
     VMAIter iter = StripIterConstness(vma_handle);
 
-    VirtualMemoryArea& vma = iter->second;
+    VirtualMemoryArea& vma = *iter;
     vma.permissions = new_perms;
     UpdatePageTableForVMA(vma);
 
@@ -235,13 +243,13 @@ VMManager::VMAHandle VMManager::Reprotect(VMAHandle vma_handle, VMAPermission ne
 }
 
 ResultCode VMManager::ReprotectRange(VAddr target, u64 size, VMAPermission new_perms) {
+    PageTableBatch batch{*this};
     CASCADE_RESULT(VMAIter vma, CarveVMARange(target, size));
     const VAddr target_end = target + size;
 
-    const VMAIter end = vma_map.end();
     // The comparison against the end of the range must be done using addresses since VMAs can be
     // merged during this process, causing invalidation of the iterators.
-    while (vma != end && vma->second.base < target_end) {
+    while (vma != vma_map.end() && vma->base < target_end) {
         vma = std::next(StripIterConstness(Reprotect(vma, new_perms)));
     }
 
@@ -258,6 +266,7 @@ ResultVal<VAddr> VMManager::SetHeapSize(u64 size) {
         return MakeResult(heap_region_base);
     }
 
+    PageTableBatch batch{*this};
     if (heap_memory == nullptr) {
         // Initialize heap
         heap_memory = std::make_shared<PhysicalMemory>(size);
@@ -315,6 +324,8 @@ ResultCode VMManager::MapPhysicalMemory(VAddr target, u64 size) {
         return ERR_RESOURCE_LIMIT_EXCEEDED;
     }
 
+    PageTableBatch batch{*this};
+
     // Keep track of the memory regions we unmap.
     std::vector<std::pair<u64, u64>> mapped_regions;
     ResultCode result = RESULT_SUCCESS;
@@ -329,7 +340,7 @@ ResultCode VMManager::MapPhysicalMemory(VAddr target, u64 size) {
         ASSERT(iter != vma_map.end());
 
         while (true) {
-            const auto& vma = iter->second;
+            const auto& vma = *iter;
             const auto vma_start = vma.base;
             const auto vma_end = vma_start + vma.size;
             const auto vma_last = vma_end - 1;
@@ -389,6 +400,8 @@ ResultCode VMManager::UnmapPhysicalMemory(VAddr target, u64 size) {
         return RESULT_SUCCESS;
     }
 
+    PageTableBatch batch{*this};
+
     // Keep track of the memory regions we unmap.
     std::vector<std::pair<u64, u64>> unmapped_regions;
     ResultCode result = RESULT_SUCCESS;
@@ -403,7 +416,7 @@ ResultCode VMManager::UnmapPhysicalMemory(VAddr target, u64 size) {
         ASSERT(iter != vma_map.end());
 
         while (true) {
-            const auto& vma = iter->second;
+            const auto& vma = *iter;
             const auto vma_start = vma.base;
             const auto vma_end = vma_start + vma.size;
             const auto vma_last = vma_end - 1;
@@ -460,6 +473,7 @@ ResultCode VMManager::MapCodeMemory(VAddr dst_address, VAddr src_address, u64 si
         return src_check_result.Code();
     }
 
+    PageTableBatch batch{*this};
     const auto mirror_result =
         MirrorMemory(dst_address, src_address, size, MemoryState::ModuleCode);
     if (mirror_result.IsError()) {
@@ -472,7 +486,7 @@ ResultCode VMManager::MapCodeMemory(VAddr dst_address, VAddr src_address, u64 si
         return src_vma_result.Code();
     }
     auto src_vma_iter = *src_vma_result;
-    src_vma_iter->second.attribute = MemoryAttribute::Locked;
+    src_vma_iter->attribute = MemoryAttribute::Locked;
     Reprotect(src_vma_iter, VMAPermission::Read);
 
     // The destination memory region is fine as is, however we need to make it read-only.
@@ -508,6 +522,7 @@ ResultCode VMManager::UnmapCodeMemory(VAddr dst_address, VAddr src_address, u64
         return dst_contiguous_check_result.Code();
     }
 
+    PageTableBatch batch{*this};
     const auto unmap_result = UnmapRange(dst_address, size);
     if (unmap_result.IsError()) {
         return unmap_result;
@@ -519,8 +534,8 @@ ResultCode VMManager::UnmapCodeMemory(VAddr dst_address, VAddr src_address, u64
         return src_vma_result.Code();
     }
     auto src_vma_iter = *src_vma_result;
-    src_vma_iter->second.state = MemoryState::Heap;
-    src_vma_iter->second.attribute = MemoryAttribute::None;
+    src_vma_iter->state = MemoryState::Heap;
+    src_vma_iter->attribute = MemoryAttribute::None;
     Reprotect(src_vma_iter, VMAPermission::ReadWrite);
 
     if (dst_memory_state == MemoryState::ModuleCode) {
@@ -535,11 +550,11 @@ MemoryInfo VMManager::QueryMemory(VAddr address) const {
     MemoryInfo memory_info{};
 
     if (IsValidHandle(vma)) {
-        memory_info.base_address = vma->second.base;
-        memory_info.attributes = ToSvcMemoryAttribute(vma->second.attribute);
-        memory_info.permission = static_cast<u32>(vma->second.permissions);
-        memory_info.size = vma->second.size;
-        memory_info.state = ToSvcMemoryState(vma->second.state);
+        memory_info.base_address = vma->base;
+        memory_info.attributes = ToSvcMemoryAttribute(vma->attribute);
+        memory_info.permission = static_cast<u32>(vma->permissions);
+        memory_info.size = vma->size;
+        memory_info.state = ToSvcMemoryState(vma->state);
     } else {
         memory_info.base_address = address_space_end;
         memory_info.permission = static_cast<u32>(VMAPermission::None);
@@ -566,13 +581,14 @@ ResultCode VMManager::SetMemoryAttribute(VAddr address, u64 size, MemoryAttribut
     const auto [prev_state, prev_permissions, prev_attributes] = *result;
     const auto new_attribute = (prev_attributes & ~mask) | (mask & attribute);
 
+    PageTableBatch batch{*this};
     const auto carve_result = CarveVMARange(address, size);
     if (carve_result.Failed()) {
         return carve_result.Code();
     }
 
     auto vma_iter = *carve_result;
-    vma_iter->second.attribute = new_attribute;
+    vma_iter->attribute = new_attribute;
 
     MergeAdjacent(vma_iter);
     return RESULT_SUCCESS;
@@ -582,20 +598,23 @@ ResultCode VMManager::MirrorMemory(VAddr dst_addr, VAddr src_addr, u64 size, Mem
     const auto vma = FindVMA(src_addr);
 
     ASSERT_MSG(vma != vma_map.end(), "Invalid memory address");
-    ASSERT_MSG(vma->second.backing_block, "Backing block doesn't exist for address");
+    ASSERT_MSG(vma->backing_block, "Backing block doesn't exist for address");
 
     // The returned VMA might be a bigger one encompassing the desired address.
-    const auto vma_offset = src_addr - vma->first;
-    ASSERT_MSG(vma_offset + size <= vma->second.size,
+    const auto vma_offset = src_addr - vma->base;
+    ASSERT_MSG(vma_offset + size <= vma->size,
                "Shared memory exceeds bounds of mapped block");
 
-    const std::shared_ptr<PhysicalMemory>& backing_block = vma->second.backing_block;
-    const std::size_t backing_block_offset = vma->second.offset + vma_offset;
+    // Mapping the mirror invalidates the iterator to the source VMA
+    std::shared_ptr<PhysicalMemory> backing_block = vma->backing_block;
+    const std::size_t backing_block_offset = vma->offset + vma_offset;
+    const VMAPermission permissions = vma->permissions;
 
-    CASCADE_RESULT(auto new_vma,
-                   MapMemoryBlock(dst_addr, backing_block, backing_block_offset, size, state));
+    PageTableBatch batch{*this};
+    CASCADE_RESULT(auto new_vma, MapMemoryBlock(dst_addr, std::move(backing_block),
+                                                backing_block_offset, size, state));
     // Protect mirror with permissions from old region
-    Reprotect(new_vma, vma->second.permissions);
+    Reprotect(new_vma, permissions);
     // Remove permissions from old region
     ReprotectRange(src_addr, size, VMAPermission::None);
 
@@ -605,8 +624,8 @@ ResultCode VMManager::MirrorMemory(VAddr dst_addr, VAddr src_addr, u64 size, Mem
 void VMManager::RefreshMemoryBlockMappings(const PhysicalMemory* block) {
     // If this ever proves to have a noticeable performance impact, allow users of the function to
     // specify a specific range of addresses to limit the scan to.
-    for (const auto& p : vma_map) {
-        const VirtualMemoryArea& vma = p.second;
+    PageTableBatch batch{*this};
+    for (const VirtualMemoryArea& vma : vma_map) {
         if (block == vma.backing_block.get()) {
             UpdatePageTableForVMA(vma);
         }
@@ -614,8 +633,7 @@ void VMManager::RefreshMemoryBlockMappings(const PhysicalMemory* block) {
 }
 
 void VMManager::LogLayout() const {
-    for (const auto& p : vma_map) {
-        const VirtualMemoryArea& vma = p.second;
+    for (const VirtualMemoryArea& vma : vma_map) {
         LOG_DEBUG(Kernel, "{:016X} - {:016X} size: {:016X} {}{}{} {}", vma.base,
                   vma.base + vma.size, vma.size,
                   (u8)vma.permissions & (u8)VMAPermission::Read ? 'R' : '-',
@@ -641,7 +659,7 @@ ResultVal<VMManager::VMAIter> VMManager::CarveVMA(VAddr base, u64 size) {
         return ERR_INVALID_ADDRESS;
     }
 
-    const VirtualMemoryArea& vma = vma_handle->second;
+    const VirtualMemoryArea& vma = *vma_handle;
     if (vma.type != VMAType::Free) {
         // Region is already allocated
         return ERR_INVALID_ADDRESS_STATE;
@@ -655,11 +673,13 @@ ResultVal<VMManager::VMAIter> VMManager::CarveVMA(VAddr base, u64 size) {
         return ERR_INVALID_ADDRESS_STATE;
     }
 
-    if (end_in_vma != vma.size) {
+    if (start_in_vma != 0 && end_in_vma != vma.size) {
+        // Split VMA at both ends of the allocated region
+        vma_handle = SplitVMA(vma_handle, start_in_vma, end_in_vma);
+    } else if (end_in_vma != vma.size) {
         // Split VMA at the end of the allocated region
-        SplitVMA(vma_handle, end_in_vma);
-    }
-    if (start_in_vma != 0) {
+        vma_handle = std::prev(SplitVMA(vma_handle, end_in_vma));
+    } else if (start_in_vma != 0) {
         // Split VMA at the start of the allocated region
         vma_handle = SplitVMA(vma_handle, start_in_vma);
     }
@@ -676,27 +696,51 @@ ResultVal<VMManager::VMAIter> VMManager::CarveVMARange(VAddr target, u64 size) {
     ASSERT(target_end <= address_space_end);
     ASSERT(size > 0);
 
-    VMAIter begin_vma = StripIterConstness(FindVMA(target));
-    const VMAIter i_end = vma_map.lower_bound(target_end);
+    const VMAIter begin_vma = StripIterConstness(FindVMA(target));
+    const VMAIter i_end = std::lower_bound(
+        begin_vma, vma_map.end(), target_end,
+        [](const VirtualMemoryArea& vma, VAddr address) { return vma.base < address; });
     if (std::any_of(begin_vma, i_end,
-                    [](const auto& entry) { return entry.second.type == VMAType::Free; })) {
+                    [](const VirtualMemoryArea& vma) { return vma.type == VMAType::Free; })) {
         return ERR_INVALID_ADDRESS_STATE;
     }
 
-    if (target != begin_vma->second.base) {
-        begin_vma = SplitVMA(begin_vma, target - begin_vma->second.base);
+    const u64 start_in_vma = target - begin_vma->base;
+    const u64 end_in_vma = target_end - begin_vma->base;
+    if (start_in_vma != 0 && end_in_vma < begin_vma->size) {
+        // The range lies inside a single VMA
+        return MakeResult<VMAIter>(SplitVMA(begin_vma, start_in_vma, end_in_vma));
+    }
+
+    if (start_in_vma != 0) {
+        SplitVMA(begin_vma, start_in_vma);
     }
 
-    VMAIter end_vma = StripIterConstness(FindVMA(target_end));
-    if (end_vma != vma_map.end() && target_end != end_vma->second.base) {
-        end_vma = SplitVMA(end_vma, target_end - end_vma->second.base);
+    const VMAIter end_vma = StripIterConstness(FindVMA(target_end));
+    if (end_vma != vma_map.end() && target_end != end_vma->base) {
+        SplitVMA(end_vma, target_end - end_vma->base);
     }
 
-    return MakeResult<VMAIter>(begin_vma);
+    // Splits invalidate iterators, the first VMA of the range is looked up again
+    return MakeResult<VMAIter>(StripIterConstness(FindVMA(target)));
 }
 
 VMManager::VMAIter VMManager::SplitVMA(VMAIter vma_handle, u64 offset_in_vma) {
-    VirtualMemoryArea& old_vma = vma_handle->second;
+    VirtualMemoryArea new_vma = SplitOffVMA(*vma_handle, offset_in_vma);
+    return vma_map.insert(std::next(vma_handle), std::move(new_vma));
+}
+
+VMManager::VMAIter VMManager::SplitVMA(VMAIter vma_handle, u64 start_in_vma, u64 end_in_vma) {
+    ASSERT(start_in_vma < end_in_vma);
+
+    VirtualMemoryArea middle_vma = SplitOffVMA(*vma_handle, start_in_vma);
+    VirtualMemoryArea right_vma = SplitOffVMA(middle_vma, end_in_vma - start_in_vma);
+    std::array<VirtualMemoryArea, 2> new_vmas{std::move(middle_vma), std::move(right_vma)};
+    return vma_map.insert(std::next(vma_handle), std::make_move_iterator(new_vmas.begin()),
+                          std::make_move_iterator(new_vmas.end()));
+}
+
+VirtualMemoryArea VMManager::SplitOffVMA(VirtualMemoryArea& old_vma, u64 offset_in_vma) {
     VirtualMemoryArea new_vma = old_vma; // Make a copy of the VMA
 
     // For now, don't allow no-op VMA splits (trying to split at a boundary) because it's probably
@@ -724,25 +768,29 @@ VMManager::VMAIter VMManager::SplitVMA(VMAIter vma_handle, u64 offset_in_vma) {
 
     ASSERT(old_vma.CanBeMergedWith(new_vma));
 
-    return vma_map.emplace_hint(std::next(vma_handle), new_vma.base, new_vma);
+    return new_vma;
 }
 
 VMManager::VMAIter VMManager::MergeAdjacent(VMAIter iter) {
     const VMAIter next_vma = std::next(iter);
-    if (next_vma != vma_map.end() && iter->second.CanBeMergedWith(next_vma->second)) {
-        MergeAdjacentVMA(iter->second, next_vma->second);
-        vma_map.erase(next_vma);
+    VMAIter erase_begin = next_vma;
+    VMAIter erase_end = next_vma;
+    if (next_vma != vma_map.end() && iter->CanBeMergedWith(*next_vma)) {
+        MergeAdjacentVMA(*iter, *next_vma);
+        erase_end = std::next(next_vma);
     }
 
     if (iter != vma_map.begin()) {
         VMAIter prev_vma = std::prev(iter);
-        if (prev_vma->second.CanBeMergedWith(iter->second)) {
-            MergeAdjacentVMA(prev_vma->second, iter->second);
-            vma_map.erase(iter);
+        if (prev_vma->CanBeMergedWith(*iter)) {
+            MergeAdjacentVMA(*prev_vma, *iter);
+            erase_begin = iter;
             iter = prev_vma;
         }
     }
 
+    // The merged VMA comes before the erased ones, so erasing doesn't invalidate it
+    vma_map.erase(erase_begin, erase_end);
     return iter;
 }
 
@@ -784,24 +832,66 @@ void VMManager::MergeAdjacentVMA(VirtualMemoryArea& left, const VirtualMemoryAre
     }
 }
 
+VMManager::PageTableBatch::PageTableBatch(VMManager& vm_manager) : vm_manager{vm_manager} {
+    ++vm_manager.page_table_batch_depth;
+}
+
+VMManager::PageTableBatch::~PageTableBatch() {
+    if (--vm_manager.page_table_batch_depth == 0) {
+        vm_manager.FlushPageTableUpdates();
+    }
+}
+
 void VMManager::UpdatePageTableForVMA(const VirtualMemoryArea& vma) {
+    // Merge the range with the queued ones it overlaps or touches
+    VAddr begin = vma.base;
+    VAddr end = vma.base + vma.size;
+    auto it = dirty_page_ranges.begin();
+    while (it != dirty_page_ranges.end()) {
+        if (it->first <= end && begin <= it->second) {
+            begin = std::min(begin, it->first);
+            end = std::max(end, it->second);
+            it = dirty_page_ranges.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    dirty_page_ranges.emplace_back(begin, end);
+
+    if (page_table_batch_depth == 0) {
+        FlushPageTableUpdates();
+    }
+}
+
+void VMManager::FlushPageTableUpdates() {
     auto& memory = system.Memory();
 
-    switch (vma.type) {
-    case VMAType::Free:
-        memory.UnmapRegion(page_table, vma.base, vma.size);
-        break;
-    case VMAType::AllocatedMemoryBlock:
-        memory.MapMemoryRegion(page_table, vma.base, vma.size,
-                               vma.backing_block->data() + vma.offset);
-        break;
-    case VMAType::BackingMemory:
-        memory.MapMemoryRegion(page_table, vma.base, vma.size, vma.backing_memory);
-        break;
-    case VMAType::MMIO:
-        memory.MapIoRegion(page_table, vma.base, vma.size, vma.mmio_handler);
-        break;
+    for (const auto& [begin, end] : dirty_page_ranges) {
+        // Only the queued part of each VMA is written, VMAs may extend far beyond it after merges
+        for (auto vma = FindVMA(begin); vma != vma_map.end() && vma->base < end; ++vma) {
+            const VAddr map_base = std::max(begin, vma->base);
+            const u64 map_size = std::min(end, vma->base + vma->size) - map_base;
+            const u64 offset_in_vma = map_base - vma->base;
+
+            switch (vma->type) {
+            case VMAType::Free:
+                memory.UnmapRegion(page_table, map_base, map_size);
+                break;
+            case VMAType::AllocatedMemoryBlock:
+                memory.MapMemoryRegion(page_table, map_base, map_size,
+                                       vma->backing_block->data() + vma->offset + offset_in_vma);
+                break;
+            case VMAType::BackingMemory:
+                memory.MapMemoryRegion(page_table, map_base, map_size,
+                                       vma->backing_memory + offset_in_vma);
+                break;
+            case VMAType::MMIO:
+                memory.MapIoRegion(page_table, map_base, map_size, vma->mmio_handler);
+                break;
+            }
+        }
     }
+    dirty_page_ranges.clear();
 }
 
 void VMManager::InitializeMemoryRegionRanges(FileSys::ProgramAddressSpaceType type) {
@@ -894,6 +984,7 @@ void VMManager::ClearVMAMap() {
 }
 
 void VMManager::ClearPageTable() {
+    dirty_page_ranges.clear();
     std::fill(page_table.pointers.begin(), page_table.pointers.end(), nullptr);
     page_table.special_regions.clear();
     std::fill(page_table.attributes.begin(), page_table.attributes.end(),
@@ -914,16 +1005,16 @@ VMManager::CheckResults VMManager::CheckRangeState(VAddr address, u64 size, Memo
     DEBUG_ASSERT(IsValidHandle(iter));
 
     const VAddr end_address = address + size - 1;
-    const MemoryAttribute initial_attributes = iter->second.attribute;
-    const VMAPermission initial_permissions = iter->second.permissions;
-    const MemoryState initial_state = iter->second.state;
+    const MemoryAttribute initial_attributes = iter->attribute;
+    const VMAPermission initial_permissions = iter->permissions;
+    const MemoryState initial_state = iter->state;
 
     while (true) {
         // The iterator should be valid throughout the traversal. Hitting the end of
         // the mapped VMA regions is unquestionably indicative of a bug.
         DEBUG_ASSERT(IsValidHandle(iter));
 
-        const auto& vma = iter->second;
+        const auto& vma = *iter;
 
         if (vma.state != initial_state) {
             return ERR_INVALID_ADDRESS_STATE;
@@ -971,7 +1062,7 @@ ResultVal<std::size_t> VMManager::SizeOfAllocatedVMAsInRange(VAddr address,
     ASSERT(iter != vma_map.end());
 
     while (true) {
-        const auto& vma = iter->second;
+        const auto& vma = *iter;
         const VAddr vma_start = vma.base;
         const VAddr vma_end = vma_start + vma.size;
         const VAddr vma_last = vma_end - 1;
@@ -1006,7 +1097,7 @@ ResultVal<std::size_t> VMManager::SizeOfUnmappablePhysicalMemoryInRange(VAddr ad
     ASSERT(iter != vma_map.end());
 
     while (true) {
-        const auto& vma = iter->second;
+        const auto& vma = *iter;
         const auto vma_start = vma.base;
         const auto vma_end = vma_start + vma.size;
         const auto vma_last = vma_end - 1;
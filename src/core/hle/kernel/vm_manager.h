@@ -4,9 +4,9 @@
 
 #pragma once
 
-#include <map>
 #include <memory>
 #include <tuple>
+#include <utility>
 #include <vector>
 #include "common/common_types.h"
 #include "common/memory_hook.h"
@@ -321,7 +321,7 @@ struct VirtualMemoryArea {
  *  - http://duartes.org/gustavo/blog/post/page-cache-the-affair-between-memory-and-files/
  */
 class VMManager final {
-    using VMAMap = std::map<VAddr, VirtualMemoryArea>;
+    using VMAMap = std::vector<VirtualMemoryArea>;
 
 public:
     using VMAHandle = VMAMap::const_iterator;
@@ -657,6 +657,23 @@ public:
 private:
     using VMAIter = VMAMap::iterator;
 
+    /**
+     * Defers the page table updates of an operation until it completes, so that pages changed
+     * several times while splitting, unmapping and merging VMAs are only written once. Batches
+     * nest, the updates are applied when the outermost one ends.
+     */
+    class PageTableBatch final {
+    public:
+        explicit PageTableBatch(VMManager& vm_manager);
+        ~PageTableBatch();
+
+        PageTableBatch(const PageTableBatch&) = delete;
+        PageTableBatch& operator=(const PageTableBatch&) = delete;
+
+    private:
+        VMManager& vm_manager;
+    };
+
     /// Converts a VMAHandle to a mutable VMAIter.
     VMAIter StripIterConstness(const VMAHandle& iter);
 
@@ -676,13 +693,27 @@ private:
     ResultVal<VMAIter> CarveVMARange(VAddr base, u64 size);
 
     /**
-     * Splits a VMA in two, at the specified offset.
-     * @returns the right side of the split, with the original iterator becoming the left side.
+     * Splits a VMA in two, at the specified offset. This invalidates all iterators to the VMA map.
+     * @returns the right side of the split, the left side is the element before it.
      */
     VMAIter SplitVMA(VMAIter vma, u64 offset_in_vma);
 
     /**
-     * Checks for and merges the specified VMA with adjacent ones if possible.
+     * Splits a VMA in three, at the specified offsets, with a single insertion into the VMA map.
+     * This invalidates all iterators to the VMA map.
+     * @returns the middle part of the split.
+     */
+    VMAIter SplitVMA(VMAIter vma, u64 start_in_vma, u64 end_in_vma);
+
+    /**
+     * Shrinks a VMA to the specified offset without touching the VMA map.
+     * @returns the VMA covering the rest of the original one.
+     */
+    static VirtualMemoryArea SplitOffVMA(VirtualMemoryArea& vma, u64 offset_in_vma);
+
+    /**
+     * Checks for and merges the specified VMA with adjacent ones if possible. The merged VMAs are
+     * erased at once, so the VMA map is shifted at most once.
      * @returns the merged VMA or the original if no merging was possible.
      */
     VMAIter MergeAdjacent(VMAIter vma);
@@ -692,9 +723,12 @@ private:
      */
     void MergeAdjacentVMA(VirtualMemoryArea& left, const VirtualMemoryArea& right);
 
-    /// Updates the pages corresponding to this VMA so they match the VMA's attributes.
+    /// Queues an update of the pages corresponding to this VMA so they match the VMA's attributes.
     void UpdatePageTableForVMA(const VirtualMemoryArea& vma);
 
+    /// Applies the queued page table updates in one pass over each changed range.
+    void FlushPageTableUpdates();
+
     /// Initializes memory region ranges to adhere to a given address space type.
     void InitializeMemoryRegionRanges(FileSys::ProgramAddressSpaceType type);
 
@@ -744,14 +778,20 @@ private:
                                                                  std::size_t size) const;
 
     /**
-     * A map covering the entirety of the managed address space, keyed by the `base` field of each
-     * VMA. It must always be modified by splitting or merging VMAs, so that the invariant
+     * An array covering the entirety of the managed address space, sorted by the `base` field of
+     * each VMA. It must always be modified by splitting or merging VMAs, so that the invariant
      * `elem.base + elem.size == next.base` is preserved, and mergeable regions must always be
      * merged when possible so that no two similar and adjacent regions exist that have not been
      * merged.
      */
     VMAMap vma_map;
 
+    /// Address ranges whose pages are out of date, as disjoint [begin, end) pairs.
+    std::vector<std::pair<VAddr, VAddr>> dirty_page_ranges;
+
+    /// Number of page table batches in progress.
+    u32 page_table_batch_depth = 0;
+
     u32 address_space_width = 0;
     VAddr address_space_base = 0;
     VAddr address_space_end = 0;
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstring>
 #include <iterator>
@@ -93,10 +94,13 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend straight into the output buffer
+        const auto output = ctx.WriteBufferSpan();
+        if (static_cast<u64>(length) > output.size()) {
+            LOG_CRITICAL(Service_FS, "length ({:016X}) is greater than buffer_size ({:016X})",
+                         length, output.size());
+        }
+        backend->Read(output.data(), std::min<std::size_t>(length, output.size()), offset);
 
         IPC::ResponseBuilder rb{ctx, 2};
         rb.Push(RESULT_SUCCESS);
@@ -150,15 +154,18 @@ private:
             return;
         }
 
-        // Read the data from the Storage backend
-        std::vector<u8> output = backend->ReadBytes(length, offset);
-
-        // Write the data to memory
-        ctx.WriteBuffer(output);
+        // Read the data from the Storage backend straight into the output buffer
+        const auto output = ctx.WriteBufferSpan();
+        if (static_cast<u64>(length) > output.size()) {
+            LOG_CRITICAL(Service_FS, "length ({:016X}) is greater than buffer_size ({:016X})",
+                         length, output.size());
+        }
+        const std::size_t read_size =
+            backend->Read(output.data(), std::min<std::size_t>(length, output.size()), offset);
 
         IPC::ResponseBuilder rb{ctx, 4};
         rb.Push(RESULT_SUCCESS);
-        rb.Push(static_cast<u64>(output.size()));
+        rb.Push(static_cast<u64>(read_size));
     }
 
     void Write(Kernel::HLERequestContext& ctx) {
@@ -649,6 +656,8 @@ private:
 
 FSP_SRV::FSP_SRV(FileSystemController& fsc, const Core::Reporter& reporter)
     : ServiceFramework("fsp-srv"), fsc(fsc), reporter(reporter) {
+    UseServiceThread();
+
     // clang-format off
     static const FunctionInfo functions[] = {
         {0, nullptr, "OpenFileSystem"},
@@ -69,6 +69,7 @@
 #include "core/hle/service/vi/vi.h"
 #include "core/hle/service/wlan/wlan.h"
 #include "core/reporter.h"
+#include "core/settings.h"
 
 namespace Service {
 
@@ -128,6 +129,12 @@ std::shared_ptr<Kernel::ClientPort> ServiceFrameworkBase::CreatePort() {
     return client_port;
 }
 
+void ServiceFrameworkBase::UseServiceThread() {
+    if (Settings::values.use_hle_service_threads) {
+        SetServiceThread(Core::System::GetInstance().Kernel().CreateServiceThread(service_name));
+    }
+}
+
 void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n) {
     handlers.reserve(handlers.size() + n);
     for (std::size_t i = 0; i < n; ++i) {
@@ -76,6 +76,12 @@ protected:
     template <typename Self>
     using HandlerFnP = void (Self::*)(Kernel::HLERequestContext&);
 
+    /**
+     * Handles the requests to this service, and to the interfaces it returns, on a dedicated host
+     * thread when HLE service threads are enabled. Meant for services doing heavy work per request.
+     */
+    void UseServiceThread();
+
 private:
     template <typename T>
     friend class ServiceFramework;
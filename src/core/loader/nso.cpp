@@ -34,10 +34,10 @@ struct MODHeader {
 };
 static_assert(sizeof(MODHeader) == 0x1c, "MODHeader has incorrect size.");
 
-std::vector<u8> DecompressSegment(const std::vector<u8>& compressed_data,
+std::vector<u8> DecompressSegment(const u8* compressed_data, std::size_t compressed_size,
                                   const NSOSegmentHeader& header) {
     const std::vector<u8> uncompressed_data =
-        Common::Compression::DecompressDataLZ4(compressed_data, header.size);
+        Common::Compression::DecompressDataLZ4(compressed_data, compressed_size, header.size);
 
     ASSERT_MSG(uncompressed_data.size() == header.size, "{} != {}", header.size,
                uncompressed_data.size());
@@ -91,16 +91,26 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::Process& process,
     Kernel::CodeSet codeset;
     Kernel::PhysicalMemory program_image;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data =
-            file.ReadBytes(nso_header.segments_compressed_size[i], nso_header.segments[i].offset);
+        // Use the segment in place when the file is in host memory
+        std::size_t size = nso_header.segments_compressed_size[i];
+        std::vector<u8> read_data;
+        const u8* source = file.GetDataView(size, nso_header.segments[i].offset);
+        if (source == nullptr) {
+            read_data = file.ReadBytes(size, nso_header.segments[i].offset);
+            source = read_data.data();
+            size = read_data.size();
+        }
+        std::vector<u8> decompressed;
         if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
+            decompressed = DecompressSegment(source, size, nso_header.segments[i]);
+            source = decompressed.data();
+            size = decompressed.size();
         }
         program_image.resize(nso_header.segments[i].location);
-        program_image.insert(program_image.end(), data.begin(), data.end());
+        program_image.insert(program_image.end(), source, source + size);
         codeset.segments[i].addr = nso_header.segments[i].location;
         codeset.segments[i].offset = nso_header.segments[i].location;
-        codeset.segments[i].size = PageAlignSize(static_cast<u32>(data.size()));
+        codeset.segments[i].size = PageAlignSize(static_cast<u32>(size));
     }
 
     if (should_pass_arguments && !Settings::values.program_args.empty()) {
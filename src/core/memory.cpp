@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 #include <optional>
 #include <utility>
 
@@ -108,39 +109,12 @@ struct Memory::Impl {
     }
 
     /**
-     * Gets a pointer to the exact memory at the virtual address (i.e. not page aligned)
-     * using a VMA from the current process
+     * Gets a pointer to the exact memory at the virtual address (i.e. not page aligned) of a page
+     * marked as cached by the rasterizer, whose entry in the pointers table is null.
      */
-    u8* GetPointerFromVMA(const Kernel::Process& process, VAddr vaddr) {
-        const auto& vm_manager = process.VMManager();
-
-        const auto it = vm_manager.FindVMA(vaddr);
-        DEBUG_ASSERT(vm_manager.IsValidHandle(it));
-
-        u8* direct_pointer = nullptr;
-        const auto& vma = it->second;
-        switch (vma.type) {
-        case Kernel::VMAType::AllocatedMemoryBlock:
-            direct_pointer = vma.backing_block->data() + vma.offset;
-            break;
-        case Kernel::VMAType::BackingMemory:
-            direct_pointer = vma.backing_memory;
-            break;
-        case Kernel::VMAType::Free:
-            return nullptr;
-        default:
-            UNREACHABLE();
-        }
-
-        return direct_pointer + (vaddr - vma.base);
-    }
-
-    /**
-     * Gets a pointer to the exact memory at the virtual address (i.e. not page aligned)
-     * using a VMA from the current process.
-     */
-    u8* GetPointerFromVMA(VAddr vaddr) {
-        return GetPointerFromVMA(*system.CurrentProcess(), vaddr);
+    static u8* GetPointerFromRasterizerCachedMemory(const Common::PageTable& page_table,
+                                                    VAddr vaddr) {
+        return reinterpret_cast<u8*>(page_table.backing_addr[vaddr >> PAGE_BITS] + vaddr);
     }
 
     u8* GetPointer(const VAddr vaddr) {
@@ -151,13 +125,40 @@ struct Memory::Impl {
 
         if (current_page_table->attributes[vaddr >> PAGE_BITS] ==
             Common::PageType::RasterizerCachedMemory) {
-            return GetPointerFromVMA(vaddr);
+            return GetPointerFromRasterizerCachedMemory(*current_page_table, vaddr);
         }
 
         LOG_ERROR(HW_Memory, "Unknown GetPointer @ 0x{:016X}", vaddr);
         return nullptr;
     }
 
+    u8* GetContiguousPointer(const Kernel::Process& process, const VAddr vaddr,
+                             const std::size_t size) {
+        const auto& page_table = process.VMManager().page_table;
+        const std::size_t first_page = vaddr >> PAGE_BITS;
+        const std::size_t last_page = (vaddr + std::max<std::size_t>(size, 1) - 1) >> PAGE_BITS;
+        if (last_page >= page_table.pointers.size()) {
+            return nullptr;
+        }
+
+        u8* const base_pointer = page_table.pointers[first_page];
+        if (base_pointer == nullptr) {
+            return nullptr;
+        }
+        for (std::size_t page = first_page + 1; page <= last_page; ++page) {
+            // Only pages of type Memory have a pointer, so this also rejects unmapped and cached
+            // pages in the range.
+            if (page_table.pointers[page] != base_pointer + ((page - first_page) << PAGE_BITS)) {
+                return nullptr;
+            }
+        }
+        return base_pointer + (vaddr & PAGE_MASK);
+    }
+
+    u8* GetContiguousPointer(const VAddr vaddr, const std::size_t size) {
+        return GetContiguousPointer(*system.CurrentProcess(), vaddr, size);
+    }
+
     u8 Read8(const VAddr addr) {
         return Read<u8>(addr);
     }
@@ -234,7 +235,8 @@ struct Memory::Impl {
                 break;
             }
             case Common::PageType::RasterizerCachedMemory: {
-                const u8* const host_ptr = GetPointerFromVMA(process, current_vaddr);
+                const u8* const host_ptr =
+                    GetPointerFromRasterizerCachedMemory(page_table, current_vaddr);
                 system.GPU().FlushRegion(ToCacheAddr(host_ptr), copy_amount);
                 std::memcpy(dest_buffer, host_ptr, copy_amount);
                 break;
@@ -281,7 +283,8 @@ struct Memory::Impl {
                 break;
             }
             case Common::PageType::RasterizerCachedMemory: {
-                u8* const host_ptr = GetPointerFromVMA(process, current_vaddr);
+                u8* const host_ptr =
+                    GetPointerFromRasterizerCachedMemory(page_table, current_vaddr);
                 system.GPU().InvalidateRegion(ToCacheAddr(host_ptr), copy_amount);
                 std::memcpy(host_ptr, src_buffer, copy_amount);
                 break;
@@ -327,7 +330,8 @@ struct Memory::Impl {
                 break;
             }
             case Common::PageType::RasterizerCachedMemory: {
-                u8* const host_ptr = GetPointerFromVMA(process, current_vaddr);
+                u8* const host_ptr =
+                    GetPointerFromRasterizerCachedMemory(page_table, current_vaddr);
                 system.GPU().InvalidateRegion(ToCacheAddr(host_ptr), copy_amount);
                 std::memset(host_ptr, 0, copy_amount);
                 break;
@@ -373,7 +377,8 @@ struct Memory::Impl {
                 break;
             }
             case Common::PageType::RasterizerCachedMemory: {
-                const u8* const host_ptr = GetPointerFromVMA(process, current_vaddr);
+                const u8* const host_ptr =
+                    GetPointerFromRasterizerCachedMemory(page_table, current_vaddr);
                 system.GPU().FlushRegion(ToCacheAddr(host_ptr), copy_amount);
                 WriteBlock(process, dest_addr, host_ptr, copy_amount);
                 break;
@@ -394,69 +399,94 @@ struct Memory::Impl {
         return CopyBlock(*system.CurrentProcess(), dest_addr, src_addr, size);
     }
 
-    void RasterizerMarkRegionCached(VAddr vaddr, u64 size, bool cached) {
+    void UpdatePagesCachedCount(Common::PageTable& page_table, VAddr vaddr, u64 size,
+                                int delta) {
         if (vaddr == 0) {
             return;
         }
 
+        if (page_table.cached_counts.empty()) {
+            page_table.cached_counts.resize(page_table.pointers.size());
+        }
+
         // Iterate over a contiguous CPU address space, which corresponds to the specified GPU
-        // address space, marking the region as un/cached. The region is marked un/cached at a
-        // granularity of CPU pages, hence why we iterate on a CPU page basis (note: GPU page size
-        // is different). This assumes the specified GPU address region is contiguous as well.
-
-        u64 num_pages = ((vaddr + size - 1) >> PAGE_BITS) - (vaddr >> PAGE_BITS) + 1;
-        for (unsigned i = 0; i < num_pages; ++i, vaddr += PAGE_SIZE) {
-            Common::PageType& page_type = current_page_table->attributes[vaddr >> PAGE_BITS];
-
-            if (cached) {
-                // Switch page type to cached if now cached
-                switch (page_type) {
-                case Common::PageType::Unmapped:
-                    // It is not necessary for a process to have this region mapped into its address
-                    // space, for example, a system module need not have a VRAM mapping.
-                    break;
-                case Common::PageType::Memory:
-                    page_type = Common::PageType::RasterizerCachedMemory;
-                    current_page_table->pointers[vaddr >> PAGE_BITS] = nullptr;
-                    break;
-                case Common::PageType::RasterizerCachedMemory:
-                    // There can be more than one GPU region mapped per CPU region, so it's common
-                    // that this area is already marked as cached.
-                    break;
-                default:
-                    UNREACHABLE();
+        // address space, updating the number of cached objects in each page. Pages switch type
+        // only when their count goes from or to zero, so overlapping objects are cheap to track.
+        const u64 page_start = vaddr >> PAGE_BITS;
+        const u64 page_end = (vaddr + size + PAGE_SIZE - 1) >> PAGE_BITS;
+        for (u64 page = page_start; page < page_end; ++page) {
+            u16& count = page_table.cached_counts[page];
+            if (delta > 0) {
+                ASSERT_MSG(count <= std::numeric_limits<u16>::max() - delta,
+                           "Cached count overflow @ 0x{:016X}", page << PAGE_BITS);
+                if (count == 0) {
+                    MarkPageCached(page_table, page, true);
                 }
+                count = static_cast<u16>(count + delta);
             } else {
-                // Switch page type to uncached if now uncached
-                switch (page_type) {
-                case Common::PageType::Unmapped:
-                    // It is not necessary for a process to have this region mapped into its address
-                    // space, for example, a system module need not have a VRAM mapping.
-                    break;
-                case Common::PageType::Memory:
-                    // There can be more than one GPU region mapped per CPU region, so it's common
-                    // that this area is already unmarked as cached.
-                    break;
-                case Common::PageType::RasterizerCachedMemory: {
-                    u8* pointer = GetPointerFromVMA(vaddr & ~PAGE_MASK);
-                    if (pointer == nullptr) {
-                        // It's possible that this function has been called while updating the
-                        // pagetable after unmapping a VMA. In that case the underlying VMA will no
-                        // longer exist, and we should just leave the pagetable entry blank.
-                        page_type = Common::PageType::Unmapped;
-                    } else {
-                        page_type = Common::PageType::Memory;
-                        current_page_table->pointers[vaddr >> PAGE_BITS] = pointer;
-                    }
-                    break;
-                }
-                default:
-                    UNREACHABLE();
+                ASSERT_MSG(count >= -delta, "Cached count underflow @ 0x{:016X}",
+                           page << PAGE_BITS);
+                count = static_cast<u16>(count + delta);
+                if (count == 0) {
+                    MarkPageCached(page_table, page, false);
                 }
             }
         }
     }
 
+    void UpdatePagesCachedCount(VAddr vaddr, u64 size, int delta) {
+        UpdatePagesCachedCount(*current_page_table, vaddr, size, delta);
+    }
+
+    /**
+     * Marks a page as cached or uncached.
+     *
+     * @param page_table The page table containing the page.
+     * @param page       The index of the page.
+     * @param cached     Whether the page is now cached or uncached.
+     */
+    static void MarkPageCached(Common::PageTable& page_table, u64 page, bool cached) {
+        Common::PageType& page_type = page_table.attributes[page];
+
+        if (cached) {
+            // Switch page type to cached if now cached
+            switch (page_type) {
+            case Common::PageType::Unmapped:
+                // It is not necessary for a process to have this region mapped into its address
+                // space, for example, a system module need not have a VRAM mapping.
+                break;
+            case Common::PageType::Memory:
+                page_type = Common::PageType::RasterizerCachedMemory;
+                page_table.pointers[page] = nullptr;
+                break;
+            case Common::PageType::RasterizerCachedMemory:
+                // The page may have been mapped again while it was cached.
+                break;
+            default:
+                UNREACHABLE();
+            }
+        } else {
+            // Switch page type to uncached if now uncached
+            switch (page_type) {
+            case Common::PageType::Unmapped:
+                // It is not necessary for a process to have this region mapped into its address
+                // space, for example, a system module need not have a VRAM mapping.
+                break;
+            case Common::PageType::Memory:
+                // The page may have been mapped again while it was cached.
+                break;
+            case Common::PageType::RasterizerCachedMemory:
+                // Unmapping a page changes its type, so cached pages always have a backing.
+                page_type = Common::PageType::Memory;
+                page_table.pointers[page] =
+                    GetPointerFromRasterizerCachedMemory(page_table, page << PAGE_BITS);
+                break;
+            default:
+                UNREACHABLE();
+            }
+        }
+    }
+
     /**
      * Maps a region of pages as a specific type.
      *
@@ -491,13 +521,30 @@ struct Memory::Impl {
         if (memory == nullptr) {
             std::fill(page_table.pointers.begin() + base, page_table.pointers.begin() + end,
                       memory);
+            std::fill(page_table.backing_addr.begin() + base,
+                      page_table.backing_addr.begin() + end, 0);
         } else {
+            // The offset between host and guest addresses is the same for the whole region.
+            std::fill(page_table.backing_addr.begin() + base,
+                      page_table.backing_addr.begin() + end,
+                      reinterpret_cast<u64>(memory) - (base << PAGE_BITS));
+
+            const VAddr start = base;
             while (base != end) {
                 page_table.pointers[base] = memory;
 
                 base += 1;
                 memory += PAGE_SIZE;
             }
+
+            // Pages still referenced by the rasterizer caches must keep being tracked.
+            if (!page_table.cached_counts.empty()) {
+                for (VAddr page = start; page != end; ++page) {
+                    if (page_table.cached_counts[page] != 0) {
+                        MarkPageCached(page_table, page, true);
+                    }
+                }
+            }
         }
     }
 
@@ -531,7 +578,8 @@ struct Memory::Impl {
             ASSERT_MSG(false, "Mapped memory page without a pointer @ {:016X}", vaddr);
             break;
         case Common::PageType::RasterizerCachedMemory: {
-            const u8* const host_ptr = GetPointerFromVMA(vaddr);
+            const u8* const host_ptr =
+                GetPointerFromRasterizerCachedMemory(*current_page_table, vaddr);
             system.GPU().FlushRegion(ToCacheAddr(host_ptr), sizeof(T));
             T value;
             std::memcpy(&value, host_ptr, sizeof(T));
@@ -573,7 +621,7 @@ struct Memory::Impl {
             ASSERT_MSG(false, "Mapped memory page without a pointer @ {:016X}", vaddr);
             break;
         case Common::PageType::RasterizerCachedMemory: {
-            u8* const host_ptr{GetPointerFromVMA(vaddr)};
+            u8* const host_ptr{GetPointerFromRasterizerCachedMemory(*current_page_table, vaddr)};
             system.GPU().InvalidateRegion(ToCacheAddr(host_ptr), sizeof(T));
             std::memcpy(host_ptr, &data, sizeof(T));
             break;
@@ -633,6 +681,14 @@ const u8* Memory::GetPointer(VAddr vaddr) const {
     return impl->GetPointer(vaddr);
 }
 
+u8* Memory::GetContiguousPointer(const Kernel::Process& process, VAddr vaddr, std::size_t size) {
+    return impl->GetContiguousPointer(process, vaddr, size);
+}
+
+u8* Memory::GetContiguousPointer(VAddr vaddr, std::size_t size) {
+    return impl->GetContiguousPointer(vaddr, size);
+}
+
 u8 Memory::Read8(const VAddr addr) {
     return impl->Read8(addr);
 }
@@ -704,8 +760,13 @@ void Memory::CopyBlock(VAddr dest_addr, VAddr src_addr, std::size_t size) {
     impl->CopyBlock(dest_addr, src_addr, size);
 }
 
-void Memory::RasterizerMarkRegionCached(VAddr vaddr, u64 size, bool cached) {
-    impl->RasterizerMarkRegionCached(vaddr, size, cached);
+void Memory::UpdatePagesCachedCount(Common::PageTable& page_table, VAddr vaddr, u64 size,
+                                    int delta) {
+    impl->UpdatePagesCachedCount(page_table, vaddr, size, delta);
+}
+
+void Memory::UpdatePagesCachedCount(VAddr vaddr, u64 size, int delta) {
+    impl->UpdatePagesCachedCount(vaddr, size, delta);
 }
 
 bool IsKernelVirtualAddress(const VAddr vaddr) {
@@ -159,6 +159,33 @@ public:
      */
     const u8* GetPointer(VAddr vaddr) const;
 
+    /**
+     * Gets a host pointer to a range of a process' address space, if the whole range can be
+     * accessed through it directly.
+     *
+     * @param process The process whose address space is accessed.
+     * @param vaddr   Virtual address of the start of the range.
+     * @param size    Size of the range, in bytes.
+     *
+     * @returns The pointer to the given address if every page in the range is regular memory that
+     *          is contiguous in host memory. Otherwise nullptr is returned, and the range has to
+     *          be accessed through ReadBlock/WriteBlock, which handle unmapped pages and pages
+     *          cached by the rasterizer.
+     */
+    u8* GetContiguousPointer(const Kernel::Process& process, VAddr vaddr, std::size_t size);
+
+    /**
+     * Gets a host pointer to a range of the current process' address space, if the whole range
+     * can be accessed through it directly.
+     *
+     * @param vaddr Virtual address of the start of the range.
+     * @param size  Size of the range, in bytes.
+     *
+     * @returns The pointer to the given address if every page in the range is regular memory that
+     *          is contiguous in host memory, otherwise nullptr.
+     */
+    u8* GetContiguousPointer(VAddr vaddr, std::size_t size);
+
     /**
      * Reads an 8-bit unsigned value from the current process' address space
      * at the given virtual address.
@@ -394,14 +421,26 @@ public:
     void CopyBlock(VAddr dest_addr, VAddr src_addr, std::size_t size);
 
     /**
-     * Marks each page within the specified address range as cached or uncached.
+     * Updates the number of rasterizer cache objects overlapping each page within the specified
+     * address range. Pages become cached when their count goes above zero and uncached when it
+     * goes back to zero.
+     *
+     * @param page_table The page table containing the address range.
+     * @param vaddr      The virtual address indicating the start of the address range.
+     * @param size       The size of the address range in bytes.
+     * @param delta      The number of objects added to (or removed from, if negative) each page.
+     */
+    void UpdatePagesCachedCount(Common::PageTable& page_table, VAddr vaddr, u64 size, int delta);
+
+    /**
+     * Updates the number of rasterizer cache objects overlapping each page within the specified
+     * address range of the current process.
      *
-     * @param vaddr  The virtual address indicating the start of the address range.
-     * @param size   The size of the address range in bytes.
-     * @param cached Whether or not any pages within the address range should be
-     *               marked as cached or uncached.
+     * @param vaddr The virtual address indicating the start of the address range.
+     * @param size  The size of the address range in bytes.
+     * @param delta The number of objects added to (or removed from, if negative) each page.
      */
-    void RasterizerMarkRegionCached(VAddr vaddr, u64 size, bool cached);
+    void UpdatePagesCachedCount(VAddr vaddr, u64 size, int delta);
 
 private:
     struct Impl;
@@ -404,6 +404,8 @@ struct Values {
 
     // Core
     bool use_multi_core;
+    bool use_relaxed_multi_core;
+    bool use_hle_service_threads;
 
     // Data Storage
     bool use_virtual_sd;
@@ -422,6 +424,9 @@ struct Values {
     bool use_disk_shader_cache;
     bool use_accurate_gpu_emulation;
     bool use_asynchronous_gpu_emulation;
+    bool use_asynchronous_shaders;
+    bool use_macro_jit;
+    u32 texture_cache_budget; ///< In MiB, 0 disables eviction
     bool force_30fps_mode;
 
     float bg_red;
@@ -445,6 +450,7 @@ struct Values {
     std::string program_args;
     bool dump_exefs;
     bool dump_nso;
+    bool record_pushbuffers;
     bool reporting_services;
     bool quest_flag;
 
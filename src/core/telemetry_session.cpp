@@ -169,6 +169,8 @@ void TelemetrySession::AddInitialInfo(Loader::AppLoader& app_loader) {
     AddField(field_type, "Audio_SinkId", Settings::values.sink_id);
     AddField(field_type, "Audio_EnableAudioStretching", Settings::values.enable_audio_stretching);
     AddField(field_type, "Core_UseMultiCore", Settings::values.use_multi_core);
+    AddField(field_type, "Core_UseRelaxedMultiCore", Settings::values.use_relaxed_multi_core);
+    AddField(field_type, "Core_UseHLEServiceThreads", Settings::values.use_hle_service_threads);
     AddField(field_type, "Renderer_Backend", "OpenGL");
     AddField(field_type, "Renderer_ResolutionFactor", Settings::values.resolution_factor);
     AddField(field_type, "Renderer_UseFrameLimit", Settings::values.use_frame_limit);
@@ -178,6 +180,9 @@ void TelemetrySession::AddInitialInfo(Loader::AppLoader& app_loader) {
              Settings::values.use_accurate_gpu_emulation);
     AddField(field_type, "Renderer_UseAsynchronousGpuEmulation",
              Settings::values.use_asynchronous_gpu_emulation);
+    AddField(field_type, "Renderer_UseAsynchronousShaders",
+             Settings::values.use_asynchronous_shaders);
+    AddField(field_type, "Renderer_TextureCacheBudget", Settings::values.texture_cache_budget);
     AddField(field_type, "System_UseDockedMode", Settings::values.use_docked_mode);
 }
 
@@ -0,0 +1,39 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "tests/allocation_counter.h"
+
+namespace {
+/// Number of heap allocations made by the tests, used to count allocations on hot paths.
+std::atomic<u64> num_allocations{};
+} // Anonymous namespace
+
+void* operator new(std::size_t size) {
+    ++num_allocations;
+    if (void* const pointer = std::malloc(size != 0 ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace Tests {
+
+u64 GetNumAllocations() {
+    return num_allocations;
+}
+
+} // namespace Tests
@@ -0,0 +1,14 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/common_types.h"
+
+namespace Tests {
+
+/// Returns the number of heap allocations made through operator new by the tests so far.
+u64 GetNumAllocations();
+
+} // namespace Tests
@@ -0,0 +1,61 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/file_util.h"
+
+namespace FileUtil {
+namespace {
+
+constexpr char TEST_FILE[] = "file_util_test.bin";
+
+void WriteTestFile(const std::vector<u8>& data) {
+    IOFile file(TEST_FILE, "wb");
+    REQUIRE(file.WriteBytes(data.data(), data.size()) == data.size());
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MappedFile[Open]", "[common]") {
+    std::vector<u8> data(0x1234);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<u8>(i * 3);
+    }
+    WriteTestFile(data);
+
+    MappedFile file(TEST_FILE);
+    REQUIRE(file.IsOpen());
+    REQUIRE(file.GetSize() == data.size());
+    REQUIRE(std::equal(data.begin(), data.end(), file.GetData()));
+
+    // Moving hands the mapping over
+    MappedFile moved = std::move(file);
+    REQUIRE(!file.IsOpen());
+    REQUIRE(file.GetData() == nullptr);
+    REQUIRE(moved.IsOpen());
+    REQUIRE(moved.GetData()[0x1000] == data[0x1000]);
+    moved.Close();
+    REQUIRE(!moved.IsOpen());
+    REQUIRE(moved.GetSize() == 0);
+
+    // Empty files are open without data
+    WriteTestFile({});
+    REQUIRE(file.Open(TEST_FILE));
+    REQUIRE(file.GetSize() == 0);
+    REQUIRE(file.GetData() == nullptr);
+    file.Close();
+    REQUIRE(Delete(TEST_FILE));
+
+    REQUIRE(!file.Open(TEST_FILE));
+    REQUIRE(!file.IsOpen());
+    REQUIRE(!MappedFile(".").IsOpen());
+}
+
+} // namespace FileUtil
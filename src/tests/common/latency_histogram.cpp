@@ -0,0 +1,31 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <catch2/catch.hpp>
+#include "common/latency_histogram.h"
+
+namespace Common {
+
+TEST_CASE("LatencyHistogram", "[common]") {
+    using namespace std::chrono_literals;
+    LatencyHistogram histogram;
+    REQUIRE(histogram.Count() == 0);
+    REQUIRE(histogram.Percentile(50) == 0us);
+
+    for (int i = 0; i < 98; ++i) {
+        histogram.Record(100ns);
+    }
+    histogram.Record(5us);
+    histogram.Record(3ms);
+
+    REQUIRE(histogram.Count() == 100);
+    REQUIRE(histogram.Max() == 3ms);
+    REQUIRE(histogram.Mean() == 30us);
+    REQUIRE(histogram.Percentile(50) == 1us);
+    REQUIRE(histogram.Percentile(99) == 8us);
+    REQUIRE(histogram.Percentile(100) == 4096us);
+}
+
+} // namespace Common
@@ -0,0 +1,134 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "common/common_types.h"
+#include "common/threadsafe_queue.h"
+
+namespace Common {
+
+namespace {
+
+/// Measures the time taken to transfer a number of elements from one thread to another.
+template <typename Queue>
+double MeasureThroughput(Queue& queue, u64 num_elements) {
+    const auto start = std::chrono::steady_clock::now();
+    std::thread consumer{[&queue, num_elements] {
+        for (u64 i = 0; i < num_elements; ++i) {
+            queue.PopWait();
+        }
+    }};
+    for (u64 i = 0; i < num_elements; ++i) {
+        queue.Push(i);
+    }
+    consumer.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(num_elements) / elapsed.count();
+}
+
+/// Measures the average time taken by a sleeping consumer to observe a new element.
+template <typename Queue>
+std::chrono::nanoseconds MeasureWakeupLatency(Queue& queue, u32 num_samples) {
+    std::chrono::nanoseconds total{};
+    for (u32 i = 0; i < num_samples; ++i) {
+        std::thread consumer{[&queue, &total] {
+            const u64 pushed_at = queue.PopWait();
+            const auto now = std::chrono::steady_clock::now().time_since_epoch();
+            total += std::chrono::nanoseconds(now.count() - static_cast<s64>(pushed_at));
+        }};
+        // Give the consumer enough time to park before pushing.
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        queue.Push(static_cast<u64>(std::chrono::nanoseconds(now).count()));
+        consumer.join();
+    }
+    return total / num_samples;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("BoundedSPSCQueue: Basic Tests", "[common]") {
+    BoundedSPSCQueue<int, 4> queue;
+    REQUIRE(queue.Empty());
+
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(queue.TryEmplace(i));
+    }
+    REQUIRE(queue.Size() == 4);
+
+    // Pushing into a full queue should fail.
+    REQUIRE(!queue.TryEmplace(42));
+
+    int value = -1;
+    REQUIRE(queue.Pop(value));
+    REQUIRE(value == 0);
+    REQUIRE(queue.TryEmplace(4));
+
+    // Elements are returned in order across the wrap around point.
+    for (int i = 1; i <= 4; ++i) {
+        REQUIRE(queue.Pop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE(queue.Empty());
+    REQUIRE(!queue.Pop(value));
+}
+
+TEST_CASE("BoundedSPSCQueue: Non-trivial elements", "[common]") {
+    auto counter = std::make_shared<int>(0);
+    {
+        BoundedSPSCQueue<std::shared_ptr<int>, 8> queue;
+        for (int i = 0; i < 6; ++i) {
+            queue.Push(counter);
+        }
+        REQUIRE(counter.use_count() == 7);
+
+        std::shared_ptr<int> element;
+        REQUIRE(queue.Pop(element));
+        REQUIRE(element == counter);
+        element.reset();
+        REQUIRE(counter.use_count() == 6);
+    }
+    // Elements left in the queue are destroyed along with it.
+    REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("BoundedSPSCQueue: Threaded", "[common]") {
+    constexpr u64 num_elements = 1 << 20;
+    BoundedSPSCQueue<u64, 64> queue;
+
+    std::thread producer{[&queue] {
+        for (u64 i = 0; i < num_elements; ++i) {
+            queue.Push(i);
+        }
+    }};
+    bool in_order = true;
+    for (u64 i = 0; i < num_elements; ++i) {
+        in_order &= queue.PopWait() == i;
+    }
+    producer.join();
+
+    REQUIRE(in_order);
+    REQUIRE(queue.Empty());
+}
+
+TEST_CASE("BoundedSPSCQueue: Benchmark", "[common][.benchmark]") {
+    constexpr u64 num_elements = 1 << 24;
+    constexpr u32 num_samples = 64;
+
+    SPSCQueue<u64> spsc_queue;
+    BoundedSPSCQueue<u64, 1024> bounded_queue;
+
+    fmt::print("Throughput: SPSCQueue {:.2f} Mops/s, BoundedSPSCQueue {:.2f} Mops/s\n",
+               MeasureThroughput(spsc_queue, num_elements) / 1e6,
+               MeasureThroughput(bounded_queue, num_elements) / 1e6);
+    fmt::print("Wake up latency: SPSCQueue {} ns, BoundedSPSCQueue {} ns\n",
+               MeasureWakeupLatency(spsc_queue, num_samples).count(),
+               MeasureWakeupLatency(bounded_queue, num_samples).count());
+}
+
+} // namespace Common
@@ -6,9 +6,14 @@
 
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <cstdlib>
 #include <memory>
+#include <random>
 #include <string>
+#include <thread>
+#include <vector>
+#include <fmt/format.h>
 
 #include "common/file_util.h"
 #include "core/core.h"
@@ -154,3 +159,131 @@ TEST_CASE("Core::Timing[PredictableLateness]", "[core]") {
     AdvanceAndCheck(core_timing, 0, 0, 10, -10); // (100 - 10)
     AdvanceAndCheck(core_timing, 1, 1, 50, -50);
 }
+
+TEST_CASE("Core::Timing[UnscheduleByHandle]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    std::shared_ptr<Core::Timing::EventType> cb_a =
+        Core::Timing::CreateEvent("callbackA", CallbackTemplate<0>);
+    std::shared_ptr<Core::Timing::EventType> cb_b =
+        Core::Timing::CreateEvent("callbackB", CallbackTemplate<1>);
+
+    // Enter slice 0
+    core_timing.ResetRun();
+
+    // Two events of the same type with the same userdata, only the second one is cancelled
+    core_timing.ScheduleEvent(100, cb_a, CB_IDS[0]);
+    const auto handle = core_timing.ScheduleEvent(200, cb_a, CB_IDS[0]);
+    core_timing.ScheduleEvent(300, cb_b, CB_IDS[1]);
+    core_timing.UnscheduleEvent(handle);
+
+    AdvanceAndCheck(core_timing, 0, 0);
+    AdvanceAndCheck(core_timing, 1, 1);
+
+    // Cancelling an event twice does nothing
+    core_timing.ScheduleEvent(100, cb_b, CB_IDS[1]);
+    core_timing.UnscheduleEvent(handle);
+    AdvanceAndCheck(core_timing, 1, 2);
+}
+
+TEST_CASE("Core::Timing[UnscheduleManyEvents]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    std::shared_ptr<Core::Timing::EventType> empty_callback =
+        Core::Timing::CreateEvent("empty_callback", EmptyCallback);
+
+    // Enough cancellations to compact the queue several times
+    constexpr u64 num_events = 4096;
+    core_timing.ResetRun();
+    std::vector<Core::Timing::EventHandle> handles;
+    for (u64 i = 0; i < num_events; ++i) {
+        handles.push_back(core_timing.ScheduleEvent(static_cast<s64>(i % 1000), empty_callback, i));
+    }
+    for (u64 i = 0; i < num_events; i += 2) {
+        core_timing.UnscheduleEvent(handles[i]);
+    }
+    for (u64 i = 1; i < num_events; i += 4) {
+        core_timing.UnscheduleEvent(empty_callback, i);
+    }
+
+    callbacks_done = 0;
+    core_timing.AddTicks(1000);
+    core_timing.Advance();
+    REQUIRE(callbacks_done == num_events / 4);
+}
+
+TEST_CASE("Core::Timing[HostThreads]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    std::shared_ptr<Core::Timing::EventType> cb_a =
+        Core::Timing::CreateEvent("callbackA", CallbackTemplate<0>);
+
+    core_timing.ResetRun();
+    core_timing.AddTicks(100);
+    const s64 downcount = core_timing.GetDowncount();
+
+    // Threads that don't run a core only see the time the cores have reached, and scheduling from
+    // them leaves the downcount of core 0 alone
+    u64 other_thread_ticks = 0;
+    std::thread([&core_timing, &cb_a, &other_thread_ticks] {
+        other_thread_ticks = core_timing.GetTicks();
+        core_timing.ScheduleEvent(1000, cb_a, CB_IDS[0]);
+    }).join();
+    REQUIRE(other_thread_ticks == 0);
+    REQUIRE(core_timing.GetTicks() == 100);
+    REQUIRE(core_timing.GetDowncount() == downcount);
+
+    // The event fires at the end of the slice instead
+    AdvanceAndCheck(core_timing, 0, 0, MAX_SLICE_LENGTH - 1000);
+}
+
+namespace {
+
+/// Measures the number of schedule/fire or schedule/cancel pairs per second with a number of
+/// long lived events pending, as happens with thread wakeups.
+double MeasureEventThroughput(u64 num_pending, u64 num_operations, bool cancel) {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    std::shared_ptr<Core::Timing::EventType> empty_callback =
+        Core::Timing::CreateEvent("empty_callback", EmptyCallback);
+    std::shared_ptr<Core::Timing::EventType> pending_callback =
+        Core::Timing::CreateEvent("pending_callback", EmptyCallback);
+
+    core_timing.ResetRun();
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<s64> distribution{1'000'000'000, 10'000'000'000};
+    for (u64 i = 0; i < num_pending; ++i) {
+        core_timing.ScheduleEvent(distribution(rng), pending_callback, i);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (u64 i = 0; i < num_operations; ++i) {
+        if (cancel) {
+            core_timing.UnscheduleEvent(empty_callback, i);
+            core_timing.ScheduleEvent(100, empty_callback, i + 1);
+        } else {
+            core_timing.ScheduleEvent(100, empty_callback, i);
+            core_timing.AddTicks(core_timing.GetDowncount());
+            core_timing.Advance();
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(num_operations) / elapsed.count();
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Core::Timing[Benchmark]", "[core][.benchmark]") {
+    constexpr u64 num_operations = 1 << 20;
+
+    for (const u64 num_pending : {16, 1024, 8192}) {
+        fmt::print("{} pending events: schedule/fire {:.2f} Mops/s, "
+                   "schedule/cancel {:.2f} Mops/s\n",
+                   num_pending, MeasureEventThroughput(num_pending, num_operations, false) / 1e6,
+                   MeasureEventThroughput(num_pending, num_operations, true) / 1e6);
+    }
+}
@@ -0,0 +1,199 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/hex_util.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/ctr_encryption_layer.h"
+#include "core/crypto/key_manager.h"
+#include "core/crypto/xts_encryption_layer.h"
+#include "core/file_sys/vfs_concat.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace Core::Crypto {
+namespace {
+
+constexpr std::size_t XTS_SECTOR_SIZE = 0x4000;
+
+std::vector<u8> MakeData(std::size_t size) {
+    std::vector<u8> data(size);
+    std::mt19937 rng(size);
+    std::generate(data.begin(), data.end(), [&rng] { return static_cast<u8>(rng()); });
+    return data;
+}
+
+/// Encrypts data like a CTR section at base_offset of an NCA with the given section counter.
+std::vector<u8> EncryptCTR(const std::vector<u8>& data, const Key128& key,
+                           std::size_t base_offset, const std::vector<u8>& section_ctr) {
+    std::array<u8, 16> iv{};
+    std::copy(section_ctr.begin(), section_ctr.end(), iv.begin());
+    u64 counter = base_offset >> 4;
+    for (std::size_t i = 0; i < 8; ++i) {
+        iv[15 - i] = static_cast<u8>(counter);
+        counter >>= 8;
+    }
+    std::vector<u8> out(data.size());
+    AESCipher<Key128>(key, Mode::CTR).CTRTranscode(data.data(), data.size(), out.data(), iv, 0);
+    return out;
+}
+
+std::vector<u8> EncryptXTS(const std::vector<u8>& data, const Key256& key) {
+    std::vector<u8> out(data.size());
+    AESCipher<Key256>(key, Mode::XTS)
+        .XTSTranscode(data.data(), data.size(), out.data(), 0, XTS_SECTOR_SIZE, Op::Encrypt);
+    return out;
+}
+
+/// Returns a file with the data, either in host memory or split in two so it can't be viewed.
+FileSys::VirtualFile MakeFile(const std::vector<u8>& data, bool in_memory) {
+    if (in_memory) {
+        return std::make_shared<FileSys::VectorVfsFile>(data);
+    }
+    const auto middle = data.begin() + data.size() / 2;
+    return FileSys::ConcatenatedVfsFile::MakeConcatenatedFile(
+        {std::make_shared<FileSys::VectorVfsFile>(std::vector<u8>(data.begin(), middle)),
+         std::make_shared<FileSys::VectorVfsFile>(std::vector<u8>(middle, data.end()))},
+        "");
+}
+
+/// Reads a file at random unaligned offsets and lengths, checking the data matches expected.
+void CheckRandomReads(const FileSys::VfsFile& file, const std::vector<u8>& expected) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> offset_dist(0, expected.size() - 1);
+    std::uniform_int_distribution<std::size_t> length_dist(1, 3 * XTS_SECTOR_SIZE);
+    std::vector<u8> out;
+    for (int i = 0; i < 200; ++i) {
+        const std::size_t offset = offset_dist(rng);
+        out.resize(length_dist(rng));
+        const std::size_t read = file.Read(out.data(), out.size(), offset);
+        REQUIRE(read == std::min(out.size(), expected.size() - offset));
+        REQUIRE(std::equal(out.begin(), out.begin() + read, expected.begin() + offset));
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("AESCipher[CTR]", "[core][crypto]") {
+    // NIST SP 800-38A F.5.1
+    const auto key = Common::HexStringToArray<16>("2B7E151628AED2A6ABF7158809CF4F3C");
+    const auto iv = Common::HexStringToArray<16>("F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF");
+    const auto plain = Common::HexStringToVector(
+        "6BC1BEE22E409F96E93D7E117393172AAE2D8A571E03AC9C9EB76FAC45AF8E51"
+        "30C81C46A35CE411E5FBC1191A0A52EFF69F2445DF4F9B17AD2B417BE66C3710",
+        false);
+    const auto encrypted = Common::HexStringToVector(
+        "874D6191B620E3261BEF6864990DB6CE9806F66B7970FDFF8617187BB9FFFDFF"
+        "5AE4DF3EDBD5D35E5B4F09020DB03EAB1E031DDA2FBE03D1792170A0F3009CEE",
+        false);
+
+    AESCipher<Key128> cipher(key, Mode::CTR);
+    std::vector<u8> out(plain.size());
+    cipher.SetIV({iv.begin(), iv.end()});
+    cipher.Transcode(plain.data(), plain.size(), out.data(), Op::Encrypt);
+    REQUIRE(out == encrypted);
+
+    // Starting within the second block
+    std::array<u8, 16> second_iv = iv;
+    second_iv[15] = 0x00;
+    second_iv[14] = 0xFF;
+    cipher.CTRTranscode(encrypted.data() + 0x15, 0x20, out.data(), second_iv, 5);
+    REQUIRE(std::equal(out.begin(), out.begin() + 0x20, plain.begin() + 0x15));
+}
+
+TEST_CASE("AESCipher[XTS]", "[core][crypto]") {
+    // IEEE 1619-2007 XTS-AES-128 vector 1
+    AESCipher<Key256> cipher(Key256{}, Mode::XTS);
+    const std::vector<u8> plain(0x20);
+    const auto encrypted = Common::HexStringToVector(
+        "917CF69EBD68B2EC9B9FE9A3EADDA692CD43D2F59598ED858C02C2652FBF922E", false);
+    std::vector<u8> out(plain.size());
+    cipher.XTSTranscode(plain.data(), plain.size(), out.data(), 0, 0x20, Op::Encrypt);
+    REQUIRE(out == encrypted);
+    cipher.XTSTranscode(out.data(), out.size(), out.data(), 0, 0x20, Op::Decrypt);
+    REQUIRE(out == plain);
+
+    // Sectors transcoded together match sectors transcoded one by one
+    const auto data = MakeData(4 * XTS_SECTOR_SIZE);
+    std::vector<u8> batched(data.size());
+    cipher.XTSTranscode(data.data(), data.size(), batched.data(), 7, XTS_SECTOR_SIZE, Op::Decrypt);
+    for (std::size_t i = 0; i < 4; ++i) {
+        std::vector<u8> sector(XTS_SECTOR_SIZE);
+        cipher.XTSTranscode(data.data() + i * XTS_SECTOR_SIZE, XTS_SECTOR_SIZE, sector.data(),
+                            7 + i, XTS_SECTOR_SIZE, Op::Decrypt);
+        REQUIRE(std::equal(sector.begin(), sector.end(), batched.begin() + i * XTS_SECTOR_SIZE));
+    }
+}
+
+TEST_CASE("CTREncryptionLayer[Read]", "[core][crypto]") {
+    const Key128 key = Common::HexStringToArray<16>("000102030405060708090A0B0C0D0E0F");
+    const std::vector<u8> section_ctr{1, 2, 3, 4, 5, 6, 7, 8};
+    const std::vector<u8> plain = MakeData(0x23456);
+    const auto encrypted = EncryptCTR(plain, key, 0xC000, section_ctr);
+
+    for (const bool in_memory : {true, false}) {
+        CTREncryptionLayer layer(MakeFile(encrypted, in_memory), key, 0xC000);
+        layer.SetIV(section_ctr);
+        CheckRandomReads(layer, plain);
+    }
+}
+
+TEST_CASE("XTSEncryptionLayer[Read]", "[core][crypto]") {
+    Key256 key{};
+    std::iota(key.begin(), key.end(), u8{0});
+    const std::vector<u8> plain = MakeData(6 * XTS_SECTOR_SIZE);
+    const auto encrypted = EncryptXTS(plain, key);
+    for (const bool in_memory : {true, false}) {
+        const XTSEncryptionLayer layer(MakeFile(encrypted, in_memory), key);
+        CheckRandomReads(layer, plain);
+        REQUIRE(layer.ReadAllBytes() == plain);
+    }
+}
+
+/// Measures the decryption throughput of the CTR and XTS layers for large sequential reads and
+/// small unaligned ones.
+TEST_CASE("EncryptionLayer[Benchmark]", "[core][crypto][.benchmark]") {
+    constexpr std::size_t DATA_SIZE = 0x4000000;
+    const std::vector<u8> plain = MakeData(DATA_SIZE);
+    const Key128 ctr_key{};
+    const Key256 xts_key{};
+    const std::vector<u8> section_ctr(8);
+    CTREncryptionLayer ctr(
+        std::make_shared<FileSys::VectorVfsFile>(EncryptCTR(plain, ctr_key, 0, section_ctr)),
+        ctr_key, 0);
+    ctr.SetIV(section_ctr);
+    const XTSEncryptionLayer xts(
+        std::make_shared<FileSys::VectorVfsFile>(EncryptXTS(plain, xts_key)), xts_key);
+
+    const auto Measure = [](const FileSys::VfsFile& file, std::size_t chunk_size, bool random) {
+        std::mt19937 rng(1234);
+        std::vector<u8> buffer(chunk_size);
+        std::size_t bytes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t offset = 0; offset + chunk_size <= DATA_SIZE; offset += chunk_size) {
+            const std::size_t read_offset = random ? rng() % (DATA_SIZE - chunk_size) : offset;
+            bytes += file.Read(buffer.data(), chunk_size, read_offset);
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return bytes / elapsed.count() / (1024.0 * 1024.0);
+    };
+
+    fmt::print("CTR: {:.1f} MiB/s in 1 MiB reads, {:.1f} MiB/s in random 4 KiB reads\n",
+               Measure(ctr, 0x100000, false), Measure(ctr, 0x1000, true));
+    fmt::print("XTS: {:.1f} MiB/s in 1 MiB reads, {:.1f} MiB/s in random 4 KiB reads\n",
+               Measure(xts, 0x100000, false), Measure(xts, 0x1000, true));
+}
+
+} // namespace Core::Crypto
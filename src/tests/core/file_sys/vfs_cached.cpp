@@ -0,0 +1,153 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "core/crypto/ctr_encryption_layer.h"
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs_cached.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace FileSys {
+namespace {
+
+std::vector<u8> MakeData(std::size_t size) {
+    std::vector<u8> data(size);
+    std::mt19937 rng(size);
+    std::generate(data.begin(), data.end(), [&rng] { return static_cast<u8>(rng()); });
+    return data;
+}
+
+/// Builds a RomFS image with many files and wraps it in a CTR layer, like an NCA RomFS section.
+VirtualFile MakeEncryptedRomFS(std::size_t num_files, std::size_t max_file_size) {
+    std::mt19937 rng(0x5EED);
+    std::uniform_int_distribution<std::size_t> size_dist(1, max_file_size);
+    std::vector<VirtualFile> files;
+    for (std::size_t i = 0; i < num_files; ++i) {
+        files.push_back(std::make_shared<VectorVfsFile>(MakeData(size_dist(rng)),
+                                                        fmt::format("file{:05}.bin", i)));
+    }
+    const auto image = CreateRomFS(std::make_shared<VectorVfsDirectory>(std::move(files)));
+
+    // CTR is symmetric, running the plain image through the layer encrypts it
+    const Core::Crypto::Key128 key{};
+    const auto plain = std::make_shared<VectorVfsFile>(image->ReadAllBytes(), "romfs");
+    const Core::Crypto::CTREncryptionLayer encrypt(plain, key, 0);
+    const auto encrypted = std::make_shared<VectorVfsFile>(encrypt.ReadAllBytes(), "romfs");
+    return std::make_shared<Core::Crypto::CTREncryptionLayer>(encrypted, key, 0);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CachedVfsFile[Read]", "[core][file_sys]") {
+    const std::vector<u8> data = MakeData(0x10321);
+    const auto base = std::make_shared<VectorVfsFile>(data);
+    const auto cached = std::make_shared<CachedVfsFile>(base, 0x100, 16, 4);
+    REQUIRE(cached->GetSize() == data.size());
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> offset_dist(0, data.size() - 1);
+    std::uniform_int_distribution<std::size_t> length_dist(1, 0x300);
+    for (int i = 0; i < 1000; ++i) {
+        const std::size_t offset = offset_dist(rng);
+        const std::size_t length = length_dist(rng);
+        const std::size_t expected = std::min(length, data.size() - offset);
+        std::vector<u8> out(length);
+        REQUIRE(cached->Read(out.data(), length, offset) == expected);
+        REQUIRE(std::equal(out.begin(), out.begin() + expected, data.begin() + offset));
+    }
+    REQUIRE(cached->Read(nullptr, 1, data.size()) == 0);
+
+    // Large reads bypass the cache
+    REQUIRE(cached->ReadAllBytes() == data);
+}
+
+TEST_CASE("CachedVfsFile[Readahead]", "[core][file_sys]") {
+    const std::vector<u8> data = MakeData(0x10000);
+    const auto base = std::make_shared<VectorVfsFile>(data);
+    const auto cached = std::make_shared<CachedVfsFile>(base, 0x100, 64, 7);
+
+    std::vector<u8> out(0x40);
+    for (std::size_t offset = 0; offset < 0x1000; offset += out.size()) {
+        REQUIRE(cached->Read(out.data(), out.size(), offset) == out.size());
+        REQUIRE(std::equal(out.begin(), out.end(), data.begin() + offset));
+    }
+    // 16 blocks read sequentially are fetched 8 at a time
+    REQUIRE(cached->GetNumBackingReads() == 2);
+
+    // Reading them again is served from the cache
+    for (std::size_t offset = 0; offset < 0x1000; offset += out.size()) {
+        cached->Read(out.data(), out.size(), offset);
+    }
+    REQUIRE(cached->GetNumBackingReads() == 2);
+}
+
+TEST_CASE("CachedVfsFile[Write]", "[core][file_sys]") {
+    const auto base = std::make_shared<VectorVfsFile>(MakeData(0x1000));
+    const auto cached = std::make_shared<CachedVfsFile>(base, 0x100, 4, 0);
+    REQUIRE(cached->ReadBytes(0x10, 0x180).size() == 0x10);
+
+    const std::vector<u8> patch(0x20, 0xAB);
+    REQUIRE(cached->WriteBytes(patch, 0x170) == patch.size());
+    REQUIRE(cached->ReadBytes(0x20, 0x170) == patch);
+    REQUIRE(base->ReadBytes(0x20, 0x170) == patch);
+}
+
+/**
+ * Reads the files of a synthetic encrypted RomFS with and without a block cache under the RomFS,
+ * reporting throughput for sequential and random access patterns.
+ */
+TEST_CASE("CachedVfsFile[Benchmark]", "[core][file_sys][.benchmark]") {
+    constexpr std::size_t MAX_FILE_SIZE = 0x40000;
+    constexpr std::size_t NUM_RANDOM_READS = 20000;
+    const std::size_t num_files = 512;
+    const VirtualFile encrypted = MakeEncryptedRomFS(num_files, MAX_FILE_SIZE);
+
+    const auto Measure = [num_files](const VirtualFile& romfs_file, bool random) {
+        const auto files = ExtractRomFS(romfs_file)->GetFiles();
+        REQUIRE(files.size() == num_files);
+        std::mt19937 rng(1234);
+        std::vector<u8> buffer(0x10000);
+        std::size_t bytes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        if (random) {
+            // Small unaligned reads of random files, like games streaming assets
+            std::uniform_int_distribution<std::size_t> file_dist(0, files.size() - 1);
+            std::uniform_int_distribution<std::size_t> length_dist(0x20, 0x2000);
+            for (std::size_t i = 0; i < NUM_RANDOM_READS; ++i) {
+                const auto& file = files[file_dist(rng)];
+                const std::size_t offset = rng() % file->GetSize();
+                bytes += file->Read(buffer.data(), length_dist(rng), offset);
+            }
+        } else {
+            for (const auto& file : files) {
+                for (std::size_t offset = 0; offset < file->GetSize(); offset += 0x1000) {
+                    bytes += file->Read(buffer.data(), 0x1000, offset);
+                }
+            }
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return bytes / elapsed.count() / (1024.0 * 1024.0);
+    };
+    const auto Cached = [&encrypted] { return std::make_shared<CachedVfsFile>(encrypted); };
+
+    fmt::print("RomFS of {:.1f} MiB, sequential: {:.1f} MiB/s uncached, {:.1f} MiB/s cached\n",
+               encrypted->GetSize() / (1024.0 * 1024.0), Measure(encrypted, false),
+               Measure(Cached(), false));
+    fmt::print("RomFS of {:.1f} MiB, random: {:.1f} MiB/s uncached, {:.1f} MiB/s cached\n",
+               encrypted->GetSize() / (1024.0 * 1024.0), Measure(encrypted, true),
+               Measure(Cached(), true));
+}
+
+} // namespace FileSys
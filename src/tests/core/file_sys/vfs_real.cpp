@@ -0,0 +1,154 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "core/file_sys/mode.h"
+#include "core/file_sys/vfs_offset.h"
+#include "core/file_sys/vfs_real.h"
+
+namespace FileSys {
+namespace {
+
+constexpr char TEST_FILE[] = "vfs_real_test.bin";
+
+std::vector<u8> MakeData(std::size_t size) {
+    std::vector<u8> data(size);
+    std::mt19937 rng(size);
+    std::generate(data.begin(), data.end(), [&rng] { return static_cast<u8>(rng()); });
+    return data;
+}
+
+void CreateTestFile(RealVfsFilesystem& vfs, const std::vector<u8>& data) {
+    const auto file = vfs.CreateFile(TEST_FILE, Mode::ReadWrite);
+    REQUIRE(file != nullptr);
+    REQUIRE(file->Resize(0));
+    REQUIRE(file->WriteBytes(data) == data.size());
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MappedVfsFile[Read]", "[core][file_sys]") {
+    RealVfsFilesystem vfs;
+    const std::vector<u8> data = MakeData(0x12345);
+    CreateTestFile(vfs, data);
+
+    {
+        // Read-only opens are mapped
+        const auto file = vfs.OpenFile(TEST_FILE, Mode::Read);
+        REQUIRE(std::dynamic_pointer_cast<MappedVfsFile>(file) != nullptr);
+        REQUIRE(file->GetName() == TEST_FILE);
+        REQUIRE(file->GetSize() == data.size());
+        REQUIRE(!file->IsWritable());
+        REQUIRE(file->WriteBytes(std::vector<u8>(0x10)) == 0);
+
+        REQUIRE(file->ReadAllBytes() == data);
+        REQUIRE(file->ReadBytes(0x100, data.size() - 0x10).size() == 0x10);
+        REQUIRE(file->ReadBytes(0x10, data.size()).empty());
+
+        const u8* const view = file->GetDataView(data.size());
+        REQUIRE(view != nullptr);
+        REQUIRE(std::equal(data.begin(), data.end(), view));
+        REQUIRE(file->GetDataView(0x10, data.size() - 0x8) == nullptr);
+
+        // Views are forwarded through offset files
+        const OffsetVfsFile offset_file(file, 0x1000, 0x2000);
+        REQUIRE(offset_file.GetDataView(0x1000, 0) == view + 0x2000);
+        REQUIRE(offset_file.GetDataView(0x1001, 0) == nullptr);
+    }
+
+    // Writable opens still go through stdio
+    const auto writable = vfs.OpenFile(TEST_FILE, Mode::ReadWrite);
+    REQUIRE(std::dynamic_pointer_cast<MappedVfsFile>(writable) == nullptr);
+    REQUIRE(writable->GetDataView(0x10) == nullptr);
+    REQUIRE(writable->ReadAllBytes() == data);
+}
+
+TEST_CASE("MappedVfsFile[Delete]", "[core][file_sys]") {
+    RealVfsFilesystem vfs;
+    CreateTestFile(vfs, MakeData(0x1000));
+    REQUIRE(vfs.OpenFile(TEST_FILE, Mode::Read)->ReadAllBytes() == MakeData(0x1000));
+    REQUIRE(vfs.DeleteFile(TEST_FILE));
+    REQUIRE(vfs.GetEntryType(TEST_FILE) == VfsEntryType::None);
+
+    // A new file at the same path is mapped again
+    CreateTestFile(vfs, MakeData(0x800));
+    REQUIRE(vfs.OpenFile(TEST_FILE, Mode::Read)->ReadAllBytes() == MakeData(0x800));
+    REQUIRE(vfs.DeleteFile(TEST_FILE));
+}
+
+TEST_CASE("MappedVfsFile[Write]", "[core][file_sys]") {
+    RealVfsFilesystem vfs;
+    CreateTestFile(vfs, MakeData(0x2000));
+    const auto mapped = vfs.OpenFile(TEST_FILE, Mode::Read);
+    REQUIRE(std::dynamic_pointer_cast<MappedVfsFile>(mapped) != nullptr);
+
+    {
+        // Files open for writing aren't mapped, reads see the writes
+        const auto writable = vfs.OpenFile(TEST_FILE, Mode::ReadWrite);
+        REQUIRE(writable->Resize(0x1000));
+        const auto file = vfs.OpenFile(TEST_FILE, Mode::Read);
+        REQUIRE(std::dynamic_pointer_cast<MappedVfsFile>(file) == nullptr);
+        REQUIRE(file->GetSize() == 0x1000);
+    }
+
+    // The writable open dropped the old mapping, the file is mapped again at its new size
+    const auto remapped = vfs.OpenFile(TEST_FILE, Mode::Read);
+    REQUIRE(std::dynamic_pointer_cast<MappedVfsFile>(remapped) != nullptr);
+    REQUIRE(remapped->GetDataView(0x1000) != mapped->GetDataView(0x1000));
+    REQUIRE(remapped->GetSize() == 0x1000);
+
+    // Mappings of files resized outside of the VFS aren't reused either
+    {
+        RealVfsFilesystem other_vfs;
+        const auto writable = other_vfs.OpenFile(TEST_FILE, Mode::ReadWrite);
+        REQUIRE(writable->Resize(0x800));
+    }
+    const auto resized = vfs.OpenFile(TEST_FILE, Mode::Read);
+    REQUIRE(std::dynamic_pointer_cast<MappedVfsFile>(resized) != nullptr);
+    REQUIRE(resized->GetSize() == 0x800);
+    const std::vector<u8> data = MakeData(0x2000);
+    REQUIRE(resized->ReadAllBytes() == std::vector<u8>(data.begin(), data.begin() + 0x800));
+}
+
+/// Compares small random reads of a read-only (mapped) file to the same reads through stdio.
+TEST_CASE("MappedVfsFile[Benchmark]", "[core][file_sys][.benchmark]") {
+    constexpr std::size_t FILE_SIZE = 0x4000000;
+    constexpr std::size_t NUM_READS = 200000;
+    RealVfsFilesystem vfs;
+    CreateTestFile(vfs, MakeData(FILE_SIZE));
+
+    const auto Measure = [&vfs](Mode mode) {
+        const auto file = vfs.OpenFile(TEST_FILE, mode);
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<std::size_t> offset_dist(0, FILE_SIZE - 1);
+        std::uniform_int_distribution<std::size_t> length_dist(0x10, 0x1000);
+        std::vector<u8> buffer(0x1000);
+        std::size_t bytes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < NUM_READS; ++i) {
+            bytes += file->Read(buffer.data(), length_dist(rng), offset_dist(rng));
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return bytes / elapsed.count() / (1024.0 * 1024.0);
+    };
+    const double stdio = Measure(Mode::ReadWrite);
+    const double mapped = Measure(Mode::Read);
+    REQUIRE(vfs.DeleteFile(TEST_FILE));
+
+    fmt::print("{} random reads: stdio {:.1f} MiB/s, mapped {:.1f} MiB/s\n", NUM_READS, stdio,
+               mapped);
+}
+
+} // namespace FileSys
@@ -0,0 +1,203 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/hle/kernel/address_wait_queue.h"
+#include "core/hle/kernel/thread.h"
+#include "tests/allocation_counter.h"
+
+namespace Kernel {
+namespace {
+
+std::vector<std::shared_ptr<Thread>> MakeThreads(const std::vector<u32>& priorities) {
+    auto& kernel = Core::System::GetInstance().Kernel();
+    std::vector<std::shared_ptr<Thread>> threads;
+    for (const u32 priority : priorities) {
+        auto thread = std::make_shared<Thread>(kernel);
+        thread->SetPriority(priority);
+        threads.push_back(std::move(thread));
+    }
+    return threads;
+}
+
+std::vector<std::shared_ptr<Thread>> MakeThreads(std::size_t count) {
+    return MakeThreads(std::vector<u32>(count, THREADPRIO_DEFAULT));
+}
+
+/// Signals every thread waiting on an address, returning them in the order they were signaled.
+std::vector<Thread*> SignalAll(AddressWaitQueue& queue, VAddr address) {
+    std::vector<Thread*> signaled;
+    while (Thread* const thread = queue.Front(address)) {
+        queue.Remove(address, thread);
+        signaled.push_back(thread);
+    }
+    return signaled;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("AddressWaitQueue[Order]", "[core][kernel]") {
+    constexpr VAddr address = 0x1000;
+    const auto threads = MakeThreads({44, 30, 44, 50, 30});
+
+    SECTION("FIFO among equal priorities") {
+        AddressWaitQueue queue{AddressWaitQueue::TieOrder::Fifo};
+        for (const auto& thread : threads) {
+            queue.Insert(address, thread.get());
+        }
+        REQUIRE(queue.Count(address) == threads.size());
+        REQUIRE(SignalAll(queue, address) ==
+                std::vector<Thread*>{threads[1].get(), threads[4].get(), threads[0].get(),
+                                     threads[2].get(), threads[3].get()});
+    }
+
+    SECTION("LIFO among equal priorities") {
+        AddressWaitQueue queue{AddressWaitQueue::TieOrder::Lifo};
+        for (const auto& thread : threads) {
+            queue.Insert(address, thread.get());
+        }
+        REQUIRE(SignalAll(queue, address) ==
+                std::vector<Thread*>{threads[4].get(), threads[1].get(), threads[2].get(),
+                                     threads[0].get(), threads[3].get()});
+    }
+}
+
+TEST_CASE("AddressWaitQueue[Remove]", "[core][kernel]") {
+    constexpr VAddr address = 0x2000;
+    const auto threads = MakeThreads(4);
+    AddressWaitQueue queue{AddressWaitQueue::TieOrder::Fifo};
+    for (const auto& thread : threads) {
+        queue.Insert(address, thread.get());
+    }
+
+    // Waits can time out anywhere in the queue
+    queue.Remove(address, threads[2].get());
+    queue.Remove(address, threads[0].get());
+    REQUIRE(queue.Count(address) == 2);
+    REQUIRE(queue.Front(address) == threads[1].get());
+
+    queue.Remove(address, threads[3].get());
+    queue.Remove(address, threads[1].get());
+    REQUIRE(queue.Count(address) == 0);
+    REQUIRE(queue.Front(address) == nullptr);
+    REQUIRE(queue.NumAddresses() == 0);
+}
+
+TEST_CASE("AddressWaitQueue[Addresses]", "[core][kernel]") {
+    // Clustered addresses and addresses a page apart, as mutexes and condition variables would be
+    constexpr std::size_t num_threads = 1024;
+    const auto threads = MakeThreads(num_threads);
+    std::vector<VAddr> addresses;
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        addresses.push_back(i % 2 == 0 ? 0x10000000 + i * 4 : 0x20000000 + i * 0x1000);
+    }
+
+    AddressWaitQueue queue{AddressWaitQueue::TieOrder::Fifo};
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        queue.Insert(addresses[i], threads[i].get());
+    }
+    REQUIRE(queue.NumAddresses() == num_threads);
+
+    std::vector<std::size_t> order(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937{1234});
+
+    // Every address stays reachable while others are dropped from the table
+    std::vector<bool> waiting(num_threads, true);
+    for (std::size_t removed = 0; removed < num_threads; ++removed) {
+        const std::size_t index = order[removed];
+        queue.Remove(addresses[index], threads[index].get());
+        waiting[index] = false;
+        if (removed % 64 != 0) {
+            continue;
+        }
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            REQUIRE(queue.Front(addresses[i]) == (waiting[i] ? threads[i].get() : nullptr));
+        }
+    }
+    REQUIRE(queue.NumAddresses() == 0);
+}
+
+TEST_CASE("AddressWaitQueue[Allocations]", "[core][kernel]") {
+    constexpr std::size_t num_threads = 64;
+    const auto threads = MakeThreads(num_threads);
+    AddressWaitQueue queue{AddressWaitQueue::TieOrder::Fifo};
+
+    const auto wait_and_signal = [&] {
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            queue.Insert(0x1000 + (i % 8) * 4, threads[i].get());
+        }
+        std::size_t signaled = 0;
+        for (VAddr address = 0x1000; address < 0x1000 + 8 * 4; address += 4) {
+            while (Thread* const thread = queue.Front(address)) {
+                queue.Remove(address, thread);
+                ++signaled;
+            }
+        }
+        return signaled;
+    };
+
+    // The first waits size the table, waiting and signaling afterwards must not allocate
+    REQUIRE(wait_and_signal() == num_threads);
+    const u64 allocations_before = Tests::GetNumAllocations();
+    std::size_t signaled = 0;
+    for (int round = 0; round < 100; ++round) {
+        signaled += wait_and_signal();
+    }
+    REQUIRE(Tests::GetNumAllocations() == allocations_before);
+    REQUIRE(signaled == num_threads * 100);
+}
+
+TEST_CASE("AddressWaitQueue[Benchmark]", "[core][kernel][.benchmark]") {
+    // Many threads of mixed priorities parked on a few condition variables and all woken again
+    constexpr std::size_t num_threads = 256;
+    constexpr std::size_t num_addresses = 16;
+    constexpr int num_rounds = 20000;
+
+    std::vector<u32> priorities;
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        priorities.push_back(static_cast<u32>(THREADPRIO_USERLAND_MAX + i % 16));
+    }
+    const auto threads = MakeThreads(priorities);
+    AddressWaitQueue queue{AddressWaitQueue::TieOrder::Fifo};
+
+    u64 num_signals = 0;
+    const u64 allocations_before = Tests::GetNumAllocations();
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < num_rounds; ++round) {
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            queue.Insert(0x80000000 + (i % num_addresses) * 0x40, threads[i].get());
+        }
+        for (std::size_t i = 0; i < num_addresses; ++i) {
+            // Wake waiters one at a time as SignalProcessWideKey does, until none is left
+            const VAddr address = 0x80000000 + i * 0x40;
+            while (Thread* const thread = queue.Front(address)) {
+                queue.Remove(address, thread);
+                ++num_signals;
+            }
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const u64 allocations = Tests::GetNumAllocations() - allocations_before;
+
+    REQUIRE(num_signals == num_threads * num_rounds);
+    fmt::print("AddressWaitQueue: {:.2f} Mwaits+signals/s, {:.3f} allocations/signal\n",
+               num_signals / elapsed.count() / 1e6,
+               static_cast<double>(allocations) / num_signals);
+}
+
+} // namespace Kernel
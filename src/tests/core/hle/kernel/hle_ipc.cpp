@@ -0,0 +1,416 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/assert.h"
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/span.h"
+#include "core/core.h"
+#include "core/file_sys/program_metadata.h"
+#include "core/hle/ipc.h"
+#include "core/hle/ipc_helpers.h"
+#include "core/hle/kernel/client_session.h"
+#include "core/hle/kernel/handle_table.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/physical_memory.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/server_session.h"
+#include "core/hle/kernel/session.h"
+#include "core/hle/kernel/thread.h"
+#include "core/hle/kernel/vm_manager.h"
+#include "core/hle/lock.h"
+#include "core/hle/service/service.h"
+#include "core/memory.h"
+#include "tests/allocation_counter.h"
+
+namespace Kernel {
+namespace {
+
+class TestService final : public Service::ServiceFramework<TestService> {
+public:
+    TestService() : ServiceFramework{"test"} {
+        static const FunctionInfo functions[] = {
+            {0, &TestService::Increment, "Increment"},
+            {1, &TestService::IncrementBuffer, "IncrementBuffer"},
+            {2, &TestService::IncrementBufferCopy, "IncrementBufferCopy"},
+        };
+        RegisterHandlers(functions);
+    }
+
+    /// Views of the buffers the last IncrementBuffer request accessed.
+    Common::Span<const u8> input;
+    Common::Span<u8> output;
+
+private:
+    void Increment(HLERequestContext& ctx) {
+        IPC::RequestParser rp{ctx};
+        const u32 value = rp.Pop<u32>();
+
+        IPC::ResponseBuilder rb{ctx, 3};
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(value + 1);
+    }
+
+    /// Writes each byte of the A buffer plus one to the B buffer, accessing both in place.
+    void IncrementBuffer(HLERequestContext& ctx) {
+        input = ctx.ReadBufferSpan();
+        output = ctx.WriteBufferSpan();
+        std::transform(input.begin(), input.end(), output.begin(),
+                       [](u8 byte) { return static_cast<u8>(byte + 1); });
+
+        IPC::ResponseBuilder rb{ctx, 2};
+        rb.Push(RESULT_SUCCESS);
+    }
+
+    /// Same as IncrementBuffer, but copies the buffers as ReadBuffer and WriteBuffer do.
+    void IncrementBufferCopy(HLERequestContext& ctx) {
+        std::vector<u8> buffer = ctx.ReadBuffer();
+        for (u8& byte : buffer) {
+            ++byte;
+        }
+        ctx.WriteBuffer(buffer);
+
+        IPC::ResponseBuilder rb{ctx, 2};
+        rb.Push(RESULT_SUCCESS);
+    }
+};
+
+enum class Command : u32 {
+    Increment = 0,
+    IncrementBuffer = 1,
+    IncrementBufferCopy = 2,
+};
+
+/// A guest buffer in the memory of the process that issues the requests.
+struct Buffer {
+    VAddr address = 0;
+    u64 size = 0;
+};
+
+using CommandBuffer = std::array<u32, IPC::COMMAND_BUFFER_LENGTH>;
+
+IPC::BufferDescriptorABW MakeBufferDescriptor(const Buffer& buffer) {
+    IPC::BufferDescriptorABW descriptor{};
+    descriptor.size_bits_0_31 = static_cast<u32>(buffer.size);
+    descriptor.address_bits_0_31 = static_cast<u32>(buffer.address);
+    descriptor.address_bits_32_35.Assign(static_cast<u32>(buffer.address >> 32) & 0xF);
+    descriptor.address_bits_36_38.Assign(static_cast<u32>(buffer.address >> 36) & 0x7);
+    return descriptor;
+}
+
+/// Builds a request to TestService with an A and a B buffer, as a guest would in its TLS.
+CommandBuffer MakeRequest(Command command, u32 value, const Buffer& input = {},
+                          const Buffer& output = {}) {
+    CommandBuffer cmd_buf{};
+    IPC::CommandHeader header{};
+    header.type.Assign(IPC::CommandType::Request);
+    header.num_buf_a_descriptors.Assign(1);
+    header.num_buf_b_descriptors.Assign(1);
+    // Padding, payload header, command id and the value
+    header.data_size.Assign(4 + 2 + 2 + 1);
+    std::memcpy(cmd_buf.data(), &header, sizeof(header));
+
+    // The buffer descriptors take words 2 to 7, which keeps the payload aligned to 16 bytes
+    const IPC::BufferDescriptorABW descriptors[] = {MakeBufferDescriptor(input),
+                                                    MakeBufferDescriptor(output)};
+    std::memcpy(&cmd_buf[2], descriptors, sizeof(descriptors));
+    cmd_buf[8] = Common::MakeMagic('S', 'F', 'C', 'I');
+    cmd_buf[10] = static_cast<u32>(command);
+    cmd_buf[12] = value;
+    return cmd_buf;
+}
+
+/// Offset in words of the value in the response to TestService::Increment.
+constexpr std::size_t RESPONSE_VALUE_OFFSET = 8;
+
+/**
+ * A guest process with a thread that issues requests, so that request buffers can be mapped in the
+ * current process. Only the cores and the kernel are brought up, and torn down again on exit.
+ */
+struct GuestProcess {
+    GuestProcess() {
+        system.InitCpuCores();
+        auto& kernel = system.Kernel();
+
+        process = Process::Create(system, "", Process::ProcessType::Userland);
+        auto& vm_manager = process->VMManager();
+        vm_manager.Reset(FileSys::ProgramAddressSpaceType::Is39Bit);
+        const VAddr entry_point = vm_manager.GetCodeRegionBaseAddress();
+        ASSERT(vm_manager
+                   .MapMemoryBlock(entry_point,
+                                   std::make_shared<PhysicalMemory>(Memory::PAGE_SIZE), 0,
+                                   Memory::PAGE_SIZE, MemoryState::Code)
+                   .Succeeded());
+        kernel.MakeCurrentProcess(process.get());
+        next_buffer_address = vm_manager.GetMapRegionBaseAddress();
+
+        thread = Thread::Create(kernel, "", entry_point, THREADPRIO_USERLAND_MAX, 0, 0, 0,
+                                *process)
+                     .Unwrap();
+        // The thread never runs, a paused thread is woken from its requests without being queued
+        // on a core
+        thread->SetActivity(ThreadActivity::Paused);
+    }
+
+    ~GuestProcess() {
+        thread.reset();
+        process.reset();
+        system.ShutdownCpuCores();
+    }
+
+    /**
+     * Maps a buffer of the given size that starts in the middle of a page. When split, its pages
+     * are backed in reverse order, so it is contiguous in guest memory but not in host memory.
+     */
+    Buffer MapBuffer(u64 size, bool split) {
+        const u64 num_pages = size / Memory::PAGE_SIZE + 2;
+        const auto block = std::make_shared<PhysicalMemory>(num_pages * Memory::PAGE_SIZE);
+        for (u64 page = 0; page < num_pages; ++page) {
+            const u64 offset = (split ? num_pages - 1 - page : page) * Memory::PAGE_SIZE;
+            REQUIRE(process->VMManager()
+                        .MapMemoryBlock(next_buffer_address + page * Memory::PAGE_SIZE, block,
+                                        offset, Memory::PAGE_SIZE, MemoryState::Heap)
+                        .Succeeded());
+        }
+        const Buffer buffer{next_buffer_address + Memory::PAGE_SIZE / 2, size};
+        next_buffer_address += num_pages * Memory::PAGE_SIZE;
+        return buffer;
+    }
+
+    std::vector<u8> Read(const Buffer& buffer) const {
+        std::vector<u8> data(buffer.size);
+        system.Memory().ReadBlock(buffer.address, data.data(), data.size());
+        return data;
+    }
+
+    void Write(const Buffer& buffer, const std::vector<u8>& data) {
+        system.Memory().WriteBlock(buffer.address, data.data(), data.size());
+    }
+
+    Core::System& system = Core::System::GetInstance();
+    std::shared_ptr<Process> process;
+    std::shared_ptr<Thread> thread;
+    VAddr next_buffer_address = 0;
+};
+
+/// Returns the given number of bytes counting up from the given value.
+std::vector<u8> MakeData(std::size_t size, u8 first) {
+    std::vector<u8> data(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<u8>(first + i);
+    }
+    return data;
+}
+
+/// Ticks after which a server session completes a request, see ServerSession::QueueSyncRequest.
+constexpr u64 REQUEST_TICKS = 20000;
+
+struct RequestStats {
+    double requests_per_second;
+    double allocations_per_request;
+    u64 num_errors;
+};
+
+/**
+ * Issues requests to TestService::Increment through a server session as svcSendSyncRequest does,
+ * and completes them by advancing the time past the request event of the session.
+ */
+RequestStats MeasureRequests(GuestProcess& guest, ServerSession& session, u64 num_requests) {
+    auto& memory = guest.system.Memory();
+    auto& core_timing = guest.system.CoreTiming();
+    Thread& thread = *guest.thread;
+    CommandBuffer cmd_buf;
+    u64 num_errors = 0;
+
+    const u64 allocations_before = Tests::GetNumAllocations();
+    const auto start = std::chrono::steady_clock::now();
+    for (u64 i = 0; i < num_requests; ++i) {
+        const u32 value = static_cast<u32>(i);
+        cmd_buf = MakeRequest(Command::Increment, value);
+        memory.WriteBlock(thread.GetTLSAddress(), cmd_buf.data(), sizeof(cmd_buf));
+
+        core_timing.ResetRun();
+        {
+            std::lock_guard lock{HLE::g_hle_lock};
+            thread.SetStatus(ThreadStatus::WaitIPC);
+            session.HandleSyncRequest(guest.thread, memory);
+        }
+        core_timing.AddTicks(REQUEST_TICKS);
+        core_timing.Advance();
+
+        memory.ReadBlock(thread.GetTLSAddress(), cmd_buf.data(), sizeof(cmd_buf));
+        if (thread.GetStatus() != ThreadStatus::Paused ||
+            cmd_buf[RESPONSE_VALUE_OFFSET] != value + 1) {
+            ++num_errors;
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const u64 allocations = Tests::GetNumAllocations() - allocations_before;
+
+    return {
+        static_cast<double>(num_requests) / elapsed.count(),
+        static_cast<double>(allocations) / num_requests,
+        num_errors,
+    };
+}
+
+struct BufferRequestStats {
+    double requests_per_second;
+    double allocations_per_request;
+};
+
+/// Issues requests that access an input and an output buffer through a recycled context.
+BufferRequestStats MeasureBufferRequests(GuestProcess& guest, TestService& service,
+                                         const std::shared_ptr<ServerSession>& session,
+                                         Command command, const Buffer& input,
+                                         const Buffer& output, u64 num_requests) {
+    CommandBuffer cmd_buf = MakeRequest(command, 0, input, output);
+    auto context = std::make_shared<HLERequestContext>(session, guest.thread);
+
+    const u64 allocations_before = Tests::GetNumAllocations();
+    const auto start = std::chrono::steady_clock::now();
+    for (u64 i = 0; i < num_requests; ++i) {
+        context->Reset(session, guest.thread);
+        context->PopulateFromIncomingCommandBuffer(guest.process->GetHandleTable(),
+                                                   cmd_buf.data());
+        service.HandleSyncRequest(*context);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const u64 allocations = Tests::GetNumAllocations() - allocations_before;
+
+    return {
+        static_cast<double>(num_requests) / elapsed.count(),
+        static_cast<double>(allocations) / num_requests,
+    };
+}
+
+} // Anonymous namespace
+
+TEST_CASE("HLERequestContext[Allocations]", "[core][kernel]") {
+    GuestProcess guest;
+    const auto service = std::make_shared<TestService>();
+    const auto [client, server] = Session::Create(guest.system.Kernel(), "test");
+    service->ClientConnected(server);
+
+    // Once the session has pooled a context and the queues have grown, requests are parsed,
+    // queued, handled and answered without touching the heap
+    REQUIRE(MeasureRequests(guest, *server, 16).num_errors == 0);
+    const RequestStats stats = MeasureRequests(guest, *server, 1000);
+    REQUIRE(stats.num_errors == 0);
+    REQUIRE(stats.allocations_per_request == 0.0);
+}
+
+TEST_CASE("HLERequestContext[InPlaceBuffers]", "[core][kernel]") {
+    constexpr u64 size = 2 * Memory::PAGE_SIZE;
+    GuestProcess guest;
+    auto& memory = guest.system.Memory();
+    const auto service = std::make_shared<TestService>();
+    const auto [client, server] = Session::Create(guest.system.Kernel(), "test");
+    service->ClientConnected(server);
+
+    const Buffer input = guest.MapBuffer(size, false);
+    const Buffer output = guest.MapBuffer(size, false);
+    guest.Write(input, MakeData(size, 0));
+
+    CommandBuffer cmd_buf = MakeRequest(Command::IncrementBuffer, 0, input, output);
+    HLERequestContext context{server, guest.thread};
+    context.PopulateFromIncomingCommandBuffer(guest.process->GetHandleTable(), cmd_buf.data());
+    service->InvokeRequest(context);
+
+    // Buffers contiguous in host memory are handed to the handler as they are
+    REQUIRE(service->input.data() == memory.GetPointer(input.address));
+    REQUIRE(service->output.data() == memory.GetPointer(output.address));
+    REQUIRE(service->output.size() == size);
+    REQUIRE(guest.Read(output) == MakeData(size, 1));
+
+    REQUIRE(context.WriteToOutgoingCommandBuffer(*guest.thread) == RESULT_SUCCESS);
+    REQUIRE(guest.Read(output) == MakeData(size, 1));
+}
+
+TEST_CASE("HLERequestContext[ScratchBuffers]", "[core][kernel]") {
+    constexpr u64 size = 2 * Memory::PAGE_SIZE;
+    GuestProcess guest;
+    auto& memory = guest.system.Memory();
+    const auto service = std::make_shared<TestService>();
+    const auto [client, server] = Session::Create(guest.system.Kernel(), "test");
+    service->ClientConnected(server);
+
+    const Buffer input = guest.MapBuffer(size, true);
+    const Buffer output = guest.MapBuffer(size, true);
+    guest.Write(input, MakeData(size, 0));
+    guest.Write(output, MakeData(size, 0x80));
+    REQUIRE(memory.GetContiguousPointer(input.address, size) == nullptr);
+
+    CommandBuffer cmd_buf = MakeRequest(Command::IncrementBuffer, 0, input, output);
+    HLERequestContext context{server, guest.thread};
+    context.PopulateFromIncomingCommandBuffer(guest.process->GetHandleTable(), cmd_buf.data());
+    service->InvokeRequest(context);
+
+    // Split buffers are accessed through scratch copies, the output is only written back to the
+    // guest along with the response
+    REQUIRE(service->input.data() != memory.GetPointer(input.address));
+    REQUIRE(service->output.data() != memory.GetPointer(output.address));
+    REQUIRE(service->output.size() == size);
+    REQUIRE(guest.Read(output) == MakeData(size, 0x80));
+
+    REQUIRE(context.WriteToOutgoingCommandBuffer(*guest.thread) == RESULT_SUCCESS);
+    REQUIRE(guest.Read(output) == MakeData(size, 1));
+    REQUIRE(guest.Read(input) == MakeData(size, 0));
+}
+
+TEST_CASE("HLERequestContext[Benchmark]", "[core][kernel][.benchmark]") {
+    constexpr u64 num_requests = 1 << 20;
+    GuestProcess guest;
+    const auto service = std::make_shared<TestService>();
+    const auto [client, server] = Session::Create(guest.system.Kernel(), "test");
+    service->ClientConnected(server);
+
+    const RequestStats stats = MeasureRequests(guest, *server, num_requests);
+    REQUIRE(stats.num_errors == 0);
+    fmt::print("Session requests: {:8.2f} Kreq/s, {:.2f} allocations/req\n",
+               stats.requests_per_second / 1e3, stats.allocations_per_request);
+}
+
+TEST_CASE("HLERequestContext[BufferBenchmark]", "[core][kernel][.benchmark]") {
+    constexpr u64 num_requests = 1 << 16;
+    GuestProcess guest;
+    const auto service = std::make_shared<TestService>();
+    const auto [client, server] = Session::Create(guest.system.Kernel(), "test");
+    service->ClientConnected(server);
+
+    for (const u64 size : {0x40, 0x1000, 0x10000}) {
+        for (const bool split : {false, true}) {
+            const Buffer input = guest.MapBuffer(size, split);
+            const Buffer output = guest.MapBuffer(size, split);
+            guest.Write(input, MakeData(size, 0));
+
+            for (const Command command : {Command::IncrementBufferCopy, Command::IncrementBuffer}) {
+                const BufferRequestStats stats = MeasureBufferRequests(
+                    guest, *service, server, command, input, output, num_requests);
+                REQUIRE(guest.Read(output) == MakeData(size, 1));
+                fmt::print("{:>5} byte {:>5} buffers, {:>6}: {:8.2f} Kreq/s, "
+                           "{:.2f} allocations/req\n",
+                           size, split ? "split" : "whole",
+                           command == Command::IncrementBuffer ? "Spans" : "Copies",
+                           stats.requests_per_second / 1e3, stats.allocations_per_request);
+                guest.Write(output, std::vector<u8>(size));
+            }
+        }
+    }
+}
+
+} // namespace Kernel
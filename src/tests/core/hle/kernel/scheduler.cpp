@@ -0,0 +1,147 @@
+// Copyright 2019 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/scope_exit.h"
+#include "core/core.h"
+#include "core/core_cpu.h"
+#include "core/core_timing.h"
+#include "core/file_sys/program_metadata.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/physical_memory.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/scheduler.h"
+#include "core/hle/kernel/thread.h"
+#include "core/hle/kernel/vm_manager.h"
+#include "core/hle/lock.h"
+#include "core/memory.h"
+#include "core/settings.h"
+
+namespace Kernel {
+
+TEST_CASE("Scheduler[MultiCoreReschedule]", "[core][kernel]") {
+    // Every core reschedules in a tight loop on its own host thread while another host thread
+    // puts threads to sleep, wakes them and changes their priorities as SVCs would.
+    constexpr std::size_t num_threads_per_core = 4;
+    constexpr int num_reschedules = 20000;
+    constexpr int num_operations = 20000;
+
+    auto& system = Core::System::GetInstance();
+    const bool use_multi_core = Settings::values.use_multi_core;
+    Settings::values.use_multi_core = true;
+    system.InitCpuCores();
+    SCOPE_EXIT({
+        system.ShutdownCpuCores();
+        Settings::values.use_multi_core = use_multi_core;
+    });
+    auto& kernel = system.Kernel();
+
+    auto process = Process::Create(system, "", Process::ProcessType::Userland);
+    auto& vm_manager = process->VMManager();
+    vm_manager.Reset(FileSys::ProgramAddressSpaceType::Is39Bit);
+    const VAddr entry_point = vm_manager.GetCodeRegionBaseAddress();
+    REQUIRE(vm_manager
+                .MapMemoryBlock(entry_point, std::make_shared<PhysicalMemory>(Memory::PAGE_SIZE),
+                                0, Memory::PAGE_SIZE, MemoryState::Code)
+                .Succeeded());
+    kernel.MakeCurrentProcess(process.get());
+
+    std::vector<std::shared_ptr<Thread>> threads;
+    for (std::size_t i = 0; i < GlobalScheduler::NUM_CPU_CORES * num_threads_per_core; ++i) {
+        const auto core = static_cast<s32>(i % GlobalScheduler::NUM_CPU_CORES);
+        auto thread = Thread::Create(kernel, "", entry_point, THREADPRIO_USERLAND_MAX, 0, core,
+                                     0, *process);
+        REQUIRE(thread.Succeeded());
+        std::lock_guard lock{HLE::g_hle_lock};
+        (*thread)->SetStatus(ThreadStatus::Ready);
+        threads.push_back(std::move(*thread));
+    }
+
+    std::vector<std::thread> cores;
+    for (std::size_t core = 0; core < GlobalScheduler::NUM_CPU_CORES; ++core) {
+        cores.emplace_back([&system, core] {
+            system.CoreTiming().SwitchContext(core);
+            for (int i = 0; i < num_reschedules; ++i) {
+                system.CoreTiming().AddTicks(1000);
+                system.CpuCore(core).Reschedule();
+            }
+        });
+    }
+
+    std::mt19937 rng{1234};
+    std::uniform_int_distribution<std::size_t> thread_distribution(0, threads.size() - 1);
+    std::uniform_int_distribution<u32> priority_distribution(THREADPRIO_USERLAND_MAX,
+                                                             THREADPRIO_USERLAND_MAX + 3);
+    for (int i = 0; i < num_operations; ++i) {
+        std::lock_guard lock{HLE::g_hle_lock};
+        Thread& thread = *threads[thread_distribution(rng)];
+        switch (thread.GetStatus()) {
+        case ThreadStatus::Ready:
+        case ThreadStatus::Running:
+            thread.SetStatus(ThreadStatus::WaitSleep);
+            thread.WakeAfterDelay(1000000);
+            break;
+        case ThreadStatus::WaitSleep:
+            // Threads only wake up once their core has switched away from them
+            if (!thread.IsRunning()) {
+                thread.ResumeFromWait();
+            }
+            break;
+        default:
+            break;
+        }
+        thread.SetPriority(priority_distribution(rng));
+        system.PrepareReschedule(static_cast<u32>(thread.GetProcessorID()));
+    }
+
+    for (auto& core : cores) {
+        core.join();
+    }
+
+    std::lock_guard lock{HLE::g_hle_lock};
+    std::array<Thread*, GlobalScheduler::NUM_CPU_CORES> current_threads{};
+    for (std::size_t core = 0; core < GlobalScheduler::NUM_CPU_CORES; ++core) {
+        system.CoreTiming().SwitchContext(core);
+        system.CpuCore(core).Reschedule();
+        current_threads[core] = system.Scheduler(core).GetCurrentThread();
+    }
+    system.CoreTiming().SwitchContext(0);
+
+    // Each core runs one of its own threads, and only threads that a core runs are running
+    for (std::size_t core = 0; core < GlobalScheduler::NUM_CPU_CORES; ++core) {
+        Thread* const current = current_threads[core];
+        if (current != nullptr) {
+            REQUIRE(current->GetProcessorID() == static_cast<s32>(core));
+            REQUIRE(current->GetStatus() == ThreadStatus::Running);
+        }
+    }
+    for (const auto& thread : threads) {
+        const bool is_current = std::find(current_threads.begin(), current_threads.end(),
+                                          thread.get()) != current_threads.end();
+        REQUIRE(thread->IsRunning() == is_current);
+        REQUIRE((thread->GetStatus() == ThreadStatus::Running) == is_current);
+    }
+
+    for (const auto& thread : threads) {
+        thread->Stop();
+    }
+    for (std::size_t core = 0; core < GlobalScheduler::NUM_CPU_CORES; ++core) {
+        system.CoreTiming().SwitchContext(core);
+        system.CpuCore(core).Reschedule();
+        REQUIRE(system.Scheduler(core).GetCurrentThread() == nullptr);
+    }
+    system.CoreTiming().SwitchContext(0);
+}
+
+} // namespace Kernel
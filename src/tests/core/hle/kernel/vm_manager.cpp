@@ -0,0 +1,193 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/page_table.h"
+#include "core/core.h"
+#include "core/file_sys/program_metadata.h"
+#include "core/hle/kernel/physical_memory.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/vm_manager.h"
+#include "core/memory.h"
+
+namespace Kernel {
+namespace {
+
+/// Returns the number of pages in [begin, end) whose page table entry doesn't match their VMA.
+u64 CountPageTableMismatches(const VMManager& vm_manager, VAddr begin, VAddr end) {
+    const auto& page_table = vm_manager.page_table;
+    u64 num_mismatches = 0;
+    for (VAddr address = begin; address < end; address += Memory::PAGE_SIZE) {
+        const auto vma = vm_manager.FindVMA(address);
+        const u64 page = address >> Memory::PAGE_BITS;
+        const u64 offset_in_vma = address - vma->base;
+
+        u8* expected_pointer = nullptr;
+        Common::PageType expected_type = Common::PageType::Unmapped;
+        switch (vma->type) {
+        case VMAType::Free:
+            break;
+        case VMAType::AllocatedMemoryBlock:
+            expected_pointer = vma->backing_block->data() + vma->offset + offset_in_vma;
+            expected_type = Common::PageType::Memory;
+            break;
+        case VMAType::BackingMemory:
+            expected_pointer = vma->backing_memory + offset_in_vma;
+            expected_type = Common::PageType::Memory;
+            break;
+        case VMAType::MMIO:
+            expected_type = Common::PageType::Special;
+            break;
+        }
+        if (page_table.pointers[page] != expected_pointer ||
+            page_table.attributes[page] != expected_type) {
+            ++num_mismatches;
+        }
+    }
+    return num_mismatches;
+}
+
+/// Returns the number of VMAs covering [begin, end), as seen through svcQueryMemory.
+std::size_t CountVMAs(const VMManager& vm_manager, VAddr begin, VAddr end) {
+    std::size_t num_vmas = 0;
+    for (VAddr address = begin; address < end;) {
+        const MemoryInfo info = vm_manager.QueryMemory(address);
+        address = info.base_address + info.size;
+        ++num_vmas;
+    }
+    return num_vmas;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("VMManager[PageTable]", "[core][kernel]") {
+    constexpr u64 block_size = 4 * Memory::PAGE_SIZE;
+    constexpr u64 num_blocks = 8;
+    constexpr u64 heap_size = 0x200000;
+
+    auto process = Process::Create(Core::System::GetInstance(), "", Process::ProcessType::Userland);
+    auto& vm_manager = process->VMManager();
+    vm_manager.Reset(FileSys::ProgramAddressSpaceType::Is32Bit);
+
+    const VAddr map_base = vm_manager.GetMapRegionBaseAddress();
+    const VAddr map_end = map_base + 0x100000;
+    const auto backing = std::make_shared<PhysicalMemory>(num_blocks * block_size);
+
+    // Adjacent mappings of the same block with matching offsets merge into a single VMA
+    for (u64 i = 0; i < num_blocks; ++i) {
+        REQUIRE(vm_manager
+                    .MapMemoryBlock(map_base + i * block_size, backing, i * block_size,
+                                    block_size, MemoryState::Normal)
+                    .Succeeded());
+    }
+    REQUIRE(CountVMAs(vm_manager, map_base, map_end) == 2);
+    REQUIRE(CountPageTableMismatches(vm_manager, map_base, map_end) == 0);
+
+    // Protecting and unmapping parts of the mapping splits it
+    REQUIRE(vm_manager.ReprotectRange(map_base + Memory::PAGE_SIZE, block_size,
+                                      VMAPermission::Read) == RESULT_SUCCESS);
+    REQUIRE(vm_manager.UnmapRange(map_base + 3 * block_size, 2 * block_size) == RESULT_SUCCESS);
+    REQUIRE(CountVMAs(vm_manager, map_base, map_end) == 6);
+    REQUIRE(CountPageTableMismatches(vm_manager, map_base, map_end) == 0);
+
+    // The heap is reallocated as it grows, so its pages have to follow the new block
+    REQUIRE(vm_manager.SetHeapSize(heap_size / 2).Succeeded());
+    REQUIRE(vm_manager.SetHeapSize(heap_size).Succeeded());
+    const VAddr heap_base = vm_manager.GetHeapRegionBaseAddress();
+    REQUIRE(CountPageTableMismatches(vm_manager, heap_base, heap_base + 2 * heap_size) == 0);
+
+    // Code mirrors of the heap share its block and lock the source
+    const VAddr code_address = map_base + 0x80000;
+    REQUIRE(vm_manager.MapCodeMemory(code_address, heap_base, 0x10000) == RESULT_SUCCESS);
+    REQUIRE(vm_manager.SetMemoryAttribute(heap_base + 0x20000, Memory::PAGE_SIZE,
+                                          MemoryAttribute::Uncached,
+                                          MemoryAttribute::Uncached) == RESULT_SUCCESS);
+    REQUIRE(vm_manager.FindVMA(code_address)->backing_block ==
+            vm_manager.FindVMA(heap_base)->backing_block);
+    REQUIRE(CountPageTableMismatches(vm_manager, map_base, map_end) == 0);
+    REQUIRE(CountPageTableMismatches(vm_manager, heap_base, heap_base + heap_size) == 0);
+
+    REQUIRE(vm_manager.UnmapCodeMemory(code_address, heap_base, 0x10000) == RESULT_SUCCESS);
+    REQUIRE(vm_manager.UnmapRange(map_base, 3 * block_size) == RESULT_SUCCESS);
+    REQUIRE(vm_manager.UnmapRange(map_base + 5 * block_size, 3 * block_size) == RESULT_SUCCESS);
+    REQUIRE(CountVMAs(vm_manager, map_base, map_end) == 1);
+    REQUIRE(CountPageTableMismatches(vm_manager, map_base, map_end) == 0);
+}
+
+TEST_CASE("VMManager[Benchmark]", "[core][kernel][.benchmark]") {
+    // A synthetic trace shaped after what titles do: a growing heap, many small mappings scattered
+    // through the map region, NRO style protection of their first page, memory queries walking
+    // the address space and unmapping in a different order than mapping.
+    constexpr std::size_t num_mappings = 64;
+    constexpr int num_rounds = 200;
+
+    auto process = Process::Create(Core::System::GetInstance(), "", Process::ProcessType::Userland);
+    auto& vm_manager = process->VMManager();
+    vm_manager.Reset(FileSys::ProgramAddressSpaceType::Is32Bit);
+
+    const VAddr map_base = vm_manager.GetMapRegionBaseAddress();
+    const auto backing = std::make_shared<PhysicalMemory>(num_mappings * 4 * Memory::PAGE_SIZE);
+
+    std::mt19937 rng{1234};
+    std::vector<std::size_t> order(num_mappings);
+    for (std::size_t i = 0; i < num_mappings; ++i) {
+        order[i] = i;
+    }
+
+    u64 num_operations = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < num_rounds; ++round) {
+        for (u64 heap_size = 0x200000; heap_size <= 0x800000; heap_size += 0x200000) {
+            REQUIRE(vm_manager.SetHeapSize(heap_size).Succeeded());
+            ++num_operations;
+        }
+
+        // Mappings of 1 to 4 pages with a free page after each
+        std::shuffle(order.begin(), order.end(), rng);
+        for (const std::size_t index : order) {
+            const VAddr address = map_base + index * 5 * Memory::PAGE_SIZE;
+            const u64 size = (1 + index % 4) * Memory::PAGE_SIZE;
+            REQUIRE(vm_manager
+                        .MapMemoryBlock(address, backing, index * 4 * Memory::PAGE_SIZE, size,
+                                        MemoryState::Normal)
+                        .Succeeded());
+            REQUIRE(vm_manager.ReprotectRange(address, Memory::PAGE_SIZE,
+                                              VMAPermission::ReadExecute) == RESULT_SUCCESS);
+            num_operations += 2;
+        }
+
+        for (VAddr address = map_base; address < map_base + num_mappings * 5 * Memory::PAGE_SIZE;
+             ++num_operations) {
+            const MemoryInfo info = vm_manager.QueryMemory(address);
+            address = info.base_address + info.size;
+        }
+
+        std::shuffle(order.begin(), order.end(), rng);
+        for (const std::size_t index : order) {
+            const VAddr address = map_base + index * 5 * Memory::PAGE_SIZE;
+            REQUIRE(vm_manager.UnmapRange(address, (1 + index % 4) * Memory::PAGE_SIZE) ==
+                    RESULT_SUCCESS);
+            ++num_operations;
+        }
+        REQUIRE(vm_manager.SetHeapSize(0x200000).Succeeded());
+        ++num_operations;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    REQUIRE(CountPageTableMismatches(vm_manager, map_base,
+                                     map_base + num_mappings * 5 * Memory::PAGE_SIZE) == 0);
+    fmt::print("VMManager: {:.2f} Kops/s\n", num_operations / elapsed.count() / 1e3);
+}
+
+} // namespace Kernel
@@ -0,0 +1,188 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/page_table.h"
+#include "common/scope_exit.h"
+#include "core/core.h"
+#include "core/file_sys/program_metadata.h"
+#include "core/frontend/emu_window.h"
+#include "core/hle/kernel/process.h"
+#include "core/hle/kernel/vm_manager.h"
+#include "core/memory.h"
+#include "core/settings.h"
+#include "video_core/renderer_null/renderer_null.h"
+
+namespace Memory {
+
+namespace {
+
+constexpr VAddr REGION_BASE = 0x10000000;
+constexpr u64 REGION_PAGE = REGION_BASE >> PAGE_BITS;
+
+/// Window that is never shown, the null renderer doesn't present anything.
+class EmuWindow_Null final : public Core::Frontend::EmuWindow {
+public:
+    void SwapBuffers() override {}
+    void PollEvents() override {}
+    void MakeCurrent() override {}
+    void DoneCurrent() override {}
+};
+
+/// Measures the throughput in GiB/s of block accesses of the given size at random offsets.
+double MeasureBlockThroughput(Memory& memory, const Kernel::Process& process, u64 region_size,
+                              std::size_t block_size, bool write) {
+    constexpr u64 bytes_per_pass = 1ULL << 30;
+    const u64 num_blocks = bytes_per_pass / block_size;
+
+    std::vector<u8> buffer(block_size);
+    std::mt19937_64 rng;
+    std::uniform_int_distribution<u64> distribution(0, region_size - block_size);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (u64 i = 0; i < num_blocks; ++i) {
+        const VAddr addr = REGION_BASE + distribution(rng);
+        if (write) {
+            memory.WriteBlock(process, addr, buffer.data(), block_size);
+        } else {
+            memory.ReadBlock(process, addr, buffer.data(), block_size);
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(bytes_per_pass) / elapsed.count() / (1ULL << 30);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Memory::GetContiguousPointer", "[core]") {
+    auto& memory = Core::System::GetInstance().Memory();
+    auto process = Kernel::Process::Create(Core::System::GetInstance(), "",
+                                           Kernel::Process::ProcessType::Userland);
+    process->VMManager().Reset(FileSys::ProgramAddressSpaceType::Is32Bit);
+    auto& page_table = process->VMManager().page_table;
+
+    // Two host allocations mapped next to each other, so the guest range isn't host contiguous
+    std::vector<u8> first_backing(2 * PAGE_SIZE);
+    std::vector<u8> second_backing(2 * PAGE_SIZE);
+    memory.MapMemoryRegion(page_table, REGION_BASE, first_backing.size(), first_backing.data());
+    memory.MapMemoryRegion(page_table, REGION_BASE + 2 * PAGE_SIZE, second_backing.size(),
+                           second_backing.data());
+
+    REQUIRE(memory.GetContiguousPointer(*process, REGION_BASE + 0x10, 2 * PAGE_SIZE - 0x10) ==
+            first_backing.data() + 0x10);
+    REQUIRE(memory.GetContiguousPointer(*process, REGION_BASE + PAGE_SIZE, 2 * PAGE_SIZE) ==
+            nullptr);
+    REQUIRE(memory.GetContiguousPointer(*process, REGION_BASE + 2 * PAGE_SIZE, 0) ==
+            second_backing.data());
+
+    // Unmapped and cached pages have to go through ReadBlock/WriteBlock
+    REQUIRE(memory.GetContiguousPointer(*process, REGION_BASE + 3 * PAGE_SIZE, 2 * PAGE_SIZE) ==
+            nullptr);
+    memory.UpdatePagesCachedCount(page_table, REGION_BASE + PAGE_SIZE, 1, 1);
+    REQUIRE(memory.GetContiguousPointer(*process, REGION_BASE, PAGE_SIZE) ==
+            first_backing.data());
+    REQUIRE(memory.GetContiguousPointer(*process, REGION_BASE, PAGE_SIZE + 1) == nullptr);
+
+    memory.UpdatePagesCachedCount(page_table, REGION_BASE + PAGE_SIZE, 1, -1);
+    memory.UnmapRegion(page_table, REGION_BASE, 4 * PAGE_SIZE);
+}
+
+TEST_CASE("Memory::UpdatePagesCachedCount", "[core]") {
+    auto& memory = Core::System::GetInstance().Memory();
+    Common::PageTable page_table{PAGE_BITS};
+    page_table.Resize(32);
+
+    std::vector<u8> backing(4 * PAGE_SIZE);
+    memory.MapMemoryRegion(page_table, REGION_BASE, backing.size(), backing.data());
+
+    const auto is_cached = [&page_table](u64 page) {
+        const bool cached = page_table.attributes[REGION_PAGE + page] ==
+                            Common::PageType::RasterizerCachedMemory;
+        REQUIRE(cached == (page_table.pointers[REGION_PAGE + page] == nullptr));
+        return cached;
+    };
+
+    // Two objects, the second one is unaligned and overlaps the first one.
+    memory.UpdatePagesCachedCount(page_table, REGION_BASE, 2 * PAGE_SIZE, 1);
+    memory.UpdatePagesCachedCount(page_table, REGION_BASE + PAGE_SIZE + 0x10, PAGE_SIZE, 1);
+    REQUIRE(is_cached(0));
+    REQUIRE(is_cached(1));
+    REQUIRE(is_cached(2));
+    REQUIRE(!is_cached(3));
+    REQUIRE(page_table.cached_counts[REGION_PAGE + 1] == 2);
+
+    // Removing the first object only uncaches the page it doesn't share with the second one.
+    memory.UpdatePagesCachedCount(page_table, REGION_BASE, 2 * PAGE_SIZE, -1);
+    REQUIRE(!is_cached(0));
+    REQUIRE(is_cached(1));
+    REQUIRE(is_cached(2));
+    REQUIRE(page_table.pointers[REGION_PAGE] == backing.data());
+
+    // Remapping the region keeps the pages that are still referenced cached, and uncaching them
+    // afterwards exposes the new backing memory.
+    std::vector<u8> new_backing(4 * PAGE_SIZE);
+    memory.MapMemoryRegion(page_table, REGION_BASE, new_backing.size(), new_backing.data());
+    REQUIRE(!is_cached(0));
+    REQUIRE(is_cached(1));
+    REQUIRE(is_cached(2));
+
+    memory.UpdatePagesCachedCount(page_table, REGION_BASE + PAGE_SIZE + 0x10, PAGE_SIZE, -1);
+    for (u64 page = 0; page < 4; ++page) {
+        REQUIRE(!is_cached(page));
+        REQUIRE(page_table.pointers[REGION_PAGE + page] == new_backing.data() + page * PAGE_SIZE);
+    }
+}
+
+TEST_CASE("Memory::RasterizerCachedMemory Benchmark", "[core][.benchmark]") {
+    constexpr u64 region_size = 64ULL << 20;
+
+    // Accesses to cached pages flush and invalidate the GPU caches, the null renderer makes those
+    // calls free so only the cost of reaching the backing memory is measured.
+    const bool use_asynchronous_gpu_emulation = Settings::values.use_asynchronous_gpu_emulation;
+    Settings::values.use_asynchronous_gpu_emulation = false;
+    EmuWindow_Null emu_window;
+    auto& system = Core::System::GetInstance();
+    REQUIRE(system.InitGPU(std::make_unique<Null::RendererNull>(emu_window)) ==
+            Core::System::ResultStatus::Success);
+    SCOPE_EXIT({
+        system.ShutdownGPU();
+        Settings::values.use_asynchronous_gpu_emulation = use_asynchronous_gpu_emulation;
+    });
+
+    auto process = Kernel::Process::Create(system, "", Kernel::Process::ProcessType::Userland);
+    process->VMManager().Reset(FileSys::ProgramAddressSpaceType::Is32Bit);
+    auto& page_table = process->VMManager().page_table;
+
+    auto& memory = system.Memory();
+    std::vector<u8> backing(region_size);
+    memory.MapMemoryRegion(page_table, REGION_BASE, region_size, backing.data());
+
+    for (const bool cached : {false, true}) {
+        if (cached) {
+            memory.UpdatePagesCachedCount(page_table, REGION_BASE, region_size, 1);
+        }
+        for (const std::size_t block_size : {0x40, 0x1000, 0x10000}) {
+            fmt::print("{:>8} pages, {:>5} byte blocks: ReadBlock {:6.2f} GiB/s, "
+                       "WriteBlock {:6.2f} GiB/s\n",
+                       cached ? "Cached" : "Uncached", block_size,
+                       MeasureBlockThroughput(memory, *process, region_size, block_size, false),
+                       MeasureBlockThroughput(memory, *process, region_size, block_size, true));
+        }
+    }
+
+    memory.UpdatePagesCachedCount(page_table, REGION_BASE, region_size, -1);
+    memory.UnmapRegion(page_table, REGION_BASE, region_size);
+}
+
+} // namespace Memory
@@ -0,0 +1,182 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "video_core/textures/astc.h"
+
+namespace Tegra::Texture::ASTC {
+namespace {
+
+using Block = std::array<u8, 16>;
+
+void WriteBits(Block& block, u32 offset, u32 num_bits, u32 value) {
+    for (u32 bit = 0; bit < num_bits; ++bit) {
+        const u32 position = offset + bit;
+        const u8 mask = static_cast<u8>(1U << (position % 8));
+        if ((value >> bit) & 1) {
+            block[position / 8] |= mask;
+        } else {
+            block[position / 8] &= static_cast<u8>(~mask);
+        }
+    }
+}
+
+/// Number of bits used to encode count values in the range [0, max_value].
+u32 EncodedBitLength(u32 max_value, u32 count) {
+    const u32 num_values = max_value + 1;
+    for (u32 bits = 0; bits < 8; ++bits) {
+        if (num_values == 1U << bits) {
+            return bits * count;
+        }
+        if (num_values == 3U << bits) {
+            return bits * count + (count * 8 + 4) / 5;
+        }
+        if (num_values == 5U << bits) {
+            return bits * count + (count * 7 + 2) / 3;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Generates a random block that decodes without errors: a weight grid that fits the block, one
+ * to three partitions with direct RGB(A) endpoints, and random endpoint and weight data.
+ */
+Block MakeRandomBlock(std::mt19937& generator, u32 block_width, u32 block_height) {
+    constexpr std::array<u32, 6> low_precision{1, 2, 3, 4, 5, 7};
+    constexpr std::array<u32, 6> high_precision{9, 11, 15, 19, 23, 31};
+
+    Block block;
+    for (u8& byte : block) {
+        byte = static_cast<u8>(generator());
+    }
+    while (true) {
+        // Block mode layout 0: the grid is (B + 4) x (A + 2) weights.
+        const u32 a = generator() % 4;
+        const u32 b = generator() % 4;
+        const u32 range = 2 + generator() % 6;
+        const u32 high = generator() % 2;
+        const u32 dual_plane = generator() % 4 == 0;
+        const u32 num_partitions = 1 + generator() % 3;
+        const u32 grid_width = b + 4;
+        const u32 grid_height = a + 2;
+        if (grid_width > block_width || grid_height > block_height) {
+            continue;
+        }
+        const u32 max_weight = (high ? high_precision : low_precision)[range - 2];
+        const u32 num_weights = grid_width * grid_height * (dual_plane ? 2 : 1);
+        const u32 weight_bits = EncodedBitLength(max_weight, num_weights);
+        if (weight_bits < 24 || weight_bits > 80) {
+            continue;
+        }
+
+        WriteBits(block, 0, 2, range >> 1);
+        WriteBits(block, 2, 2, 0);
+        WriteBits(block, 4, 1, range & 1);
+        WriteBits(block, 5, 2, a);
+        WriteBits(block, 7, 2, b);
+        WriteBits(block, 9, 1, high);
+        WriteBits(block, 10, 1, dual_plane);
+        WriteBits(block, 11, 2, num_partitions - 1);
+
+        const u32 endpoint_mode = generator() % 2 == 0 ? 8 : 12;
+        if (num_partitions == 1) {
+            WriteBits(block, 13, 4, endpoint_mode);
+        } else {
+            // Every partition shares the same endpoint mode.
+            WriteBits(block, 23, 6, endpoint_mode << 2);
+        }
+        return block;
+    }
+}
+
+std::vector<u8> MakeImage(std::mt19937& generator, u32 width, u32 height, u32 block_width,
+                          u32 block_height, u32 num_unique_blocks) {
+    std::vector<Block> unique_blocks;
+    for (u32 i = 0; i < num_unique_blocks; ++i) {
+        unique_blocks.push_back(MakeRandomBlock(generator, block_width, block_height));
+    }
+    const u32 num_blocks =
+        ((width + block_width - 1) / block_width) * ((height + block_height - 1) / block_height);
+    std::vector<u8> data(num_blocks * 16);
+    for (u32 i = 0; i < num_blocks; ++i) {
+        const Block& block = unique_blocks[generator() % num_unique_blocks];
+        std::memcpy(data.data() + i * 16, block.data(), block.size());
+    }
+    return data;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ASTC[BlockConsistency]", "[video_core]") {
+    // Decoding a large image goes through the worker threads and the block cache, every block
+    // must match the result of decoding it on its own.
+    std::mt19937 generator{0x45544353};
+    for (const auto& [block_width, block_height] : {std::pair{4U, 4U}, {8U, 5U}, {12U, 12U}}) {
+        const u32 width = block_width * 70 + 3;
+        const u32 height = block_height * 65 + 1;
+        const std::vector<u8> data =
+            MakeImage(generator, width, height, block_width, block_height, 256);
+        const std::vector<u8> image = Decompress(data.data(), width, height, 1, block_width,
+                                                 block_height);
+
+        const u32 blocks_per_row = (width + block_width - 1) / block_width;
+        bool matches = true;
+        for (u32 y = 0; y < height; y += block_height) {
+            for (u32 x = 0; x < width; x += block_width) {
+                const u32 block_index = (y / block_height) * blocks_per_row + x / block_width;
+                const std::vector<u8> texels =
+                    Decompress(data.data() + block_index * 16, block_width, block_height, 1,
+                               block_width, block_height);
+                const u32 copy_width = std::min(block_width, width - x);
+                const u32 copy_height = std::min(block_height, height - y);
+                for (u32 row = 0; row < copy_height; ++row) {
+                    const u8* expected = texels.data() + row * block_width * 4;
+                    const u8* result = image.data() + ((y + row) * width + x) * 4;
+                    matches &= std::memcmp(expected, result, copy_width * 4) == 0;
+                }
+            }
+        }
+        REQUIRE(matches);
+    }
+}
+
+TEST_CASE("ASTC[Benchmark]", "[video_core][.benchmark]") {
+    constexpr u32 width = 2048;
+    constexpr u32 height = 2048;
+    constexpr int iterations = 4;
+
+    std::mt19937 generator{0x45544353};
+    for (const auto& [block_width, block_height] :
+         {std::pair{4U, 4U}, {5U, 5U}, {6U, 6U}, {8U, 8U}, {10U, 10U}, {12U, 12U}}) {
+        // Unique blocks measure the decoder itself, an atlas like image measures the cache.
+        for (const u32 num_unique_blocks : {1U << 16, 64U}) {
+            const std::vector<u8> data = MakeImage(generator, width, height, block_width,
+                                                   block_height, num_unique_blocks);
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                Decompress(data.data(), width, height, 1, block_width, block_height);
+            }
+            const std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+            const double mpixels = static_cast<double>(width) * height * iterations / 1e6;
+            fmt::print("{:>2}x{:<2} {:>5} unique blocks: {:8.2f} MPixels/s\n", block_width,
+                       block_height, num_unique_blocks, mpixels / elapsed.count());
+        }
+    }
+}
+
+} // namespace Tegra::Texture::ASTC
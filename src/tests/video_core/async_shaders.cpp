@@ -0,0 +1,31 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "core/frontend/emu_window.h"
+#include "video_core/shader/async_shaders.h"
+
+namespace VideoCommon::Shader {
+
+TEST_CASE("AsyncShaders[Jobs]", "[video_core]") {
+    AsyncShaders async_shaders(std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>>(2));
+    REQUIRE(async_shaders.NumWorkers() == 2);
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 64; ++i) {
+        futures.push_back(async_shaders.QueueJob([i] { return i * i; }));
+    }
+    for (int i = 0; i < 64; ++i) {
+        futures[i].wait();
+        REQUIRE(AsyncShaders::IsReady(futures[i]));
+        REQUIRE(futures[i].get() == i * i);
+    }
+}
+
+} // namespace VideoCommon::Shader
@@ -0,0 +1,73 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/common_types.h"
+#include "video_core/macro_opcode.h"
+
+namespace Tegra::EngineTests {
+
+/// First method that triggers a macro call on Maxwell3D.
+constexpr u32 MACRO_METHOD = 0xE00;
+/// Flag that marks a macro instruction as the last one, its delay slot is still executed.
+constexpr u32 EXIT = 1U << 7;
+
+inline u32 AddImmediate(Macro::ResultOperation result, u32 dst, u32 src_a, s32 immediate) {
+    Macro::Opcode opcode{};
+    opcode.operation.Assign(Macro::Operation::AddImmediate);
+    opcode.result_operation.Assign(result);
+    opcode.dst.Assign(dst);
+    opcode.src_a.Assign(src_a);
+    opcode.immediate.Assign(immediate);
+    return opcode.raw;
+}
+
+inline u32 ALU(Macro::ALUOperation operation, Macro::ResultOperation result, u32 dst, u32 src_a,
+               u32 src_b) {
+    Macro::Opcode opcode{};
+    opcode.operation.Assign(Macro::Operation::ALU);
+    opcode.result_operation.Assign(result);
+    opcode.dst.Assign(dst);
+    opcode.src_a.Assign(src_a);
+    opcode.src_b.Assign(src_b);
+    opcode.alu_operation.Assign(operation);
+    return opcode.raw;
+}
+
+inline u32 Bitfield(Macro::Operation operation, Macro::ResultOperation result, u32 dst, u32 src_a,
+                    u32 src_b, u32 src_bit, u32 size, u32 dst_bit) {
+    Macro::Opcode opcode{};
+    opcode.operation.Assign(operation);
+    opcode.result_operation.Assign(result);
+    opcode.dst.Assign(dst);
+    opcode.src_a.Assign(src_a);
+    opcode.src_b.Assign(src_b);
+    opcode.bf_src_bit.Assign(src_bit);
+    opcode.bf_size.Assign(size);
+    opcode.bf_dst_bit.Assign(dst_bit);
+    return opcode.raw;
+}
+
+inline u32 Read(Macro::ResultOperation result, u32 dst, u32 src_a, s32 immediate) {
+    Macro::Opcode opcode{};
+    opcode.operation.Assign(Macro::Operation::Read);
+    opcode.result_operation.Assign(result);
+    opcode.dst.Assign(dst);
+    opcode.src_a.Assign(src_a);
+    opcode.immediate.Assign(immediate);
+    return opcode.raw;
+}
+
+inline u32 Branch(Macro::BranchCondition condition, bool annul, u32 src_a, s32 offset) {
+    Macro::Opcode opcode{};
+    opcode.operation.Assign(Macro::Operation::Branch);
+    opcode.branch_condition.Assign(condition);
+    opcode.branch_annul.Assign(annul ? 1 : 0);
+    opcode.src_a.Assign(src_a);
+    opcode.immediate.Assign(offset);
+    return opcode.raw;
+}
+
+} // namespace Tegra::EngineTests
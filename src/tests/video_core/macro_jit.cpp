@@ -0,0 +1,186 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/settings.h"
+#include "tests/video_core/engine_test_common.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro_opcode.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_null/rasterizer_null.h"
+
+namespace Tegra {
+namespace {
+
+using Engines::Maxwell3D;
+using namespace EngineTests;
+using namespace Macro;
+
+/// Macro code together with the parameters it was called with.
+struct MacroRecording {
+    std::vector<u32> code;
+    std::vector<std::vector<u32>> calls;
+};
+
+/// Sends the parameters after the first one to consecutive registers, counting loop iterations.
+const MacroRecording LOOP_SEND{
+    {
+        AddImmediate(ResultOperation::MoveAndSetMethod, 2, 0, 0x1200),
+        AddImmediate(ResultOperation::IgnoreAndFetch, 3, 0, 0),
+        AddImmediate(ResultOperation::MoveAndSend, 4, 3, 0),
+        AddImmediate(ResultOperation::Move, 1, 1, -1),
+        Branch(BranchCondition::NotZero, false, 1, -3),
+        AddImmediate(ResultOperation::Move, 5, 5, 1),
+        AddImmediate(ResultOperation::MoveAndSend, 0, 5, 0) | EXIT,
+        AddImmediate(ResultOperation::MoveAndSend, 0, 1, 0),
+    },
+    {
+        {1, 0xDEADBEEF},
+        {3, 1, 2, 3},
+        {8, 0, 0xFFFFFFFF, 0x80000000, 7, 6, 5, 4, 3},
+    },
+};
+
+/// Exercises every ALU operation and the carry flag.
+const MacroRecording ALU_CARRY{
+    {
+        AddImmediate(ResultOperation::IgnoreAndFetch, 2, 0, 0),
+        AddImmediate(ResultOperation::IgnoreAndFetch, 3, 0, 0),
+        AddImmediate(ResultOperation::IgnoreAndFetch, 4, 0, 0),
+        AddImmediate(ResultOperation::MoveAndSetMethod, 5, 0, 0x1210),
+        ALU(ALUOperation::Add, ResultOperation::MoveAndSend, 6, 1, 2),
+        ALU(ALUOperation::AddWithCarry, ResultOperation::MoveAndSend, 7, 3, 4),
+        ALU(ALUOperation::Subtract, ResultOperation::MoveAndSend, 6, 1, 2),
+        ALU(ALUOperation::SubtractWithBorrow, ResultOperation::MoveAndSend, 7, 3, 4),
+        ALU(ALUOperation::Xor, ResultOperation::MoveAndSend, 0, 1, 2),
+        ALU(ALUOperation::Or, ResultOperation::MoveAndSend, 0, 1, 3),
+        ALU(ALUOperation::And, ResultOperation::MoveAndSend, 0, 2, 4),
+        ALU(ALUOperation::AndNot, ResultOperation::MoveAndSend, 0, 3, 4),
+        ALU(ALUOperation::Nand, ResultOperation::MoveAndSend, 0, 1, 4),
+        ALU(ALUOperation::AddWithCarry, ResultOperation::MoveAndSend, 0, 0, 0),
+        ALU(ALUOperation::Subtract, ResultOperation::MoveAndSend, 0, 2, 1) | EXIT,
+        ALU(ALUOperation::SubtractWithBorrow, ResultOperation::MoveAndSend, 0, 0, 0),
+    },
+    {
+        {0, 0, 0, 0},
+        {0xFFFFFFFF, 1, 0, 0},
+        {1, 2, 0x7FFFFFFF, 0x80000001},
+        {0x80000000, 0x80000000, 0xFFFFFFFF, 0xFFFFFFFF},
+        {0x12345678, 0x9ABCDEF0, 0x0F0F0F0F, 0xF0F0F0F0},
+    },
+};
+
+/// Exercises bitfield operations, register reads, annulled branches and delay slots.
+const MacroRecording BITFIELD_BRANCH{
+    {
+        AddImmediate(ResultOperation::MoveAndSetMethod, 2, 0, 0x2220),
+        Bitfield(Operation::ExtractInsert, ResultOperation::MoveAndSend, 3, 1, 1, 4, 8, 16),
+        AddImmediate(ResultOperation::IgnoreAndFetch, 4, 0, 0),
+        Bitfield(Operation::ExtractShiftLeftImmediate, ResultOperation::MoveAndSend, 5, 4, 1, 0,
+                 12, 3),
+        Bitfield(Operation::ExtractShiftLeftRegister, ResultOperation::MoveAndSend, 6, 4, 1, 2, 6,
+                 0),
+        Read(ResultOperation::Move, 7, 0, 0x220),
+        Branch(BranchCondition::Zero, true, 7, 3),
+        AddImmediate(ResultOperation::MoveAndSetMethodSend, 0, 0, (5 << 12) | 0x230),
+        AddImmediate(ResultOperation::MoveAndSetMethodFetchAndSend, 0, 0, 0x240),
+        Branch(BranchCondition::Zero, false, 0, 2),
+        AddImmediate(ResultOperation::FetchAndSetMethod, 3, 0, 0x1250),
+        AddImmediate(ResultOperation::MoveAndSend, 0, 3, 0) | EXIT,
+        AddImmediate(ResultOperation::MoveAndSend, 0, 4, 0),
+    },
+    {
+        {0, 3, 0x11},
+        {0xABCDEF12, 0, 0x22, 0x33},
+        {0xFFFFFFFF, 7, 0x44, 0x55},
+        {0x00000FF0, 31, 0x66, 0x77},
+    },
+};
+
+class MacroEngines {
+public:
+    MacroEngines()
+        : system{Core::System::GetInstance()}, memory_manager{system, rasterizer},
+          interpreter{MakeEngine(false)}, jit{MakeEngine(true)} {}
+
+    /// Uploads the macro code at the given offset and binds it to the first macro entry.
+    void Upload(u32 offset, const std::vector<u32>& code) {
+        for (Maxwell3D* const engine : {interpreter.get(), jit.get()}) {
+            engine->CallMethod({MAXWELL3D_REG_INDEX(macros.upload_address), offset});
+            for (const u32 word : code) {
+                engine->CallMethod({MAXWELL3D_REG_INDEX(macros.data), word});
+            }
+            engine->CallMethod({MAXWELL3D_REG_INDEX(macros.entry), 0});
+            engine->CallMethod({MAXWELL3D_REG_INDEX(macros.bind), offset});
+        }
+    }
+
+    /// Calls the first macro on both engines and checks that their registers match.
+    void CallAndCompare(const std::vector<u32>& parameters) {
+        for (Maxwell3D* const engine : {interpreter.get(), jit.get()}) {
+            const auto num_parameters = static_cast<u32>(parameters.size());
+            for (u32 i = 0; i < num_parameters; ++i) {
+                const u32 method = MACRO_METHOD + (i == 0 ? 0 : 1);
+                engine->CallMethod({method, parameters[i], 0, num_parameters - i});
+            }
+        }
+        REQUIRE(interpreter->regs.reg_array == jit->regs.reg_array);
+    }
+
+private:
+    std::unique_ptr<Maxwell3D> MakeEngine(bool use_macro_jit) {
+        Settings::values.use_macro_jit = use_macro_jit;
+        return std::make_unique<Maxwell3D>(system, rasterizer, memory_manager);
+    }
+
+    Core::System& system;
+    Null::RasterizerNull rasterizer;
+    MemoryManager memory_manager;
+    std::unique_ptr<Maxwell3D> interpreter;
+    std::unique_ptr<Maxwell3D> jit;
+};
+
+void RunRecording(const MacroRecording& recording) {
+    MacroEngines engines;
+    engines.Upload(0, recording.code);
+    for (const auto& parameters : recording.calls) {
+        engines.CallAndCompare(parameters);
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MacroJIT[Loop]", "[video_core]") {
+    RunRecording(LOOP_SEND);
+}
+
+TEST_CASE("MacroJIT[ALU]", "[video_core]") {
+    RunRecording(ALU_CARRY);
+}
+
+TEST_CASE("MacroJIT[BitfieldBranch]", "[video_core]") {
+    RunRecording(BITFIELD_BRANCH);
+}
+
+TEST_CASE("MacroJIT[Reupload]", "[video_core]") {
+    MacroEngines engines;
+
+    // Upload a macro at an offset other than zero, then overwrite it with a different program.
+    engines.Upload(0x100, LOOP_SEND.code);
+    engines.CallAndCompare(LOOP_SEND.calls[1]);
+    engines.Upload(0x100, ALU_CARRY.code);
+    engines.CallAndCompare(ALU_CARRY.calls[2]);
+
+    // Uploading the first program again must not execute stale code.
+    engines.Upload(0x100, LOOP_SEND.code);
+    engines.CallAndCompare(LOOP_SEND.calls[2]);
+}
+
+} // namespace Tegra
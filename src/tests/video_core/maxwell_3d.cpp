@@ -0,0 +1,195 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "tests/video_core/engine_test_common.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/memory_manager.h"
+#include "video_core/renderer_null/rasterizer_null.h"
+
+namespace Tegra {
+namespace {
+
+using Engines::Maxwell3D;
+using namespace EngineTests;
+using namespace Macro;
+
+/// Sends every parameter after the first one to consecutive registers starting at 0x200, the
+/// first parameter holds the number of parameters that follow.
+const std::vector<u32> FORWARD_PARAMETERS{
+    AddImmediate(ResultOperation::MoveAndSetMethod, 0, 0, 0x1200),
+    AddImmediate(ResultOperation::IgnoreAndFetch, 2, 0, 0),
+    AddImmediate(ResultOperation::MoveAndSend, 3, 2, 0),
+    AddImmediate(ResultOperation::Move, 1, 1, -1),
+    Branch(BranchCondition::NotZero, true, 1, -3),
+    AddImmediate(ResultOperation::Move, 0, 0, 0) | EXIT,
+    AddImmediate(ResultOperation::Move, 0, 0, 0),
+};
+
+/// Writes the values to the method one at a time.
+void CallPerWord(Maxwell3D& engine, u32 method, const u32* values, u32 amount,
+                 u32 methods_pending) {
+    for (u32 i = 0; i < amount; ++i) {
+        engine.CallMethod({method, values[i], 0, methods_pending - i});
+    }
+}
+
+/// Writes the values to the method in batches of at most max_batch values, as if they were split
+/// across several command lists.
+void CallBatched(Maxwell3D& engine, u32 method, const u32* values, u32 amount,
+                 u32 methods_pending, u32 max_batch) {
+    for (u32 i = 0; i < amount; i += max_batch) {
+        const u32 batch = std::min(max_batch, amount - i);
+        engine.CallMultiMethod(method, values + i, batch, methods_pending - i);
+    }
+}
+
+class EngineInstance {
+public:
+    EngineInstance()
+        : system{Core::System::GetInstance()}, memory_manager{system, rasterizer},
+          maxwell3d{std::make_unique<Maxwell3D>(system, rasterizer, memory_manager)} {
+        maxwell3d->CallMethod({MAXWELL3D_REG_INDEX(macros.upload_address), 0});
+        for (const u32 word : FORWARD_PARAMETERS) {
+            maxwell3d->CallMethod({MAXWELL3D_REG_INDEX(macros.data), word});
+        }
+        maxwell3d->CallMethod({MAXWELL3D_REG_INDEX(macros.entry), 0});
+        maxwell3d->CallMethod({MAXWELL3D_REG_INDEX(macros.bind), 0});
+    }
+
+    Maxwell3D& Engine() {
+        return *maxwell3d;
+    }
+
+private:
+    Core::System& system;
+    Null::RasterizerNull rasterizer;
+    MemoryManager memory_manager;
+    std::unique_ptr<Maxwell3D> maxwell3d;
+};
+
+/// Builds the parameters of a FORWARD_PARAMETERS call that forwards the specified values.
+std::vector<u32> MakeMacroCall(u32 num_values) {
+    std::vector<u32> parameters(num_values + 1);
+    parameters[0] = num_values;
+    for (u32 i = 1; i <= num_values; ++i) {
+        parameters[i] = i * 0x01010101U;
+    }
+    return parameters;
+}
+
+/// Calls the first macro the way the command processor does for an IncreaseOnce command: the
+/// first parameter goes to the macro method and the rest to its argument register.
+template <typename Dispatch>
+void CallMacro(Maxwell3D& engine, const std::vector<u32>& parameters, Dispatch&& dispatch) {
+    const auto num_parameters = static_cast<u32>(parameters.size());
+    engine.CallMethod({MACRO_METHOD, parameters[0], 0, num_parameters});
+    dispatch(engine, MACRO_METHOD + 1, parameters.data() + 1, num_parameters - 1,
+             num_parameters - 1);
+}
+
+/// Returns the number of method calls processed per second.
+template <typename Function>
+double MeasureMethods(u64 num_methods, Function&& function) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(num_methods) / elapsed.count();
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Maxwell3D[MultiMethod]", "[video_core]") {
+    EngineInstance per_word;
+    EngineInstance batched;
+    const auto call_batched = [](Maxwell3D& engine, u32 method, const u32* values, u32 amount,
+                                 u32 methods_pending) {
+        CallBatched(engine, method, values, amount, methods_pending, 7);
+    };
+
+    std::vector<u32> values(40);
+    for (u32 i = 0; i < static_cast<u32>(values.size()); ++i) {
+        values[i] = i * 3 + 1;
+    }
+    const auto amount = static_cast<u32>(values.size());
+
+    // Non-incrementing writes to a plain register.
+    const u32 clear_color = MAXWELL3D_REG_INDEX(clear_color[0]);
+    CallPerWord(per_word.Engine(), clear_color, values.data(), amount, amount);
+    call_batched(batched.Engine(), clear_color, values.data(), amount, amount);
+    REQUIRE(per_word.Engine().regs.reg_array == batched.Engine().regs.reg_array);
+
+    // Macro parameters, including a call where every parameter fits in the first word.
+    for (const u32 num_values : {33U, 1U, 7U}) {
+        const std::vector<u32> parameters = MakeMacroCall(num_values);
+        CallMacro(per_word.Engine(), parameters, CallPerWord);
+        CallMacro(batched.Engine(), parameters, call_batched);
+        REQUIRE(per_word.Engine().regs.reg_array == batched.Engine().regs.reg_array);
+    }
+
+    // Constant buffer data only updates the buffer position until it's flushed to memory.
+    for (EngineInstance* const instance : {&per_word, &batched}) {
+        instance->Engine().CallMethod({MAXWELL3D_REG_INDEX(const_buffer.cb_size), 0x1000});
+        instance->Engine().CallMethod({MAXWELL3D_REG_INDEX(const_buffer.cb_pos), 0x10});
+    }
+    const u32 cb_data = MAXWELL3D_REG_INDEX(const_buffer.cb_data[3]);
+    CallPerWord(per_word.Engine(), cb_data, values.data(), amount, amount);
+    call_batched(batched.Engine(), cb_data, values.data(), amount, amount);
+    REQUIRE(per_word.Engine().regs.reg_array == batched.Engine().regs.reg_array);
+    REQUIRE(batched.Engine().regs.const_buffer.cb_pos == 0x10 + amount * 4);
+}
+
+TEST_CASE("Maxwell3D[MultiMethod]: Benchmark", "[video_core][.benchmark]") {
+    constexpr u32 num_calls = 1 << 14;
+    constexpr u32 num_values = 256;
+
+    const std::vector<u32> parameters = MakeMacroCall(num_values);
+    const u64 num_methods = static_cast<u64>(num_calls) * parameters.size();
+    const auto call_batched = [](Maxwell3D& engine, u32 method, const u32* values, u32 amount,
+                                 u32 methods_pending) {
+        engine.CallMultiMethod(method, values, amount, methods_pending);
+    };
+
+    EngineInstance per_word;
+    EngineInstance batched;
+    const double per_word_macro = MeasureMethods(num_methods, [&] {
+        for (u32 i = 0; i < num_calls; ++i) {
+            CallMacro(per_word.Engine(), parameters, CallPerWord);
+        }
+    });
+    const double batched_macro = MeasureMethods(num_methods, [&] {
+        for (u32 i = 0; i < num_calls; ++i) {
+            CallMacro(batched.Engine(), parameters, call_batched);
+        }
+    });
+
+    const u32 clear_color = MAXWELL3D_REG_INDEX(clear_color[0]);
+    const auto amount = static_cast<u32>(parameters.size());
+    const double per_word_register = MeasureMethods(num_methods, [&] {
+        for (u32 i = 0; i < num_calls; ++i) {
+            CallPerWord(per_word.Engine(), clear_color, parameters.data(), amount, amount);
+        }
+    });
+    const double batched_register = MeasureMethods(num_methods, [&] {
+        for (u32 i = 0; i < num_calls; ++i) {
+            call_batched(batched.Engine(), clear_color, parameters.data(), amount, amount);
+        }
+    });
+
+    fmt::print("Macro parameters: per word {:.2f} Mmethods/s, batched {:.2f} Mmethods/s\n",
+               per_word_macro / 1e6, batched_macro / 1e6);
+    fmt::print("Register writes: per word {:.2f} Mmethods/s, batched {:.2f} Mmethods/s\n",
+               per_word_register / 1e6, batched_register / 1e6);
+}
+
+} // namespace Tegra
@@ -0,0 +1,238 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "video_core/engines/shader_type.h"
+#include "video_core/renderer_opengl/gl_shader_disk_cache.h"
+
+namespace OpenGL {
+namespace {
+
+constexpr char TEST_FILE[] = "shader_disk_cache_test.bin";
+
+using Tegra::Engines::ShaderType;
+
+ShaderDiskCacheRaw MakeRaw(u64 unique_identifier) {
+    ProgramCode code(16 + unique_identifier % 8);
+    for (std::size_t i = 0; i < code.size(); ++i) {
+        code[i] = unique_identifier * 0x100 + i;
+    }
+    return ShaderDiskCacheRaw(unique_identifier, ShaderType::Fragment, std::move(code));
+}
+
+ShaderDiskCacheUsage MakeUsage(u64 unique_identifier, u32 value) {
+    ShaderDiskCacheUsage usage;
+    usage.unique_identifier = unique_identifier;
+    usage.variant = ProgramVariant(GL_TRIANGLES);
+    usage.keys.insert({{1, 0x10}, value});
+    usage.keys.insert({{2, 0x20}, value + 1});
+    usage.bound_samplers.emplace(0x30, Tegra::Engines::SamplerDescriptor{});
+    return usage;
+}
+
+/// Creates a transferable file with a raw shader and a usage of it for each identifier
+void CreateTransferableFile(u64 num_shaders) {
+    FileUtil::Delete(TEST_FILE);
+    auto file = ShaderDiskCacheOpenGL::MakeTransferableFile();
+    REQUIRE(file.OpenForAppend(TEST_FILE));
+    for (u64 id = 0; id < num_shaders; ++id) {
+        REQUIRE(file.Append(id, {}, ShaderDiskCacheEntryKind::Raw, MakeRaw(id).Serialize()));
+        REQUIRE(ShaderDiskCacheOpenGL::AppendUsage(file, MakeUsage(id, static_cast<u32>(id))));
+    }
+}
+
+std::vector<u8> ReadTestFile() {
+    std::vector<u8> data(FileUtil::GetSize(TEST_FILE));
+    FileUtil::IOFile file(TEST_FILE, "rb");
+    REQUIRE(file.ReadBytes(data.data(), data.size()) == data.size());
+    return data;
+}
+
+void WriteTestFile(const std::vector<u8>& data) {
+    FileUtil::IOFile file(TEST_FILE, "wb");
+    REQUIRE(file.WriteBytes(data.data(), data.size()) == data.size());
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ShaderDiskCache[Transferable]", "[video_core]") {
+    // Enough entries to fill the first index block
+    constexpr u64 num_shaders = 200;
+    CreateTransferableFile(num_shaders);
+
+    auto file = ShaderDiskCacheOpenGL::MakeTransferableFile();
+    REQUIRE(file.Load(TEST_FILE) == ShaderDiskCacheFileStatus::Success);
+    REQUIRE(file.GetIndex().size() == 2 * num_shaders);
+    auto entries = ShaderDiskCacheOpenGL::LoadTransferableEntries(file);
+    REQUIRE(entries);
+    REQUIRE(entries->raws.size() == num_shaders);
+    REQUIRE(entries->usages.size() == num_shaders);
+    for (u64 id = 0; id < num_shaders; ++id) {
+        const auto raw = entries->LoadRaw(id);
+        REQUIRE(raw);
+        REQUIRE(raw->GetUniqueIdentifier() == id);
+        REQUIRE(raw->GetType() == ShaderType::Fragment);
+        REQUIRE(raw->GetCode() == MakeRaw(id).GetCode());
+        REQUIRE(raw->GetCodeB().empty());
+        REQUIRE(entries->usages[id] == MakeUsage(id, static_cast<u32>(id)));
+    }
+
+    // Appending to an existing file keeps its entries
+    REQUIRE(file.OpenForAppend(TEST_FILE));
+    REQUIRE(file.Append(num_shaders, {}, ShaderDiskCacheEntryKind::Raw,
+                        MakeRaw(num_shaders).Serialize()));
+    file.Close();
+    REQUIRE(file.Load(TEST_FILE) == ShaderDiskCacheFileStatus::Success);
+    entries = ShaderDiskCacheOpenGL::LoadTransferableEntries(file);
+    REQUIRE(entries);
+    REQUIRE(entries->raws.size() == num_shaders + 1);
+    REQUIRE(entries->LoadRaw(num_shaders)->GetCode() == MakeRaw(num_shaders).GetCode());
+
+    entries.reset();
+    file.Close();
+    REQUIRE(FileUtil::Delete(TEST_FILE));
+}
+
+TEST_CASE("ShaderDiskCache[Precompiled]", "[video_core]") {
+    FileUtil::Delete(TEST_FILE);
+    std::vector<u8> binary(0x1000);
+    for (std::size_t i = 0; i < binary.size(); ++i) {
+        binary[i] = static_cast<u8>(i % 7);
+    }
+    {
+        auto file = ShaderDiskCacheOpenGL::MakePrecompiledFile();
+        REQUIRE(file.OpenForAppend(TEST_FILE));
+        REQUIRE(ShaderDiskCacheOpenGL::AppendDump(file, MakeUsage(1, 5), 0x1234, binary));
+        REQUIRE(ShaderDiskCacheOpenGL::AppendDump(file, MakeUsage(1, 6), 0x1234, {1, 2, 3}));
+    }
+
+    auto file = ShaderDiskCacheOpenGL::MakePrecompiledFile();
+    REQUIRE(file.Load(TEST_FILE) == ShaderDiskCacheFileStatus::Success);
+    ShaderDumps dumps{file};
+    file.Close();
+
+    // Dumps are looked up by their whole usage
+    const auto dump = dumps.Find(MakeUsage(1, 5));
+    REQUIRE(dump);
+    REQUIRE(dump->binary_format == 0x1234);
+    REQUIRE(dump->binary_size == binary.size());
+    REQUIRE(dump->Decompress() == binary);
+    REQUIRE(dumps.Find(MakeUsage(1, 6))->Decompress() == std::vector<u8>{1, 2, 3});
+    REQUIRE(!dumps.Find(MakeUsage(1, 7)));
+    REQUIRE(!dumps.Find(MakeUsage(2, 5)));
+    ShaderDiskCacheUsage other_variant = MakeUsage(1, 5);
+    other_variant.variant = ProgramVariant(GL_POINTS);
+    REQUIRE(!dumps.Find(other_variant));
+
+    // Dumps keep the file mapped after the others are cleared
+    dumps.Clear();
+    REQUIRE(!dumps.Find(MakeUsage(1, 5)));
+    REQUIRE(dump->Decompress() == binary);
+    REQUIRE(FileUtil::Delete(TEST_FILE));
+}
+
+TEST_CASE("ShaderDiskCache[BadHeader]", "[video_core]") {
+    CreateTransferableFile(1);
+    auto precompiled = ShaderDiskCacheOpenGL::MakePrecompiledFile();
+    REQUIRE(precompiled.Load(TEST_FILE) == ShaderDiskCacheFileStatus::BadMagic);
+    REQUIRE(!precompiled.OpenForAppend(TEST_FILE));
+
+    // Transferable files of the previous format start with their version
+    WriteTestFile({11, 0, 0, 0, 1, 0, 0, 0});
+    auto transferable = ShaderDiskCacheOpenGL::MakeTransferableFile();
+    REQUIRE(transferable.Load(TEST_FILE) == ShaderDiskCacheFileStatus::BadMagic);
+    WriteTestFile({1, 2});
+    REQUIRE(transferable.Load(TEST_FILE) == ShaderDiskCacheFileStatus::Corrupted);
+
+    FileUtil::Delete(TEST_FILE);
+    ShaderCacheVersionHash hash{};
+    hash[0] = 1;
+    {
+        ShaderDiskCacheFile file{0x1234, 2, hash};
+        REQUIRE(file.OpenForAppend(TEST_FILE));
+    }
+    REQUIRE(ShaderDiskCacheFile(0x1234, 2, hash).Load(TEST_FILE) ==
+            ShaderDiskCacheFileStatus::Success);
+    REQUIRE(ShaderDiskCacheFile(0x4321, 2, hash).Load(TEST_FILE) ==
+            ShaderDiskCacheFileStatus::BadMagic);
+    REQUIRE(ShaderDiskCacheFile(0x1234, 3, hash).Load(TEST_FILE) ==
+            ShaderDiskCacheFileStatus::OldVersion);
+    REQUIRE(ShaderDiskCacheFile(0x1234, 1, hash).Load(TEST_FILE) ==
+            ShaderDiskCacheFileStatus::NewVersion);
+    REQUIRE(ShaderDiskCacheFile(0x1234, 2, {}).Load(TEST_FILE) ==
+            ShaderDiskCacheFileStatus::OtherBuild);
+    REQUIRE(ShaderDiskCacheFile(0x1234, 2, {}).Load("missing_" + std::string(TEST_FILE)) ==
+            ShaderDiskCacheFileStatus::NotFound);
+    REQUIRE(FileUtil::Delete(TEST_FILE));
+}
+
+TEST_CASE("ShaderDiskCache[Truncated]", "[video_core]") {
+    CreateTransferableFile(300);
+    const std::vector<u8> data = ReadTestFile();
+    auto file = ShaderDiskCacheOpenGL::MakeTransferableFile();
+
+    // Bytes of an entry that wasn't added to the index are ignored
+    std::vector<u8> partial_append = data;
+    partial_append.resize(data.size() + 0x30, 0xFF);
+    WriteTestFile(partial_append);
+    REQUIRE(file.Load(TEST_FILE) == ShaderDiskCacheFileStatus::Success);
+    REQUIRE(file.GetIndex().size() == 600);
+    file.Close();
+
+    // Cutting the file anywhere else loses entries the index points to, or the index itself
+    for (const std::size_t size : {data.size() - 1, data.size() / 2, std::size_t{0x100},
+                                   std::size_t{72}, std::size_t{10}}) {
+        WriteTestFile(std::vector<u8>(data.begin(), data.begin() + size));
+        REQUIRE(file.Load(TEST_FILE) == ShaderDiskCacheFileStatus::Corrupted);
+        REQUIRE(file.GetIndex().empty());
+        REQUIRE(!file.OpenForAppend(TEST_FILE));
+    }
+    REQUIRE(FileUtil::Delete(TEST_FILE));
+}
+
+TEST_CASE("ShaderDiskCache[MalformedEntries]", "[video_core]") {
+    FileUtil::Delete(TEST_FILE);
+    {
+        auto file = ShaderDiskCacheOpenGL::MakeTransferableFile();
+        REQUIRE(file.OpenForAppend(TEST_FILE));
+        std::vector<u8> raw = MakeRaw(1).Serialize();
+        raw.pop_back();
+        REQUIRE(file.Append(1, {}, ShaderDiskCacheEntryKind::Raw, raw));
+    }
+    auto file = ShaderDiskCacheOpenGL::MakeTransferableFile();
+    REQUIRE(file.Load(TEST_FILE) == ShaderDiskCacheFileStatus::Success);
+    auto entries = ShaderDiskCacheOpenGL::LoadTransferableEntries(file);
+    REQUIRE(entries);
+    REQUIRE(!entries->LoadRaw(0));
+
+    // Key counts past the end of the entry
+    REQUIRE(file.OpenForAppend(TEST_FILE));
+    std::vector<u8> usage(12);
+    const u32 num_keys = 0x10000000;
+    std::memcpy(usage.data(), &num_keys, sizeof(num_keys));
+    REQUIRE(file.Append(1, {}, ShaderDiskCacheEntryKind::Usage, usage));
+    REQUIRE(file.Load(TEST_FILE) == ShaderDiskCacheFileStatus::Success);
+    REQUIRE(!ShaderDiskCacheOpenGL::LoadTransferableEntries(file));
+
+    // Precompiled entries aren't valid transferable entries
+    file.Close();
+    REQUIRE(FileUtil::Delete(TEST_FILE));
+    REQUIRE(file.OpenForAppend(TEST_FILE));
+    REQUIRE(file.Append(1, {}, ShaderDiskCacheEntryKind::Dump, std::vector<u8>(12)));
+    REQUIRE(file.Load(TEST_FILE) == ShaderDiskCacheFileStatus::Success);
+    REQUIRE(!ShaderDiskCacheOpenGL::LoadTransferableEntries(file));
+
+    entries.reset();
+    file.Close();
+    REQUIRE(FileUtil::Delete(TEST_FILE));
+}
+
+} // namespace OpenGL
@@ -0,0 +1,117 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <optional>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "video_core/engines/shader_type.h"
+#include "video_core/renderer_opengl/gl_shader_disk_cache.h"
+#include "video_core/shader/const_buffer_locker.h"
+#include "video_core/shader/node_arena.h"
+#include "video_core/shader/node_helper.h"
+#include "video_core/shader/shader_ir.h"
+
+namespace VideoCommon::Shader {
+namespace {
+
+/// Main offsets used by the OpenGL shader cache, graphics stages skip the shader header.
+constexpr u32 STAGE_MAIN_OFFSET = 10;
+constexpr u32 KERNEL_MAIN_OFFSET = 0;
+
+struct DestructorCounter {
+    explicit DestructorCounter(int& count) : count{count} {}
+    ~DestructorCounter() {
+        ++count;
+    }
+
+    int& count;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("NodeArena[Lifetime]", "[video_core]") {
+    int destroyed = 0;
+    {
+        NodeArena arena;
+        for (int i = 0; i < 10000; ++i) {
+            arena.Create<DestructorCounter>(destroyed);
+        }
+        REQUIRE(destroyed == 0);
+        REQUIRE(arena.GetReservedBytes() >= 10000 * sizeof(DestructorCounter));
+    }
+    REQUIRE(destroyed == 10000);
+}
+
+TEST_CASE("NodeArena[Scope]", "[video_core]") {
+    NodeArena outer;
+    NodeArena inner;
+    NodeArena::Scope outer_scope{outer};
+    Node first = Immediate(1U);
+    {
+        NodeArena::Scope inner_scope{inner};
+        REQUIRE(&NodeArena::Current() == &inner);
+        Node second = Immediate(2U);
+        REQUIRE(std::get<ImmediateNode>(*second).GetValue() == 2);
+    }
+    REQUIRE(&NodeArena::Current() == &outer);
+    REQUIRE(std::get<ImmediateNode>(*first).GetValue() == 1);
+    REQUIRE(outer.GetReservedBytes() > 0);
+    REQUIRE(inner.GetReservedBytes() > 0);
+}
+
+/**
+ * Decodes every shader of a transferable shader cache pointed by YUZU_SHADER_CORPUS, reporting
+ * the time spent building the IR and the memory held by its nodes.
+ */
+TEST_CASE("ShaderIR[Benchmark]", "[video_core][.benchmark]") {
+    const char* const corpus_path = std::getenv("YUZU_SHADER_CORPUS");
+    if (corpus_path == nullptr) {
+        WARN("Set YUZU_SHADER_CORPUS to a transferable shader cache to run this benchmark");
+        return;
+    }
+    auto file = OpenGL::ShaderDiskCacheOpenGL::MakeTransferableFile();
+    REQUIRE(file.Load(corpus_path) == OpenGL::ShaderDiskCacheFileStatus::Success);
+    const auto entries = OpenGL::ShaderDiskCacheOpenGL::LoadTransferableEntries(file);
+    REQUIRE(entries);
+
+    const CompilerSettings settings{};
+    std::size_t num_shaders = 0;
+    std::size_t total_bytes = 0;
+    std::size_t peak_bytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < entries->raws.size(); ++i) {
+        const auto loaded_raw = entries->LoadRaw(i);
+        REQUIRE(loaded_raw);
+        const auto& raw = *loaded_raw;
+        const bool is_compute = raw.GetType() == Tegra::Engines::ShaderType::Compute;
+        const u32 main_offset = is_compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
+        ConstBufferLocker locker(raw.GetType());
+        const ShaderIR ir(raw.GetCode(), main_offset, settings, locker);
+        std::size_t shader_bytes = ir.GetNodeMemoryUsage();
+        if (raw.HasProgramA()) {
+            const ShaderIR ir_b(raw.GetCodeB(), main_offset, settings, locker);
+            shader_bytes += ir_b.GetNodeMemoryUsage();
+        }
+        total_bytes += shader_bytes;
+        peak_bytes = std::max(peak_bytes, shader_bytes);
+        ++num_shaders;
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    const double divisor = static_cast<double>(std::max<std::size_t>(num_shaders, 1));
+
+    fmt::print("{} shaders decoded in {:.2f} ms ({:.3f} ms/shader), node memory: "
+               "{:.2f} KiB peak, {:.2f} KiB average\n",
+               num_shaders, elapsed.count(), elapsed.count() / divisor, peak_bytes / 1024.0,
+               total_bytes / 1024.0 / divisor);
+}
+
+} // namespace VideoCommon::Shader
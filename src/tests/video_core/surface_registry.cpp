@@ -0,0 +1,209 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "video_core/gpu.h"
+#include "video_core/texture_cache/surface_registry.h"
+
+namespace VideoCommon {
+namespace {
+
+struct FakeSurface {
+    explicit FakeSurface(CacheAddr addr, std::size_t size) : addr{addr}, addr_end{addr + size} {}
+
+    CacheAddr GetCacheAddr() const {
+        return addr;
+    }
+
+    CacheAddr GetCacheAddrEnd() const {
+        return addr_end;
+    }
+
+    CacheAddr addr;
+    CacheAddr addr_end;
+};
+
+using TSurface = std::shared_ptr<FakeSurface>;
+using Registry = SurfaceRegistry<TSurface>;
+
+constexpr CacheAddr BASE_ADDR = 0x10000000;
+
+/// Page registry the texture cache used before SurfaceRegistry, kept to compare against.
+class UnorderedMapRegistry {
+public:
+    void Register(const TSurface& surface) {
+        for (u64 page = surface->addr >> Registry::PAGE_BITS;
+             page <= (surface->addr_end - 1) >> Registry::PAGE_BITS; ++page) {
+            registry[page].push_back(surface);
+        }
+    }
+
+    void Unregister(const TSurface& surface) {
+        for (u64 page = surface->addr >> Registry::PAGE_BITS;
+             page <= (surface->addr_end - 1) >> Registry::PAGE_BITS; ++page) {
+            auto& list = registry[page];
+            list.erase(std::find(list.begin(), list.end(), surface));
+        }
+    }
+
+    std::vector<TSurface> GetSurfacesInRegion(CacheAddr addr, std::size_t size) {
+        const CacheAddr addr_end = addr + size;
+        std::vector<TSurface> surfaces;
+        for (u64 page = addr >> Registry::PAGE_BITS; page <= (addr_end - 1) >> Registry::PAGE_BITS;
+             ++page) {
+            for (auto& surface : registry[page]) {
+                if (surface->addr < addr_end && surface->addr_end > addr &&
+                    std::find(surfaces.begin(), surfaces.end(), surface) == surfaces.end()) {
+                    surfaces.push_back(surface);
+                }
+            }
+        }
+        return surfaces;
+    }
+
+private:
+    std::unordered_map<u64, std::vector<TSurface>> registry;
+};
+
+enum class TraceOp { Register, Lookup, Invalidate };
+
+struct TraceEntry {
+    TraceOp op;
+    CacheAddr addr;
+    std::size_t size;
+};
+
+/// Generates a deterministic trace resembling a game streaming textures and render targets.
+std::vector<TraceEntry> GenerateTrace(std::size_t num_ops) {
+    std::mt19937 rng(0x5EED);
+    std::uniform_int_distribution<u32> op_dist(0, 9);
+    std::uniform_int_distribution<CacheAddr> addr_dist(0, 1024ULL * Registry::PAGE_SIZE);
+    std::uniform_int_distribution<std::size_t> size_dist(0x1000, 32 * Registry::PAGE_SIZE);
+
+    std::vector<TraceEntry> trace;
+    trace.reserve(num_ops);
+    for (std::size_t i = 0; i < num_ops; ++i) {
+        const u32 roll = op_dist(rng);
+        const TraceOp op = roll < 2 ? TraceOp::Register
+                                    : (roll < 8 ? TraceOp::Lookup : TraceOp::Invalidate);
+        const CacheAddr addr = BASE_ADDR + (addr_dist(rng) & ~CacheAddr{0xFFF});
+        trace.push_back({op, addr, size_dist(rng)});
+    }
+    return trace;
+}
+
+/// Replays a trace, returning the number of surfaces found by lookups.
+template <typename RegistryType>
+std::size_t ReplayTrace(RegistryType& registry, const std::vector<TraceEntry>& trace) {
+    std::size_t found = 0;
+    for (const TraceEntry& entry : trace) {
+        switch (entry.op) {
+        case TraceOp::Register:
+            registry.Register(std::make_shared<FakeSurface>(entry.addr, entry.size));
+            break;
+        case TraceOp::Lookup:
+            found += registry.GetSurfacesInRegion(entry.addr, entry.size).size();
+            break;
+        case TraceOp::Invalidate:
+            for (const auto& surface : registry.GetSurfacesInRegion(entry.addr, entry.size)) {
+                registry.Unregister(surface);
+            }
+            break;
+        }
+    }
+    return found;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("SurfaceRegistry[Query]", "[video_core]") {
+    Registry registry;
+    const auto small = std::make_shared<FakeSurface>(BASE_ADDR + 0x100, 0x100);
+    const auto large = std::make_shared<FakeSurface>(BASE_ADDR, 8 * Registry::PAGE_SIZE);
+    const auto far = std::make_shared<FakeSurface>(BASE_ADDR + 64 * Registry::PAGE_SIZE, 0x1000);
+    registry.Register(small);
+    registry.Register(large);
+    registry.Register(far);
+    REQUIRE(registry.GetNumSurfaces() == 3);
+
+    // Surfaces spanning several pages are returned once
+    const auto all = registry.GetSurfacesInRegion(BASE_ADDR, 128 * Registry::PAGE_SIZE);
+    REQUIRE(all == std::vector<TSurface>{small, large, far});
+
+    REQUIRE(registry.GetSurfacesInRegion(BASE_ADDR + 0x200, 0x100) == std::vector<TSurface>{large});
+    REQUIRE(registry.GetSurfacesInRegion(BASE_ADDR + 7 * Registry::PAGE_SIZE, 1) ==
+            std::vector<TSurface>{large});
+    REQUIRE(registry.GetSurfacesInRegion(BASE_ADDR + 32 * Registry::PAGE_SIZE, 0x1000).empty());
+    REQUIRE(registry.GetSurfacesInRegion(BASE_ADDR, 0).empty());
+
+    REQUIRE(registry.FindByAddress(BASE_ADDR + 0x100) == small);
+    REQUIRE(registry.FindByAddress(BASE_ADDR + 0x180) == nullptr);
+}
+
+TEST_CASE("SurfaceRegistry[Unregister]", "[video_core]") {
+    Registry registry;
+    std::vector<TSurface> surfaces;
+    for (std::size_t i = 0; i < 256; ++i) {
+        const CacheAddr addr = BASE_ADDR + i * Registry::PAGE_SIZE;
+        surfaces.push_back(std::make_shared<FakeSurface>(addr, 4 * Registry::PAGE_SIZE));
+        registry.Register(surfaces.back());
+    }
+    for (std::size_t i = 0; i < surfaces.size(); i += 2) {
+        registry.Unregister(surfaces[i]);
+    }
+    REQUIRE(registry.GetNumSurfaces() == 128);
+
+    const auto found = registry.GetSurfacesInRegion(BASE_ADDR, 512 * Registry::PAGE_SIZE);
+    REQUIRE(found.size() == 128);
+    for (std::size_t i = 0; i < found.size(); ++i) {
+        REQUIRE(found[i] == surfaces[i * 2 + 1]);
+    }
+
+    // Freed entries are reused by new surfaces
+    const auto reused = std::make_shared<FakeSurface>(BASE_ADDR, 0x1000);
+    registry.Register(reused);
+    REQUIRE(registry.FindByAddress(BASE_ADDR) == reused);
+}
+
+TEST_CASE("SurfaceRegistry[Trace]", "[video_core]") {
+    const auto trace = GenerateTrace(2000);
+    Registry registry;
+    UnorderedMapRegistry reference;
+    REQUIRE(ReplayTrace(registry, trace) == ReplayTrace(reference, trace));
+}
+
+/// Replays a synthetic register/lookup/invalidate trace on the registry and the unordered_map
+/// based one it replaced.
+TEST_CASE("SurfaceRegistry[Benchmark]", "[video_core][.benchmark]") {
+    const auto trace = GenerateTrace(200000);
+    const auto Measure = [&trace](auto& registry) {
+        const auto start = std::chrono::steady_clock::now();
+        const std::size_t found = ReplayTrace(registry, trace);
+        const std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        return std::make_pair(found, elapsed.count());
+    };
+    Registry registry;
+    UnorderedMapRegistry reference;
+    const auto [found, registry_ms] = Measure(registry);
+    const auto [reference_found, reference_ms] = Measure(reference);
+    REQUIRE(found == reference_found);
+
+    fmt::print("{} operations replayed: SurfaceRegistry {:.2f} ms, unordered_map {:.2f} ms\n",
+               trace.size(), registry_ms, reference_ms);
+}
+
+} // namespace VideoCommon
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include "common/microprofile.h"
 #include "core/core.h"
 #include "core/memory.h"
@@ -68,7 +69,8 @@ bool DmaPusher::Step() {
     gpu.MemoryManager().ReadBlockUnsafe(dma_get, command_headers.data(),
                                         command_list_header.size * sizeof(u32));
 
-    for (const CommandHeader& command_header : command_headers) {
+    for (std::size_t index = 0; index < command_headers.size();) {
+        const CommandHeader& command_header = command_headers[index];
 
         // now, see if we're in the middle of a command
         if (dma_state.length_pending) {
@@ -77,12 +79,20 @@ bool DmaPusher::Step() {
             dma_state.method_count = command_header.method_count_;
         } else if (dma_state.method_count) {
             // Data word of methods command
-            CallMethod(command_header.argument);
-
-            if (!dma_state.non_incrementing) {
-                dma_state.method++;
+            if (dma_state.non_incrementing) {
+                // Every remaining word in this list targets the same method, dispatch them in a
+                // single call.
+                const std::size_t max_write = std::min<std::size_t>(
+                    dma_state.method_count, command_headers.size() - index);
+                CallMultiMethod(&command_header.argument, static_cast<u32>(max_write));
+                dma_state.method_count -= static_cast<u32>(max_write);
+                index += max_write;
+                continue;
             }
 
+            CallMethod(command_header.argument);
+            dma_state.method++;
+
             if (dma_increment_once) {
                 dma_state.non_incrementing = true;
             }
@@ -117,6 +127,7 @@ bool DmaPusher::Step() {
                 break;
             }
         }
+        index++;
     }
 
     if (!non_main) {
@@ -137,4 +148,9 @@ void DmaPusher::CallMethod(u32 argument) const {
     gpu.CallMethod({dma_state.method, argument, dma_state.subchannel, dma_state.method_count});
 }
 
+void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
+    gpu.CallMultiMethod(dma_state.method, dma_state.subchannel, base_start, num_methods,
+                        dma_state.method_count);
+}
+
 } // namespace Tegra
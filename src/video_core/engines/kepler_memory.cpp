@@ -41,4 +41,24 @@ void KeplerMemory::CallMethod(const GPU::MethodCall& method_call) {
     }
 }
 
+void KeplerMemory::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
+                                   u32 methods_pending) {
+    switch (method) {
+    case KEPLERMEMORY_REG_INDEX(data): {
+        regs.reg_array[method] = base_start[amount - 1];
+        const bool is_last_call = amount == methods_pending;
+        upload_state.ProcessData(base_start, amount, is_last_call);
+        if (is_last_call) {
+            system.GPU().Maxwell3D().dirty.OnMemoryWrite();
+        }
+        break;
+    }
+    default:
+        for (u32 i = 0; i < amount; i++) {
+            CallMethod({method, base_start[i], 0, methods_pending - i});
+        }
+        break;
+    }
+}
+
 } // namespace Tegra::Engines
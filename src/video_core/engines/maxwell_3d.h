@@ -6,6 +6,7 @@
 
 #include <array>
 #include <bitset>
+#include <memory>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "video_core/engines/shader_type.h"
 #include "video_core/gpu.h"
 #include "video_core/macro_interpreter.h"
+#include "video_core/macro_jit_x64.h"
 #include "video_core/textures/texture.h"
 
 namespace Core {
@@ -1279,6 +1281,9 @@ public:
     /// Write the value to the register identified by method.
     void CallMethod(const GPU::MethodCall& method_call);
 
+    /// Write multiple values to the register identified by method.
+    void CallMultiMethod(u32 method, const u32* base_start, u32 amount, u32 methods_pending);
+
     /// Write the value to the register identified by method.
     void CallMethodFromMME(const GPU::MethodCall& method_call);
 
@@ -1353,6 +1358,8 @@ private:
 
     /// Interpreter for the macro codes uploaded to the GPU.
     MacroInterpreter macro_interpreter;
+    /// JIT compiler for the macro codes uploaded to the GPU, null when the interpreter is used.
+    std::unique_ptr<MacroJITx64> macro_jit;
 
     static constexpr u32 null_cb_data = 0xFFFFFFFF;
     struct {
@@ -1383,6 +1390,15 @@ private:
      */
     void CallMacroMethod(u32 method, std::size_t num_parameters, const u32* parameters);
 
+    /**
+     * Appends parameters to the macro that is being fed, calling it after the last one.
+     * @param method Macro method the parameters were written to
+     * @param base_start Pointer to the first parameter
+     * @param amount Number of parameters
+     * @param is_last_call Whether these are the last parameters in the command buffer
+     */
+    void ProcessMacro(u32 method, const u32* base_start, u32 amount, bool is_last_call);
+
     /// Handles writes to the macro uploading register.
     void ProcessMacroUpload(u32 data);
 
@@ -1407,6 +1423,7 @@ private:
     /// Handles a write to the CB_DATA[i] register.
     void StartCBData(u32 method);
     void ProcessCBData(u32 value);
+    void ProcessCBMultiData(u32 method, const u32* start_base, u32 amount);
     void FinishCBData();
 
     /// Handles a write to the CB_BIND register.
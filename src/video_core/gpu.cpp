@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <utility>
 #include "common/assert.h"
 #include "common/microprofile.h"
 #include "core/core.h"
@@ -228,16 +229,80 @@ void GPU::CallMethod(const MethodCall& method_call) {
 
     ASSERT(method_call.subchannel < bound_engines.size());
 
-    if (ExecuteMethodOnEngine(method_call)) {
+    const auto start = engine_stats_enabled ? std::chrono::steady_clock::now()
+                                            : std::chrono::steady_clock::time_point{};
+
+    if (ExecuteMethodOnEngine(method_call.method)) {
         CallEngineMethod(method_call);
     } else {
         CallPullerMethod(method_call);
     }
+
+    if (engine_stats_enabled) {
+        RecordEngineStats(method_call.method, method_call.subchannel, 1, start);
+    }
 }
 
-bool GPU::ExecuteMethodOnEngine(const MethodCall& method_call) {
-    const auto method = static_cast<BufferMethods>(method_call.method);
-    return method >= BufferMethods::NonPullerMethods;
+void GPU::CallMultiMethod(u32 method, u32 subchannel, const u32* base_start, u32 amount,
+                          u32 methods_pending) {
+    LOG_TRACE(HW_GPU, "Processing method {:08X} on subchannel {} with {} values", method,
+              subchannel, amount);
+
+    ASSERT(subchannel < bound_engines.size());
+
+    const auto start = engine_stats_enabled ? std::chrono::steady_clock::now()
+                                            : std::chrono::steady_clock::time_point{};
+
+    if (ExecuteMethodOnEngine(method)) {
+        CallEngineMultiMethod(method, subchannel, base_start, amount, methods_pending);
+    } else {
+        for (u32 i = 0; i < amount; i++) {
+            CallPullerMethod({method, base_start[i], subchannel, methods_pending - i});
+        }
+    }
+
+    if (engine_stats_enabled) {
+        RecordEngineStats(method, subchannel, amount, start);
+    }
+}
+
+bool GPU::ExecuteMethodOnEngine(u32 method) {
+    const auto buffer_method = static_cast<BufferMethods>(method);
+    return buffer_method >= BufferMethods::NonPullerMethods;
+}
+
+void GPU::RecordEngineStats(u32 method, u32 subchannel, u32 num_calls,
+                            std::chrono::steady_clock::time_point start) {
+    StatsEngine stats_engine = StatsEngine::Puller;
+    if (ExecuteMethodOnEngine(method)) {
+        switch (bound_engines[subchannel]) {
+        case EngineID::FERMI_TWOD_A:
+            stats_engine = StatsEngine::Fermi2D;
+            break;
+        case EngineID::MAXWELL_B:
+            stats_engine = StatsEngine::Maxwell3D;
+            break;
+        case EngineID::KEPLER_COMPUTE_B:
+            stats_engine = StatsEngine::KeplerCompute;
+            break;
+        case EngineID::MAXWELL_DMA_COPY_A:
+            stats_engine = StatsEngine::MaxwellDMA;
+            break;
+        case EngineID::KEPLER_INLINE_TO_MEMORY_B:
+            stats_engine = StatsEngine::KeplerMemory;
+            break;
+        default:
+            return;
+        }
+    }
+
+    EngineStats& stats = engine_stats[static_cast<std::size_t>(stats_engine)];
+    stats.method_calls += num_calls;
+    stats.time += std::chrono::steady_clock::now() - start;
+}
+
+GPU::EngineStatsArray GPU::GetAndResetEngineStats() {
+    return std::exchange(engine_stats, {});
 }
 
 void GPU::CallPullerMethod(const MethodCall& method_call) {
@@ -317,6 +382,31 @@ void GPU::CallEngineMethod(const MethodCall& method_call) {
     }
 }
 
+void GPU::CallEngineMultiMethod(u32 method, u32 subchannel, const u32* base_start, u32 amount,
+                                u32 methods_pending) {
+    const EngineID engine = bound_engines[subchannel];
+
+    switch (engine) {
+    case EngineID::FERMI_TWOD_A:
+        fermi_2d->CallMultiMethod(method, base_start, amount, methods_pending);
+        break;
+    case EngineID::MAXWELL_B:
+        maxwell_3d->CallMultiMethod(method, base_start, amount, methods_pending);
+        break;
+    case EngineID::KEPLER_COMPUTE_B:
+        kepler_compute->CallMultiMethod(method, base_start, amount, methods_pending);
+        break;
+    case EngineID::MAXWELL_DMA_COPY_A:
+        maxwell_dma->CallMultiMethod(method, base_start, amount, methods_pending);
+        break;
+    case EngineID::KEPLER_INLINE_TO_MEMORY_B:
+        kepler_memory->CallMultiMethod(method, base_start, amount, methods_pending);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unimplemented engine");
+    }
+}
+
 void GPU::ProcessBindMethod(const MethodCall& method_call) {
     // Bind the current subchannel to the desired engine id.
     LOG_DEBUG(HW_GPU, "Binding subchannel {} to engine {}", method_call.subchannel,
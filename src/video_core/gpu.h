@@ -6,6 +6,7 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -154,6 +155,10 @@ public:
     /// Calls a GPU method.
     void CallMethod(const MethodCall& method_call);
 
+    /// Calls a GPU multivalue method.
+    void CallMultiMethod(u32 method, u32 subchannel, const u32* base_start, u32 amount,
+                         u32 methods_pending);
+
     void FlushCommands();
 
     /// Returns a reference to the Maxwell3D GPU engine.
@@ -202,6 +207,33 @@ public:
     /// Returns a const reference to the GPU DMA pusher.
     const Tegra::DmaPusher& DmaPusher() const;
 
+    /// Units that method calls are dispatched to, used to index the engine statistics.
+    enum class StatsEngine : std::size_t {
+        Puller,
+        Fermi2D,
+        Maxwell3D,
+        KeplerCompute,
+        MaxwellDMA,
+        KeplerMemory,
+    };
+    static constexpr std::size_t NumStatsEngines = 6;
+
+    /// Number of method calls executed by an engine and the time spent executing them.
+    struct EngineStats {
+        u64 method_calls{};
+        std::chrono::nanoseconds time{};
+    };
+    using EngineStatsArray = std::array<EngineStats, NumStatsEngines>;
+
+    /// Enables gathering statistics about the methods executed by each engine. Timing every call
+    /// adds a noticeable overhead, so this is only meant to be used by profiling tools.
+    void SetEngineStatsEnabled(bool enabled) {
+        engine_stats_enabled = enabled;
+    }
+
+    /// Returns the engine statistics gathered since the last call and resets them.
+    EngineStatsArray GetAndResetEngineStats();
+
     struct Regs {
         static constexpr size_t NUM_REGS = 0x100;
 
@@ -282,8 +314,16 @@ private:
     /// Calls a GPU engine method.
     void CallEngineMethod(const MethodCall& method_call);
 
+    /// Calls a GPU engine multivalue method.
+    void CallEngineMultiMethod(u32 method, u32 subchannel, const u32* base_start, u32 amount,
+                               u32 methods_pending);
+
     /// Determines where the method should be executed.
-    bool ExecuteMethodOnEngine(const MethodCall& method_call);
+    bool ExecuteMethodOnEngine(u32 method);
+
+    /// Accounts the method calls executed since start to the engine they were dispatched to.
+    void RecordEngineStats(u32 method, u32 subchannel, u32 num_calls,
+                           std::chrono::steady_clock::time_point start);
 
 protected:
     std::unique_ptr<Tegra::DmaPusher> dma_pusher;
@@ -312,6 +352,9 @@ private:
 
     std::mutex sync_mutex;
 
+    bool engine_stats_enabled = false;
+    EngineStatsArray engine_stats{};
+
     const bool is_async;
 };
 
@@ -2,13 +2,21 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <ctime>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
 #include "common/assert.h"
+#include "common/common_paths.h"
+#include "common/file_util.h"
 #include "common/microprofile.h"
 #include "core/core.h"
 #include "core/frontend/scope_acquire_window_context.h"
+#include "core/hle/kernel/process.h"
+#include "core/settings.h"
 #include "video_core/dma_pusher.h"
 #include "video_core/gpu.h"
 #include "video_core/gpu_thread.h"
+#include "video_core/pushbuffer_capture.h"
 #include "video_core/renderer_base.h"
 
 namespace VideoCommon::GPUThread {
@@ -19,8 +27,7 @@ static void RunThread(VideoCore::RendererBase& renderer, Tegra::DmaPusher& dma_p
     MicroProfileOnThreadCreate("GpuThread");
 
     // Wait for first GPU command before acquiring the window context
-    while (state.queue.Empty())
-        ;
+    state.queue.WaitNotEmpty();
 
     // If emulation was stopped during disk shader loading, abort before trying to acquire context
     if (!state.is_running) {
@@ -67,10 +74,16 @@ void ThreadManager::StartThread(VideoCore::RendererBase& renderer, Tegra::DmaPus
 }
 
 void ThreadManager::SubmitList(Tegra::CommandList&& entries) {
+    if (const auto recorder = GetRecorder()) {
+        recorder->RecordCommandList(entries);
+    }
     PushCommand(SubmitListCommand(std::move(entries)));
 }
 
 void ThreadManager::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
+    if (const auto recorder = GetRecorder()) {
+        recorder->RecordFrameEnd();
+    }
     PushCommand(SwapBuffersCommand(framebuffer ? std::make_optional(*framebuffer) : std::nullopt));
 }
 
@@ -94,8 +107,37 @@ void ThreadManager::WaitIdle() const {
 
 u64 ThreadManager::PushCommand(CommandData&& command_data) {
     const u64 fence{++state.last_fence};
-    state.queue.Push(CommandDataContainer(std::move(command_data), fence));
+    state.queue.Emplace(std::move(command_data), fence);
     return fence;
 }
 
+Tegra::PushbufferRecorder* ThreadManager::GetRecorder() {
+    if (!Settings::values.record_pushbuffers || recorder_failed) {
+        return nullptr;
+    }
+    if (recorder) {
+        return recorder.get();
+    }
+
+    const std::string path =
+        FileUtil::GetUserPath(FileUtil::UserPath::DumpDir) + "pushbuffers" DIR_SEP;
+    const std::time_t t = std::time(nullptr);
+    // %F Date format expanded is "%Y-%m-%d"
+    const std::string filename = fmt::format("{}{:016X}_{:%F-%H-%M-%S}.ypb", path,
+                                             system.CurrentProcess()->GetTitleID(),
+                                             *std::localtime(&t));
+    if (!FileUtil::CreateFullPath(filename)) {
+        LOG_ERROR(HW_GPU, "Failed to create pushbuffer capture directory {}", path);
+        recorder_failed = true;
+        return nullptr;
+    }
+
+    recorder = std::make_unique<Tegra::PushbufferRecorder>(system.GPU().MemoryManager(), filename);
+    if (!recorder->IsOpen()) {
+        recorder.reset();
+        recorder_failed = true;
+    }
+    return recorder.get();
+}
+
 } // namespace VideoCommon::GPUThread
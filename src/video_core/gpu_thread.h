@@ -6,6 +6,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <thread>
@@ -17,6 +18,7 @@
 namespace Tegra {
 struct FramebufferConfig;
 class DmaPusher;
+class PushbufferRecorder;
 } // namespace Tegra
 
 namespace Core {
@@ -86,7 +88,10 @@ struct CommandDataContainer {
 struct SynchState final {
     std::atomic_bool is_running{true};
 
-    using CommandQueue = Common::SPSCQueue<CommandDataContainer>;
+    /// Maximum number of commands in flight, the CPU waits for the GPU thread past this point.
+    static constexpr std::size_t MaxPendingCommands = 1024;
+
+    using CommandQueue = Common::BoundedSPSCQueue<CommandDataContainer, MaxPendingCommands>;
     CommandQueue queue;
     u64 last_fence{};
     std::atomic<u64> signaled_fence{};
@@ -123,11 +128,18 @@ private:
     /// Pushes a command to be executed by the GPU thread
     u64 PushCommand(CommandData&& command_data);
 
+    /// Returns the pushbuffer recorder, creating it on first use. Returns nullptr when recording
+    /// is disabled or the capture file couldn't be created.
+    Tegra::PushbufferRecorder* GetRecorder();
+
 private:
     SynchState state;
     Core::System& system;
     std::thread thread;
     std::thread::id thread_id;
+
+    std::unique_ptr<Tegra::PushbufferRecorder> recorder;
+    bool recorder_failed = false;
 };
 
 } // namespace VideoCommon::GPUThread
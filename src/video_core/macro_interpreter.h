@@ -7,8 +7,8 @@
 #include <array>
 #include <optional>
 
-#include "common/bit_field.h"
 #include "common/common_types.h"
+#include "video_core/macro_opcode.h"
 
 namespace Tegra {
 namespace Engines {
@@ -27,17 +27,11 @@ public:
     void Execute(u32 offset, std::size_t num_parameters, const u32* parameters);
 
 private:
-    enum class ALUOperation : u32;
-    enum class BranchCondition : u32;
-    enum class ResultOperation : u32;
-
-    union Opcode;
-
-    union MethodAddress {
-        u32 raw;
-        BitField<0, 12, u32> address;
-        BitField<12, 6, u32> increment;
-    };
+    using ALUOperation = Macro::ALUOperation;
+    using BranchCondition = Macro::BranchCondition;
+    using ResultOperation = Macro::ResultOperation;
+    using Opcode = Macro::Opcode;
+    using MethodAddress = Macro::MethodAddress;
 
     /// Resets the execution engine state, zeroing registers, etc.
     void Reset();
@@ -89,10 +83,8 @@ private:
     /// Program counter to execute at after the delay slot is executed.
     std::optional<u32> delayed_pc;
 
-    static constexpr std::size_t NumMacroRegisters = 8;
-
     /// General purpose macro registers.
-    std::array<u32, NumMacroRegisters> registers = {};
+    std::array<u32, Macro::NUM_MACRO_REGISTERS> registers = {};
 
     /// Method address to use for the next Send instruction.
     MethodAddress method_address = {};
@@ -0,0 +1,472 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include <xbyak.h>
+
+#include "common/assert.h"
+#include "common/hash.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/macro_interpreter.h"
+#include "video_core/macro_jit_x64.h"
+#include "video_core/macro_opcode.h"
+
+MICROPROFILE_DEFINE(MacroJitCompile, "GPU", "Compile macro JIT", MP_RGB(173, 255, 47));
+MICROPROFILE_DEFINE(MacroJitExecute, "GPU", "Execute macro JIT", MP_RGB(255, 255, 0));
+
+namespace Tegra {
+
+using namespace Macro;
+
+namespace {
+
+/// Upper bound of host code emitted for a single macro instruction, including its delay slot.
+constexpr std::size_t MAX_CODE_SIZE_PER_INSTRUCTION = 256;
+/// Host code reserved for the prologue and the epilogue of a compiled macro.
+constexpr std::size_t CODE_SIZE_OVERHEAD = 4096;
+
+/// State shared between the compiled code and the host.
+struct JITState {
+    Engines::Maxwell3D* maxwell3d{};
+    std::array<u32, NUM_MACRO_REGISTERS> registers{};
+    /// Parameter pointer after execution, used to validate that every parameter was consumed.
+    const u32* parameters{};
+    u8 carry_flag{};
+};
+static_assert(std::is_standard_layout_v<JITState>, "JITState must be standard layout");
+
+using ProgramType = void (*)(JITState* state, const u32* parameters);
+
+// Every register holding state across instructions is callee saved, so it survives the calls
+// back into Maxwell3D.
+const Xbyak::Reg64 STATE = Xbyak::util::rbx;
+const Xbyak::Reg32 RESULT = Xbyak::util::ebp;
+const Xbyak::Reg64 PARAMETERS = Xbyak::util::r12;
+const Xbyak::Reg32 METHOD_ADDRESS = Xbyak::util::r13d;
+
+#ifdef _WIN32
+const Xbyak::Reg64 ABI_PARAM1 = Xbyak::util::rcx;
+const Xbyak::Reg64 ABI_PARAM2 = Xbyak::util::rdx;
+const Xbyak::Reg32 ABI_PARAM2_32 = Xbyak::util::edx;
+const Xbyak::Reg32 ABI_PARAM3_32 = Xbyak::util::r8d;
+/// Shadow space for the callee and padding to keep the stack aligned to 16 bytes on calls.
+constexpr u32 STACK_RESERVE = 32 + 8;
+#else
+const Xbyak::Reg64 ABI_PARAM1 = Xbyak::util::rdi;
+const Xbyak::Reg64 ABI_PARAM2 = Xbyak::util::rsi;
+const Xbyak::Reg32 ABI_PARAM2_32 = Xbyak::util::esi;
+const Xbyak::Reg32 ABI_PARAM3_32 = Xbyak::util::edx;
+/// Padding to keep the stack aligned to 16 bytes on calls.
+constexpr u32 STACK_RESERVE = 8;
+#endif
+
+void Send(Engines::Maxwell3D* maxwell3d, u32 method_address, u32 value) {
+    maxwell3d->CallMethodFromMME({MethodAddress{method_address}.address, value});
+}
+
+u32 Read(Engines::Maxwell3D* maxwell3d, u32 method) {
+    return maxwell3d->GetRegisterValue(method);
+}
+
+/**
+ * Returns the code of the macro starting at the specified offset. Code is reachable up to the
+ * first exit instruction (plus its delay slot) that no branch jumps over.
+ * @returns The macro code, or std::nullopt if its end couldn't be determined.
+ */
+std::optional<std::vector<u32>> ExtractMacroCode(const Engines::Maxwell3D::MacroMemory& memory,
+                                                 u32 offset) {
+    std::size_t furthest_target = offset;
+    for (std::size_t pc = offset; pc < memory.size(); ++pc) {
+        const Opcode opcode{memory[pc]};
+        if (opcode.operation == Operation::Branch) {
+            const s64 target = static_cast<s64>(pc) + opcode.immediate.Value();
+            if (target < static_cast<s64>(offset) || target >= static_cast<s64>(memory.size())) {
+                return std::nullopt;
+            }
+            furthest_target = std::max(furthest_target, static_cast<std::size_t>(target));
+        }
+        if (opcode.is_exit && pc >= furthest_target) {
+            const std::size_t end = std::min(pc + 2, memory.size());
+            return std::vector<u32>(memory.begin() + offset, memory.begin() + end);
+        }
+    }
+    return std::nullopt;
+}
+
+} // Anonymous namespace
+
+class MacroJITx64::CompiledMacro final : public Xbyak::CodeGenerator {
+public:
+    explicit CompiledMacro(const std::vector<u32>& code)
+        : Xbyak::CodeGenerator(code.size() * MAX_CODE_SIZE_PER_INSTRUCTION +
+                               CODE_SIZE_OVERHEAD) {
+        try {
+            is_valid = Compile(code);
+        } catch (const Xbyak::Error& error) {
+            LOG_ERROR(HW_GPU, "Failed to emit macro code: {}", error.what());
+            is_valid = false;
+        }
+    }
+
+    /// Returns true when the whole macro was translated.
+    bool IsValid() const {
+        return is_valid;
+    }
+
+    void Execute(JITState& state, const u32* parameters) const {
+        program(&state, parameters);
+    }
+
+private:
+    bool Compile(const std::vector<u32>& code);
+
+    /// Compiles a non-branch instruction, the exit flag is handled by the caller.
+    bool CompileInstruction(Opcode opcode);
+
+    /// Emits an ALU operation, leaving the result in eax.
+    bool CompileALU(ALUOperation operation, u32 src_a, u32 src_b);
+
+    /// Emits the result operation for the value held in eax.
+    void CompileProcessResult(ResultOperation operation, u32 reg);
+
+    void LoadRegister(const Xbyak::Reg32& dest, u32 reg);
+    void StoreRegister(u32 reg, const Xbyak::Reg32& value);
+    void FetchParameter(const Xbyak::Reg32& dest);
+    void CompileSend(const Xbyak::Reg32& value);
+
+    template <typename T>
+    void CallFunction(T* function) {
+        mov(rax, reinterpret_cast<std::size_t>(function));
+        call(rax);
+    }
+
+    ProgramType program{};
+    bool is_valid = false;
+};
+
+bool MacroJITx64::CompiledMacro::Compile(const std::vector<u32>& code) {
+    const std::size_t num_instructions = code.size();
+    std::vector<Xbyak::Label> labels(num_instructions);
+    Xbyak::Label end_of_program;
+
+    push(rbx);
+    push(rbp);
+    push(r12);
+    push(r13);
+    sub(rsp, STACK_RESERVE);
+
+    mov(STATE, ABI_PARAM1);
+    mov(PARAMETERS, ABI_PARAM2);
+    xor_(METHOD_ADDRESS, METHOD_ADDRESS);
+
+    for (std::size_t pc = 0; pc < num_instructions; ++pc) {
+        L(labels[pc]);
+
+        const Opcode opcode{code[pc]};
+        const bool has_delay_slot = pc + 1 < num_instructions;
+
+        if (opcode.operation == Operation::Branch) {
+            const s64 target = static_cast<s64>(pc) + opcode.immediate.Value();
+            if (target < 0 || target >= static_cast<s64>(num_instructions)) {
+                return false;
+            }
+
+            Xbyak::Label not_taken;
+            LoadRegister(eax, opcode.src_a);
+            test(eax, eax);
+            if (opcode.branch_condition == BranchCondition::Zero) {
+                jnz(not_taken, T_NEAR);
+            } else {
+                jz(not_taken, T_NEAR);
+            }
+            // Unless the branch is annulled, the next instruction is executed before jumping.
+            if (!opcode.branch_annul) {
+                if (!has_delay_slot || !CompileInstruction(Opcode{code[pc + 1]})) {
+                    return false;
+                }
+            }
+            jmp(labels[static_cast<std::size_t>(target)], T_NEAR);
+            L(not_taken);
+        } else if (!CompileInstruction(opcode)) {
+            return false;
+        }
+
+        // An instruction with the exit flag ends the program once its delay slot is executed. The
+        // flag is ignored when the instruction itself is in a delay slot.
+        if (opcode.is_exit) {
+            if (has_delay_slot && !CompileInstruction(Opcode{code[pc + 1]})) {
+                return false;
+            }
+            jmp(end_of_program, T_NEAR);
+        }
+    }
+
+    L(end_of_program);
+    mov(qword[STATE + offsetof(JITState, parameters)], PARAMETERS);
+    add(rsp, STACK_RESERVE);
+    pop(r13);
+    pop(r12);
+    pop(rbp);
+    pop(rbx);
+    ret();
+
+    program = getCode<ProgramType>();
+    return true;
+}
+
+bool MacroJITx64::CompiledMacro::CompileInstruction(Opcode opcode) {
+    switch (opcode.operation) {
+    case Operation::ALU:
+        if (!CompileALU(opcode.alu_operation, opcode.src_a, opcode.src_b)) {
+            return false;
+        }
+        break;
+    case Operation::AddImmediate:
+        LoadRegister(eax, opcode.src_a);
+        add(eax, static_cast<u32>(opcode.immediate.Value()));
+        break;
+    case Operation::ExtractInsert: {
+        const u32 mask = opcode.GetBitfieldMask();
+        LoadRegister(eax, opcode.src_a);
+        LoadRegister(ecx, opcode.src_b);
+        shr(ecx, static_cast<int>(opcode.bf_src_bit.Value()));
+        and_(ecx, mask);
+        shl(ecx, static_cast<int>(opcode.bf_dst_bit.Value()));
+        and_(eax, ~(mask << opcode.bf_dst_bit));
+        or_(eax, ecx);
+        break;
+    }
+    case Operation::ExtractShiftLeftImmediate:
+        LoadRegister(ecx, opcode.src_a);
+        LoadRegister(eax, opcode.src_b);
+        shr(eax, cl);
+        and_(eax, opcode.GetBitfieldMask());
+        shl(eax, static_cast<int>(opcode.bf_dst_bit.Value()));
+        break;
+    case Operation::ExtractShiftLeftRegister:
+        LoadRegister(ecx, opcode.src_a);
+        LoadRegister(eax, opcode.src_b);
+        shr(eax, static_cast<int>(opcode.bf_src_bit.Value()));
+        and_(eax, opcode.GetBitfieldMask());
+        shl(eax, cl);
+        break;
+    case Operation::Read:
+        LoadRegister(ABI_PARAM2_32, opcode.src_a);
+        add(ABI_PARAM2_32, static_cast<u32>(opcode.immediate.Value()));
+        mov(ABI_PARAM1, qword[STATE + offsetof(JITState, maxwell3d)]);
+        CallFunction(&Read);
+        break;
+    case Operation::Branch:
+        LOG_ERROR(HW_GPU, "Executing a branch in a delay slot is not valid");
+        return false;
+    default:
+        LOG_ERROR(HW_GPU, "Unimplemented macro operation {}",
+                  static_cast<u32>(opcode.operation.Value()));
+        return false;
+    }
+
+    CompileProcessResult(opcode.result_operation, opcode.dst);
+    return true;
+}
+
+bool MacroJITx64::CompiledMacro::CompileALU(ALUOperation operation, u32 src_a, u32 src_b) {
+    // Operands are loaded before the carry flag is, zeroing a register clobbers the host flags.
+    LoadRegister(eax, src_a);
+    LoadRegister(ecx, src_b);
+
+    const auto carry_flag = byte[STATE + offsetof(JITState, carry_flag)];
+    switch (operation) {
+    case ALUOperation::Add:
+        add(eax, ecx);
+        setc(carry_flag);
+        break;
+    case ALUOperation::AddWithCarry:
+        // Sets the host carry flag when the macro carry flag is set.
+        cmp(carry_flag, 1);
+        cmc();
+        adc(eax, ecx);
+        setc(carry_flag);
+        break;
+    case ALUOperation::Subtract:
+        // The macro carry flag is set when the subtraction does not borrow.
+        sub(eax, ecx);
+        setnc(carry_flag);
+        break;
+    case ALUOperation::SubtractWithBorrow:
+        // Sets the host carry flag (borrow) when the macro carry flag is clear.
+        cmp(carry_flag, 1);
+        sbb(eax, ecx);
+        setnc(carry_flag);
+        break;
+    case ALUOperation::Xor:
+        xor_(eax, ecx);
+        break;
+    case ALUOperation::Or:
+        or_(eax, ecx);
+        break;
+    case ALUOperation::And:
+        and_(eax, ecx);
+        break;
+    case ALUOperation::AndNot:
+        not_(ecx);
+        and_(eax, ecx);
+        break;
+    case ALUOperation::Nand:
+        and_(eax, ecx);
+        not_(eax);
+        break;
+    default:
+        LOG_ERROR(HW_GPU, "Unimplemented ALU operation {}", static_cast<u32>(operation));
+        return false;
+    }
+    return true;
+}
+
+void MacroJITx64::CompiledMacro::CompileProcessResult(ResultOperation operation, u32 reg) {
+    mov(RESULT, eax);
+
+    switch (operation) {
+    case ResultOperation::IgnoreAndFetch:
+        FetchParameter(eax);
+        StoreRegister(reg, eax);
+        break;
+    case ResultOperation::Move:
+        StoreRegister(reg, RESULT);
+        break;
+    case ResultOperation::MoveAndSetMethod:
+        StoreRegister(reg, RESULT);
+        mov(METHOD_ADDRESS, RESULT);
+        break;
+    case ResultOperation::FetchAndSend:
+        FetchParameter(eax);
+        StoreRegister(reg, eax);
+        CompileSend(RESULT);
+        break;
+    case ResultOperation::MoveAndSend:
+        StoreRegister(reg, RESULT);
+        CompileSend(RESULT);
+        break;
+    case ResultOperation::FetchAndSetMethod:
+        FetchParameter(eax);
+        StoreRegister(reg, eax);
+        mov(METHOD_ADDRESS, RESULT);
+        break;
+    case ResultOperation::MoveAndSetMethodFetchAndSend:
+        StoreRegister(reg, RESULT);
+        mov(METHOD_ADDRESS, RESULT);
+        FetchParameter(eax);
+        CompileSend(eax);
+        break;
+    case ResultOperation::MoveAndSetMethodSend:
+        StoreRegister(reg, RESULT);
+        mov(METHOD_ADDRESS, RESULT);
+        mov(eax, RESULT);
+        shr(eax, 12);
+        and_(eax, 0b111111);
+        CompileSend(eax);
+        break;
+    }
+}
+
+void MacroJITx64::CompiledMacro::LoadRegister(const Xbyak::Reg32& dest, u32 reg) {
+    // Register 0 is hardwired as the zero register.
+    if (reg == 0) {
+        xor_(dest, dest);
+        return;
+    }
+    mov(dest, dword[STATE + offsetof(JITState, registers) + reg * sizeof(u32)]);
+}
+
+void MacroJITx64::CompiledMacro::StoreRegister(u32 reg, const Xbyak::Reg32& value) {
+    if (reg == 0) {
+        return;
+    }
+    mov(dword[STATE + offsetof(JITState, registers) + reg * sizeof(u32)], value);
+}
+
+void MacroJITx64::CompiledMacro::FetchParameter(const Xbyak::Reg32& dest) {
+    mov(dest, dword[PARAMETERS]);
+    add(PARAMETERS, static_cast<u32>(sizeof(u32)));
+}
+
+void MacroJITx64::CompiledMacro::CompileSend(const Xbyak::Reg32& value) {
+    mov(ABI_PARAM3_32, value);
+    mov(ABI_PARAM2_32, METHOD_ADDRESS);
+    mov(ABI_PARAM1, qword[STATE + offsetof(JITState, maxwell3d)]);
+    CallFunction(&Send);
+
+    // Increment the method address by the method increment.
+    mov(eax, METHOD_ADDRESS);
+    shr(eax, 12);
+    and_(eax, 0b111111);
+    add(eax, METHOD_ADDRESS);
+    and_(eax, 0xFFF);
+    and_(METHOD_ADDRESS, ~0xFFFU);
+    or_(METHOD_ADDRESS, eax);
+}
+
+MacroJITx64::MacroJITx64(Engines::Maxwell3D& maxwell3d, MacroInterpreter& interpreter)
+    : maxwell3d{maxwell3d}, interpreter{interpreter} {}
+
+MacroJITx64::~MacroJITx64() = default;
+
+void MacroJITx64::Execute(u32 offset, std::size_t num_parameters, const u32* parameters) {
+    if (code_dirty) {
+        offset_cache.clear();
+        code_dirty = false;
+    }
+
+    auto [it, is_new] = offset_cache.try_emplace(offset);
+    if (is_new) {
+        it->second = Compile(offset);
+    }
+    CompiledMacro* const compiled = it->second;
+    if (!compiled) {
+        interpreter.Execute(offset, num_parameters, parameters);
+        return;
+    }
+
+    MICROPROFILE_SCOPE(MacroJitExecute);
+
+    JITState state;
+    state.maxwell3d = &maxwell3d;
+    state.registers[1] = parameters[0];
+    // The first parameter is already in $r1, the 'parm' instruction starts fetching after it.
+    compiled->Execute(state, parameters + 1);
+
+    // Assert the the macro used all the input parameters
+    ASSERT(state.parameters == parameters + num_parameters);
+}
+
+MacroJITx64::CompiledMacro* MacroJITx64::Compile(u32 offset) {
+    MICROPROFILE_SCOPE(MacroJitCompile);
+
+    const auto code = ExtractMacroCode(maxwell3d.GetMacroMemory(), offset);
+    if (!code) {
+        LOG_WARNING(HW_GPU, "Unable to find the end of the macro at offset {}, interpreting it",
+                    offset);
+        return nullptr;
+    }
+
+    const u64 hash = Common::ComputeHash64(code->data(), code->size() * sizeof(u32));
+    if (const auto it = compiled_macros.find(hash); it != compiled_macros.end()) {
+        return it->second.get();
+    }
+
+    auto compiled = std::make_unique<CompiledMacro>(*code);
+    if (!compiled->IsValid()) {
+        LOG_WARNING(HW_GPU, "Unable to compile the macro at offset {}, interpreting it", offset);
+        return nullptr;
+    }
+    return compiled_macros.emplace(hash, std::move(compiled)).first->second.get();
+}
+
+} // namespace Tegra
@@ -0,0 +1,60 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include "common/common_types.h"
+
+namespace Tegra {
+namespace Engines {
+class Maxwell3D;
+}
+
+class MacroInterpreter;
+
+/**
+ * Just-in-time compiler that translates macro code uploaded to Maxwell3D into x86-64 code.
+ * Macros are compiled the first time they are executed and cached by the hash of their code, so
+ * re-uploading an identical macro does not recompile it. Programs the JIT can't translate are
+ * executed through the interpreter.
+ */
+class MacroJITx64 final {
+public:
+    explicit MacroJITx64(Engines::Maxwell3D& maxwell3d, MacroInterpreter& interpreter);
+    ~MacroJITx64();
+
+    /**
+     * Executes the macro code with the specified input parameters.
+     * @param offset Offset to start execution at.
+     * @param parameters The parameters of the macro.
+     */
+    void Execute(u32 offset, std::size_t num_parameters, const u32* parameters);
+
+    /// Notifies the JIT that macro memory has been written, previous lookups are no longer valid.
+    void InvalidateCode() {
+        code_dirty = true;
+    }
+
+private:
+    class CompiledMacro;
+
+    /// Compiles the macro starting at the specified offset, returns nullptr when it can't be
+    /// translated.
+    CompiledMacro* Compile(u32 offset);
+
+    Engines::Maxwell3D& maxwell3d;
+    MacroInterpreter& interpreter;
+
+    /// Compiled macros, indexed by the hash of their code.
+    std::unordered_map<u64, std::unique_ptr<CompiledMacro>> compiled_macros;
+    /// Compiled macro for each start offset. Invalidated when macro memory is modified.
+    std::unordered_map<u32, CompiledMacro*> offset_cache;
+
+    bool code_dirty = false;
+};
+
+} // namespace Tegra
@@ -95,6 +95,28 @@ GPUVAddr MemoryManager::UnmapBuffer(GPUVAddr gpu_addr, u64 size) {
     return gpu_addr;
 }
 
+void MemoryManager::MapHostMemory(GPUVAddr gpu_addr, u8* memory, u64 size) {
+    ASSERT((gpu_addr & page_mask) == 0);
+
+    MapBackingMemory(gpu_addr, memory, Common::AlignUp(size, page_size), 0);
+}
+
+void MemoryManager::UnmapHostMemory(GPUVAddr gpu_addr, u64 size) {
+    ASSERT((gpu_addr & page_mask) == 0);
+
+    UnmapRange(gpu_addr, Common::AlignUp(size, page_size));
+}
+
+std::vector<VirtualMemoryArea> MemoryManager::GetMappedAreas() const {
+    std::vector<VirtualMemoryArea> areas;
+    for (const auto& [base, vma] : vma_map) {
+        if (vma.type == VirtualMemoryArea::Type::Mapped) {
+            areas.push_back(vma);
+        }
+    }
+    return areas;
+}
+
 GPUVAddr MemoryManager::FindFreeRegion(GPUVAddr region_start, u64 size) const {
     // Find the first Free VMA.
     const VMAHandle vma_handle{
@@ -6,6 +6,7 @@
 
 #include <map>
 #include <optional>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/page_table.h"
@@ -61,6 +62,22 @@ public:
     GPUVAddr UnmapBuffer(GPUVAddr addr, u64 size);
     std::optional<VAddr> GpuToCpuAddress(GPUVAddr addr) const;
 
+    /**
+     * Maps host memory that isn't owned by the emulated process at the given address. This is
+     * used to back the address space when command lists are replayed without a running title.
+     *
+     * @param addr   The page aligned GPU address to start the mapping at.
+     * @param memory The host memory to be mapped, it must remain valid while mapped.
+     * @param size   Size of the mapping in bytes.
+     */
+    void MapHostMemory(GPUVAddr addr, u8* memory, u64 size);
+
+    /// Unmaps a range of addresses previously mapped with MapHostMemory.
+    void UnmapHostMemory(GPUVAddr addr, u64 size);
+
+    /// Returns the areas of the address space that are mapped to memory, sorted by address.
+    std::vector<VirtualMemoryArea> GetMappedAreas() const;
+
     template <typename T>
     T Read(GPUVAddr addr) const;
 
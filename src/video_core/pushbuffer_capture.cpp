@@ -0,0 +1,206 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#include "common/common_funcs.h"
+#include "common/logging/log.h"
+#include "common/swap.h"
+#include "common/zstd_compression.h"
+#include "video_core/memory_manager.h"
+#include "video_core/pushbuffer_capture.h"
+
+namespace Tegra {
+
+namespace {
+
+constexpr u32 CAPTURE_MAGIC = Common::MakeMagic('Y', 'P', 'B', 'C');
+constexpr u32 CAPTURE_VERSION = 1;
+
+enum class RecordType : u32 {
+    MemoryMap = 0,
+    CommandList = 1,
+    FrameEnd = 2,
+};
+
+struct FileHeader {
+    u32_le magic;
+    u32_le version;
+};
+static_assert(sizeof(FileHeader) == 0x8, "FileHeader has incorrect size.");
+
+struct RecordHeader {
+    u32_le type;
+    u32_le num_items;
+    u32_le uncompressed_size;
+    u32_le compressed_size;
+};
+static_assert(sizeof(RecordHeader) == 0x10, "RecordHeader has incorrect size.");
+
+template <typename T>
+void Append(std::vector<u8>& buffer, const T* data, std::size_t count) {
+    const std::size_t offset = buffer.size();
+    buffer.resize(offset + count * sizeof(T));
+    std::memcpy(buffer.data() + offset, data, count * sizeof(T));
+}
+
+std::optional<CaptureRecord> ParseRecord(const RecordHeader& header,
+                                         const std::vector<u8>& payload) {
+    switch (static_cast<RecordType>(static_cast<u32>(header.type))) {
+    case RecordType::MemoryMap: {
+        CapturedMemoryMap memory_map;
+        memory_map.areas.resize(header.num_items);
+        if (payload.size() != memory_map.areas.size() * sizeof(CapturedArea)) {
+            return std::nullopt;
+        }
+        std::memcpy(memory_map.areas.data(), payload.data(), payload.size());
+        return memory_map;
+    }
+    case RecordType::CommandList: {
+        CapturedCommandList command_list;
+        command_list.entries.resize(header.num_items);
+        const std::size_t entries_size = command_list.entries.size() * sizeof(CommandListHeader);
+        if (payload.size() < entries_size) {
+            return std::nullopt;
+        }
+        std::memcpy(command_list.entries.data(), payload.data(), entries_size);
+
+        std::size_t num_words = 0;
+        for (const CommandListHeader& entry : command_list.entries) {
+            num_words += entry.size;
+        }
+        if (payload.size() != entries_size + num_words * sizeof(u32)) {
+            return std::nullopt;
+        }
+        command_list.words.resize(num_words);
+        std::memcpy(command_list.words.data(), payload.data() + entries_size,
+                    num_words * sizeof(u32));
+        return command_list;
+    }
+    case RecordType::FrameEnd:
+        return CapturedFrameEnd{};
+    default:
+        return std::nullopt;
+    }
+}
+
+} // Anonymous namespace
+
+PushbufferRecorder::PushbufferRecorder(const MemoryManager& memory_manager,
+                                       const std::string& path)
+    : memory_manager{memory_manager}, file{path, "wb"} {
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to create pushbuffer capture file {}", path);
+        return;
+    }
+    LOG_INFO(HW_GPU, "Recording pushbuffers to {}", path);
+
+    const FileHeader header{CAPTURE_MAGIC, CAPTURE_VERSION};
+    file.WriteObject(header);
+}
+
+PushbufferRecorder::~PushbufferRecorder() = default;
+
+void PushbufferRecorder::RecordCommandList(const CommandList& entries) {
+    if (!IsOpen()) {
+        return;
+    }
+    RecordMemoryMap();
+
+    payload.clear();
+    Append(payload, entries.data(), entries.size());
+    for (const CommandListHeader& entry : entries) {
+        const std::size_t offset = payload.size();
+        const std::size_t size = entry.size * sizeof(u32);
+        payload.resize(offset + size);
+        memory_manager.ReadBlockUnsafe(entry.addr, payload.data() + offset, size);
+    }
+    WriteRecord(static_cast<u32>(RecordType::CommandList), static_cast<u32>(entries.size()),
+                payload);
+}
+
+void PushbufferRecorder::RecordFrameEnd() {
+    if (!IsOpen()) {
+        return;
+    }
+    payload.clear();
+    WriteRecord(static_cast<u32>(RecordType::FrameEnd), 0, payload);
+}
+
+void PushbufferRecorder::RecordMemoryMap() {
+    std::vector<CapturedArea> areas;
+    for (const VirtualMemoryArea& vma : memory_manager.GetMappedAreas()) {
+        areas.push_back({vma.base, vma.size});
+    }
+    if (areas == mapped_areas) {
+        return;
+    }
+    mapped_areas = std::move(areas);
+
+    payload.clear();
+    Append(payload, mapped_areas.data(), mapped_areas.size());
+    WriteRecord(static_cast<u32>(RecordType::MemoryMap), static_cast<u32>(mapped_areas.size()),
+                payload);
+}
+
+void PushbufferRecorder::WriteRecord(u32 type, u32 num_items, const std::vector<u8>& payload) {
+    const std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(payload.data(), payload.size());
+
+    RecordHeader header{};
+    header.type = type;
+    header.num_items = num_items;
+    header.uncompressed_size = static_cast<u32>(payload.size());
+    header.compressed_size = static_cast<u32>(compressed.size());
+    if (file.WriteObject(header) != 1 ||
+        file.WriteBytes(compressed.data(), compressed.size()) != compressed.size()) {
+        LOG_ERROR(HW_GPU, "Failed to write pushbuffer capture record, stopping the capture");
+        file.Close();
+    }
+}
+
+std::optional<std::vector<CaptureRecord>> LoadPushbufferCapture(const std::string& path) {
+    FileUtil::IOFile file{path, "rb"};
+    if (!file.IsOpen()) {
+        LOG_ERROR(HW_GPU, "Failed to open pushbuffer capture file {}", path);
+        return std::nullopt;
+    }
+
+    FileHeader header{};
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        header.magic != CAPTURE_MAGIC) {
+        LOG_ERROR(HW_GPU, "{} is not a pushbuffer capture file", path);
+        return std::nullopt;
+    }
+    if (header.version != CAPTURE_VERSION) {
+        LOG_ERROR(HW_GPU, "Pushbuffer capture version {} is not supported",
+                  static_cast<u32>(header.version));
+        return std::nullopt;
+    }
+
+    std::vector<CaptureRecord> records;
+    RecordHeader record_header{};
+    std::vector<u8> compressed;
+    while (file.ReadBytes(&record_header, sizeof(record_header)) == sizeof(record_header)) {
+        compressed.resize(record_header.compressed_size);
+        if (file.ReadBytes(compressed.data(), compressed.size()) != compressed.size()) {
+            LOG_WARNING(HW_GPU, "Pushbuffer capture is truncated, ignoring the last record");
+            break;
+        }
+        const std::vector<u8> payload = Common::Compression::DecompressDataZSTD(compressed);
+        if (payload.size() != record_header.uncompressed_size) {
+            LOG_ERROR(HW_GPU, "Pushbuffer capture record {} is corrupted", records.size());
+            return std::nullopt;
+        }
+        auto record = ParseRecord(record_header, payload);
+        if (!record) {
+            LOG_ERROR(HW_GPU, "Pushbuffer capture record {} is invalid", records.size());
+            return std::nullopt;
+        }
+        records.push_back(std::move(*record));
+    }
+    return records;
+}
+
+} // namespace Tegra
@@ -0,0 +1,89 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "video_core/dma_pusher.h"
+
+namespace Tegra {
+
+class MemoryManager;
+
+/// Area of the GPU address space that was mapped to memory when a capture record was written.
+struct CapturedArea {
+    GPUVAddr base{};
+    u64 size{};
+
+    bool operator==(const CapturedArea& rhs) const {
+        return base == rhs.base && size == rhs.size;
+    }
+};
+
+/// Replaces the set of mapped areas, it's recorded whenever the GPU address space layout changes.
+struct CapturedMemoryMap {
+    std::vector<CapturedArea> areas;
+};
+
+/// Command list submitted to the GPU, together with the pushbuffer memory it references.
+struct CapturedCommandList {
+    CommandList entries;
+    /// Contents of each entry's pushbuffer at the time of the submission, laid out in order.
+    std::vector<u32> words;
+};
+
+/// Marks the point where the game presented a frame.
+struct CapturedFrameEnd {};
+
+using CaptureRecord = std::variant<CapturedMemoryMap, CapturedCommandList, CapturedFrameEnd>;
+
+/**
+ * Records the command lists submitted to the GPU into a file that can be replayed without the
+ * game being loaded. Each record is compressed on its own, so a capture can be stopped at any
+ * point.
+ */
+class PushbufferRecorder final {
+public:
+    explicit PushbufferRecorder(const MemoryManager& memory_manager, const std::string& path);
+    ~PushbufferRecorder();
+
+    /// Returns true when the capture file was opened successfully.
+    bool IsOpen() const {
+        return file.IsOpen();
+    }
+
+    /// Records a command list and the pushbuffer words it references.
+    void RecordCommandList(const CommandList& entries);
+
+    /// Records the presentation of a frame.
+    void RecordFrameEnd();
+
+private:
+    /// Records the mapped areas of the address space if they changed since the last record.
+    void RecordMemoryMap();
+
+    /// Compresses the payload and appends it to the capture file.
+    void WriteRecord(u32 type, u32 num_items, const std::vector<u8>& payload);
+
+    const MemoryManager& memory_manager;
+    FileUtil::IOFile file;
+
+    std::vector<CapturedArea> mapped_areas;
+    std::vector<u8> payload;
+};
+
+/**
+ * Loads every record of a capture file written by PushbufferRecorder.
+ * @param path Path to the capture file.
+ * @returns The records in the order they were recorded, or std::nullopt if the file is invalid.
+ */
+std::optional<std::vector<CaptureRecord>> LoadPushbufferCapture(const std::string& path);
+
+} // namespace Tegra
@@ -6,8 +6,6 @@
 
 #include <mutex>
 
-#include <boost/icl/interval_map.hpp>
-
 #include "common/common_types.h"
 #include "video_core/rasterizer_interface.h"
 
@@ -26,8 +24,7 @@ public:
     void UpdatePagesCachedCount(VAddr addr, u64 size, int delta) override;
 
 private:
-    using CachedPageMap = boost::icl::interval_map<u64, int>;
-    CachedPageMap cached_pages;
+    /// Serializes updates to the per-page cached counts, which live in the CPU page table.
     std::mutex pages_mutex;
 
     Memory::Memory& cpu_memory;
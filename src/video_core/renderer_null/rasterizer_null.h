@@ -0,0 +1,55 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/common_types.h"
+#include "video_core/rasterizer_interface.h"
+
+namespace Null {
+
+/**
+ * Rasterizer that doesn't render anything. It only counts the operations requested by the
+ * engines, which makes it useful to measure the cost of the GPU command processing on its own.
+ */
+class RasterizerNull final : public VideoCore::RasterizerInterface {
+public:
+    /// Number of operations requested from the rasterizer.
+    struct Counters {
+        u64 draws{};
+        u64 clears{};
+        u64 dispatches{};
+        u64 surface_copies{};
+    };
+
+    RasterizerNull();
+    ~RasterizerNull() override;
+
+    bool DrawBatch(bool is_indexed) override;
+    bool DrawMultiBatch(bool is_indexed) override;
+    void Clear() override;
+    void DispatchCompute(GPUVAddr code_addr) override;
+    void FlushAll() override;
+    void FlushRegion(CacheAddr addr, u64 size) override;
+    void InvalidateRegion(CacheAddr addr, u64 size) override;
+    void FlushAndInvalidateRegion(CacheAddr addr, u64 size) override;
+    void FlushCommands() override;
+    void TickFrame() override;
+    bool AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Regs::Surface& src,
+                               const Tegra::Engines::Fermi2D::Regs::Surface& dst,
+                               const Tegra::Engines::Fermi2D::Config& copy_config) override;
+
+    const Counters& GetCounters() const {
+        return counters;
+    }
+
+    void ResetCounters() {
+        counters = {};
+    }
+
+private:
+    Counters counters;
+};
+
+} // namespace Null
@@ -0,0 +1,31 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <memory>
+
+#include "video_core/renderer_null/rasterizer_null.h"
+#include "video_core/renderer_null/renderer_null.h"
+
+namespace Null {
+
+RendererNull::RendererNull(Core::Frontend::EmuWindow& emu_window) : RendererBase{emu_window} {}
+
+RendererNull::~RendererNull() = default;
+
+bool RendererNull::Init() {
+    rasterizer = std::make_unique<RasterizerNull>();
+    return true;
+}
+
+void RendererNull::ShutDown() {}
+
+void RendererNull::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
+    ++m_current_frame;
+}
+
+RasterizerNull& RendererNull::GetNullRasterizer() {
+    return static_cast<RasterizerNull&>(*rasterizer);
+}
+
+} // namespace Null
@@ -0,0 +1,31 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "video_core/renderer_base.h"
+
+namespace Core::Frontend {
+class EmuWindow;
+}
+
+namespace Null {
+
+class RasterizerNull;
+
+/// Renderer that discards every frame, used to run the GPU without a host graphics API.
+class RendererNull final : public VideoCore::RendererBase {
+public:
+    explicit RendererNull(Core::Frontend::EmuWindow& emu_window);
+    ~RendererNull() override;
+
+    bool Init() override;
+    void ShutDown() override;
+    void SwapBuffers(const Tegra::FramebufferConfig* framebuffer) override;
+
+    /// Returns the null rasterizer owned by this renderer.
+    RasterizerNull& GetNullRasterizer();
+};
+
+} // namespace Null
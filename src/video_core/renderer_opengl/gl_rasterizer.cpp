@@ -255,11 +255,12 @@ GLintptr RasterizerOpenGL::SetupIndexBuffer() {
     return offset;
 }
 
-void RasterizerOpenGL::SetupShaders(GLenum primitive_mode) {
+bool RasterizerOpenGL::SetupShaders(GLenum primitive_mode) {
     MICROPROFILE_SCOPE(OpenGL_Shader);
     auto& gpu = system.GPU().Maxwell3D();
 
     std::array<bool, Maxwell::NumClipDistances> clip_distances{};
+    bool programs_ready = true;
 
     for (std::size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
         const auto& shader_config = gpu.regs.shader_config[index];
@@ -299,6 +300,7 @@ void RasterizerOpenGL::SetupShaders(GLenum primitive_mode) {
 
         const ProgramVariant variant(primitive_mode);
         const auto program_handle = shader->GetHandle(variant);
+        programs_ready = programs_ready && program_handle != 0;
 
         switch (program) {
         case Maxwell::ShaderProgram::VertexA:
@@ -334,6 +336,7 @@ void RasterizerOpenGL::SetupShaders(GLenum primitive_mode) {
     SyncClipEnabled(clip_distances);
 
     gpu.dirty.shaders = false;
+    return programs_ready;
 }
 
 std::size_t RasterizerOpenGL::CalculateVertexArraysSize() const {
@@ -515,6 +518,7 @@ void RasterizerOpenGL::Clear() {
     }
 
     ConfigureClearFramebuffer(clear_state, use_color, use_depth, use_stencil);
+    texture_cache.CommitUploads();
 
     SyncViewport(clear_state);
     SyncRasterizeEnable(clear_state);
@@ -542,7 +546,7 @@ void RasterizerOpenGL::Clear() {
     }
 }
 
-void RasterizerOpenGL::DrawPrelude() {
+bool RasterizerOpenGL::DrawPrelude() {
     auto& gpu = system.GPU().Maxwell3D();
 
     SyncRasterizeEnable(state);
@@ -609,10 +613,11 @@ void RasterizerOpenGL::DrawPrelude() {
     // Setup shaders and their used resources.
     texture_cache.GuardSamplers(true);
     const auto primitive_mode = MaxwellToGL::PrimitiveTopology(gpu.regs.draw.topology);
-    SetupShaders(primitive_mode);
+    const bool programs_ready = SetupShaders(primitive_mode);
     texture_cache.GuardSamplers(false);
 
     ConfigureFramebuffers();
+    texture_cache.CommitUploads();
 
     // Signal the buffer cache that we are not going to upload more things.
     const bool invalidate = buffer_cache.Unmap();
@@ -633,6 +638,10 @@ void RasterizerOpenGL::DrawPrelude() {
     if (texture_cache.TextureBarrier()) {
         glTextureBarrier();
     }
+    if (!programs_ready) {
+        shader_cache.CountSkippedDraw();
+    }
+    return programs_ready;
 }
 
 struct DrawParams {
@@ -677,7 +686,7 @@ bool RasterizerOpenGL::DrawBatch(bool is_indexed) {
 
     MICROPROFILE_SCOPE(OpenGL_Drawing);
 
-    DrawPrelude();
+    const bool programs_ready = DrawPrelude();
 
     auto& maxwell3d = system.GPU().Maxwell3D();
     const auto& regs = maxwell3d.regs;
@@ -697,7 +706,9 @@ bool RasterizerOpenGL::DrawBatch(bool is_indexed) {
         draw_call.count = static_cast<GLint>(regs.vertex_buffer.count);
         draw_call.base_vertex = static_cast<GLint>(regs.vertex_buffer.first);
     }
-    draw_call.DispatchDraw();
+    if (programs_ready) {
+        draw_call.DispatchDraw();
+    }
 
     maxwell3d.dirty.memory_general = false;
     accelerate_draw = AccelDraw::Disabled;
@@ -709,7 +720,7 @@ bool RasterizerOpenGL::DrawMultiBatch(bool is_indexed) {
 
     MICROPROFILE_SCOPE(OpenGL_Drawing);
 
-    DrawPrelude();
+    const bool programs_ready = DrawPrelude();
 
     auto& maxwell3d = system.GPU().Maxwell3D();
     const auto& regs = maxwell3d.regs;
@@ -729,7 +740,9 @@ bool RasterizerOpenGL::DrawMultiBatch(bool is_indexed) {
         draw_call.count = static_cast<GLint>(regs.vertex_buffer.count);
         draw_call.base_vertex = static_cast<GLint>(regs.vertex_buffer.first);
     }
-    draw_call.DispatchDraw();
+    if (programs_ready) {
+        draw_call.DispatchDraw();
+    }
 
     maxwell3d.dirty.memory_general = false;
     accelerate_draw = AccelDraw::Disabled;
@@ -746,12 +759,18 @@ void RasterizerOpenGL::DispatchCompute(GPUVAddr code_addr) {
     auto kernel = shader_cache.GetComputeKernel(code_addr);
     SetupComputeTextures(kernel);
     SetupComputeImages(kernel);
+    texture_cache.CommitUploads();
 
     const auto& launch_desc = system.GPU().KeplerCompute().launch_description;
     const ProgramVariant variant(launch_desc.block_dim_x, launch_desc.block_dim_y,
                                  launch_desc.block_dim_z, launch_desc.shared_alloc,
                                  launch_desc.local_pos_alloc);
     state.draw.shader_program = kernel->GetHandle(variant);
+    if (state.draw.shader_program == 0) {
+        // The kernel is still being built in the background
+        shader_cache.CountSkippedDraw();
+        return;
+    }
     state.draw.program_pipeline = 0;
 
     const std::size_t buffer_size =
@@ -812,6 +831,7 @@ void RasterizerOpenGL::FlushCommands() {
 
 void RasterizerOpenGL::TickFrame() {
     buffer_cache.TickFrame();
+    texture_cache.TickFrame();
 }
 
 bool RasterizerOpenGL::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Regs::Surface& src,
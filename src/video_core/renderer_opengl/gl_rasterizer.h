@@ -103,7 +103,8 @@ private:
                            std::size_t size);
 
     /// Syncs all the state, shaders, render targets and textures setting before a draw call.
-    void DrawPrelude();
+    /// Returns false when the draw has to be skipped because its programs are not built yet.
+    bool DrawPrelude();
 
     /// Configures the current textures to use for the draw command.
     void SetupDrawTextures(std::size_t stage_index, const Shader& shader);
@@ -222,7 +223,8 @@ private:
 
     GLintptr index_buffer_offset;
 
-    void SetupShaders(GLenum primitive_mode);
+    /// Binds the programs of the enabled stages. Returns false if any of them is not built yet.
+    bool SetupShaders(GLenum primitive_mode);
 
     enum class AccelDraw { Disabled, Arrays, Indexed };
     AccelDraw accelerate_draw = AccelDraw::Disabled;
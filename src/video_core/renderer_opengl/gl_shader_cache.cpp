@@ -2,6 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <chrono>
+#include <future>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -11,9 +14,10 @@
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
-#include "common/scope_exit.h"
+#include "common/thread_pool.h"
 #include "core/core.h"
 #include "core/frontend/emu_window.h"
+#include "core/settings.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/engines/shader_type.h"
@@ -230,21 +234,14 @@ void FillLocker(ConstBufferLocker& locker, const ShaderDiskCacheUsage& usage) {
     }
 }
 
-CachedProgram BuildShader(const Device& device, u64 unique_identifier, ShaderType shader_type,
-                          const ProgramCode& code, const ProgramCode& code_b,
-                          ConstBufferLocker& locker, const ProgramVariant& variant,
-                          bool hint_retrievable = false) {
-    LOG_INFO(Render_OpenGL, "called. {}", GetShaderId(unique_identifier, shader_type));
-
-    const bool is_compute = shader_type == ShaderType::Compute;
-    const u32 main_offset = is_compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
-    const ShaderIR ir(code, main_offset, COMPILER_SETTINGS, locker);
-    std::optional<ShaderIR> ir_b;
-    if (!code_b.empty()) {
-        ir_b.emplace(code_b, main_offset, COMPILER_SETTINGS, locker);
-    }
-    const auto entries = GLShader::GetEntries(ir);
+constexpr u32 GetMainOffset(ShaderType shader_type) {
+    return shader_type == ShaderType::Compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
+}
 
+/// Decompiles the IR of a shader into the GLSL source of the given variant
+std::string GenerateSource(const Device& device, u64 unique_identifier, ShaderType shader_type,
+                           const ShaderIR& ir, const std::optional<ShaderIR>& ir_b,
+                           const ProgramVariant& variant) {
     std::string source = fmt::format(R"(// {}
 #version 430 core
 #extension GL_ARB_separate_shader_objects : enable
@@ -287,7 +284,12 @@ CachedProgram BuildShader(const Device& device, u64 unique_identifier, ShaderTyp
 
     source += '\n';
     source += GenerateGLSL(device, shader_type, ir, ir_b);
+    return source;
+}
 
+/// Compiles and links a separable program from GLSL source
+CachedProgram CompileProgram(const std::string& source, ShaderType shader_type,
+                             bool hint_retrievable) {
     OGLShader shader;
     shader.Create(source.c_str(), GetGLShaderType(shader_type));
 
@@ -296,6 +298,33 @@ CachedProgram BuildShader(const Device& device, u64 unique_identifier, ShaderTyp
     return program;
 }
 
+CachedProgram BuildShader(const Device& device, u64 unique_identifier, ShaderType shader_type,
+                          const ProgramCode& code, const ProgramCode& code_b,
+                          ConstBufferLocker& locker, const ProgramVariant& variant,
+                          bool hint_retrievable = false) {
+    LOG_INFO(Render_OpenGL, "called. {}", GetShaderId(unique_identifier, shader_type));
+
+    const u32 main_offset = GetMainOffset(shader_type);
+    const ShaderIR ir(code, main_offset, COMPILER_SETTINGS, locker);
+    std::optional<ShaderIR> ir_b;
+    if (!code_b.empty()) {
+        ir_b.emplace(code_b, main_offset, COMPILER_SETTINGS, locker);
+    }
+    const std::string source =
+        GenerateSource(device, unique_identifier, shader_type, ir, ir_b, variant);
+    return CompileProgram(source, shader_type, hint_retrievable);
+}
+
+/// Shader decoded on the GPU thread that waits for a worker thread to decompile and compile it
+struct ShaderBuildJob {
+    // The IR references the code it was decoded from, so the job keeps its own copy. It also
+    // references the locker, which is only used while decoding.
+    ProgramCode code;
+    ProgramCode code_b;
+    std::optional<ShaderIR> ir;
+    std::optional<ShaderIR> ir_b;
+};
+
 std::unordered_set<GLenum> GetSupportedFormats() {
     GLint num_formats{};
     glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
@@ -315,7 +344,8 @@ std::unordered_set<GLenum> GetSupportedFormats() {
 CachedShader::CachedShader(const ShaderParameters& params, ShaderType shader_type,
                            GLShader::ShaderEntries entries, ProgramCode code, ProgramCode code_b)
     : RasterizerCacheObject{params.host_ptr}, system{params.system}, disk_cache{params.disk_cache},
-      device{params.device}, cpu_addr{params.cpu_addr}, unique_identifier{params.unique_identifier},
+      device{params.device}, async_shaders{params.async_shaders}, stats{params.stats},
+      cpu_addr{params.cpu_addr}, unique_identifier{params.unique_identifier},
       shader_type{shader_type}, entries{entries}, code{std::move(code)}, code_b{std::move(code_b)} {
     if (!params.precompiled_variants) {
         return;
@@ -380,12 +410,17 @@ Shader CachedShader::CreateFromCache(const ShaderParameters& params,
 GLuint CachedShader::GetHandle(const ProgramVariant& variant) {
     EnsureValidLockerVariant();
 
-    const auto [entry, is_cache_miss] = curr_locker_variant->programs.try_emplace(variant);
-    auto& program = entry->second;
-    if (!is_cache_miss) {
-        return program->handle;
+    if (const auto it = curr_locker_variant->programs.find(variant);
+        it != curr_locker_variant->programs.end()) {
+        ++stats.hits;
+        return it->second->handle;
+    }
+    if (async_shaders) {
+        return GetHandleAsync(variant);
     }
+    ++stats.misses;
 
+    auto& program = curr_locker_variant->programs[variant];
     program = BuildShader(device, unique_identifier, shader_type, code, code_b,
                           *curr_locker_variant->locker, variant);
     disk_cache.SaveUsage(GetUsage(variant, *curr_locker_variant->locker));
@@ -394,6 +429,50 @@ GLuint CachedShader::GetHandle(const ProgramVariant& variant) {
     return program->handle;
 }
 
+GLuint CachedShader::GetHandleAsync(const ProgramVariant& variant) {
+    auto& pending_programs = curr_locker_variant->pending_programs;
+    const auto [entry, is_cache_miss] = pending_programs.try_emplace(variant);
+    auto& pending = entry->second;
+    if (is_cache_miss) {
+        ++stats.misses;
+        LOG_INFO(Render_OpenGL, "Queued {}", GetShaderId(unique_identifier, shader_type));
+
+        // Decoding reads constant buffers through the locker, so it has to happen while the
+        // engine state is current. Decompilation and compilation are left to the worker.
+        auto& locker = *curr_locker_variant->locker;
+        const u32 main_offset = GetMainOffset(shader_type);
+        auto job = std::make_shared<ShaderBuildJob>();
+        job->code = code;
+        job->code_b = code_b;
+        job->ir.emplace(job->code, main_offset, COMPILER_SETTINGS, locker);
+        if (!job->code_b.empty()) {
+            job->ir_b.emplace(job->code_b, main_offset, COMPILER_SETTINGS, locker);
+        }
+        pending = async_shaders->QueueJob([job = std::move(job), &device = device,
+                                           unique_identifier = unique_identifier,
+                                           shader_type = shader_type, variant] {
+            const std::string source =
+                GenerateSource(device, unique_identifier, shader_type, *job->ir, job->ir_b,
+                               variant);
+            CachedProgram program = CompileProgram(source, shader_type, false);
+            // Make sure the program is complete before the GPU thread's context uses it
+            glFinish();
+            return program;
+        });
+    }
+    if (!VideoCommon::Shader::AsyncShaders::IsReady(pending)) {
+        return 0;
+    }
+
+    CachedProgram program = pending.get();
+    pending_programs.erase(entry);
+    curr_locker_variant->programs.emplace(variant, program);
+    disk_cache.SaveUsage(GetUsage(variant, *curr_locker_variant->locker));
+
+    LabelGLObject(GL_PROGRAM, program->handle, cpu_addr);
+    return program->handle;
+}
+
 bool CachedShader::EnsureValidLockerVariant() {
     const auto previous_variant = curr_locker_variant;
     if (curr_locker_variant && !curr_locker_variant->locker->IsConsistent()) {
@@ -424,25 +503,48 @@ ShaderDiskCacheUsage CachedShader::GetUsage(const ProgramVariant& variant,
 ShaderCacheOpenGL::ShaderCacheOpenGL(RasterizerOpenGL& rasterizer, Core::System& system,
                                      Core::Frontend::EmuWindow& emu_window, const Device& device)
     : RasterizerCache{rasterizer}, system{system}, emu_window{emu_window}, device{device},
-      disk_cache{system} {}
+      disk_cache{system} {
+    if (!Settings::values.use_asynchronous_shaders) {
+        return;
+    }
+    // Leave most of the host threads to the emulated CPU cores and the GPU thread
+    const std::size_t num_workers = std::clamp(std::thread::hardware_concurrency() / 4, 1U, 4U);
+    std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> contexts(num_workers);
+    for (auto& context : contexts) {
+        context = emu_window.CreateSharedContext();
+    }
+    async_shaders = std::make_unique<VideoCommon::Shader::AsyncShaders>(std::move(contexts));
+    LOG_INFO(Render_OpenGL, "Building shaders asynchronously on {} threads", num_workers);
+}
+
+ShaderCacheOpenGL::~ShaderCacheOpenGL() {
+    LOG_INFO(Render_OpenGL, "Shader programs: {} hits, {} misses, {} draws waited", stats.hits,
+             stats.misses, stats.waits);
+}
 
 void ShaderCacheOpenGL::LoadDiskCache(const std::atomic_bool& stop_loading,
                                       const VideoCore::DiskResourceLoadCallback& callback) {
+    using Clock = std::chrono::steady_clock;
+    const auto read_start = Clock::now();
+
     const auto transferable = disk_cache.LoadTransferable();
     if (!transferable) {
         return;
     }
-    const auto [raws, shader_usages] = *transferable;
-    if (!GenerateUnspecializedShaders(stop_loading, callback, raws) || stop_loading) {
-        return;
-    }
-
-    const auto dumps = disk_cache.LoadPrecompiled();
+    const auto& shader_usages = transferable->usages;
+    auto dumps = disk_cache.LoadPrecompiled();
     const auto supported_formats = GetSupportedFormats();
 
-    // Track if precompiled cache was altered during loading to know if we have to
-    // serialize the virtual precompiled cache file back to the hard drive
-    bool precompiled_cache_altered = false;
+    // Decoding and decompiling only needs the CPU, while the driver compiles on fewer threads that
+    // own a context each. Decompiled shaders are handed to the context threads as soon as they are
+    // ready, so both stages run at the same time.
+    const auto decompile_start = Clock::now();
+    Common::ThreadPool decompilers{std::max(std::thread::hardware_concurrency(), 2U) - 1,
+                                   "yuzu:ShaderDecompiler"};
+    if (!GenerateUnspecializedShaders(decompilers, stop_loading, callback, *transferable) ||
+        stop_loading) {
+        return;
+    }
 
     // Inform the frontend about shader build initialization
     if (callback) {
@@ -452,74 +554,104 @@ void ShaderCacheOpenGL::LoadDiskCache(const std::atomic_bool& stop_loading,
     std::mutex mutex;
     std::size_t built_shaders = 0; // It doesn't have be atomic since it's used behind a mutex
     std::atomic_bool compilation_failed = false;
+    std::vector<std::future<CachedProgram>> programs(shader_usages.size());
+    Clock::time_point build_end;
+    {
+        const std::size_t num_builders = std::max(std::thread::hardware_concurrency() / 4, 1U);
+        std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> contexts(num_builders);
+        for (auto& context : contexts) {
+            // On some platforms the shared context has to be created from the GUI thread
+            context = emu_window.CreateSharedContext();
+        }
+        VideoCommon::Shader::AsyncShaders builders{std::move(contexts)};
 
-    const auto Worker = [&](Core::Frontend::GraphicsContext* context, std::size_t begin,
-                            std::size_t end, const std::vector<ShaderDiskCacheUsage>& shader_usages,
-                            const ShaderDumpsMap& dumps) {
-        context->MakeCurrent();
-        SCOPE_EXIT({ return context->DoneCurrent(); });
+        const auto ReportBuilt = [&] {
+            std::scoped_lock lock{mutex};
+            if (callback) {
+                callback(VideoCore::LoadCallbackStage::Build, ++built_shaders,
+                         shader_usages.size());
+            }
+        };
 
-        for (std::size_t i = begin; i < end; ++i) {
+        decompilers.ParallelFor(shader_usages.size(), [&](std::size_t i) {
             if (stop_loading || compilation_failed) {
                 return;
             }
             const auto& usage{shader_usages[i]};
-            const auto& unspecialized{unspecialized_shaders.at(usage.unique_identifier)};
-            const auto dump{dumps.find(usage)};
-
-            CachedProgram shader;
-            if (dump != dumps.end()) {
-                // If the shader is dumped, attempt to load it with
-                shader = GeneratePrecompiledProgram(dump->second, supported_formats);
-                if (!shader) {
-                    compilation_failed = true;
-                    return;
-                }
+            if (auto dump{dumps.Find(usage)}) {
+                // If the shader is dumped, attempt to load it. Binaries are decompressed by the
+                // builder threads
+                programs[i] = builders.QueueJob([&, binary = std::move(*dump)]() -> CachedProgram {
+                    if (stop_loading || compilation_failed) {
+                        return {};
+                    }
+                    CachedProgram program = GeneratePrecompiledProgram(binary, supported_formats);
+                    if (!program) {
+                        compilation_failed = true;
+                        return {};
+                    }
+                    ReportBuilt();
+                    return program;
+                });
+                return;
             }
-            if (!shader) {
-                auto locker{MakeLocker(system, unspecialized.type)};
-                FillLocker(*locker, usage);
 
-                shader = BuildShader(device, usage.unique_identifier, unspecialized.type,
-                                     unspecialized.code, unspecialized.code_b, *locker,
-                                     usage.variant, true);
+            const auto& unspecialized{unspecialized_shaders.at(usage.unique_identifier)};
+            const u32 main_offset = GetMainOffset(unspecialized.type);
+            auto locker{MakeLocker(system, unspecialized.type)};
+            FillLocker(*locker, usage);
+            const ShaderIR ir(unspecialized.code, main_offset, COMPILER_SETTINGS, *locker);
+            std::optional<ShaderIR> ir_b;
+            if (!unspecialized.code_b.empty()) {
+                ir_b.emplace(unspecialized.code_b, main_offset, COMPILER_SETTINGS, *locker);
             }
-
-            std::scoped_lock lock{mutex};
-            if (callback) {
-                callback(VideoCore::LoadCallbackStage::Build, ++built_shaders,
-                         shader_usages.size());
+            std::string source = GenerateSource(device, usage.unique_identifier,
+                                                unspecialized.type, ir, ir_b, usage.variant);
+
+            programs[i] = builders.QueueJob(
+                [&, source = std::move(source), type = unspecialized.type]() -> CachedProgram {
+                    if (stop_loading || compilation_failed) {
+                        return {};
+                    }
+                    CachedProgram program = CompileProgram(source, type, true);
+                    ReportBuilt();
+                    return program;
+                });
+        });
+        const auto decompile_end = Clock::now();
+
+        for (std::size_t i = 0; i < shader_usages.size(); ++i) {
+            if (!programs[i].valid()) {
+                continue;
             }
-
-            precompiled_programs.emplace(usage, std::move(shader));
+            CachedProgram program = programs[i].get();
+            if (!program) {
+                continue;
+            }
+            const auto& usage{shader_usages[i]};
+            precompiled_programs.emplace(usage, std::move(program));
 
             // TODO(Rodrigo): Is there a better way to do this?
             precompiled_variants[usage.unique_identifier].push_back(
                 precompiled_programs.find(usage));
         }
-    };
-
-    const auto num_workers{static_cast<std::size_t>(std::thread::hardware_concurrency() + 1ULL)};
-    const std::size_t bucket_size{shader_usages.size() / num_workers};
-    std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> contexts(num_workers);
-    std::vector<std::thread> threads(num_workers);
-    for (std::size_t i = 0; i < num_workers; ++i) {
-        const bool is_last_worker = i + 1 == num_workers;
-        const std::size_t start{bucket_size * i};
-        const std::size_t end{is_last_worker ? shader_usages.size() : start + bucket_size};
+        build_end = Clock::now();
 
-        // On some platforms the shared context has to be created from the GUI thread
-        contexts[i] = emu_window.CreateSharedContext();
-        threads[i] = std::thread(Worker, contexts[i].get(), start, end, shader_usages, dumps);
-    }
-    for (auto& thread : threads) {
-        thread.join();
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+        LOG_INFO(Render_OpenGL,
+                 "Loaded {} shaders: reading took {:.1f} ms, decompiling {:.1f} ms on {} threads, "
+                 "building {:.1f} ms on {} threads",
+                 shader_usages.size(), Milliseconds(decompile_start - read_start).count(),
+                 Milliseconds(decompile_end - decompile_start).count(),
+                 decompilers.NumWorkers() + 1, Milliseconds(build_end - decompile_start).count(),
+                 builders.NumWorkers());
     }
 
     if (compilation_failed) {
-        // Invalidate the precompiled cache if a shader dumped shader was rejected
+        // Invalidate the precompiled cache if a shader dumped shader was rejected. Dumps are
+        // released first to unmap the file before removing it.
+        dumps.Clear();
         disk_cache.InvalidatePrecompiled();
-        precompiled_cache_altered = true;
         return;
     }
     if (stop_loading) {
@@ -531,16 +663,11 @@ void ShaderCacheOpenGL::LoadDiskCache(const std::atomic_bool& stop_loading,
 
     for (std::size_t i = 0; i < shader_usages.size(); ++i) {
         const auto& usage{shader_usages[i]};
-        if (dumps.find(usage) == dumps.end()) {
+        if (!dumps.Find(usage)) {
             const auto& program{precompiled_programs.at(usage)};
             disk_cache.SaveDump(usage, program->handle);
-            precompiled_cache_altered = true;
         }
     }
-
-    if (precompiled_cache_altered) {
-        disk_cache.SaveVirtualPrecompiledFile();
-    }
 }
 
 const PrecompiledVariants* ShaderCacheOpenGL::GetPrecompiledVariants(u64 unique_identifier) const {
@@ -554,12 +681,17 @@ CachedProgram ShaderCacheOpenGL::GeneratePrecompiledProgram(
         LOG_INFO(Render_OpenGL, "Precompiled cache entry with unsupported format - removing");
         return {};
     }
+    const std::vector<u8> binary = dump.Decompress();
+    if (binary.empty()) {
+        LOG_INFO(Render_OpenGL, "Failed to decompress precompiled cache entry - removing");
+        return {};
+    }
 
     CachedProgram shader = std::make_shared<OGLProgram>();
     shader->handle = glCreateProgram();
     glProgramParameteri(shader->handle, GL_PROGRAM_SEPARABLE, GL_TRUE);
-    glProgramBinary(shader->handle, dump.binary_format, dump.binary.data(),
-                    static_cast<GLsizei>(dump.binary.size()));
+    glProgramBinary(shader->handle, dump.binary_format, binary.data(),
+                    static_cast<GLsizei>(binary.size()));
 
     GLint link_status{};
     glGetProgramiv(shader->handle, GL_LINK_STATUS, &link_status);
@@ -572,17 +704,30 @@ CachedProgram ShaderCacheOpenGL::GeneratePrecompiledProgram(
 }
 
 bool ShaderCacheOpenGL::GenerateUnspecializedShaders(
-    const std::atomic_bool& stop_loading, const VideoCore::DiskResourceLoadCallback& callback,
-    const std::vector<ShaderDiskCacheRaw>& raws) {
+    Common::ThreadPool& thread_pool, const std::atomic_bool& stop_loading,
+    const VideoCore::DiskResourceLoadCallback& callback,
+    const ShaderDiskCacheTransferable& transferable) {
+    const auto& raws{transferable.raws};
     if (callback) {
         callback(VideoCore::LoadCallbackStage::Decompile, 0, raws.size());
     }
 
-    for (std::size_t i = 0; i < raws.size(); ++i) {
-        if (stop_loading) {
-            return false;
+    std::mutex mutex;
+    std::size_t decompiled_shaders = 0;
+    std::atomic_bool invalid_entry = false;
+    std::vector<std::optional<UnspecializedShader>> results(raws.size());
+    thread_pool.ParallelFor(raws.size(), [&](std::size_t i) {
+        if (stop_loading || invalid_entry) {
+            return;
         }
-        const auto& raw{raws[i]};
+        const auto loaded_raw{transferable.LoadRaw(i)};
+        if (!loaded_raw) {
+            LOG_ERROR(Render_OpenGL, "Failed to load raw entry={:016x} - removing shader cache",
+                      raws[i].unique_identifier);
+            invalid_entry = true;
+            return;
+        }
+        const auto& raw{*loaded_raw};
         const u64 unique_identifier{raw.GetUniqueIdentifier()};
         const u64 calculated_hash{
             GetUniqueIdentifier(raw.GetType(), raw.HasProgramA(), raw.GetCode(), raw.GetCodeB())};
@@ -590,13 +735,12 @@ bool ShaderCacheOpenGL::GenerateUnspecializedShaders(
             LOG_ERROR(Render_OpenGL,
                       "Invalid hash in entry={:016x} (obtained hash={:016x}) - "
                       "removing shader cache",
-                      raw.GetUniqueIdentifier(), calculated_hash);
-            disk_cache.InvalidateTransferable();
-            return false;
+                      unique_identifier, calculated_hash);
+            invalid_entry = true;
+            return;
         }
 
-        const u32 main_offset =
-            raw.GetType() == ShaderType::Compute ? KERNEL_MAIN_OFFSET : STAGE_MAIN_OFFSET;
+        const u32 main_offset = GetMainOffset(raw.GetType());
         ConstBufferLocker locker(raw.GetType());
         const ShaderIR ir(raw.GetCode(), main_offset, COMPILER_SETTINGS, locker);
         // TODO(Rodrigo): Handle VertexA shaders
@@ -605,16 +749,27 @@ bool ShaderCacheOpenGL::GenerateUnspecializedShaders(
         //     ir_b.emplace(raw.GetProgramCodeB(), main_offset);
         // }
 
-        UnspecializedShader unspecialized;
+        auto& unspecialized = results[i].emplace();
         unspecialized.entries = GLShader::GetEntries(ir);
         unspecialized.type = raw.GetType();
         unspecialized.code = raw.GetCode();
         unspecialized.code_b = raw.GetCodeB();
-        unspecialized_shaders.emplace(raw.GetUniqueIdentifier(), unspecialized);
 
+        std::scoped_lock lock{mutex};
         if (callback) {
-            callback(VideoCore::LoadCallbackStage::Decompile, i, raws.size());
+            callback(VideoCore::LoadCallbackStage::Decompile, ++decompiled_shaders, raws.size());
         }
+    });
+    if (invalid_entry) {
+        disk_cache.InvalidateTransferable();
+        return false;
+    }
+    if (stop_loading) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < raws.size(); ++i) {
+        unspecialized_shaders.emplace(raws[i].unique_identifier, std::move(*results[i]));
     }
     return true;
 }
@@ -646,8 +801,9 @@ Shader ShaderCacheOpenGL::GetStageProgram(Maxwell::ShaderProgram program) {
         GetShaderType(program), program == Maxwell::ShaderProgram::VertexA, code, code_b);
     const auto precompiled_variants = GetPrecompiledVariants(unique_identifier);
     const auto cpu_addr{*memory_manager.GpuToCpuAddress(address)};
-    const ShaderParameters params{system,   disk_cache, precompiled_variants, device,
-                                  cpu_addr, host_ptr,   unique_identifier};
+    const ShaderParameters params{system,        disk_cache,          precompiled_variants,
+                                  device,        async_shaders.get(), stats,
+                                  cpu_addr,      host_ptr,            unique_identifier};
 
     const auto found = unspecialized_shaders.find(unique_identifier);
     if (found == unspecialized_shaders.end()) {
@@ -674,8 +830,9 @@ Shader ShaderCacheOpenGL::GetComputeKernel(GPUVAddr code_addr) {
     const auto unique_identifier{GetUniqueIdentifier(ShaderType::Compute, false, code, {})};
     const auto precompiled_variants = GetPrecompiledVariants(unique_identifier);
     const auto cpu_addr{*memory_manager.GpuToCpuAddress(code_addr)};
-    const ShaderParameters params{system,   disk_cache, precompiled_variants, device,
-                                  cpu_addr, host_ptr,   unique_identifier};
+    const ShaderParameters params{system,        disk_cache,          precompiled_variants,
+                                  device,        async_shaders.get(), stats,
+                                  cpu_addr,      host_ptr,            unique_identifier};
 
     const auto found = unspecialized_shaders.find(unique_identifier);
     if (found == unspecialized_shaders.end()) {
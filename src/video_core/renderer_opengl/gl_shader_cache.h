@@ -7,6 +7,7 @@
 #include <array>
 #include <atomic>
 #include <bitset>
+#include <future>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -22,9 +23,14 @@
 #include "video_core/renderer_opengl/gl_resource_manager.h"
 #include "video_core/renderer_opengl/gl_shader_decompiler.h"
 #include "video_core/renderer_opengl/gl_shader_disk_cache.h"
+#include "video_core/shader/async_shaders.h"
 #include "video_core/shader/const_buffer_locker.h"
 #include "video_core/shader/shader_ir.h"
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace Core {
 class System;
 }
@@ -58,6 +64,8 @@ struct ShaderParameters {
     ShaderDiskCacheOpenGL& disk_cache;
     const PrecompiledVariants* precompiled_variants;
     const Device& device;
+    VideoCommon::Shader::AsyncShaders* async_shaders;
+    VideoCommon::Shader::AsyncShaderStats& stats;
     VAddr cpu_addr;
     u8* host_ptr;
     u64 unique_identifier;
@@ -86,13 +94,15 @@ public:
         return entries;
     }
 
-    /// Gets the GL program handle for the shader
+    /// Gets the GL program handle for the shader. Returns zero while it's being built in the
+    /// background.
     GLuint GetHandle(const ProgramVariant& variant);
 
 private:
     struct LockerVariant {
         std::unique_ptr<VideoCommon::Shader::ConstBufferLocker> locker;
         std::unordered_map<ProgramVariant, CachedProgram> programs;
+        std::unordered_map<ProgramVariant, std::future<CachedProgram>> pending_programs;
     };
 
     explicit CachedShader(const ShaderParameters& params, Tegra::Engines::ShaderType shader_type,
@@ -101,12 +111,17 @@ private:
 
     bool EnsureValidLockerVariant();
 
+    /// Returns the handle of a program being built in the background, or zero if it isn't ready.
+    GLuint GetHandleAsync(const ProgramVariant& variant);
+
     ShaderDiskCacheUsage GetUsage(const ProgramVariant& variant,
                                   const VideoCommon::Shader::ConstBufferLocker& locker) const;
 
     Core::System& system;
     ShaderDiskCacheOpenGL& disk_cache;
     const Device& device;
+    VideoCommon::Shader::AsyncShaders* async_shaders;
+    VideoCommon::Shader::AsyncShaderStats& stats;
 
     VAddr cpu_addr{};
 
@@ -126,6 +141,7 @@ class ShaderCacheOpenGL final : public RasterizerCache<Shader> {
 public:
     explicit ShaderCacheOpenGL(RasterizerOpenGL& rasterizer, Core::System& system,
                                Core::Frontend::EmuWindow& emu_window, const Device& device);
+    ~ShaderCacheOpenGL();
 
     /// Loads disk cache for the current game
     void LoadDiskCache(const std::atomic_bool& stop_loading,
@@ -137,14 +153,27 @@ public:
     /// Gets a compute kernel in the passed address
     Shader GetComputeKernel(GPUVAddr code_addr);
 
+    /// Returns how often programs were found, built or waited for
+    const VideoCommon::Shader::AsyncShaderStats& GetStats() const {
+        return stats;
+    }
+
+    /// Counts a draw or dispatch skipped because one of its programs is still being built
+    void CountSkippedDraw() {
+        ++stats.waits;
+    }
+
 protected:
     // We do not have to flush this cache as things in it are never modified by us.
     void FlushObjectInner(const Shader& object) override {}
 
 private:
-    bool GenerateUnspecializedShaders(const std::atomic_bool& stop_loading,
+    /// Reads and decodes the raw shaders of the transferable cache in parallel to learn their
+    /// entries
+    bool GenerateUnspecializedShaders(Common::ThreadPool& thread_pool,
+                                      const std::atomic_bool& stop_loading,
                                       const VideoCore::DiskResourceLoadCallback& callback,
-                                      const std::vector<ShaderDiskCacheRaw>& raws);
+                                      const ShaderDiskCacheTransferable& transferable);
 
     CachedProgram GeneratePrecompiledProgram(const ShaderDiskCacheDump& dump,
                                              const std::unordered_set<GLenum>& supported_formats);
@@ -163,6 +192,11 @@ private:
     std::unordered_map<u64, UnspecializedShader> unspecialized_shaders;
 
     std::array<Shader, Maxwell::MaxShaderProgram> last_shaders;
+
+    VideoCommon::Shader::AsyncShaderStats stats;
+
+    /// Background shader builders, only present when asynchronous shaders are enabled
+    std::unique_ptr<VideoCommon::Shader::AsyncShaders> async_shaders;
 };
 
 } // namespace OpenGL
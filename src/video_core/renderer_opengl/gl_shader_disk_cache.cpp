@@ -2,7 +2,10 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstddef>
 #include <cstring>
+#include <memory>
 
 #include <fmt/format.h>
 
@@ -29,13 +32,6 @@ using VideoCommon::Shader::KeyMap;
 
 namespace {
 
-using ShaderCacheVersionHash = std::array<u8, 64>;
-
-enum class TransferableEntryKind : u32 {
-    Raw,
-    Usage,
-};
-
 struct ConstBufferKey {
     u32 cbuf{};
     u32 offset{};
@@ -53,10 +49,47 @@ struct BindlessSamplerKey {
     Tegra::Engines::SamplerDescriptor sampler{};
 };
 
-constexpr u32 NativeVersion = 11;
+/// Identifies transferable cache files
+constexpr u32 TransferableMagic = 0x43545A59; // "YZTC"
+constexpr u32 NativeVersion = 12;
+
+/// Identifies precompiled cache files
+constexpr u32 PrecompiledMagic = 0x43505A59; // "YZPC"
+constexpr u32 PrecompiledVersion = 2;
+
+struct FileHeader {
+    u32 magic{};
+    u32 version{};
+    ShaderCacheVersionHash hash{};
+};
+
+/// Header of an index block. It's followed by IndexBlockEntries entries, of which the first
+/// num_entries are used. next_block is zero for the last block.
+struct IndexBlockHeader {
+    u64 next_block{};
+    u32 num_entries{};
+    u32 reserved{};
+};
+
+constexpr u32 IndexBlockEntries = 256;
+constexpr u64 IndexBlockSize =
+    sizeof(IndexBlockHeader) + IndexBlockEntries * sizeof(ShaderDiskCacheIndexEntry);
+
+/// Fixed size part of a dump entry. It's followed by the keys of the usage, as in usage entries,
+/// and the compressed program binary.
+struct DumpEntryHeader {
+    u32 binary_format{};
+    u32 binary_size{};
+    u32 compressed_size{};
+    u32 reserved{};
+};
 
 // Making sure sizes doesn't change by accident
 static_assert(sizeof(ProgramVariant) == 20);
+static_assert(sizeof(ShaderDiskCacheIndexEntry) == 48);
+static_assert(sizeof(FileHeader) == 72);
+static_assert(sizeof(IndexBlockHeader) == 16);
+static_assert(sizeof(DumpEntryHeader) == 16);
 
 ShaderCacheVersionHash GetShaderCacheVersionHash() {
     ShaderCacheVersionHash hash{};
@@ -65,268 +98,461 @@ ShaderCacheVersionHash GetShaderCacheVersionHash() {
     return hash;
 }
 
-} // Anonymous namespace
+/// Reads trivially copyable objects out of the data of an entry, failing past its end
+class EntryReader {
+public:
+    explicit EntryReader(const u8* data, std::size_t size) : data{data}, size{size} {}
 
-ShaderDiskCacheRaw::ShaderDiskCacheRaw(u64 unique_identifier, ShaderType type, ProgramCode code,
-                                       ProgramCode code_b)
-    : unique_identifier{unique_identifier}, type{type}, code{std::move(code)}, code_b{std::move(
-                                                                                   code_b)} {}
+    template <typename T>
+    bool ReadArray(T* objects, std::size_t count) {
+        const u64 length = u64{count} * sizeof(T);
+        if (size - offset < length) {
+            return false;
+        }
+        std::memcpy(objects, data + offset, length);
+        offset += length;
+        return true;
+    }
 
-ShaderDiskCacheRaw::ShaderDiskCacheRaw() = default;
+    template <typename T>
+    bool ReadObject(T& object) {
+        return ReadArray(&object, 1);
+    }
 
-ShaderDiskCacheRaw::~ShaderDiskCacheRaw() = default;
+    /// Reads count objects into a vector, checking the size before allocating it
+    template <typename T>
+    bool ReadVector(std::vector<T>& objects, u32 count) {
+        if ((size - offset) / sizeof(T) < count) {
+            return false;
+        }
+        objects.resize(count);
+        return ReadArray(objects.data(), count);
+    }
 
-bool ShaderDiskCacheRaw::Load(FileUtil::IOFile& file) {
-    if (file.ReadBytes(&unique_identifier, sizeof(u64)) != sizeof(u64) ||
-        file.ReadBytes(&type, sizeof(u32)) != sizeof(u32)) {
-        return false;
+    const u8* GetCurrent() const {
+        return data + offset;
     }
-    u32 code_size{};
-    u32 code_size_b{};
-    if (file.ReadBytes(&code_size, sizeof(u32)) != sizeof(u32) ||
-        file.ReadBytes(&code_size_b, sizeof(u32)) != sizeof(u32)) {
-        return false;
+
+    std::size_t GetRemaining() const {
+        return size - offset;
     }
 
-    code.resize(code_size);
-    code_b.resize(code_size_b);
+private:
+    const u8* data;
+    std::size_t size;
+    std::size_t offset{};
+};
 
-    if (file.ReadArray(code.data(), code_size) != code_size)
-        return false;
+template <typename T>
+void WriteArray(std::vector<u8>& out, const T* objects, std::size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto bytes = reinterpret_cast<const u8*>(objects);
+    out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+
+template <typename T>
+void WriteObject(std::vector<u8>& out, const T& object) {
+    WriteArray(out, &object, 1);
+}
+
+void WriteUsageKeys(std::vector<u8>& out, const ShaderDiskCacheUsage& usage) {
+    WriteObject(out, static_cast<u32>(usage.keys.size()));
+    WriteObject(out, static_cast<u32>(usage.bound_samplers.size()));
+    WriteObject(out, static_cast<u32>(usage.bindless_samplers.size()));
+    for (const auto& [pair, value] : usage.keys) {
+        WriteObject(out, ConstBufferKey{pair.first, pair.second, value});
+    }
+    for (const auto& [offset, sampler] : usage.bound_samplers) {
+        WriteObject(out, BoundSamplerKey{offset, sampler});
+    }
+    for (const auto& [pair, sampler] : usage.bindless_samplers) {
+        WriteObject(out, BindlessSamplerKey{pair.first, pair.second, sampler});
+    }
+}
 
-    if (HasProgramA() && file.ReadArray(code_b.data(), code_size_b) != code_size_b) {
+bool ReadUsageKeys(EntryReader& reader, ShaderDiskCacheUsage& usage) {
+    u32 num_keys{};
+    u32 num_bound_samplers{};
+    u32 num_bindless_samplers{};
+    std::vector<ConstBufferKey> keys;
+    std::vector<BoundSamplerKey> bound_samplers;
+    std::vector<BindlessSamplerKey> bindless_samplers;
+    if (!reader.ReadObject(num_keys) || !reader.ReadObject(num_bound_samplers) ||
+        !reader.ReadObject(num_bindless_samplers) || !reader.ReadVector(keys, num_keys) ||
+        !reader.ReadVector(bound_samplers, num_bound_samplers) ||
+        !reader.ReadVector(bindless_samplers, num_bindless_samplers)) {
         return false;
     }
+    for (const auto& key : keys) {
+        usage.keys.insert({{key.cbuf, key.offset}, key.value});
+    }
+    for (const auto& key : bound_samplers) {
+        usage.bound_samplers.emplace(key.offset, key.sampler);
+    }
+    for (const auto& key : bindless_samplers) {
+        usage.bindless_samplers.insert({{key.cbuf, key.offset}, key.sampler});
+    }
     return true;
 }
 
-bool ShaderDiskCacheRaw::Save(FileUtil::IOFile& file) const {
-    if (file.WriteObject(unique_identifier) != 1 || file.WriteObject(static_cast<u32>(type)) != 1 ||
-        file.WriteObject(static_cast<u32>(code.size())) != 1 ||
-        file.WriteObject(static_cast<u32>(code_b.size())) != 1) {
+/// Reads the usage of a usage or dump entry, leaving the reader past its keys
+std::optional<ShaderDiskCacheUsage> ReadUsage(const ShaderDiskCacheIndexEntry& entry,
+                                              EntryReader& reader) {
+    ShaderDiskCacheUsage usage;
+    usage.unique_identifier = entry.unique_identifier;
+    usage.variant = entry.variant;
+    if (!ReadUsageKeys(reader, usage)) {
+        return {};
+    }
+    return usage;
+}
+
+} // Anonymous namespace
+
+ShaderDiskCacheFile::ShaderDiskCacheFile(u32 magic, u32 version,
+                                         const ShaderCacheVersionHash& hash)
+    : magic{magic}, version{version}, hash{hash} {}
+
+ShaderDiskCacheFile::~ShaderDiskCacheFile() = default;
+
+ShaderDiskCacheFileStatus ShaderDiskCacheFile::Load(const std::string& path) {
+    Close();
+    auto file = std::make_shared<FileUtil::MappedFile>();
+    if (!file->Open(path)) {
+        return ShaderDiskCacheFileStatus::NotFound;
+    }
+    const u8* const data = file->GetData();
+    const u64 size = file->GetSize();
+
+    // Files of older formats without a magic may be smaller than the header
+    FileHeader header;
+    if (size < sizeof(header.magic)) {
+        return ShaderDiskCacheFileStatus::Corrupted;
+    }
+    std::memcpy(&header.magic, data, sizeof(header.magic));
+    if (header.magic != magic) {
+        return ShaderDiskCacheFileStatus::BadMagic;
+    }
+    if (size < sizeof(header)) {
+        return ShaderDiskCacheFileStatus::Corrupted;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != version) {
+        return header.version < version ? ShaderDiskCacheFileStatus::OldVersion
+                                        : ShaderDiskCacheFileStatus::NewVersion;
+    }
+    if (header.hash != hash) {
+        return ShaderDiskCacheFileStatus::OtherBuild;
+    }
+
+    // Blocks are appended to the file, so each one comes after the previous
+    std::vector<ShaderDiskCacheIndexEntry> entries;
+    u64 block = sizeof(header);
+    IndexBlockHeader block_header;
+    while (true) {
+        if (block > size || size - block < IndexBlockSize) {
+            return ShaderDiskCacheFileStatus::Corrupted;
+        }
+        std::memcpy(&block_header, data + block, sizeof(block_header));
+        if (block_header.num_entries > IndexBlockEntries ||
+            (block_header.next_block != 0 && block_header.next_block <= block)) {
+            return ShaderDiskCacheFileStatus::Corrupted;
+        }
+        const std::size_t first = entries.size();
+        entries.resize(first + block_header.num_entries);
+        std::memcpy(entries.data() + first, data + block + sizeof(block_header),
+                    block_header.num_entries * sizeof(ShaderDiskCacheIndexEntry));
+        if (block_header.next_block == 0) {
+            break;
+        }
+        block = block_header.next_block;
+    }
+    for (const auto& entry : entries) {
+        if (entry.offset > size || size - entry.offset < entry.size) {
+            return ShaderDiskCacheFileStatus::Corrupted;
+        }
+    }
+
+    mapping = std::move(file);
+    index = std::move(entries);
+    last_block = block;
+    last_block_entries = block_header.num_entries;
+    return ShaderDiskCacheFileStatus::Success;
+}
+
+bool ShaderDiskCacheFile::OpenForAppend(const std::string& path) {
+    if (!FileUtil::Exists(path) || FileUtil::GetSize(path) == 0) {
+        // New files start with the header and an empty index block
+        Close();
+        if (!writer.Open(path, "wb")) {
+            return false;
+        }
+        const FileHeader header{magic, version, hash};
+        const std::vector<u8> block(IndexBlockSize);
+        if (writer.WriteObject(header) != 1 ||
+            writer.WriteBytes(block.data(), block.size()) != block.size() || !writer.Flush()) {
+            writer.Close();
+            return false;
+        }
+        last_block = sizeof(header);
+        last_block_entries = 0;
+        return true;
+    }
+    if (Load(path) != ShaderDiskCacheFileStatus::Success) {
         return false;
     }
+    return writer.Open(path, "r+b");
+}
 
-    if (file.WriteArray(code.data(), code.size()) != code.size())
+bool ShaderDiskCacheFile::Append(u64 unique_identifier, const ProgramVariant& variant,
+                                 ShaderDiskCacheEntryKind kind, const std::vector<u8>& data) {
+    if (!writer.IsOpen() || !writer.Seek(0, SEEK_END)) {
+        return false;
+    }
+    const u64 offset = writer.Tell();
+    if (writer.WriteBytes(data.data(), data.size()) != data.size()) {
+        return false;
+    }
+    if (last_block_entries == IndexBlockEntries) {
+        // Append an empty block after the entry and link it to the full one
+        const u64 block = offset + data.size();
+        const std::vector<u8> block_data(IndexBlockSize);
+        if (writer.WriteBytes(block_data.data(), block_data.size()) != block_data.size() ||
+            !writer.Flush() || !writer.Seek(static_cast<s64>(last_block), SEEK_SET) ||
+            writer.WriteObject(block) != 1) {
+            return false;
+        }
+        last_block = block;
+        last_block_entries = 0;
+    }
+
+    // The entry is counted once it's written, the index never points to a partial entry
+    const ShaderDiskCacheIndexEntry entry{unique_identifier, variant, kind, offset,
+                                          static_cast<u32>(data.size())};
+    const u64 entry_offset = last_block + sizeof(IndexBlockHeader) +
+                             u64{last_block_entries} * sizeof(ShaderDiskCacheIndexEntry);
+    const u64 count_offset = last_block + offsetof(IndexBlockHeader, num_entries);
+    if (!writer.Flush() || !writer.Seek(static_cast<s64>(entry_offset), SEEK_SET) ||
+        writer.WriteObject(entry) != 1 || !writer.Flush() ||
+        !writer.Seek(static_cast<s64>(count_offset), SEEK_SET) ||
+        writer.WriteObject(last_block_entries + 1) != 1 || !writer.Flush()) {
         return false;
+    }
+    ++last_block_entries;
+    return true;
+}
+
+void ShaderDiskCacheFile::Close() {
+    writer.Close();
+    mapping.reset();
+    index.clear();
+    last_block = 0;
+    last_block_entries = 0;
+}
 
-    if (HasProgramA() && file.WriteArray(code_b.data(), code_b.size()) != code_b.size()) {
+std::optional<ShaderDiskCacheRaw> ShaderDiskCacheTransferable::LoadRaw(std::size_t index) const {
+    const ShaderDiskCacheIndexEntry& entry = raws[index];
+    ShaderDiskCacheRaw raw;
+    if (!raw.Load(entry.unique_identifier, file->GetData() + entry.offset, entry.size)) {
+        return {};
+    }
+    return raw;
+}
+
+std::vector<u8> ShaderDiskCacheDump::Decompress() const {
+    std::vector<u8> binary =
+        Common::Compression::DecompressDataZSTD(compressed_binary, compressed_size);
+    if (binary.size() != binary_size) {
+        return {};
+    }
+    return binary;
+}
+
+ShaderDumps::ShaderDumps() = default;
+
+ShaderDumps::ShaderDumps(const ShaderDiskCacheFile& file_) : file{file_.GetMapping()} {
+    for (const auto& entry : file_.GetIndex()) {
+        if (entry.kind == ShaderDiskCacheEntryKind::Dump) {
+            entries.emplace(entry.unique_identifier, entry);
+        }
+    }
+}
+
+ShaderDumps::~ShaderDumps() = default;
+
+std::optional<ShaderDiskCacheDump> ShaderDumps::Find(const ShaderDiskCacheUsage& usage) const {
+    const auto [begin, end] = entries.equal_range(usage.unique_identifier);
+    for (auto it = begin; it != end; ++it) {
+        const ShaderDiskCacheIndexEntry& entry = it->second;
+        if (entry.variant != usage.variant) {
+            continue;
+        }
+        EntryReader reader(file->GetData() + entry.offset, entry.size);
+        DumpEntryHeader header;
+        if (!reader.ReadObject(header)) {
+            continue;
+        }
+        const auto entry_usage = ReadUsage(entry, reader);
+        if (!entry_usage || *entry_usage != usage ||
+            reader.GetRemaining() != header.compressed_size) {
+            continue;
+        }
+
+        ShaderDiskCacheDump dump;
+        dump.binary_format = static_cast<GLenum>(header.binary_format);
+        dump.binary_size = header.binary_size;
+        dump.compressed_binary = reader.GetCurrent();
+        dump.compressed_size = header.compressed_size;
+        dump.file = file;
+        return dump;
+    }
+    return {};
+}
+
+void ShaderDumps::Clear() {
+    entries.clear();
+    file.reset();
+}
+
+ShaderDiskCacheRaw::ShaderDiskCacheRaw(u64 unique_identifier, ShaderType type, ProgramCode code,
+                                       ProgramCode code_b)
+    : unique_identifier{unique_identifier}, type{type}, code{std::move(code)}, code_b{std::move(
+                                                                                   code_b)} {}
+
+ShaderDiskCacheRaw::ShaderDiskCacheRaw() = default;
+
+ShaderDiskCacheRaw::~ShaderDiskCacheRaw() = default;
+
+bool ShaderDiskCacheRaw::Load(u64 unique_identifier_, const u8* data, std::size_t size) {
+    EntryReader reader(data, size);
+    u32 code_size{};
+    u32 code_size_b{};
+    if (!reader.ReadObject(type) || !reader.ReadObject(code_size) ||
+        !reader.ReadObject(code_size_b) || !reader.ReadVector(code, code_size) ||
+        !reader.ReadVector(code_b, code_size_b)) {
         return false;
     }
+    unique_identifier = unique_identifier_;
     return true;
 }
 
-ShaderDiskCacheOpenGL::ShaderDiskCacheOpenGL(Core::System& system) : system{system} {}
+std::vector<u8> ShaderDiskCacheRaw::Serialize() const {
+    std::vector<u8> data;
+    WriteObject(data, static_cast<u32>(type));
+    WriteObject(data, static_cast<u32>(code.size()));
+    WriteObject(data, static_cast<u32>(code_b.size()));
+    WriteArray(data, code.data(), code.size());
+    WriteArray(data, code_b.data(), code_b.size());
+    return data;
+}
+
+ShaderDiskCacheOpenGL::ShaderDiskCacheOpenGL(Core::System& system)
+    : system{system}, transferable_file{MakeTransferableFile()},
+      precompiled_file{MakePrecompiledFile()} {}
 
 ShaderDiskCacheOpenGL::~ShaderDiskCacheOpenGL() = default;
 
-std::optional<std::pair<std::vector<ShaderDiskCacheRaw>, std::vector<ShaderDiskCacheUsage>>>
-ShaderDiskCacheOpenGL::LoadTransferable() {
+std::optional<ShaderDiskCacheTransferable> ShaderDiskCacheOpenGL::LoadTransferable() {
     // Skip games without title id
     const bool has_title_id = system.CurrentProcess()->GetTitleID() != 0;
     if (!Settings::values.use_disk_shader_cache || !has_title_id) {
         return {};
     }
 
-    FileUtil::IOFile file(GetTransferablePath(), "rb");
-    if (!file.IsOpen()) {
+    switch (transferable_file.Load(GetTransferablePath())) {
+    case ShaderDiskCacheFileStatus::Success:
+        break;
+    case ShaderDiskCacheFileStatus::NotFound:
         LOG_INFO(Render_OpenGL, "No transferable shader cache found for game with title id={}",
                  GetTitleID());
         is_usable = true;
         return {};
-    }
-
-    u32 version{};
-    if (file.ReadBytes(&version, sizeof(version)) != sizeof(version)) {
-        LOG_ERROR(Render_OpenGL,
-                  "Failed to get transferable cache version for title id={}, skipping",
+    case ShaderDiskCacheFileStatus::NewVersion:
+        LOG_WARNING(Render_OpenGL, "Transferable shader cache was generated with a newer version "
+                                   "of the emulator, skipping");
+        return {};
+    case ShaderDiskCacheFileStatus::Corrupted:
+        LOG_ERROR(Render_OpenGL, "Failed to read transferable cache for title id={}, skipping",
                   GetTitleID());
+        transferable_file.Close();
         return {};
-    }
-
-    if (version < NativeVersion) {
+    default:
         LOG_INFO(Render_OpenGL, "Transferable shader cache is old, removing");
-        file.Close();
         InvalidateTransferable();
         is_usable = true;
         return {};
     }
-    if (version > NativeVersion) {
-        LOG_WARNING(Render_OpenGL, "Transferable shader cache was generated with a newer version "
-                                   "of the emulator, skipping");
+
+    // Version is valid, load the shaders
+    auto entries = LoadTransferableEntries(transferable_file);
+    if (!entries) {
+        transferable_file.Close();
         return {};
     }
+    for (const auto& raw : entries->raws) {
+        transferable.insert({raw.unique_identifier, {}});
+    }
+    for (const auto& usage : entries->usages) {
+        transferable[usage.unique_identifier].insert(usage);
+    }
 
-    // Version is valid, load the shaders
-    constexpr const char error_loading[] = "Failed to load transferable raw entry, skipping";
-    std::vector<ShaderDiskCacheRaw> raws;
-    std::vector<ShaderDiskCacheUsage> usages;
-    while (file.Tell() < file.GetSize()) {
-        TransferableEntryKind kind{};
-        if (file.ReadBytes(&kind, sizeof(u32)) != sizeof(u32)) {
-            LOG_ERROR(Render_OpenGL, "Failed to read transferable file, skipping");
-            return {};
-        }
+    is_usable = true;
+    return entries;
+}
 
-        switch (kind) {
-        case TransferableEntryKind::Raw: {
-            ShaderDiskCacheRaw entry;
-            if (!entry.Load(file)) {
-                LOG_ERROR(Render_OpenGL, error_loading);
-                return {};
-            }
-            transferable.insert({entry.GetUniqueIdentifier(), {}});
-            raws.push_back(std::move(entry));
+std::optional<ShaderDiskCacheTransferable> ShaderDiskCacheOpenGL::LoadTransferableEntries(
+    const ShaderDiskCacheFile& file) {
+    // Only usages are read here, raw shaders are read by the threads decoding them
+    ShaderDiskCacheTransferable result;
+    result.file = file.GetMapping();
+    for (const auto& entry : file.GetIndex()) {
+        switch (entry.kind) {
+        case ShaderDiskCacheEntryKind::Raw:
+            result.raws.push_back(entry);
             break;
-        }
-        case TransferableEntryKind::Usage: {
-            ShaderDiskCacheUsage usage;
-
-            u32 num_keys{};
-            u32 num_bound_samplers{};
-            u32 num_bindless_samplers{};
-            if (file.ReadArray(&usage.unique_identifier, 1) != 1 ||
-                file.ReadArray(&usage.variant, 1) != 1 || file.ReadArray(&num_keys, 1) != 1 ||
-                file.ReadArray(&num_bound_samplers, 1) != 1 ||
-                file.ReadArray(&num_bindless_samplers, 1) != 1) {
-                LOG_ERROR(Render_OpenGL, error_loading);
+        case ShaderDiskCacheEntryKind::Usage: {
+            EntryReader reader(file.GetEntryData(entry), entry.size);
+            auto usage = ReadUsage(entry, reader);
+            if (!usage) {
+                LOG_ERROR(Render_OpenGL, "Failed to load transferable usage entry, skipping");
                 return {};
             }
-
-            std::vector<ConstBufferKey> keys(num_keys);
-            std::vector<BoundSamplerKey> bound_samplers(num_bound_samplers);
-            std::vector<BindlessSamplerKey> bindless_samplers(num_bindless_samplers);
-            if (file.ReadArray(keys.data(), keys.size()) != keys.size() ||
-                file.ReadArray(bound_samplers.data(), bound_samplers.size()) !=
-                    bound_samplers.size() ||
-                file.ReadArray(bindless_samplers.data(), bindless_samplers.size()) !=
-                    bindless_samplers.size()) {
-                LOG_ERROR(Render_OpenGL, error_loading);
-                return {};
-            }
-            for (const auto& key : keys) {
-                usage.keys.insert({{key.cbuf, key.offset}, key.value});
-            }
-            for (const auto& key : bound_samplers) {
-                usage.bound_samplers.emplace(key.offset, key.sampler);
-            }
-            for (const auto& key : bindless_samplers) {
-                usage.bindless_samplers.insert({{key.cbuf, key.offset}, key.sampler});
-            }
-
-            usages.push_back(std::move(usage));
+            result.usages.push_back(std::move(*usage));
             break;
         }
         default:
             LOG_ERROR(Render_OpenGL, "Unknown transferable shader cache entry kind={}, skipping",
-                      static_cast<u32>(kind));
+                      static_cast<u32>(entry.kind));
             return {};
         }
     }
-
-    is_usable = true;
-    return {{std::move(raws), std::move(usages)}};
+    return result;
 }
 
-std::unordered_map<ShaderDiskCacheUsage, ShaderDiskCacheDump>
-ShaderDiskCacheOpenGL::LoadPrecompiled() {
+ShaderDumps ShaderDiskCacheOpenGL::LoadPrecompiled() {
     if (!is_usable) {
         return {};
     }
 
-    std::string path = GetPrecompiledPath();
-    FileUtil::IOFile file(path, "rb");
-    if (!file.IsOpen()) {
+    switch (precompiled_file.Load(GetPrecompiledPath())) {
+    case ShaderDiskCacheFileStatus::Success:
+        return ShaderDumps{precompiled_file};
+    case ShaderDiskCacheFileStatus::NotFound:
         LOG_INFO(Render_OpenGL, "No precompiled shader cache found for game with title id={}",
                  GetTitleID());
         return {};
-    }
-
-    const auto result = LoadPrecompiledFile(file);
-    if (!result) {
+    default:
         LOG_INFO(Render_OpenGL,
                  "Failed to load precompiled cache for game with title id={}, removing",
                  GetTitleID());
-        file.Close();
         InvalidatePrecompiled();
         return {};
     }
-    return *result;
-}
-
-std::optional<std::unordered_map<ShaderDiskCacheUsage, ShaderDiskCacheDump>>
-ShaderDiskCacheOpenGL::LoadPrecompiledFile(FileUtil::IOFile& file) {
-    // Read compressed file from disk and decompress to virtual precompiled cache file
-    std::vector<u8> compressed(file.GetSize());
-    file.ReadBytes(compressed.data(), compressed.size());
-    const std::vector<u8> decompressed = Common::Compression::DecompressDataZSTD(compressed);
-    SaveArrayToPrecompiled(decompressed.data(), decompressed.size());
-    precompiled_cache_virtual_file_offset = 0;
-
-    ShaderCacheVersionHash file_hash{};
-    if (!LoadArrayFromPrecompiled(file_hash.data(), file_hash.size())) {
-        precompiled_cache_virtual_file_offset = 0;
-        return {};
-    }
-    if (GetShaderCacheVersionHash() != file_hash) {
-        LOG_INFO(Render_OpenGL, "Precompiled cache is from another version of the emulator");
-        precompiled_cache_virtual_file_offset = 0;
-        return {};
-    }
-
-    ShaderDumpsMap dumps;
-    while (precompiled_cache_virtual_file_offset < precompiled_cache_virtual_file.GetSize()) {
-        u32 num_keys{};
-        u32 num_bound_samplers{};
-        u32 num_bindless_samplers{};
-        ShaderDiskCacheUsage usage;
-        if (!LoadObjectFromPrecompiled(usage.unique_identifier) ||
-            !LoadObjectFromPrecompiled(usage.variant) || !LoadObjectFromPrecompiled(num_keys) ||
-            !LoadObjectFromPrecompiled(num_bound_samplers) ||
-            !LoadObjectFromPrecompiled(num_bindless_samplers)) {
-            return {};
-        }
-        std::vector<ConstBufferKey> keys(num_keys);
-        std::vector<BoundSamplerKey> bound_samplers(num_bound_samplers);
-        std::vector<BindlessSamplerKey> bindless_samplers(num_bindless_samplers);
-        if (!LoadArrayFromPrecompiled(keys.data(), keys.size()) ||
-            !LoadArrayFromPrecompiled(bound_samplers.data(), bound_samplers.size()) !=
-                bound_samplers.size() ||
-            !LoadArrayFromPrecompiled(bindless_samplers.data(), bindless_samplers.size()) !=
-                bindless_samplers.size()) {
-            return {};
-        }
-        for (const auto& key : keys) {
-            usage.keys.insert({{key.cbuf, key.offset}, key.value});
-        }
-        for (const auto& key : bound_samplers) {
-            usage.bound_samplers.emplace(key.offset, key.sampler);
-        }
-        for (const auto& key : bindless_samplers) {
-            usage.bindless_samplers.insert({{key.cbuf, key.offset}, key.sampler});
-        }
-
-        ShaderDiskCacheDump dump;
-        if (!LoadObjectFromPrecompiled(dump.binary_format)) {
-            return {};
-        }
-
-        u32 binary_length{};
-        if (!LoadObjectFromPrecompiled(binary_length)) {
-            return {};
-        }
-
-        dump.binary.resize(binary_length);
-        if (!LoadArrayFromPrecompiled(dump.binary.data(), dump.binary.size())) {
-            return {};
-        }
-
-        dumps.emplace(std::move(usage), dump);
-    }
-    return dumps;
 }
 
 void ShaderDiskCacheOpenGL::InvalidateTransferable() {
+    transferable_file.Close();
+
     if (!FileUtil::Delete(GetTransferablePath())) {
         LOG_ERROR(Render_OpenGL, "Failed to invalidate transferable file={}",
                   GetTransferablePath());
@@ -335,8 +561,7 @@ void ShaderDiskCacheOpenGL::InvalidateTransferable() {
 }
 
 void ShaderDiskCacheOpenGL::InvalidatePrecompiled() {
-    // Clear virtaul precompiled cache file
-    precompiled_cache_virtual_file.Resize(0);
+    precompiled_file.Close();
 
     if (!FileUtil::Delete(GetPrecompiledPath())) {
         LOG_ERROR(Render_OpenGL, "Failed to invalidate precompiled file={}", GetPrecompiledPath());
@@ -354,13 +579,11 @@ void ShaderDiskCacheOpenGL::SaveRaw(const ShaderDiskCacheRaw& entry) {
         return;
     }
 
-    FileUtil::IOFile file = AppendTransferableFile();
-    if (!file.IsOpen()) {
+    if (!OpenTransferableFile()) {
         return;
     }
-    if (file.WriteObject(TransferableEntryKind::Raw) != 1 || !entry.Save(file)) {
+    if (!transferable_file.Append(id, {}, ShaderDiskCacheEntryKind::Raw, entry.Serialize())) {
         LOG_ERROR(Render_OpenGL, "Failed to save raw transferable cache entry, removing");
-        file.Close();
         InvalidateTransferable();
         return;
     }
@@ -382,42 +605,12 @@ void ShaderDiskCacheOpenGL::SaveUsage(const ShaderDiskCacheUsage& usage) {
     }
     usages.insert(usage);
 
-    FileUtil::IOFile file = AppendTransferableFile();
-    if (!file.IsOpen())
+    if (!OpenTransferableFile()) {
         return;
-    const auto Close = [&] {
+    }
+    if (!AppendUsage(transferable_file, usage)) {
         LOG_ERROR(Render_OpenGL, "Failed to save usage transferable cache entry, removing");
-        file.Close();
         InvalidateTransferable();
-    };
-
-    if (file.WriteObject(TransferableEntryKind::Usage) != 1 ||
-        file.WriteObject(usage.unique_identifier) != 1 || file.WriteObject(usage.variant) != 1 ||
-        file.WriteObject(static_cast<u32>(usage.keys.size())) != 1 ||
-        file.WriteObject(static_cast<u32>(usage.bound_samplers.size())) != 1 ||
-        file.WriteObject(static_cast<u32>(usage.bindless_samplers.size())) != 1) {
-        Close();
-        return;
-    }
-    for (const auto& [pair, value] : usage.keys) {
-        const auto [cbuf, offset] = pair;
-        if (file.WriteObject(ConstBufferKey{cbuf, offset, value}) != 1) {
-            Close();
-            return;
-        }
-    }
-    for (const auto& [offset, sampler] : usage.bound_samplers) {
-        if (file.WriteObject(BoundSamplerKey{offset, sampler}) != 1) {
-            Close();
-            return;
-        }
-    }
-    for (const auto& [pair, sampler] : usage.bindless_samplers) {
-        const auto [cbuf, offset] = pair;
-        if (file.WriteObject(BindlessSamplerKey{cbuf, offset, sampler}) != 1) {
-            Close();
-            return;
-        }
     }
 }
 
@@ -426,13 +619,6 @@ void ShaderDiskCacheOpenGL::SaveDump(const ShaderDiskCacheUsage& usage, GLuint p
         return;
     }
 
-    // TODO(Rodrigo): This is a design smell. I shouldn't be having to manually write the header
-    // when writing the dump. This should be done the moment I get access to write to the virtual
-    // file.
-    if (precompiled_cache_virtual_file.GetSize() == 0) {
-        SavePrecompiledHeaderToVirtualPrecompiledCache();
-    }
-
     GLint binary_length{};
     glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_length);
 
@@ -440,98 +626,74 @@ void ShaderDiskCacheOpenGL::SaveDump(const ShaderDiskCacheUsage& usage, GLuint p
     std::vector<u8> binary(binary_length);
     glGetProgramBinary(program, binary_length, nullptr, &binary_format, binary.data());
 
-    const auto Close = [&] {
+    if (!OpenPrecompiledFile() || !AppendDump(precompiled_file, usage, binary_format, binary)) {
         LOG_ERROR(Render_OpenGL, "Failed to save binary program file in shader={:016X}, removing",
                   usage.unique_identifier);
         InvalidatePrecompiled();
-    };
-
-    if (!SaveObjectToPrecompiled(usage.unique_identifier) ||
-        !SaveObjectToPrecompiled(usage.variant) ||
-        !SaveObjectToPrecompiled(static_cast<u32>(usage.keys.size())) ||
-        !SaveObjectToPrecompiled(static_cast<u32>(usage.bound_samplers.size())) ||
-        !SaveObjectToPrecompiled(static_cast<u32>(usage.bindless_samplers.size()))) {
-        Close();
-        return;
-    }
-    for (const auto& [pair, value] : usage.keys) {
-        const auto [cbuf, offset] = pair;
-        if (SaveObjectToPrecompiled(ConstBufferKey{cbuf, offset, value}) != 1) {
-            Close();
-            return;
-        }
-    }
-    for (const auto& [offset, sampler] : usage.bound_samplers) {
-        if (SaveObjectToPrecompiled(BoundSamplerKey{offset, sampler}) != 1) {
-            Close();
-            return;
-        }
-    }
-    for (const auto& [pair, sampler] : usage.bindless_samplers) {
-        const auto [cbuf, offset] = pair;
-        if (SaveObjectToPrecompiled(BindlessSamplerKey{cbuf, offset, sampler}) != 1) {
-            Close();
-            return;
-        }
-    }
-    if (!SaveObjectToPrecompiled(static_cast<u32>(binary_format)) ||
-        !SaveObjectToPrecompiled(static_cast<u32>(binary_length)) ||
-        !SaveArrayToPrecompiled(binary.data(), binary.size())) {
-        Close();
     }
 }
 
-FileUtil::IOFile ShaderDiskCacheOpenGL::AppendTransferableFile() const {
-    if (!EnsureDirectories()) {
-        return {};
+bool ShaderDiskCacheOpenGL::AppendUsage(ShaderDiskCacheFile& file,
+                                        const ShaderDiskCacheUsage& usage) {
+    std::vector<u8> data;
+    WriteUsageKeys(data, usage);
+    return file.Append(usage.unique_identifier, usage.variant, ShaderDiskCacheEntryKind::Usage,
+                       data);
+}
+
+bool ShaderDiskCacheOpenGL::AppendDump(ShaderDiskCacheFile& file,
+                                       const ShaderDiskCacheUsage& usage, GLenum binary_format,
+                                       const std::vector<u8>& binary) {
+    // Every entry is compressed on its own so they can be appended and decompressed separately
+    const std::vector<u8> compressed =
+        Common::Compression::CompressDataZSTDDefault(binary.data(), binary.size());
+    if (compressed.empty()) {
+        return false;
     }
 
-    const auto transferable_path{GetTransferablePath()};
-    const bool existed = FileUtil::Exists(transferable_path);
+    DumpEntryHeader header;
+    header.binary_format = static_cast<u32>(binary_format);
+    header.binary_size = static_cast<u32>(binary.size());
+    header.compressed_size = static_cast<u32>(compressed.size());
 
-    FileUtil::IOFile file(transferable_path, "ab");
-    if (!file.IsOpen()) {
-        LOG_ERROR(Render_OpenGL, "Failed to open transferable cache in path={}", transferable_path);
-        return {};
-    }
-    if (!existed || file.GetSize() == 0) {
-        // If the file didn't exist, write its version
-        if (file.WriteObject(NativeVersion) != 1) {
-            LOG_ERROR(Render_OpenGL, "Failed to write transferable cache version in path={}",
-                      transferable_path);
-            return {};
-        }
-    }
-    return file;
+    std::vector<u8> data;
+    WriteObject(data, header);
+    WriteUsageKeys(data, usage);
+    data.insert(data.end(), compressed.begin(), compressed.end());
+    return file.Append(usage.unique_identifier, usage.variant, ShaderDiskCacheEntryKind::Dump,
+                       data);
 }
 
-void ShaderDiskCacheOpenGL::SavePrecompiledHeaderToVirtualPrecompiledCache() {
-    const auto hash{GetShaderCacheVersionHash()};
-    if (!SaveArrayToPrecompiled(hash.data(), hash.size())) {
-        LOG_ERROR(
-            Render_OpenGL,
-            "Failed to write precompiled cache version hash to virtual precompiled cache file");
-    }
+ShaderDiskCacheFile ShaderDiskCacheOpenGL::MakeTransferableFile() {
+    return ShaderDiskCacheFile{TransferableMagic, NativeVersion, {}};
 }
 
-void ShaderDiskCacheOpenGL::SaveVirtualPrecompiledFile() {
-    precompiled_cache_virtual_file_offset = 0;
-    const std::vector<u8> uncompressed = precompiled_cache_virtual_file.ReadAllBytes();
-    const std::vector<u8> compressed =
-        Common::Compression::CompressDataZSTDDefault(uncompressed.data(), uncompressed.size());
+ShaderDiskCacheFile ShaderDiskCacheOpenGL::MakePrecompiledFile() {
+    return ShaderDiskCacheFile{PrecompiledMagic, PrecompiledVersion, GetShaderCacheVersionHash()};
+}
 
-    const auto precompiled_path{GetPrecompiledPath()};
-    FileUtil::IOFile file(precompiled_path, "wb");
+bool ShaderDiskCacheOpenGL::OpenTransferableFile() {
+    if (transferable_file.IsOpenForAppend()) {
+        return true;
+    }
+    const auto transferable_path{GetTransferablePath()};
+    if (!EnsureDirectories() || !transferable_file.OpenForAppend(transferable_path)) {
+        LOG_ERROR(Render_OpenGL, "Failed to open transferable cache in path={}", transferable_path);
+        return false;
+    }
+    return true;
+}
 
-    if (!file.IsOpen()) {
-        LOG_ERROR(Render_OpenGL, "Failed to open precompiled cache in path={}", precompiled_path);
-        return;
+bool ShaderDiskCacheOpenGL::OpenPrecompiledFile() {
+    if (precompiled_file.IsOpenForAppend()) {
+        return true;
     }
-    if (file.WriteBytes(compressed.data(), compressed.size()) != compressed.size()) {
-        LOG_ERROR(Render_OpenGL, "Failed to write precompiled cache version in path={}",
-                  precompiled_path);
-        return;
+    const auto precompiled_path{GetPrecompiledPath()};
+    if (!EnsureDirectories() || !precompiled_file.OpenForAppend(precompiled_path)) {
+        LOG_ERROR(Render_OpenGL, "Failed to open precompiled cache in path={}", precompiled_path);
+        return false;
     }
+    return true;
 }
 
 bool ShaderDiskCacheOpenGL::EnsureDirectories() const {
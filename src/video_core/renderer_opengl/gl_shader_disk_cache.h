@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -17,7 +19,7 @@
 
 #include "common/assert.h"
 #include "common/common_types.h"
-#include "core/file_sys/vfs_vector.h"
+#include "common/file_util.h"
 #include "video_core/engines/shader_type.h"
 #include "video_core/renderer_opengl/gl_shader_gen.h"
 #include "video_core/shader/const_buffer_locker.h"
@@ -26,17 +28,10 @@ namespace Core {
 class System;
 }
 
-namespace FileUtil {
-class IOFile;
-}
-
 namespace OpenGL {
 
-struct ShaderDiskCacheUsage;
-struct ShaderDiskCacheDump;
-
 using ProgramCode = std::vector<u64>;
-using ShaderDumpsMap = std::unordered_map<ShaderDiskCacheUsage, ShaderDiskCacheDump>;
+using ShaderCacheVersionHash = std::array<u8, 64>;
 
 /// Describes the different variants a program can be compiled with.
 struct ProgramVariant final {
@@ -122,6 +117,92 @@ struct hash<OpenGL::ShaderDiskCacheUsage> {
 
 namespace OpenGL {
 
+/// Kinds of entries stored in the shader cache files
+enum class ShaderDiskCacheEntryKind : u32 {
+    Raw,
+    Usage,
+    Dump,
+};
+
+/// Location of an entry in a shader cache file, keyed by the unique identifier and the variant
+/// of the shader it describes. Raw shaders have no variant.
+struct ShaderDiskCacheIndexEntry {
+    u64 unique_identifier{};
+    ProgramVariant variant;
+    ShaderDiskCacheEntryKind kind{};
+    u64 offset{};
+    u32 size{};
+    u32 reserved{};
+};
+static_assert(std::is_trivially_copyable_v<ShaderDiskCacheIndexEntry>);
+
+enum class ShaderDiskCacheFileStatus {
+    Success,
+    NotFound,
+    BadMagic,
+    OldVersion,
+    NewVersion,
+    OtherBuild,
+    Corrupted,
+};
+
+/**
+ * Shader cache file made of a header, entries appended one after another and an index of their
+ * locations. The index is stored in fixed size blocks, the first one right after the header and
+ * the next ones appended when the previous fills up, so entries are appended without rewriting
+ * the file. An entry is added to the index only once its data has been written, files cut short
+ * while appending keep every entry written before.
+ */
+class ShaderDiskCacheFile {
+public:
+    explicit ShaderDiskCacheFile(u32 magic, u32 version, const ShaderCacheVersionHash& hash);
+    ~ShaderDiskCacheFile();
+
+    /// Maps the file and reads its index, entries are read from the mapping on demand.
+    ShaderDiskCacheFileStatus Load(const std::string& path);
+
+    /// Opens the file for appending. Empty and missing files are created with an empty index.
+    /// Returns false if the file can't be opened or isn't a valid file of this kind.
+    bool OpenForAppend(const std::string& path);
+
+    bool IsOpenForAppend() const {
+        return writer.IsOpen();
+    }
+
+    /// Appends an entry and adds it to the index in the file. Returns false on failure.
+    bool Append(u64 unique_identifier, const ProgramVariant& variant,
+                ShaderDiskCacheEntryKind kind, const std::vector<u8>& data);
+
+    /// Unmaps and closes the file.
+    void Close();
+
+    /// Returns the index of the file as it was loaded, without the entries appended since.
+    const std::vector<ShaderDiskCacheIndexEntry>& GetIndex() const {
+        return index;
+    }
+
+    /// Returns the data of an entry of the index in the mapped file.
+    const u8* GetEntryData(const ShaderDiskCacheIndexEntry& entry) const {
+        return mapping->GetData() + entry.offset;
+    }
+
+    const std::shared_ptr<const FileUtil::MappedFile>& GetMapping() const {
+        return mapping;
+    }
+
+private:
+    u32 magic;
+    u32 version;
+    ShaderCacheVersionHash hash;
+
+    std::shared_ptr<const FileUtil::MappedFile> mapping;
+    std::vector<ShaderDiskCacheIndexEntry> index;
+
+    FileUtil::IOFile writer;
+    u64 last_block{};
+    u32 last_block_entries{};
+};
+
 /// Describes a shader how it's used by the guest GPU
 class ShaderDiskCacheRaw {
 public:
@@ -130,9 +211,11 @@ public:
     ShaderDiskCacheRaw();
     ~ShaderDiskCacheRaw();
 
-    bool Load(FileUtil::IOFile& file);
+    /// Reads the shader from the data of its cache entry. Returns false if it's malformed.
+    bool Load(u64 unique_identifier, const u8* data, std::size_t size);
 
-    bool Save(FileUtil::IOFile& file) const;
+    /// Returns the data of the shader's cache entry.
+    std::vector<u8> Serialize() const;
 
     u64 GetUniqueIdentifier() const {
         return unique_identifier;
@@ -161,10 +244,48 @@ private:
     ProgramCode code_b;
 };
 
-/// Contains an OpenGL dumped binary program
+/// Contents of a transferable file. Usages are read when the file is loaded, raw shaders are
+/// read from the mapped file on demand.
+struct ShaderDiskCacheTransferable {
+    /// Reads the raw shader of an entry of raws. Returns empty if the entry is malformed.
+    std::optional<ShaderDiskCacheRaw> LoadRaw(std::size_t index) const;
+
+    std::vector<ShaderDiskCacheIndexEntry> raws;
+    std::vector<ShaderDiskCacheUsage> usages;
+    std::shared_ptr<const FileUtil::MappedFile> file;
+};
+
+/// Contains an OpenGL dumped binary program, kept compressed in the mapped precompiled file
 struct ShaderDiskCacheDump {
+    /// Decompresses the program binary. Returns empty on failure.
+    std::vector<u8> Decompress() const;
+
     GLenum binary_format{};
-    std::vector<u8> binary;
+    u32 binary_size{};
+    const u8* compressed_binary{};
+    u32 compressed_size{};
+
+    /// Keeps the precompiled file mapped while its dumps are alive
+    std::shared_ptr<const FileUtil::MappedFile> file;
+};
+
+/// Dumps of a precompiled file, indexed by unique identifier. The keys of an entry are only read
+/// when a usage with its identifier and variant is looked up.
+class ShaderDumps {
+public:
+    ShaderDumps();
+    explicit ShaderDumps(const ShaderDiskCacheFile& file);
+    ~ShaderDumps();
+
+    /// Returns the dump of a usage, or empty if it has none. Safe to call from many threads.
+    std::optional<ShaderDiskCacheDump> Find(const ShaderDiskCacheUsage& usage) const;
+
+    /// Forgets the dumps and unmaps the file once the dumps returned by Find are released.
+    void Clear();
+
+private:
+    std::unordered_multimap<u64, ShaderDiskCacheIndexEntry> entries;
+    std::shared_ptr<const FileUtil::MappedFile> file;
 };
 
 class ShaderDiskCacheOpenGL {
@@ -173,16 +294,21 @@ public:
     ~ShaderDiskCacheOpenGL();
 
     /// Loads transferable cache. If file has a old version or on failure, it deletes the file.
-    std::optional<std::pair<std::vector<ShaderDiskCacheRaw>, std::vector<ShaderDiskCacheUsage>>>
-    LoadTransferable();
+    std::optional<ShaderDiskCacheTransferable> LoadTransferable();
+
+    /// Reads the usages of a loaded transferable file and collects its raw entries. Returns empty
+    /// on failure.
+    static std::optional<ShaderDiskCacheTransferable> LoadTransferableEntries(
+        const ShaderDiskCacheFile& file);
 
-    /// Loads current game's precompiled cache. Invalidates on failure.
-    std::unordered_map<ShaderDiskCacheUsage, ShaderDiskCacheDump> LoadPrecompiled();
+    /// Indexes current game's precompiled cache, keys and binaries are read on demand.
+    /// Invalidates on failure.
+    ShaderDumps LoadPrecompiled();
 
     /// Removes the transferable (and precompiled) cache file.
     void InvalidateTransferable();
 
-    /// Removes the precompiled cache file and clears virtual precompiled cache file.
+    /// Removes the precompiled cache file.
     void InvalidatePrecompiled();
 
     /// Saves a raw dump to the transferable file. Checks for collisions.
@@ -191,22 +317,27 @@ public:
     /// Saves shader usage to the transferable file. Does not check for collisions.
     void SaveUsage(const ShaderDiskCacheUsage& usage);
 
-    /// Saves a dump entry to the precompiled file. Does not check for collisions.
+    /// Appends a dump entry to the precompiled file. Does not check for collisions.
     void SaveDump(const ShaderDiskCacheUsage& usage, GLuint program);
 
-    /// Serializes virtual precompiled shader cache file to real file
-    void SaveVirtualPrecompiledFile();
+    /// Appends a usage entry to a transferable file. Returns false on failure.
+    static bool AppendUsage(ShaderDiskCacheFile& file, const ShaderDiskCacheUsage& usage);
 
-private:
-    /// Loads the transferable cache. Returns empty on failure.
-    std::optional<std::unordered_map<ShaderDiskCacheUsage, ShaderDiskCacheDump>>
-    LoadPrecompiledFile(FileUtil::IOFile& file);
+    /// Compresses a program binary and appends it to a precompiled file. Returns false on failure.
+    static bool AppendDump(ShaderDiskCacheFile& file, const ShaderDiskCacheUsage& usage,
+                           GLenum binary_format, const std::vector<u8>& binary);
+
+    /// Creates the objects of the transferable and precompiled files. The transferable file is
+    /// shared between emulator builds, so it doesn't hold a build hash.
+    static ShaderDiskCacheFile MakeTransferableFile();
+    static ShaderDiskCacheFile MakePrecompiledFile();
 
-    /// Opens current game's transferable file and write it's header if it doesn't exist
-    FileUtil::IOFile AppendTransferableFile() const;
+private:
+    /// Opens current game's transferable file for appending. Returns false on failure.
+    bool OpenTransferableFile();
 
-    /// Save precompiled header to precompiled_cache_in_memory
-    void SavePrecompiledHeaderToVirtualPrecompiledCache();
+    /// Opens current game's precompiled file for appending. Returns false on failure.
+    bool OpenPrecompiledFile();
 
     /// Create shader disk cache directories. Returns true on success.
     bool EnsureDirectories() const;
@@ -229,44 +360,11 @@ private:
     /// Get current game's title id
     std::string GetTitleID() const;
 
-    template <typename T>
-    bool SaveArrayToPrecompiled(const T* data, std::size_t length) {
-        const std::size_t write_length = precompiled_cache_virtual_file.WriteArray(
-            data, length, precompiled_cache_virtual_file_offset);
-        precompiled_cache_virtual_file_offset += write_length;
-        return write_length == sizeof(T) * length;
-    }
-
-    template <typename T>
-    bool LoadArrayFromPrecompiled(T* data, std::size_t length) {
-        const std::size_t read_length = precompiled_cache_virtual_file.ReadArray(
-            data, length, precompiled_cache_virtual_file_offset);
-        precompiled_cache_virtual_file_offset += read_length;
-        return read_length == sizeof(T) * length;
-    }
-
-    template <typename T>
-    bool SaveObjectToPrecompiled(const T& object) {
-        return SaveArrayToPrecompiled(&object, 1);
-    }
-
-    bool SaveObjectToPrecompiled(bool object) {
-        const auto value = static_cast<u8>(object);
-        return SaveArrayToPrecompiled(&value, 1);
-    }
-
-    template <typename T>
-    bool LoadObjectFromPrecompiled(T& object) {
-        return LoadArrayFromPrecompiled(&object, 1);
-    }
-
     Core::System& system;
 
-    // Stores whole precompiled cache which will be read from or saved to the precompiled chache
-    // file
-    FileSys::VectorVfsFile precompiled_cache_virtual_file;
-    // Stores the current offset of the precompiled cache file for IO purposes
-    std::size_t precompiled_cache_virtual_file_offset = 0;
+    // Transferable and precompiled files, kept open while entries are appended to them
+    ShaderDiskCacheFile transferable_file;
+    ShaderDiskCacheFile precompiled_file;
 
     // Stored transferable shaders
     std::unordered_map<u64, std::unordered_set<ShaderDiskCacheUsage>> transferable;
@@ -33,7 +33,7 @@ class ASTVarSet;
 using ASTData = std::variant<ASTProgram, ASTIfThen, ASTIfElse, ASTBlockEncoded, ASTBlockDecoded,
                              ASTVarSet, ASTGoto, ASTLabel, ASTDoWhile, ASTReturn, ASTBreak>;
 
-using ASTNode = std::shared_ptr<ASTBase>;
+using ASTNode = ASTBase*;
 
 enum class ASTZipperType : u32 {
     Program,
@@ -148,8 +148,8 @@ public:
 
     template <class U, class... Args>
     static ASTNode Make(ASTNode parent, Args&&... args) {
-        return std::make_shared<ASTBase>(std::move(parent),
-                                         ASTData(U(std::forward<Args>(args)...)));
+        return NodeArena::Current().Create<ASTBase>(std::move(parent),
+                                                    ASTData(U(std::forward<Args>(args)...)));
     }
 
     void SetParent(ASTNode new_parent) {
@@ -289,9 +289,9 @@ public:
     }
 
     void Clear() {
-        next.reset();
-        previous.reset();
-        parent.reset();
+        next = nullptr;
+        previous = nullptr;
+        parent = nullptr;
         manager = nullptr;
     }
 
@@ -313,8 +313,8 @@ public:
     ASTManager(const ASTManager& o) = delete;
     ASTManager& operator=(const ASTManager& other) = delete;
 
-    ASTManager(ASTManager&& other) noexcept = default;
-    ASTManager& operator=(ASTManager&& other) noexcept = default;
+    ASTManager(ASTManager&& other) noexcept;
+    ASTManager& operator=(ASTManager&& other) noexcept;
 
     void Init();
 
@@ -0,0 +1,69 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <utility>
+
+#include "common/scope_exit.h"
+#include "common/thread.h"
+#include "core/frontend/emu_window.h"
+#include "video_core/shader/async_shaders.h"
+
+namespace VideoCommon::Shader {
+
+AsyncShaders::AsyncShaders(std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> contexts_)
+    : contexts{std::move(contexts_)} {
+    threads.reserve(contexts.size());
+    for (auto& context : contexts) {
+        threads.emplace_back([this, context = context.get()] { WorkerLoop(context); });
+    }
+}
+
+AsyncShaders::~AsyncShaders() {
+    {
+        std::lock_guard lock{queue_mutex};
+        stop_requested = true;
+        // Pending jobs are dropped, their futures report a broken promise
+        work_queue = {};
+    }
+    work_available.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void AsyncShaders::QueueWork(std::function<void()> work) {
+    {
+        std::lock_guard lock{queue_mutex};
+        work_queue.push(std::move(work));
+    }
+    work_available.notify_one();
+}
+
+void AsyncShaders::WorkerLoop(Core::Frontend::GraphicsContext* context) {
+    Common::SetCurrentThreadName("yuzu:ShaderBuilder");
+    if (context) {
+        context->MakeCurrent();
+    }
+    SCOPE_EXIT({
+        if (context) {
+            context->DoneCurrent();
+        }
+    });
+
+    while (true) {
+        std::function<void()> work;
+        {
+            std::unique_lock lock{queue_mutex};
+            work_available.wait(lock, [this] { return stop_requested || !work_queue.empty(); });
+            if (stop_requested) {
+                return;
+            }
+            work = std::move(work_queue.front());
+            work_queue.pop();
+        }
+        work();
+    }
+}
+
+} // namespace VideoCommon::Shader
@@ -0,0 +1,85 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Core::Frontend {
+class GraphicsContext;
+}
+
+namespace VideoCommon::Shader {
+
+/// Counters describing how often drawing had to wait for shaders to be built.
+struct AsyncShaderStats {
+    u64 hits{};   ///< Programs found already built.
+    u64 misses{}; ///< Programs that had to be built.
+    u64 waits{};  ///< Draws or dispatches skipped because their program was still being built.
+};
+
+/**
+ * Queue of shader build jobs executed in the background by worker threads. It is agnostic of
+ * the graphics API, backends queue whatever decompilation and compilation work they need and poll
+ * the returned future from the GPU thread.
+ */
+class AsyncShaders final {
+public:
+    /**
+     * Starts one worker thread per context.
+     * @param contexts Contexts made current on each worker thread while it runs. They may be null
+     *                 for APIs that don't need a context to build pipelines.
+     */
+    explicit AsyncShaders(std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> contexts);
+    ~AsyncShaders();
+
+    /// Queues a job to be run on a worker thread, returning a future to its result.
+    template <typename Func>
+    std::future<std::invoke_result_t<Func>> QueueJob(Func&& func) {
+        using Result = std::invoke_result_t<Func>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        std::future<Result> future = task->get_future();
+        QueueWork([task = std::move(task)] { (*task)(); });
+        return future;
+    }
+
+    /// Returns true when the result of a queued job is ready to be taken without blocking.
+    template <typename T>
+    static bool IsReady(const std::future<T>& future) {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    /// Returns the number of worker threads.
+    std::size_t NumWorkers() const {
+        return threads.size();
+    }
+
+private:
+    void QueueWork(std::function<void()> work);
+
+    void WorkerLoop(Core::Frontend::GraphicsContext* context);
+
+    std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> contexts;
+    std::vector<std::thread> threads;
+
+    std::mutex queue_mutex;
+    std::condition_variable work_available;
+    std::queue<std::function<void()>> work_queue;
+    bool stop_requested = false;
+};
+
+} // namespace VideoCommon::Shader
@@ -14,7 +14,7 @@ bool ExprIsBoolean(const Expr& expr) {
 }
 
 bool ExprBooleanGet(const Expr& expr) {
-    return std::get_if<ExprBoolean>(expr.get())->value;
+    return std::get_if<ExprBoolean>(expr)->value;
 }
 } // Anonymous namespace
 
@@ -44,7 +44,7 @@ bool ExprNot::operator!=(const ExprNot& b) const {
 
 Expr MakeExprNot(Expr first) {
     if (std::holds_alternative<ExprNot>(*first)) {
-        return std::get_if<ExprNot>(first.get())->operand1;
+        return std::get_if<ExprNot>(first)->operand1;
     }
     return MakeExpr<ExprNot>(std::move(first));
 }
@@ -75,10 +75,10 @@ bool ExprAreEqual(const Expr& first, const Expr& second) {
 
 bool ExprAreOpposite(const Expr& first, const Expr& second) {
     if (std::holds_alternative<ExprNot>(*first)) {
-        return ExprAreEqual(std::get_if<ExprNot>(first.get())->operand1, second);
+        return ExprAreEqual(std::get_if<ExprNot>(first)->operand1, second);
     }
     if (std::holds_alternative<ExprNot>(*second)) {
-        return ExprAreEqual(std::get_if<ExprNot>(second.get())->operand1, first);
+        return ExprAreEqual(std::get_if<ExprNot>(second)->operand1, first);
     }
     return false;
 }
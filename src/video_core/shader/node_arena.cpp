@@ -0,0 +1,81 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstdint>
+
+#include "common/assert.h"
+#include "video_core/shader/node_arena.h"
+
+namespace VideoCommon::Shader {
+
+namespace {
+/// Size of the blocks nodes are allocated from, large enough for a few hundred nodes.
+constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+thread_local NodeArena* current_arena = nullptr;
+} // Anonymous namespace
+
+NodeArena::Scope::Scope(NodeArena& arena) : previous{current_arena} {
+    current_arena = &arena;
+}
+
+NodeArena::Scope::~Scope() {
+    current_arena = previous;
+}
+
+NodeArena::NodeArena() = default;
+
+NodeArena::~NodeArena() {
+    DestroyObjects();
+}
+
+NodeArena::NodeArena(NodeArena&& other) noexcept
+    : blocks{std::move(other.blocks)}, destructors{std::move(other.destructors)},
+      cursor{std::exchange(other.cursor, nullptr)},
+      block_end{std::exchange(other.block_end, nullptr)},
+      reserved_bytes{std::exchange(other.reserved_bytes, 0)} {}
+
+NodeArena& NodeArena::operator=(NodeArena&& other) noexcept {
+    if (this != &other) {
+        DestroyObjects();
+        blocks = std::move(other.blocks);
+        destructors = std::move(other.destructors);
+        cursor = std::exchange(other.cursor, nullptr);
+        block_end = std::exchange(other.block_end, nullptr);
+        reserved_bytes = std::exchange(other.reserved_bytes, 0);
+    }
+    return *this;
+}
+
+NodeArena& NodeArena::Current() {
+    ASSERT_MSG(current_arena != nullptr, "Shader nodes created without an active arena");
+    return *current_arena;
+}
+
+void* NodeArena::Allocate(std::size_t size, std::size_t alignment) {
+    auto address = reinterpret_cast<std::uintptr_t>(cursor);
+    address = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    if (cursor == nullptr || address + size > reinterpret_cast<std::uintptr_t>(block_end)) {
+        const std::size_t block_size = std::max(BLOCK_SIZE, size + alignment);
+        blocks.push_back(std::make_unique<u8[]>(block_size));
+        reserved_bytes += block_size;
+        cursor = blocks.back().get();
+        block_end = cursor + block_size;
+        address = reinterpret_cast<std::uintptr_t>(cursor);
+        address = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    }
+    cursor = reinterpret_cast<u8*>(address + size);
+    return reinterpret_cast<void*>(address);
+}
+
+void NodeArena::DestroyObjects() {
+    // Destroy in reverse order of construction, nodes may still reference older ones
+    for (auto it = destructors.rbegin(); it != destructors.rend(); ++it) {
+        it->destroy(it->object);
+    }
+    destructors.clear();
+}
+
+} // namespace VideoCommon::Shader
@@ -0,0 +1,85 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace VideoCommon::Shader {
+
+/**
+ * Bump allocator owning the nodes of a shader's IR, expressions and AST. Nodes are referenced
+ * through plain pointers and are all destroyed at once along with the arena, so building the IR
+ * doesn't pay for a heap allocation and reference counting per node.
+ *
+ * Node creation helpers (MakeNode, MakeExpr, ASTBase::Make) allocate from the arena that is
+ * active on the calling thread, see NodeArena::Scope.
+ */
+class NodeArena final {
+public:
+    /// Makes an arena the one nodes are created in on the calling thread while in scope.
+    class Scope final {
+    public:
+        explicit Scope(NodeArena& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        NodeArena* previous;
+    };
+
+    NodeArena();
+    ~NodeArena();
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    NodeArena(NodeArena&&) noexcept;
+    NodeArena& operator=(NodeArena&&) noexcept;
+
+    /// Returns the arena active on the calling thread. There must be one.
+    static NodeArena& Current();
+
+    /// Constructs an object in the arena. It lives until the arena is destroyed.
+    template <typename T, typename... Args>
+    T* Create(Args&&... args) {
+        T* const object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destructors.push_back({object, [](void* pointer) { static_cast<T*>(pointer)->~T(); }});
+        }
+        return object;
+    }
+
+    /// Returns the number of bytes reserved from the heap for nodes.
+    std::size_t GetReservedBytes() const {
+        return reserved_bytes;
+    }
+
+private:
+    struct Destructor {
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    void* Allocate(std::size_t size, std::size_t alignment);
+
+    void DestroyObjects();
+
+    std::vector<std::unique_ptr<u8[]>> blocks;
+    std::vector<Destructor> destructors;
+    u8* cursor = nullptr;
+    u8* block_end = nullptr;
+    std::size_t reserved_bytes = 0;
+};
+
+} // namespace VideoCommon::Shader
@@ -20,6 +20,7 @@
 #include "video_core/shader/compiler_settings.h"
 #include "video_core/shader/const_buffer_locker.h"
 #include "video_core/shader/node.h"
+#include "video_core/shader/node_arena.h"
 
 namespace VideoCommon::Shader {
 
@@ -169,6 +170,11 @@ public:
         return program_manager.GetVariables();
     }
 
+    /// Returns the number of bytes reserved to hold the nodes of the shader.
+    std::size_t GetNodeMemoryUsage() const {
+        return arena.GetReservedBytes();
+    }
+
     u32 ConvertAddressToNvidiaSpace(u32 address) const {
         return (address - main_offset) * static_cast<u32>(sizeof(Tegra::Shader::Instruction));
     }
@@ -403,6 +409,9 @@ private:
     u32 coverage_begin{};
     u32 coverage_end{};
 
+    /// Owns every node of the shader, it has to outlive the containers referencing them.
+    NodeArena arena;
+
     std::map<u32, NodeBlock> basic_blocks;
     NodeBlock global_code;
     ASTManager program_manager{true, true};
@@ -6,13 +6,16 @@
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/microprofile.h"
+#include "common/thread_pool.h"
 #include "video_core/memory_manager.h"
 #include "video_core/texture_cache/surface_base.h"
 #include "video_core/texture_cache/surface_params.h"
 #include "video_core/textures/convert.h"
+#include "video_core/textures/decoders.h"
 
 namespace VideoCommon {
 
+MICROPROFILE_DEFINE(GPU_Read_Texture, "GPU", "Texture Read", MP_RGB(128, 192, 128));
 MICROPROFILE_DEFINE(GPU_Load_Texture, "GPU", "Texture Load", MP_RGB(128, 192, 128));
 MICROPROFILE_DEFINE(GPU_Flush_Texture, "GPU", "Texture Flush", MP_RGB(128, 192, 128));
 
@@ -156,7 +159,7 @@ std::vector<CopyParams> SurfaceBaseImpl::BreakDownNonLayered(const SurfaceParams
 }
 
 void SurfaceBaseImpl::SwizzleFunc(MortonSwizzleMode mode, u8* memory, const SurfaceParams& params,
-                                  u8* buffer, u32 level) {
+                                  u8* buffer, u32 level) const {
     const u32 width{params.GetMipWidth(level)};
     const u32 height{params.GetMipHeight(level)};
     const u32 block_height{params.GetMipBlockHeight(level)};
@@ -164,14 +167,21 @@ void SurfaceBaseImpl::SwizzleFunc(MortonSwizzleMode mode, u8* memory, const Surf
 
     std::size_t guest_offset{mipmap_offsets[level]};
     if (params.is_layered) {
-        std::size_t host_offset{0};
         const std::size_t guest_stride = layer_size;
         const std::size_t host_stride = params.GetHostLayerSize(level);
-        for (u32 layer = 0; layer < params.depth; ++layer) {
+        const auto swizzle_layer = [&](std::size_t layer) {
             MortonSwizzle(mode, params.pixel_format, width, block_height, height, block_depth, 1,
-                          params.tile_width_spacing, buffer + host_offset, memory + guest_offset);
-            guest_offset += guest_stride;
-            host_offset += host_stride;
+                          params.tile_width_spacing, buffer + layer * host_stride,
+                          memory + guest_offset + layer * guest_stride);
+        };
+        // Layers are independent from each other, large arrays are split between worker threads.
+        if (params.depth > 1 &&
+            host_stride * params.depth >= Tegra::Texture::ParallelSwizzleThreshold) {
+            Tegra::Texture::GetTextureWorkerPool().ParallelFor(params.depth, swizzle_layer);
+            return;
+        }
+        for (u32 layer = 0; layer < params.depth; ++layer) {
+            swizzle_layer(layer);
         }
     } else {
         MortonSwizzle(mode, params.pixel_format, width, block_height, height, block_depth,
@@ -180,35 +190,23 @@ void SurfaceBaseImpl::SwizzleFunc(MortonSwizzleMode mode, u8* memory, const Surf
     }
 }
 
-void SurfaceBaseImpl::LoadBuffer(Tegra::MemoryManager& memory_manager,
-                                 StagingCache& staging_cache) {
-    MICROPROFILE_SCOPE(GPU_Load_Texture);
-    auto& staging_buffer = staging_cache.GetBuffer(0);
-    u8* host_ptr;
+void SurfaceBaseImpl::ReadGuestMemory(Tegra::MemoryManager& memory_manager,
+                                      std::vector<u8>& guest_memory) {
+    MICROPROFILE_SCOPE(GPU_Read_Texture);
     is_continuous = memory_manager.IsBlockContinuous(gpu_addr, guest_memory_size);
+    guest_memory.resize(guest_memory_size);
+    memory_manager.ReadBlockUnsafe(gpu_addr, guest_memory.data(), guest_memory_size);
+}
 
-    // Handle continuouty
-    if (is_continuous) {
-        // Use physical memory directly
-        host_ptr = memory_manager.GetPointer(gpu_addr);
-        if (!host_ptr) {
-            return;
-        }
-    } else {
-        // Use an extra temporal buffer
-        auto& tmp_buffer = staging_cache.GetBuffer(1);
-        tmp_buffer.resize(guest_memory_size);
-        host_ptr = tmp_buffer.data();
-        memory_manager.ReadBlockUnsafe(gpu_addr, host_ptr, guest_memory_size);
-    }
-
+void SurfaceBaseImpl::DecodeBuffer(u8* guest_memory, u8* host_memory) const {
+    MICROPROFILE_SCOPE(GPU_Load_Texture);
     if (params.is_tiled) {
         ASSERT_MSG(params.block_width == 0, "Block width is defined as {} on texture target {}",
                    params.block_width, static_cast<u32>(params.target));
         for (u32 level = 0; level < params.num_levels; ++level) {
             const std::size_t host_offset{params.GetHostMipmapLevelOffset(level)};
-            SwizzleFunc(MortonSwizzleMode::MortonToLinear, host_ptr, params,
-                        staging_buffer.data() + host_offset, level);
+            SwizzleFunc(MortonSwizzleMode::MortonToLinear, guest_memory, params,
+                        host_memory + host_offset, level);
         }
     } else {
         ASSERT_MSG(params.num_levels == 1, "Linear mipmap loading is not implemented");
@@ -219,10 +217,10 @@ void SurfaceBaseImpl::LoadBuffer(Tegra::MemoryManager& memory_manager,
         const u32 height{(params.height + block_height - 1) / block_height};
         const u32 copy_size{width * bpp};
         if (params.pitch == copy_size) {
-            std::memcpy(staging_buffer.data(), host_ptr, params.GetHostSizeInBytes());
+            std::memcpy(host_memory, guest_memory, params.GetHostSizeInBytes());
         } else {
-            const u8* start{host_ptr};
-            u8* write_to{staging_buffer.data()};
+            const u8* start{guest_memory};
+            u8* write_to{host_memory};
             for (u32 h = height; h > 0; --h) {
                 std::memcpy(write_to, start, copy_size);
                 start += params.pitch;
@@ -242,8 +240,8 @@ void SurfaceBaseImpl::LoadBuffer(Tegra::MemoryManager& memory_manager,
         const std::size_t out_host_offset = compression_type == SurfaceCompression::Rearranged
                                                 ? in_host_offset
                                                 : params.GetConvertedMipmapOffset(level);
-        u8* in_buffer = staging_buffer.data() + in_host_offset;
-        u8* out_buffer = staging_buffer.data() + out_host_offset;
+        u8* in_buffer = host_memory + in_host_offset;
+        u8* out_buffer = host_memory + out_host_offset;
         ConvertFromGuestToHost(in_buffer, out_buffer, params.pixel_format,
                                params.GetMipWidth(level), params.GetMipHeight(level),
                                params.GetMipDepth(level), true, true);
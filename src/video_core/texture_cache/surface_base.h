@@ -60,7 +60,12 @@ private:
 
 class SurfaceBaseImpl {
 public:
-    void LoadBuffer(Tegra::MemoryManager& memory_manager, StagingCache& staging_cache);
+    /// Copies the guest memory of the surface, so it can be decoded while the guest keeps running.
+    void ReadGuestMemory(Tegra::MemoryManager& memory_manager, std::vector<u8>& guest_memory);
+
+    /// Decodes a copy of the guest memory into host memory ready to be uploaded. It doesn't modify
+    /// the surface, so it can be called from any thread.
+    void DecodeBuffer(u8* guest_memory, u8* host_memory) const;
 
     void FlushBuffer(Tegra::MemoryManager& memory_manager, StagingCache& staging_cache);
 
@@ -180,7 +185,7 @@ protected:
 
 private:
     void SwizzleFunc(MortonSwizzleMode mode, u8* memory, const SurfaceParams& params, u8* buffer,
-                     u32 level);
+                     u32 level) const;
 
     std::vector<CopyParams> BreakDownLayered(const SurfaceParams& in_params) const;
 
@@ -204,10 +209,6 @@ public:
         index = index_;
     }
 
-    void MarkAsPicked(bool is_picked_) {
-        is_picked = is_picked_;
-    }
-
     bool IsModified() const {
         return is_modified;
     }
@@ -229,10 +230,6 @@ public:
         return is_registered;
     }
 
-    bool IsPicked() const {
-        return is_picked;
-    }
-
     void MarkAsRegistered(bool is_reg) {
         is_registered = is_reg;
     }
@@ -241,6 +238,14 @@ public:
         return modification_tick;
     }
 
+    void MarkAsUsed(u64 frame) {
+        last_use_frame = frame;
+    }
+
+    u64 GetLastUseFrame() const {
+        return last_use_frame;
+    }
+
     TView EmplaceOverview(const SurfaceParams& overview_params) {
         const u32 num_layers{(params.is_layered && !overview_params.is_layered) ? 1 : params.depth};
         return GetView(ViewParams(overview_params.target, 0, num_layers, 0, params.num_levels));
@@ -313,9 +318,9 @@ private:
     bool is_modified{};
     bool is_target{};
     bool is_registered{};
-    bool is_picked{};
     u32 index{NO_RT};
     u64 modification_tick{};
+    u64 last_use_frame{};
 };
 
 } // namespace VideoCommon
@@ -0,0 +1,214 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "common/assert.h"
+#include "common/common_types.h"
+#include "video_core/gpu.h"
+
+namespace VideoCommon {
+
+/**
+ * Indexes surfaces by the pages of guest memory they cover to answer overlap queries.
+ *
+ * Pages are looked up in an open addressing table, so queries never allocate entries for pages
+ * without surfaces. Surfaces are stored once with their address range and pages refer to them by
+ * index, which lets queries test overlaps and discard duplicates without touching the surfaces.
+ * @tparam TSurface Surface handle, it has to provide GetCacheAddr and GetCacheAddrEnd.
+ */
+template <typename TSurface>
+class SurfaceRegistry {
+public:
+    static constexpr u64 PAGE_BITS = 20;
+    static constexpr u64 PAGE_SIZE = u64{1} << PAGE_BITS;
+
+    SurfaceRegistry() {
+        slots.resize(INITIAL_SLOTS);
+    }
+
+    /// Adds a surface to every page it covers.
+    void Register(const TSurface& surface) {
+        const CacheAddr start = surface->GetCacheAddr();
+        const CacheAddr end = surface->GetCacheAddrEnd();
+
+        u32 index;
+        if (free_entries.empty()) {
+            index = static_cast<u32>(entries.size());
+            entries.emplace_back();
+        } else {
+            index = free_entries.back();
+            free_entries.pop_back();
+        }
+        entries[index] = Entry{surface, start, end, 0};
+
+        for (u64 page = start >> PAGE_BITS; page <= (end - 1) >> PAGE_BITS; ++page) {
+            FindOrInsertPage(page).push_back(index);
+        }
+        ++num_surfaces;
+    }
+
+    /// Removes a surface previously added with Register.
+    void Unregister(const TSurface& surface) {
+        const CacheAddr start = surface->GetCacheAddr();
+        const CacheAddr end = surface->GetCacheAddrEnd();
+
+        std::vector<u32>* const first_page = FindPage(start >> PAGE_BITS);
+        ASSERT(first_page != nullptr);
+        const auto it = std::find_if(first_page->begin(), first_page->end(),
+                                     [&](u32 index) { return entries[index].surface == surface; });
+        ASSERT(it != first_page->end());
+        const u32 index = *it;
+        ASSERT(entries[index].end == end);
+
+        for (u64 page = start >> PAGE_BITS; page <= (end - 1) >> PAGE_BITS; ++page) {
+            // Erasing keeps the registration order, which callers rely on for overlap order
+            std::vector<u32>& list = *FindPage(page);
+            list.erase(std::find(list.begin(), list.end(), index));
+        }
+        entries[index] = Entry{};
+        free_entries.push_back(index);
+        --num_surfaces;
+    }
+
+    /// Returns every surface overlapping the given range, without duplicates. Surfaces are sorted
+    /// by the first queried page they are found in, then by registration order.
+    std::vector<TSurface> GetSurfacesInRegion(CacheAddr addr, std::size_t size) {
+        std::vector<TSurface> surfaces;
+        if (size == 0) {
+            return surfaces;
+        }
+        const CacheAddr addr_end = addr + size;
+        const u32 stamp = NextStamp();
+        for (u64 page = addr >> PAGE_BITS; page <= (addr_end - 1) >> PAGE_BITS; ++page) {
+            const std::vector<u32>* const list = FindPage(page);
+            if (list == nullptr) {
+                continue;
+            }
+            for (const u32 index : *list) {
+                Entry& entry = entries[index];
+                if (entry.stamp == stamp || entry.start >= addr_end || entry.end <= addr) {
+                    continue;
+                }
+                entry.stamp = stamp;
+                surfaces.push_back(entry.surface);
+            }
+        }
+        return surfaces;
+    }
+
+    /// Returns the first registered surface starting at the given address, or null.
+    TSurface FindByAddress(CacheAddr addr) const {
+        const std::vector<u32>* const list = FindPage(addr >> PAGE_BITS);
+        if (list == nullptr) {
+            return nullptr;
+        }
+        for (const u32 index : *list) {
+            if (entries[index].start == addr) {
+                return entries[index].surface;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Returns the number of registered surfaces.
+    std::size_t GetNumSurfaces() const {
+        return num_surfaces;
+    }
+
+private:
+    static constexpr std::size_t INITIAL_SLOTS = 64;
+    static constexpr u32 EMPTY_SLOT = std::numeric_limits<u32>::max();
+
+    struct Entry {
+        TSurface surface{};
+        CacheAddr start{};
+        CacheAddr end{};
+        u32 stamp{}; ///< Last query that returned this surface.
+    };
+
+    struct Slot {
+        u64 page{};
+        u32 list = EMPTY_SLOT; ///< Index in page_lists.
+    };
+
+    /// Fibonacci hashing, pages are mostly contiguous and would cluster with an identity hash.
+    std::size_t SlotIndex(u64 page) const {
+        return static_cast<std::size_t>((page * 0x9E3779B97F4A7C15ULL) >> 32) & (slots.size() - 1);
+    }
+
+    const std::vector<u32>* FindPage(u64 page) const {
+        for (std::size_t i = SlotIndex(page);; i = (i + 1) & (slots.size() - 1)) {
+            const Slot& slot = slots[i];
+            if (slot.list == EMPTY_SLOT) {
+                return nullptr;
+            }
+            if (slot.page == page) {
+                return &page_lists[slot.list];
+            }
+        }
+    }
+
+    std::vector<u32>* FindPage(u64 page) {
+        return const_cast<std::vector<u32>*>(std::as_const(*this).FindPage(page));
+    }
+
+    /// Pages are never removed from the table, their lists are reused once they get surfaces
+    /// again. The number of pages is bounded by the guest memory that has been drawn to.
+    std::vector<u32>& FindOrInsertPage(u64 page) {
+        if (std::vector<u32>* const list = FindPage(page)) {
+            return *list;
+        }
+        if ((page_lists.size() + 1) * 2 > slots.size()) {
+            Grow();
+        }
+        std::size_t i = SlotIndex(page);
+        while (slots[i].list != EMPTY_SLOT) {
+            i = (i + 1) & (slots.size() - 1);
+        }
+        slots[i] = Slot{page, static_cast<u32>(page_lists.size())};
+        return page_lists.emplace_back();
+    }
+
+    void Grow() {
+        std::vector<Slot> old_slots(slots.size() * 2);
+        std::swap(slots, old_slots);
+        for (const Slot& slot : old_slots) {
+            if (slot.list == EMPTY_SLOT) {
+                continue;
+            }
+            std::size_t i = SlotIndex(slot.page);
+            while (slots[i].list != EMPTY_SLOT) {
+                i = (i + 1) & (slots.size() - 1);
+            }
+            slots[i] = slot;
+        }
+    }
+
+    u32 NextStamp() {
+        if (++current_stamp == 0) {
+            // Stamps wrapped around, forget old queries so they can't be confused with new ones
+            for (Entry& entry : entries) {
+                entry.stamp = 0;
+            }
+            current_stamp = 1;
+        }
+        return current_stamp;
+    }
+
+    std::vector<Slot> slots;
+    std::vector<std::vector<u32>> page_lists;
+    std::vector<Entry> entries;
+    std::vector<u32> free_entries;
+    std::size_t num_surfaces{};
+    u32 current_stamp{};
+};
+
+} // namespace VideoCommon
@@ -6,11 +6,13 @@
 
 #include <algorithm>
 #include <array>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/icl/interval_map.hpp>
@@ -19,6 +21,7 @@
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/math_util.h"
+#include "common/thread_pool.h"
 #include "core/core.h"
 #include "core/memory.h"
 #include "core/settings.h"
@@ -32,7 +35,9 @@
 #include "video_core/texture_cache/format_lookup_table.h"
 #include "video_core/texture_cache/surface_base.h"
 #include "video_core/texture_cache/surface_params.h"
+#include "video_core/texture_cache/surface_registry.h"
 #include "video_core/texture_cache/surface_view.h"
+#include "video_core/textures/decoders.h"
 
 namespace Tegra::Texture {
 struct FullTextureInfo;
@@ -49,6 +54,14 @@ using VideoCore::Surface::PixelFormat;
 using VideoCore::Surface::SurfaceTarget;
 using RenderTargetConfig = Tegra::Engines::Maxwell3D::Regs::RenderTargetConfig;
 
+/// Texture cache residency. Per frame counters refer to the last completed frame.
+struct TextureCacheStats {
+    u64 resident_bytes{}; ///< Host memory used by cached surfaces.
+    u64 budget_bytes{};   ///< Configured memory budget, 0 when unlimited.
+    u64 evictions{};      ///< Surfaces evicted to stay within the budget.
+    u64 uploads{};        ///< Surfaces loaded from guest memory, including evicted ones.
+};
+
 template <typename TSurface, typename TView>
 class TextureCache {
     using IntervalMap = boost::icl::interval_map<CacheAddr, std::set<TSurface>>;
@@ -263,6 +276,7 @@ public:
             GetSurface(dst_gpu_addr, dst_cache_addr, dst_params, true, false);
         std::pair<TSurface, TView> src_surface =
             GetSurface(src_gpu_addr, src_cache_addr, src_params, true, false);
+        CommitUploads();
         ImageBlit(src_surface.second, dst_surface.second, copy_config);
         dst_surface.first->MarkAsModified(true, Tick());
     }
@@ -272,20 +286,42 @@ public:
         if (!cache_addr) {
             return nullptr;
         }
-        const CacheAddr page = cache_addr >> registry_page_bits;
-        std::vector<TSurface>& list = registry[page];
-        for (auto& surface : list) {
-            if (surface->GetCacheAddr() == cache_addr) {
-                return surface;
-            }
+        CommitUploads();
+        return registry.FindByAddress(cache_addr);
+    }
+
+    /**
+     * Waits for pending surface loads and uploads them. It has to be called before the host GPU
+     * accesses any surface returned by the cache.
+     */
+    void CommitUploads() {
+        std::lock_guard lock{mutex};
+        for (auto& upload : pending_uploads) {
+            upload.surface->UploadTexture(upload.host_memory.get());
         }
-        return nullptr;
+        pending_uploads.clear();
     }
 
     u64 Tick() {
         return ++ticks;
     }
 
+    /// Ends the current frame, evicting the least recently used surfaces over the memory budget.
+    void TickFrame() {
+        std::lock_guard lock{mutex};
+        EvictSurfaces();
+        stats.resident_bytes = resident_bytes;
+        stats.budget_bytes = GetBudget();
+        stats.evictions = std::exchange(frame_evictions, 0);
+        stats.uploads = std::exchange(frame_uploads, 0);
+        ++frame;
+    }
+
+    TextureCacheStats GetStats() {
+        std::lock_guard lock{mutex};
+        return stats;
+    }
+
 protected:
     TextureCache(Core::System& system, VideoCore::RasterizerInterface& rasterizer)
         : system{system}, rasterizer{rasterizer} {
@@ -308,7 +344,12 @@ protected:
         sampled_textures.reserve(64);
     }
 
-    ~TextureCache() = default;
+    ~TextureCache() {
+        // Jobs reference surfaces owned by the cache
+        for (auto& upload : pending_uploads) {
+            upload.host_memory.wait();
+        }
+    }
 
     virtual TSurface CreateSurface(GPUVAddr gpu_addr, const SurfaceParams& params) = 0;
 
@@ -365,7 +406,6 @@ protected:
         rasterizer.UpdatePagesCachedCount(cpu_addr, size, -1);
         UnregisterInnerCache(surface);
         surface->MarkAsRegistered(false);
-        ReserveSurface(surface->GetSurfaceParams(), surface);
     }
 
     TSurface GetUncachedSurface(const GPUVAddr gpu_addr, const SurfaceParams& params) {
@@ -375,6 +415,8 @@ protected:
         }
         // No reserved surface available, create a new one and reserve it
         auto new_surface{CreateSurface(gpu_addr, params)};
+        resident_bytes += new_surface->GetHostSizeInBytes();
+        ReserveSurface(new_surface->GetSurfaceParams(), new_surface);
         return new_surface;
     }
 
@@ -483,6 +525,7 @@ private:
         }
         case RecycleStrategy::BufferCopy: {
             auto new_surface = GetUncachedSurface(gpu_addr, params);
+            CommitUploads();
             BufferCopy(overlaps[0], new_surface);
             return {new_surface, new_surface->GetMainView()};
         }
@@ -516,6 +559,7 @@ private:
             new_surface = GetUncachedSurface(gpu_addr, params);
         }
         const auto& final_params = new_surface->GetSurfaceParams();
+        CommitUploads();
         if (cr_params.type != final_params.type) {
             BufferCopy(current_surface, new_surface);
         } else {
@@ -578,6 +622,7 @@ private:
         bool modified = false;
         TSurface new_surface = GetUncachedSurface(gpu_addr, params);
         u32 passed_tests = 0;
+        CommitUploads();
         for (auto& surface : overlaps) {
             const SurfaceParams& src_params = surface->GetSurfaceParams();
             if (src_params.is_layered || src_params.num_levels > 1) {
@@ -640,6 +685,7 @@ private:
             }
             TSurface new_surface = GetUncachedSurface(gpu_addr, params);
             bool modified = false;
+            CommitUploads();
             for (auto& surface : overlaps) {
                 const SurfaceParams& src_params = surface->GetSurfaceParams();
                 if (src_params.target != SurfaceTarget::Texture2D) {
@@ -721,6 +767,16 @@ private:
     std::pair<TSurface, TView> GetSurface(const GPUVAddr gpu_addr, const CacheAddr cache_addr,
                                           const SurfaceParams& params, bool preserve_contents,
                                           bool is_render) {
+        auto result = FindOrCreateSurface(gpu_addr, cache_addr, params, preserve_contents,
+                                          is_render);
+        result.first->MarkAsUsed(frame);
+        return result;
+    }
+
+    std::pair<TSurface, TView> FindOrCreateSurface(const GPUVAddr gpu_addr,
+                                                   const CacheAddr cache_addr,
+                                                   const SurfaceParams& params,
+                                                   bool preserve_contents, bool is_render) {
 
         // Step 1
         // Check Level 1 Cache for a fast structural match. If candidate surface
@@ -997,17 +1053,39 @@ private:
         return {new_surface, new_surface->GetMainView()};
     }
 
+    /**
+     * Loads a surface from guest memory. Guest memory is copied right away, but it's decoded by
+     * the texture worker threads and uploaded by the next CommitUploads. Uploads are committed in
+     * the order surfaces were loaded.
+     */
     void LoadSurface(const TSurface& surface) {
-        staging_cache.GetBuffer(0).resize(surface->GetHostSizeInBytes());
-        surface->LoadBuffer(system.GPU().MemoryManager(), staging_cache);
-        surface->UploadTexture(staging_cache.GetBuffer(0));
+        std::vector<u8> guest_memory;
+        surface->ReadGuestMemory(system.GPU().MemoryManager(), guest_memory);
+
+        // The job doesn't own the surface, so it's never destroyed from a worker thread. The
+        // pending upload keeps it alive until the job is done.
+        auto job = std::make_shared<std::packaged_task<std::vector<u8>()>>(
+            [surface = surface.get(), guest_memory = std::move(guest_memory)]() mutable {
+                std::vector<u8> host_memory(surface->GetHostSizeInBytes());
+                surface->DecodeBuffer(guest_memory.data(), host_memory.data());
+                return host_memory;
+            });
+        pending_uploads.push_back({surface, job->get_future()});
+        if (surface->GetHostSizeInBytes() < ASYNC_DECODE_THRESHOLD) {
+            // Small surfaces are decoded faster than a worker thread can be woken up
+            (*job)();
+        } else {
+            Tegra::Texture::GetTextureWorkerPool().QueueWork([job] { (*job)(); });
+        }
         surface->MarkAsModified(false, Tick());
+        ++frame_uploads;
     }
 
     void FlushSurface(const TSurface& surface) {
         if (!surface->IsModified()) {
             return;
         }
+        CommitUploads();
         staging_cache.GetBuffer(0).resize(surface->GetHostSizeInBytes());
         surface->DownloadTexture(staging_cache.GetBuffer(0));
         surface->FlushBuffer(system.GPU().MemoryManager(), staging_cache);
@@ -1015,54 +1093,76 @@ private:
     }
 
     void RegisterInnerCache(TSurface& surface) {
-        const CacheAddr cache_addr = surface->GetCacheAddr();
-        CacheAddr start = cache_addr >> registry_page_bits;
-        const CacheAddr end = (surface->GetCacheAddrEnd() - 1) >> registry_page_bits;
-        l1_cache[cache_addr] = surface;
-        while (start <= end) {
-            registry[start].push_back(surface);
-            start++;
-        }
+        l1_cache[surface->GetCacheAddr()] = surface;
+        registry.Register(surface);
     }
 
     void UnregisterInnerCache(TSurface& surface) {
-        const CacheAddr cache_addr = surface->GetCacheAddr();
-        CacheAddr start = cache_addr >> registry_page_bits;
-        const CacheAddr end = (surface->GetCacheAddrEnd() - 1) >> registry_page_bits;
-        l1_cache.erase(cache_addr);
-        while (start <= end) {
-            auto& reg{registry[start]};
-            reg.erase(std::find(reg.begin(), reg.end(), surface));
-            start++;
-        }
+        l1_cache.erase(surface->GetCacheAddr());
+        registry.Unregister(surface);
     }
 
     std::vector<TSurface> GetSurfacesInRegion(const CacheAddr cache_addr, const std::size_t size) {
-        if (size == 0) {
-            return {};
+        return registry.GetSurfacesInRegion(cache_addr, size);
+    }
+
+    void ReserveSurface(const SurfaceParams& params, TSurface surface) {
+        surface_reserve[params].push_back(std::move(surface));
+    }
+
+    void EraseReservedSurface(const TSurface& surface) {
+        const auto search{surface_reserve.find(surface->GetSurfaceParams())};
+        ASSERT(search != surface_reserve.end());
+        auto& surfaces{search->second};
+        surfaces.erase(std::find(surfaces.begin(), surfaces.end(), surface));
+        if (surfaces.empty()) {
+            surface_reserve.erase(search);
+        }
+    }
+
+    u64 GetBudget() const {
+        return u64{Settings::values.texture_cache_budget} << 20;
+    }
+
+    /**
+     * Evicts surfaces until the cache fits in the memory budget. Only clean surfaces that haven't
+     * been used in the current frame can be evicted, as their contents can be loaded again from
+     * guest memory. Unregistered surfaces go first, then the least recently used ones.
+     */
+    void EvictSurfaces() {
+        const u64 budget = GetBudget();
+        if (budget == 0 || resident_bytes <= budget) {
+            return;
         }
-        const CacheAddr cache_addr_end = cache_addr + size;
-        CacheAddr start = cache_addr >> registry_page_bits;
-        const CacheAddr end = (cache_addr_end - 1) >> registry_page_bits;
-        std::vector<TSurface> surfaces;
-        while (start <= end) {
-            std::vector<TSurface>& list = registry[start];
-            for (auto& surface : list) {
-                if (!surface->IsPicked() && surface->Overlaps(cache_addr, cache_addr_end)) {
-                    surface->MarkAsPicked(true);
-                    surfaces.push_back(surface);
+        std::vector<TSurface> candidates;
+        for (const auto& [params, surfaces] : surface_reserve) {
+            for (const auto& surface : surfaces) {
+                if (surface->GetLastUseFrame() < frame && !surface->IsModified() &&
+                    !surface->IsRenderTarget()) {
+                    candidates.push_back(surface);
                 }
             }
-            start++;
         }
-        for (auto& surface : surfaces) {
-            surface->MarkAsPicked(false);
+        std::sort(candidates.begin(), candidates.end(), [](const TSurface& a, const TSurface& b) {
+            return std::make_pair(a->IsRegistered(), a->GetLastUseFrame()) <
+                   std::make_pair(b->IsRegistered(), b->GetLastUseFrame());
+        });
+        for (const auto& surface : candidates) {
+            if (resident_bytes <= budget) {
+                break;
+            }
+            if (surface->IsRegistered()) {
+                Unregister(surface);
+                if (surface->IsRegistered()) {
+                    continue;
+                }
+            }
+            EraseReservedSurface(surface);
+            resident_bytes -= surface->GetHostSizeInBytes();
+            ++frame_evictions;
         }
-        return surfaces;
-    }
-
-    void ReserveSurface(const SurfaceParams& params, TSurface surface) {
-        surface_reserve[params].push_back(std::move(surface));
+        LOG_DEBUG(HW_GPU, "Texture cache resident size after eviction: {} MiB",
+                  resident_bytes >> 20);
     }
 
     TSurface TryGetReservedSurface(const SurfaceParams& params) {
@@ -1105,11 +1205,10 @@ private:
     // The internal Cache is different for the Texture Cache. It's based on buckets
     // of 1MB. This fits better for the purpose of this cache as textures are normaly
     // large in size.
-    static constexpr u64 registry_page_bits{20};
-    static constexpr u64 registry_page_size{1 << registry_page_bits};
-    std::unordered_map<CacheAddr, std::vector<TSurface>> registry;
+    SurfaceRegistry<TSurface> registry;
 
     static constexpr u32 DEPTH_RT = 8;
+    static constexpr std::size_t ASYNC_DECODE_THRESHOLD = 64 * 1024;
     static constexpr u32 NO_RT = 0xFFFFFFFF;
 
     // The L1 Cache is used for fast texture lookup before checking the overlaps
@@ -1118,8 +1217,21 @@ private:
 
     /// The surface reserve is a "backup" cache, this is where we put unique surfaces that have
     /// previously been used. This is to prevent surfaces from being constantly created and
-    /// destroyed when used with different surface parameters.
+    /// destroyed when used with different surface parameters. It owns every surface created by
+    /// the cache, registered or not, until they are evicted.
     std::unordered_map<SurfaceParams, std::vector<TSurface>> surface_reserve;
+
+    struct PendingUpload {
+        TSurface surface;
+        std::future<std::vector<u8>> host_memory;
+    };
+    std::vector<PendingUpload> pending_uploads;
+
+    u64 frame{};          ///< Frames completed, used to track when surfaces were last used.
+    u64 resident_bytes{}; ///< Host memory used by the surfaces in the reserve.
+    u64 frame_evictions{};
+    u64 frame_uploads{};
+    TextureCacheStats stats;
     std::array<FramebufferTargetInfo, Tegra::Engines::Maxwell3D::Regs::NumRenderTargets>
         render_targets;
     FramebufferTargetInfo depth_buffer;
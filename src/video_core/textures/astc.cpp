@@ -16,12 +16,17 @@
 // <http://gamma.cs.unc.edu/FasTC/>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <cstring>
 #include <vector>
 
+#include <boost/container/static_vector.hpp>
+
+#include "common/thread_pool.h"
 #include "video_core/textures/astc.h"
+#include "video_core/textures/decoders.h"
 
 class InputBitStream {
 public:
@@ -46,11 +51,23 @@ public:
         return bit & 1;
     }
 
+    // Reads as many bits as possible from each byte instead of going bit by bit.
     unsigned int ReadBits(unsigned int nBits) {
         unsigned int ret = 0;
-        for (unsigned int i = 0; i < nBits; i++) {
-            ret |= (ReadBit() & 1) << i;
+        unsigned int numRead = 0;
+        while (numRead < nBits) {
+            const unsigned int available = 8 - static_cast<unsigned int>(m_NextBit);
+            const unsigned int count = std::min(available, nBits - numRead);
+            const unsigned int bits = (*m_CurByte >> m_NextBit) & ((1U << count) - 1);
+            ret |= bits << numRead;
+            numRead += count;
+            m_NextBit += static_cast<int>(count);
+            if (m_NextBit == 8) {
+                m_NextBit = 0;
+                m_CurByte++;
+            }
         }
+        m_BitsRead += static_cast<int>(nBits);
         return ret;
     }
 
@@ -146,6 +163,65 @@ private:
 
 enum EIntegerEncoding { eIntegerEncoding_JustBits, eIntegerEncoding_Quint, eIntegerEncoding_Trit };
 
+// Count the number of bits set in a number.
+static constexpr uint32_t Popcnt(uint32_t n) {
+    uint32_t c = 0;
+    for (; n; c++) {
+        n &= n - 1;
+    }
+    return c;
+}
+
+struct IntegerEncoding {
+    EIntegerEncoding encoding;
+    uint32_t numBits;
+};
+
+// Returns the encoding with the largest range that can take no more than maxVal values.
+static constexpr IntegerEncoding FindEncoding(uint32_t maxVal) {
+    while (maxVal > 0) {
+        uint32_t check = maxVal + 1;
+
+        // Is maxVal a power of two?
+        if (!(check & (check - 1))) {
+            return {eIntegerEncoding_JustBits, Popcnt(maxVal)};
+        }
+
+        // Is maxVal of the type 3*2^n - 1?
+        if ((check % 3 == 0) && !((check / 3) & ((check / 3) - 1))) {
+            return {eIntegerEncoding_Trit, Popcnt(check / 3 - 1)};
+        }
+
+        // Is maxVal of the type 5*2^n - 1?
+        if ((check % 5 == 0) && !((check / 5) & ((check / 5) - 1))) {
+            return {eIntegerEncoding_Quint, Popcnt(check / 5 - 1)};
+        }
+
+        // Apparently it can't be represented with a bounded integer sequence...
+        // just iterate.
+        maxVal--;
+    }
+    return {eIntegerEncoding_JustBits, 0};
+}
+
+// Color values are at most 255, searching for the encoding of every value is slow enough to
+// dominate the decoding of a block, so the encodings are computed at compile time.
+static constexpr std::array<IntegerEncoding, 256> MakeEncodingsTable() {
+    std::array<IntegerEncoding, 256> table{};
+    for (uint32_t maxVal = 0; maxVal < table.size(); maxVal++) {
+        table[maxVal] = FindEncoding(maxVal);
+    }
+    return table;
+}
+
+static constexpr auto ENCODINGS_TABLE = MakeEncodingsTable();
+
+class IntegerEncodedValue;
+
+// Blocks have at most 144 texels with two weight planes, and trit blocks may decode four values
+// past the requested count. Keeping the values inline avoids allocating for every block.
+using IntegerEncodedVector = boost::container::static_vector<IntegerEncodedValue, 2 * 144 + 4>;
+
 class IntegerEncodedValue {
 private:
     const EIntegerEncoding m_Encoding;
@@ -210,47 +286,14 @@ public:
         return totalBits;
     }
 
-    // Count the number of bits set in a number.
-    static inline uint32_t Popcnt(uint32_t n) {
-        uint32_t c;
-        for (c = 0; n; c++) {
-            n &= n - 1;
-        }
-        return c;
-    }
-
     // Returns a new instance of this struct that corresponds to the
     // can take no more than maxval values
-    static IntegerEncodedValue CreateEncoding(uint32_t maxVal) {
-        while (maxVal > 0) {
-            uint32_t check = maxVal + 1;
-
-            // Is maxVal a power of two?
-            if (!(check & (check - 1))) {
-                return IntegerEncodedValue(eIntegerEncoding_JustBits, Popcnt(maxVal));
-            }
-
-            // Is maxVal of the type 3*2^n - 1?
-            if ((check % 3 == 0) && !((check / 3) & ((check / 3) - 1))) {
-                return IntegerEncodedValue(eIntegerEncoding_Trit, Popcnt(check / 3 - 1));
-            }
-
-            // Is maxVal of the type 5*2^n - 1?
-            if ((check % 5 == 0) && !((check / 5) & ((check / 5) - 1))) {
-                return IntegerEncodedValue(eIntegerEncoding_Quint, Popcnt(check / 5 - 1));
-            }
-
-            // Apparently it can't be represented with a bounded integer sequence...
-            // just iterate.
-            maxVal--;
-        }
-        return IntegerEncodedValue(eIntegerEncoding_JustBits, 0);
-    }
+    static IntegerEncodedValue CreateEncoding(uint32_t maxVal);
 
     // Fills result with the values that are encoded in the given
     // bitstream. We must know beforehand what the maximum possible
     // value is, and how many values we're decoding.
-    static void DecodeIntegerSequence(std::vector<IntegerEncodedValue>& result,
+    static void DecodeIntegerSequence(IntegerEncodedVector& result,
                                       InputBitStream& bits, uint32_t maxRange, uint32_t nValues) {
         // Determine encoding parameters
         IntegerEncodedValue val = IntegerEncodedValue::CreateEncoding(maxRange);
@@ -279,7 +322,7 @@ public:
     }
 
 private:
-    static void DecodeTritBlock(InputBitStream& bits, std::vector<IntegerEncodedValue>& result,
+    static void DecodeTritBlock(InputBitStream& bits, IntegerEncodedVector& result,
                                 uint32_t nBitsPerValue) {
         // Implement the algorithm in section C.2.12
         uint32_t m[5];
@@ -339,7 +382,7 @@ private:
         }
     }
 
-    static void DecodeQuintBlock(InputBitStream& bits, std::vector<IntegerEncodedValue>& result,
+    static void DecodeQuintBlock(InputBitStream& bits, IntegerEncodedVector& result,
                                  uint32_t nBitsPerValue) {
         // Implement the algorithm in section C.2.12
         uint32_t m[3];
@@ -388,6 +431,12 @@ private:
     }
 };
 
+IntegerEncodedValue IntegerEncodedValue::CreateEncoding(uint32_t maxVal) {
+    assert(maxVal < ENCODINGS_TABLE.size());
+    const IntegerEncoding& encoding = ENCODINGS_TABLE[maxVal];
+    return IntegerEncodedValue(encoding.encoding, encoding.numBits);
+}
+
 namespace ASTCC {
 
 struct TexelWeightParams {
@@ -834,7 +883,7 @@ static void DecodeColorValues(uint32_t* out, uint8_t* data, const uint32_t* mode
     }
 
     // We now have enough to decode our integer sequence.
-    std::vector<IntegerEncodedValue> decodedColorValues;
+    IntegerEncodedVector decodedColorValues;
     InputBitStream colorStream(data);
     IntegerEncodedValue::DecodeIntegerSequence(decodedColorValues, colorStream, range, nValues);
 
@@ -1064,7 +1113,7 @@ static uint32_t UnquantizeTexelWeight(const IntegerEncodedValue& val) {
 }
 
 static void UnquantizeTexelWeights(uint32_t out[2][144],
-                                   const std::vector<IntegerEncodedValue>& weights,
+                                   const IntegerEncodedVector& weights,
                                    const TexelWeightParams& params, const uint32_t blockWidth,
                                    const uint32_t blockHeight) {
     uint32_t weightIdx = 0;
@@ -1564,7 +1613,7 @@ static void DecompressBlock(const uint8_t inBuf[16], const uint32_t blockWidth,
         static_cast<uint8_t>((1 << (weightParams.GetPackedBitSize() % 8)) - 1);
     memset(texelWeightData + clearByteStart, 0, 16 - clearByteStart);
 
-    std::vector<IntegerEncodedValue> texelWeightValues;
+    IntegerEncodedVector texelWeightValues;
     InputBitStream weightStream(texelWeightData);
 
     IntegerEncodedValue::DecodeIntegerSequence(texelWeightValues, weightStream,
@@ -1576,36 +1625,43 @@ static void DecompressBlock(const uint8_t inBuf[16], const uint32_t blockWidth,
     UnquantizeTexelWeights(weights, texelWeightValues, weightParams, blockWidth, blockHeight);
 
     // Now that we have endpoints and weights, we can interpolate and generate
-    // the proper decoding...
+    // the proper decoding... Endpoints are expanded to 16 bits once per partition and the
+    // interpolation is kept in integer arithmetic, so the compiler can vectorize the channels.
+    uint32_t expandedEndpoints[4][2][4];
+    for (uint32_t i = 0; i < nPartitions; i++) {
+        for (uint32_t e = 0; e < 2; e++) {
+            for (uint32_t c = 0; c < 4; c++) {
+                const auto component = static_cast<uint32_t>(endpoints[i][e].Component(c));
+                expandedEndpoints[i][e][c] = Replicate(component, 8, 16);
+            }
+        }
+    }
+
+    // Channels are stored as ARGB, packed pixels are laid out as ABGR.
+    static constexpr uint32_t channelShift[4] = {24, 0, 8, 16};
+    const uint32_t dualPlaneChannel =
+        weightParams.m_bDualPlane ? static_cast<uint32_t>((planeIdx + 1) & 3) : 4;
+
     for (uint32_t j = 0; j < blockHeight; j++)
         for (uint32_t i = 0; i < blockWidth; i++) {
-            uint32_t partition = Select2DPartition(partitionIndex, i, j, nPartitions,
-                                                   (blockHeight * blockWidth) < 32);
+            const uint32_t texel = j * blockWidth + i;
+            uint32_t partition = 0;
+            if (nPartitions > 1) {
+                partition = Select2DPartition(partitionIndex, i, j, nPartitions,
+                                              (blockHeight * blockWidth) < 32);
+            }
             assert(partition < nPartitions);
 
-            Pixel p;
+            const uint32_t(&low)[4] = expandedEndpoints[partition][0];
+            const uint32_t(&high)[4] = expandedEndpoints[partition][1];
+            uint32_t packed = 0;
             for (uint32_t c = 0; c < 4; c++) {
-                uint32_t C0 = endpoints[partition][0].Component(c);
-                C0 = Replicate(C0, 8, 16);
-                uint32_t C1 = endpoints[partition][1].Component(c);
-                C1 = Replicate(C1, 8, 16);
-
-                uint32_t plane = 0;
-                if (weightParams.m_bDualPlane && (((planeIdx + 1) & 3) == c)) {
-                    plane = 1;
-                }
-
-                uint32_t weight = weights[plane][j * blockWidth + i];
-                uint32_t C = (C0 * (64 - weight) + C1 * weight + 32) / 64;
-                if (C == 65535) {
-                    p.Component(c) = 255;
-                } else {
-                    double Cf = static_cast<double>(C);
-                    p.Component(c) = static_cast<uint16_t>(255.0 * (Cf / 65536.0) + 0.5);
-                }
+                const uint32_t weight = weights[c == dualPlaneChannel ? 1 : 0][texel];
+                const uint32_t C = (low[c] * (64 - weight) + high[c] * weight + 32) / 64;
+                // Same as rounding 255 * C / 65536 to the nearest integer.
+                packed |= ((C * 255 + 32768) >> 16) << channelShift[c];
             }
-
-            outBuf[j * blockWidth + i] = p.Pack();
+            outBuf[texel] = packed;
         }
 }
 
@@ -1613,35 +1669,106 @@ static void DecompressBlock(const uint8_t inBuf[16], const uint32_t blockWidth,
 
 namespace Tegra::Texture::ASTC {
 
-std::vector<uint8_t> Decompress(const uint8_t* data, uint32_t width, uint32_t height,
-                                uint32_t depth, uint32_t block_width, uint32_t block_height) {
-    uint32_t blockIdx = 0;
-    std::size_t depth_offset = 0;
-    std::vector<uint8_t> outData(height * width * depth * 4);
-    for (uint32_t k = 0; k < depth; k++) {
-        for (uint32_t j = 0; j < height; j += block_height) {
-            for (uint32_t i = 0; i < width; i += block_width) {
+namespace {
 
-                const uint8_t* blockPtr = data + blockIdx * 16;
+constexpr uint32_t BLOCK_CACHE_BITS = 6;
+constexpr std::size_t BLOCK_CACHE_SIZE = std::size_t{1} << BLOCK_CACHE_BITS;
 
-                // Blocks can be at most 12x12
-                uint32_t uncompData[144];
-                ASTCC::DecompressBlock(blockPtr, block_width, block_height, uncompData);
+/// Images with at least this many blocks are decoded by multiple threads.
+constexpr std::size_t PARALLEL_DECODE_THRESHOLD = 4096;
 
-                uint32_t decompWidth = std::min(block_width, width - i);
-                uint32_t decompHeight = std::min(block_height, height - j);
+/**
+ * Direct mapped cache of decoded blocks. UI atlases and flat areas tend to repeat the exact same
+ * block many times, those are only decoded once.
+ */
+class DecodedBlockCache {
+public:
+    DecodedBlockCache(uint32_t block_width, uint32_t block_height)
+        : block_width{block_width}, block_height{block_height}, entries(BLOCK_CACHE_SIZE) {}
+
+    /// Returns the texels of the given block, decoding it if it's not in the cache.
+    const uint32_t* Decode(const uint8_t* block) {
+        uint64_t low;
+        uint64_t high;
+        std::memcpy(&low, block, sizeof(low));
+        std::memcpy(&high, block + sizeof(low), sizeof(high));
+
+        constexpr uint64_t golden_ratio = 0x9E3779B97F4A7C15ULL;
+        const uint64_t hash = (low ^ (high * golden_ratio)) * golden_ratio;
+        Entry& entry = entries[hash >> (64 - BLOCK_CACHE_BITS)];
+        if (!entry.valid || entry.low != low || entry.high != high) {
+            ASTCC::DecompressBlock(block, block_width, block_height, entry.texels.data());
+            entry.low = low;
+            entry.high = high;
+            entry.valid = true;
+        }
+        return entry.texels.data();
+    }
 
-                uint8_t* outRow = depth_offset + outData.data() + (j * width + i) * 4;
-                for (uint32_t jj = 0; jj < decompHeight; jj++) {
-                    memcpy(outRow + jj * width * 4, uncompData + jj * block_width, decompWidth * 4);
-                }
+private:
+    struct Entry {
+        uint64_t low = 0;
+        uint64_t high = 0;
+        bool valid = false;
+        // Blocks can be at most 12x12
+        std::array<uint32_t, 144> texels;
+    };
+
+    uint32_t block_width;
+    uint32_t block_height;
+    std::vector<Entry> entries;
+};
 
-                blockIdx++;
+/// Decodes a range of block rows, rows of all the layers are numbered consecutively.
+void DecompressRows(const uint8_t* data, uint8_t* out_data, uint32_t width, uint32_t height,
+                    uint32_t block_width, uint32_t block_height, std::size_t first_row,
+                    std::size_t end_row) {
+    const uint32_t rows_per_layer = (height + block_height - 1) / block_height;
+    const uint32_t blocks_per_row = (width + block_width - 1) / block_width;
+    const std::size_t layer_size = std::size_t{height} * width * 4;
+
+    DecodedBlockCache cache(block_width, block_height);
+    for (std::size_t row = first_row; row < end_row; row++) {
+        const std::size_t layer = row / rows_per_layer;
+        const uint32_t j = static_cast<uint32_t>(row % rows_per_layer) * block_height;
+        const uint32_t decompHeight = std::min(block_height, height - j);
+        const uint8_t* blockPtr = data + row * blocks_per_row * 16;
+        uint8_t* const rowStart = out_data + layer * layer_size + std::size_t{j} * width * 4;
+
+        for (uint32_t i = 0; i < width; i += block_width) {
+            const uint32_t* uncompData = cache.Decode(blockPtr);
+            const uint32_t decompWidth = std::min(block_width, width - i);
+
+            uint8_t* outRow = rowStart + std::size_t{i} * 4;
+            for (uint32_t jj = 0; jj < decompHeight; jj++) {
+                memcpy(outRow + jj * width * 4, uncompData + jj * block_width, decompWidth * 4);
             }
+            blockPtr += 16;
         }
-        depth_offset += height * width * 4;
     }
+}
 
+} // Anonymous namespace
+
+std::vector<uint8_t> Decompress(const uint8_t* data, uint32_t width, uint32_t height,
+                                uint32_t depth, uint32_t block_width, uint32_t block_height) {
+    std::vector<uint8_t> outData(height * width * depth * 4);
+    const std::size_t num_rows = std::size_t{(height + block_height - 1) / block_height} * depth;
+    const std::size_t num_blocks = num_rows * ((width + block_width - 1) / block_width);
+
+    if (num_blocks < PARALLEL_DECODE_THRESHOLD || num_rows < 2) {
+        DecompressRows(data, outData.data(), width, height, block_width, block_height, 0,
+                       num_rows);
+        return outData;
+    }
+
+    // Split the rows in more chunks than threads, blocks don't take the same time to decode.
+    auto& pool = GetTextureWorkerPool();
+    const std::size_t num_chunks = std::min(num_rows, (pool.NumWorkers() + 1) * 4);
+    pool.ParallelFor(num_chunks, [&](std::size_t chunk) {
+        DecompressRows(data, outData.data(), width, height, block_width, block_height,
+                       num_rows * chunk / num_chunks, num_rows * (chunk + 1) / num_chunks);
+    });
     return outData;
 }
 
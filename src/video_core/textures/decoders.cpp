@@ -2,12 +2,16 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <thread>
 #include "common/alignment.h"
 #include "common/assert.h"
+#include "common/thread_pool.h"
 #include "video_core/gpu.h"
 #include "video_core/textures/decoders.h"
+#include "video_core/textures/gob_copy.h"
 #include "video_core/textures/texture.h"
 
 namespace Tegra::Texture {
@@ -88,6 +92,8 @@ void PreciseProcessBlock(u8* const swizzled_data, u8* const unswizzled_data, con
  * This function manages ALL the GOBs(Group of Bytes) Inside a single block.
  * Instead of going gob by gob, we map the coordinates inside a block and manage from
  * those. Block_Width is assumed to be 1.
+ * When the block covers whole GOBs and the pixel size doesn't change, the GOBs are copied with
+ * the vectorized kernels and only the remaining lines go through the swizzle table.
  */
 void FastProcessBlock(u8* const swizzled_data, u8* const unswizzled_data, const bool unswizzle,
                       const u32 x_start, const u32 y_start, const u32 z_start, const u32 x_end,
@@ -99,10 +105,23 @@ void FastProcessBlock(u8* const swizzled_data, u8* const unswizzled_data, const
     const u32 x_startb = x_start * bytes_per_pixel;
     const u32 x_endb = x_end * bytes_per_pixel;
 
+    const bool whole_gobs =
+        x_endb - x_startb == gob_size_x && bytes_per_pixel == out_bytes_per_pixel;
+    const u32 num_gobs = whole_gobs ? (y_end - y_start) / gob_size_y : 0;
+    const u32 gob_lines_end = y_start + num_gobs * gob_size_y;
+    const auto& kernels = GetGOBCopyKernels();
+    const GOBCopyFn copy_gobs = unswizzle ? kernels.unswizzle : kernels.swizzle;
+
     for (u32 z = z_start; z < z_end; z++) {
         u32 y_address = z_address;
         u32 pixel_base = layer_z * z + y_start * stride_x;
-        for (u32 y = y_start; y < y_end; y++) {
+        if (num_gobs > 0) {
+            copy_gobs(swizzled_data + y_address, unswizzled_data + pixel_base + x_startb, stride_x,
+                      num_gobs);
+            y_address += num_gobs * gob_size;
+            pixel_base += num_gobs * gob_size_y * stride_x;
+        }
+        for (u32 y = gob_lines_end; y < y_end; y++) {
             const auto& table = fast_swizzle_table[y % gob_size_y];
             for (u32 xb = x_startb; xb < x_endb; xb += fast_swizzle_align) {
                 const u32 swizzle_offset{y_address + table[(xb / fast_swizzle_align) % 4]};
@@ -149,10 +168,10 @@ void SwizzledData(u8* const swizzled_data, u8* const unswizzled_data, const bool
     const u32 blocks_on_z = div_ceil(depth, block_z_elements);
     const u32 xy_block_size = gob_size * block_height;
     const u32 block_size = xy_block_size * block_depth;
-    u32 tile_offset = 0;
-    for (u32 zb = 0; zb < blocks_on_z; zb++) {
+    const auto process_z_blocks = [&](u32 zb) {
         const u32 z_start = zb * block_z_elements;
         const u32 z_end = std::min(depth, z_start + block_z_elements);
+        u32 tile_offset = zb * blocks_on_y * blocks_on_x * block_size;
         for (u32 yb = 0; yb < blocks_on_y; yb++) {
             const u32 y_start = yb * block_y_elements;
             const u32 y_end = std::min(height, y_start + block_y_elements);
@@ -171,7 +190,24 @@ void SwizzledData(u8* const swizzled_data, u8* const unswizzled_data, const bool
                 tile_offset += block_size;
             }
         }
+    };
+
+    // Slices of blocks along the z axis don't overlap, large 3D textures are split between them.
+    if (blocks_on_z > 1 && std::size_t{layer_z} * depth >= ParallelSwizzleThreshold) {
+        GetTextureWorkerPool().ParallelFor(
+            blocks_on_z, [&](std::size_t zb) { process_z_blocks(static_cast<u32>(zb)); });
+        return;
     }
+    for (u32 zb = 0; zb < blocks_on_z; zb++) {
+        process_z_blocks(zb);
+    }
+}
+
+Common::ThreadPool& GetTextureWorkerPool() {
+    // Leave room for the emulated CPU cores and the GPU thread.
+    static Common::ThreadPool pool{std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U),
+                                   "yuzu:TextureWorker"};
+    return pool;
 }
 
 void CopySwizzledData(u32 width, u32 height, u32 depth, u32 bytes_per_pixel,
@@ -8,6 +8,10 @@
 #include "common/common_types.h"
 #include "video_core/textures/texture.h"
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace Tegra::Texture {
 
 // GOBSize constant. Calculated by 64 bytes in x multiplied by 8 y coords, represents
@@ -20,6 +24,12 @@ inline std::size_t GetGOBSizeShift() {
     return 9;
 }
 
+/// Minimum size in bytes of a texture for its layers or depth slices to be swizzled in parallel.
+constexpr std::size_t ParallelSwizzleThreshold = 1 << 20;
+
+/// Returns the pool of worker threads used to swizzle large textures.
+Common::ThreadPool& GetTextureWorkerPool();
+
 /// Unswizzles a swizzled texture without changing its format.
 void UnswizzleTexture(u8* unswizzled_data, u8* address, u32 tile_size_x, u32 tile_size_y,
                       u32 bytes_per_pixel, u32 width, u32 height, u32 depth,
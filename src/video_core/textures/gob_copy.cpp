@@ -0,0 +1,129 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#include "common/logging/log.h"
+#include "video_core/textures/gob_copy.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#endif
+
+namespace Tegra::Texture {
+
+namespace {
+
+/**
+ * A GOB is 64 bytes wide and 8 lines tall. It's made of two 256 byte sectors, one for each 32
+ * byte wide half, and each sector stores pairs of lines: the first 16 bytes of both lines,
+ * followed by the last 16 bytes of both lines.
+ */
+constexpr u32 GOB_SIZE = 512;
+constexpr u32 GOB_LINES = 8;
+constexpr u32 SECTOR_SIZE = 256;
+constexpr u32 LINE_PAIR_SIZE = 64;
+
+template <bool swizzle>
+void GenericCopyGOBs(u8* swizzled, u8* linear, u32 linear_stride, u32 num_gobs) {
+    for (u32 gob = 0; gob < num_gobs; ++gob) {
+        for (u32 line = 0; line < GOB_LINES; ++line) {
+            u8* const line_start = linear + line * linear_stride;
+            for (u32 x = 0; x < 64; x += 16) {
+                const u32 offset = (x / 32) * SECTOR_SIZE + (line / 2) * LINE_PAIR_SIZE +
+                                   (x % 32 / 16) * 32 + (line % 2) * 16;
+                if constexpr (swizzle) {
+                    std::memcpy(swizzled + offset, line_start + x, 16);
+                } else {
+                    std::memcpy(line_start + x, swizzled + offset, 16);
+                }
+            }
+        }
+        swizzled += GOB_SIZE;
+        linear += GOB_LINES * linear_stride;
+    }
+}
+
+constexpr GOBCopyKernels GENERIC_KERNELS{"Generic", GenericCopyGOBs<true>,
+                                         GenericCopyGOBs<false>};
+
+#ifdef ARCHITECTURE_x86_64
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+/**
+ * Each 64 byte line pair of a sector holds 32 bytes of two consecutive lines. Two 128-bit lane
+ * permutes turn the pair into two contiguous 32 byte line segments, and vice versa.
+ */
+template <bool swizzle>
+TARGET_AVX2 void AVX2CopyGOBs(u8* swizzled, u8* linear, u32 linear_stride, u32 num_gobs) {
+    for (u32 gob = 0; gob < num_gobs; ++gob) {
+        for (u32 pair = 0; pair < GOB_LINES / 2; ++pair) {
+            // Both sectors are handled together so that whole 64 byte lines are written at once.
+            auto* const block = reinterpret_cast<__m256i*>(swizzled + pair * LINE_PAIR_SIZE);
+            auto* const next_block = block + SECTOR_SIZE / sizeof(__m256i);
+            auto* const line0 = reinterpret_cast<__m256i*>(linear + pair * 2 * linear_stride);
+            auto* const line1 = reinterpret_cast<__m256i*>(linear + (pair * 2 + 1) * linear_stride);
+            if constexpr (swizzle) {
+                const __m256i line0_low = _mm256_loadu_si256(line0);
+                const __m256i line0_high = _mm256_loadu_si256(line0 + 1);
+                const __m256i line1_low = _mm256_loadu_si256(line1);
+                const __m256i line1_high = _mm256_loadu_si256(line1 + 1);
+                _mm256_storeu_si256(block, _mm256_permute2x128_si256(line0_low, line1_low, 0x20));
+                _mm256_storeu_si256(block + 1,
+                                    _mm256_permute2x128_si256(line0_low, line1_low, 0x31));
+                _mm256_storeu_si256(next_block,
+                                    _mm256_permute2x128_si256(line0_high, line1_high, 0x20));
+                _mm256_storeu_si256(next_block + 1,
+                                    _mm256_permute2x128_si256(line0_high, line1_high, 0x31));
+            } else {
+                const __m256i low0 = _mm256_loadu_si256(block);
+                const __m256i low1 = _mm256_loadu_si256(block + 1);
+                const __m256i high0 = _mm256_loadu_si256(next_block);
+                const __m256i high1 = _mm256_loadu_si256(next_block + 1);
+                _mm256_storeu_si256(line0, _mm256_permute2x128_si256(low0, low1, 0x20));
+                _mm256_storeu_si256(line0 + 1, _mm256_permute2x128_si256(high0, high1, 0x20));
+                _mm256_storeu_si256(line1, _mm256_permute2x128_si256(low0, low1, 0x31));
+                _mm256_storeu_si256(line1 + 1, _mm256_permute2x128_si256(high0, high1, 0x31));
+            }
+        }
+        swizzled += GOB_SIZE;
+        linear += GOB_LINES * linear_stride;
+    }
+}
+
+#undef TARGET_AVX2
+
+constexpr GOBCopyKernels AVX2_KERNELS{"AVX2", AVX2CopyGOBs<true>, AVX2CopyGOBs<false>};
+
+#endif
+
+const GOBCopyKernels& SelectKernels() {
+#ifdef ARCHITECTURE_x86_64
+    if (Common::GetCPUCaps().avx2) {
+        LOG_INFO(HW_GPU, "Using AVX2 GOB copy kernels");
+        return AVX2_KERNELS;
+    }
+#endif
+    // The 16 byte copies of the generic kernels are already compiled to SSE loads and stores.
+    return GENERIC_KERNELS;
+}
+
+} // Anonymous namespace
+
+const GOBCopyKernels& GetGOBCopyKernels() {
+    static const GOBCopyKernels& kernels = SelectKernels();
+    return kernels;
+}
+
+const GOBCopyKernels& GetGenericGOBCopyKernels() {
+    return GENERIC_KERNELS;
+}
+
+} // namespace Tegra::Texture
@@ -0,0 +1,33 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include "common/common_types.h"
+
+namespace Tegra::Texture {
+
+/**
+ * Copies a column of vertically adjacent GOBs between their swizzled and their linear layout.
+ * @param swizzled      Swizzled GOBs, stored contiguously.
+ * @param linear        First byte of the first line of the linear region, 64 bytes wide.
+ * @param linear_stride Distance in bytes between two lines of the linear region.
+ * @param num_gobs      Number of GOBs to copy, the linear region is 8 lines tall per GOB.
+ */
+using GOBCopyFn = void (*)(u8* swizzled, u8* linear, u32 linear_stride, u32 num_gobs);
+
+/// GOB copy functions for a particular instruction set.
+struct GOBCopyKernels {
+    const char* name;
+    GOBCopyFn swizzle;   ///< Copies from the linear to the swizzled layout.
+    GOBCopyFn unswizzle; ///< Copies from the swizzled to the linear layout.
+};
+
+/// Returns the fastest GOB copy functions supported by the host CPU.
+const GOBCopyKernels& GetGOBCopyKernels();
+
+/// Returns the GOB copy functions that don't depend on any instruction set extension.
+const GOBCopyKernels& GetGenericGOBCopyKernels();
+
+} // namespace Tegra::Texture
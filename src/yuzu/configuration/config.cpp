@@ -437,6 +437,10 @@ void Config::ReadCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     Settings::values.use_multi_core = ReadSetting(QStringLiteral("use_multi_core"), false).toBool();
+    Settings::values.use_relaxed_multi_core =
+        ReadSetting(QStringLiteral("use_relaxed_multi_core"), false).toBool();
+    Settings::values.use_hle_service_threads =
+        ReadSetting(QStringLiteral("use_hle_service_threads"), false).toBool();
 
     qt_config->endGroup();
 }
@@ -518,6 +522,8 @@ void Config::ReadDebuggingValues() {
         ReadSetting(QStringLiteral("program_args"), QStringLiteral("")).toString().toStdString();
     Settings::values.dump_exefs = ReadSetting(QStringLiteral("dump_exefs"), false).toBool();
     Settings::values.dump_nso = ReadSetting(QStringLiteral("dump_nso"), false).toBool();
+    Settings::values.record_pushbuffers =
+        ReadSetting(QStringLiteral("record_pushbuffers"), false).toBool();
     Settings::values.reporting_services =
         ReadSetting(QStringLiteral("reporting_services"), false).toBool();
     Settings::values.quest_flag = ReadSetting(QStringLiteral("quest_flag"), false).toBool();
@@ -624,6 +630,11 @@ void Config::ReadRendererValues() {
         ReadSetting(QStringLiteral("use_accurate_gpu_emulation"), false).toBool();
     Settings::values.use_asynchronous_gpu_emulation =
         ReadSetting(QStringLiteral("use_asynchronous_gpu_emulation"), false).toBool();
+    Settings::values.use_asynchronous_shaders =
+        ReadSetting(QStringLiteral("use_asynchronous_shaders"), false).toBool();
+    Settings::values.use_macro_jit = ReadSetting(QStringLiteral("use_macro_jit"), true).toBool();
+    Settings::values.texture_cache_budget =
+        ReadSetting(QStringLiteral("texture_cache_budget"), 4096).toUInt();
     Settings::values.force_30fps_mode =
         ReadSetting(QStringLiteral("force_30fps_mode"), false).toBool();
 
@@ -919,6 +930,10 @@ void Config::SaveCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     WriteSetting(QStringLiteral("use_multi_core"), Settings::values.use_multi_core, false);
+    WriteSetting(QStringLiteral("use_relaxed_multi_core"), Settings::values.use_relaxed_multi_core,
+                 false);
+    WriteSetting(QStringLiteral("use_hle_service_threads"),
+                 Settings::values.use_hle_service_threads, false);
 
     qt_config->endGroup();
 }
@@ -973,6 +988,7 @@ void Config::SaveDebuggingValues() {
                  QString::fromStdString(Settings::values.program_args), QStringLiteral(""));
     WriteSetting(QStringLiteral("dump_exefs"), Settings::values.dump_exefs, false);
     WriteSetting(QStringLiteral("dump_nso"), Settings::values.dump_nso, false);
+    WriteSetting(QStringLiteral("record_pushbuffers"), Settings::values.record_pushbuffers, false);
     WriteSetting(QStringLiteral("quest_flag"), Settings::values.quest_flag, false);
 
     qt_config->endGroup();
@@ -1049,6 +1065,11 @@ void Config::SaveRendererValues() {
                  Settings::values.use_accurate_gpu_emulation, false);
     WriteSetting(QStringLiteral("use_asynchronous_gpu_emulation"),
                  Settings::values.use_asynchronous_gpu_emulation, false);
+    WriteSetting(QStringLiteral("use_asynchronous_shaders"),
+                 Settings::values.use_asynchronous_shaders, false);
+    WriteSetting(QStringLiteral("use_macro_jit"), Settings::values.use_macro_jit, true);
+    WriteSetting(QStringLiteral("texture_cache_budget"), Settings::values.texture_cache_budget,
+                 4096);
     WriteSetting(QStringLiteral("force_30fps_mode"), Settings::values.force_30fps_mode, false);
 
     // Cast to double because Qt's written float values are not human-readable
@@ -80,6 +80,16 @@ touch_device=
 # 0 (default): Disabled, 1: Enabled
 use_multi_core=
 
+# Whether CPU cores may run ahead of each other for a few time slices in multi-core mode, instead
+# of synchronizing at the end of every slice
+# 0 (default): Disabled, 1: Enabled
+use_relaxed_multi_core=
+
+# Whether heavy services like the filesystem and GPU driver handle requests on their own host
+# threads, concurrently with emulated code
+# 0 (default): Disabled, 1: Enabled
+use_hle_service_threads=
+
 [Renderer]
 # Whether to use software or hardware rendering.
 # 0: Software, 1 (default): Hardware
@@ -118,6 +128,18 @@ use_accurate_gpu_emulation =
 # 0 : Off (slow), 1 (default): On (fast)
 use_asynchronous_gpu_emulation =
 
+# Whether to build new shaders on background threads, skipping draws until they are ready
+# 0 (default): Off, 1: On (less stuttering, objects may briefly not render)
+use_asynchronous_shaders =
+
+# Whether to compile GPU macros to native code instead of interpreting them
+# 0 : Off (interpreter), 1 (default): On (JIT, x86-64 only)
+use_macro_jit =
+
+# Host memory in MiB textures may use before the least recently used ones are evicted
+# 0: No limit, 4096 (default)
+texture_cache_budget =
+
 # The clear color for the renderer. What shows up on the sides of the bottom screen.
 # Must be in range of 0.0-1.0. Defaults to 1.0 for all.
 bg_red =
@@ -236,6 +258,9 @@ gdbstub_port=24689
 dump_exefs=false
 # Determines whether or not yuzu will dump all NSOs it attempts to load while loading them
 dump_nso=false
+# Records the GPU command lists submitted by the game to the dump directory, to be replayed with
+# yuzu-replay. Requires asynchronous GPU emulation.
+record_pushbuffers=false
 # Determines whether or not yuzu will report to the game that the emulated console is in Kiosk Mode
 # false: Retail/Normal Mode (default), true: Kiosk Mode
 quest_flag =
@@ -0,0 +1,317 @@
+// Copyright 2019 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/common_paths.h"
+#include "common/common_types.h"
+#include "common/file_util.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/scm_rev.h"
+#include "common/scope_exit.h"
+#include "common/string_util.h"
+#include "core/core.h"
+#include "core/frontend/emu_window.h"
+#include "core/settings.h"
+#include "video_core/gpu.h"
+#include "video_core/memory_manager.h"
+#include "video_core/pushbuffer_capture.h"
+#include "video_core/renderer_null/rasterizer_null.h"
+#include "video_core/renderer_null/renderer_null.h"
+
+#ifdef _WIN32
+// windows.h needs to be included before shellapi.h
+#include <windows.h>
+
+#include <shellapi.h>
+#endif
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// Window that is never shown, the null renderer doesn't present anything.
+class EmuWindow_Null final : public Core::Frontend::EmuWindow {
+public:
+    void SwapBuffers() override {}
+    void PollEvents() override {}
+    void MakeCurrent() override {}
+    void DoneCurrent() override {}
+};
+
+/// Host memory backing an area of the GPU address space during the replay.
+struct HostArea {
+    Tegra::CapturedArea area;
+    std::unique_ptr<u8, decltype(&std::free)> memory{nullptr, &std::free};
+};
+
+/// Results of a replay pass.
+struct ReplayResults {
+    u64 command_lists{};
+    u64 frames{};
+    Null::RasterizerNull::Counters counters{};
+    Tegra::GPU::EngineStatsArray engine_stats{};
+    std::chrono::nanoseconds time{};
+};
+
+constexpr std::array<const char*, Tegra::GPU::NumStatsEngines> ENGINE_NAMES{
+    "Puller", "Fermi2D", "Maxwell3D", "KeplerCompute", "MaxwellDMA", "KeplerMemory",
+};
+
+void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [options] <filename>\n"
+                 "-h, --help            Display this help and exit\n"
+                 "-v, --version         Output version information and exit\n"
+                 "-j, --jit             Execute macros with the JIT instead of the interpreter\n"
+                 "-l, --log             Log to console in addition to file (will log to file only "
+                 "by default)\n";
+}
+
+void PrintVersion() {
+    std::cout << "yuzu [Replay Utility] " << Common::g_scm_branch << " " << Common::g_scm_desc
+              << std::endl;
+}
+
+void InitializeLogging(bool console) {
+    Log::Filter log_filter(Log::Level::Info);
+    log_filter.ParseFilterString(Settings::values.log_filter);
+    Log::SetGlobalFilter(log_filter);
+
+    if (console)
+        Log::AddBackend(std::make_unique<Log::ColorConsoleBackend>());
+
+    const std::string& log_dir = FileUtil::GetUserPath(FileUtil::UserPath::LogDir);
+    FileUtil::CreateFullPath(log_dir);
+    Log::AddBackend(std::make_unique<Log::FileBackend>(log_dir + LOG_FILE));
+#ifdef _WIN32
+    Log::AddBackend(std::make_unique<Log::DebuggerBackend>());
+#endif
+}
+
+/// Maps host memory for the areas that became mapped and releases the ones that were unmapped.
+/// Areas that remain mapped keep their contents.
+void UpdateMemoryMap(Tegra::MemoryManager& memory_manager, std::vector<HostArea>& host_areas,
+                     const Tegra::CapturedMemoryMap& memory_map) {
+    const auto is_mapped = [&memory_map](const Tegra::CapturedArea& area) {
+        const auto& areas = memory_map.areas;
+        return std::find(areas.begin(), areas.end(), area) != areas.end();
+    };
+    for (auto it = host_areas.begin(); it != host_areas.end();) {
+        if (is_mapped(it->area)) {
+            ++it;
+            continue;
+        }
+        memory_manager.UnmapHostMemory(it->area.base, it->area.size);
+        it = host_areas.erase(it);
+    }
+
+    for (const Tegra::CapturedArea& area : memory_map.areas) {
+        const auto it = std::find_if(host_areas.begin(), host_areas.end(),
+                                     [&area](const HostArea& host) { return host.area == area; });
+        if (it != host_areas.end()) {
+            continue;
+        }
+        // calloc lets the host commit pages lazily, most of the mapped memory is never touched.
+        HostArea& host = host_areas.emplace_back();
+        host.area = area;
+        host.memory.reset(static_cast<u8*>(std::calloc(area.size, 1)));
+        if (!host.memory) {
+            LOG_CRITICAL(Frontend, "Failed to allocate {} bytes to back GPU address {:016X}",
+                         area.size, area.base);
+            std::exit(-1);
+        }
+        memory_manager.MapHostMemory(area.base, host.memory.get(), area.size);
+    }
+}
+
+/// Executes every record of the capture once.
+ReplayResults Replay(Core::System& system, const std::vector<Tegra::CaptureRecord>& records,
+                     bool gather_engine_stats) {
+    auto& gpu = system.GPU();
+    auto& memory_manager = gpu.MemoryManager();
+    auto& renderer = static_cast<Null::RendererNull&>(system.Renderer());
+    auto& rasterizer = renderer.GetNullRasterizer();
+
+    std::vector<HostArea> host_areas;
+    SCOPE_EXIT({
+        for (const HostArea& host : host_areas) {
+            memory_manager.UnmapHostMemory(host.area.base, host.area.size);
+        }
+    });
+
+    rasterizer.ResetCounters();
+    gpu.SetEngineStatsEnabled(gather_engine_stats);
+    gpu.GetAndResetEngineStats();
+
+    ReplayResults results;
+    for (const Tegra::CaptureRecord& record : records) {
+        if (const auto memory_map = std::get_if<Tegra::CapturedMemoryMap>(&record)) {
+            UpdateMemoryMap(memory_manager, host_areas, *memory_map);
+        } else if (const auto command_list = std::get_if<Tegra::CapturedCommandList>(&record)) {
+            // Restore the pushbuffers before executing them, only the command processing is timed.
+            const u32* words = command_list->words.data();
+            for (const Tegra::CommandListHeader& entry : command_list->entries) {
+                memory_manager.WriteBlockUnsafe(entry.addr, words, entry.size * sizeof(u32));
+                words += entry.size;
+            }
+            Tegra::CommandList entries = command_list->entries;
+
+            const auto start = std::chrono::steady_clock::now();
+            gpu.PushGPUEntries(std::move(entries));
+            results.time += std::chrono::steady_clock::now() - start;
+            ++results.command_lists;
+        } else if (std::holds_alternative<Tegra::CapturedFrameEnd>(record)) {
+            gpu.SwapBuffers(nullptr);
+            ++results.frames;
+        }
+    }
+
+    gpu.SetEngineStatsEnabled(false);
+    results.engine_stats = gpu.GetAndResetEngineStats();
+    results.counters = rasterizer.GetCounters();
+    return results;
+}
+
+void PrintResults(const ReplayResults& throughput, const ReplayResults& profile) {
+    u64 total_methods = 0;
+    for (const auto& stats : profile.engine_stats) {
+        total_methods += stats.method_calls;
+    }
+    const double seconds = std::chrono::duration<double>(throughput.time).count();
+
+    std::cout << fmt::format("Replayed {} command lists and {} frames in {:.3f} ms\n",
+                             throughput.command_lists, throughput.frames, seconds * 1000.0);
+    std::cout << fmt::format("{:.3f} Mmethods/s, {:.1f} draws/s, {:.1f} frames/s\n",
+                             total_methods / seconds / 1e6, throughput.counters.draws / seconds,
+                             throughput.frames / seconds);
+    std::cout << fmt::format("Draws: {}, clears: {}, dispatches: {}, surface copies: {}\n\n",
+                             throughput.counters.draws, throughput.counters.clears,
+                             throughput.counters.dispatches, throughput.counters.surface_copies);
+
+    // The per engine times come from a separate pass, timing every call skews the totals above.
+    std::cout << fmt::format("{:<14} | {:>12} | {:>12} | {:>10}\n", "Engine", "Methods",
+                             "Time (ms)", "ns/method");
+    for (std::size_t engine = 0; engine < Tegra::GPU::NumStatsEngines; ++engine) {
+        const auto& stats = profile.engine_stats[engine];
+        if (stats.method_calls == 0) {
+            continue;
+        }
+        const auto nanoseconds = static_cast<double>(stats.time.count());
+        std::cout << fmt::format("{:<14} | {:>12} | {:>12.3f} | {:>10.1f}\n",
+                                 ENGINE_NAMES[engine], stats.method_calls, nanoseconds / 1e6,
+                                 nanoseconds / stats.method_calls);
+    }
+}
+
+} // Anonymous namespace
+
+/// Application entry point
+int main(int argc, char** argv) {
+    int option_index = 0;
+
+#ifdef _WIN32
+    int argc_w;
+    auto argv_w = CommandLineToArgvW(GetCommandLineW(), &argc_w);
+
+    if (argv_w == nullptr) {
+        std::cout << "Failed to get command line arguments" << std::endl;
+        return -1;
+    }
+#endif
+    std::string filepath;
+
+    static struct option long_options[] = {
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'v'},
+        {"jit", no_argument, 0, 'j'},
+        {"log", no_argument, 0, 'l'},
+        {0, 0, 0, 0},
+    };
+
+    bool console_log = false;
+    bool use_macro_jit = false;
+
+    while (optind < argc) {
+        int arg = getopt_long(argc, argv, "hvjl", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            case 'v':
+                PrintVersion();
+                return 0;
+            case 'j':
+                use_macro_jit = true;
+                break;
+            case 'l':
+                console_log = true;
+                break;
+            }
+        } else {
+#ifdef _WIN32
+            filepath = Common::UTF16ToUTF8(argv_w[optind]);
+#else
+            filepath = argv[optind];
+#endif
+            optind++;
+        }
+    }
+
+    InitializeLogging(console_log);
+
+#ifdef _WIN32
+    LocalFree(argv_w);
+#endif
+
+    MicroProfileOnThreadCreate("EmuThread");
+    SCOPE_EXIT({ MicroProfileShutdown(); });
+
+    if (filepath.empty()) {
+        std::cout << "No capture file specified" << std::endl;
+        PrintHelp(argv[0]);
+        return -1;
+    }
+
+    const auto records = Tegra::LoadPushbufferCapture(filepath);
+    if (!records) {
+        std::cout << "Failed to load capture file " << filepath << std::endl;
+        return -1;
+    }
+
+    // Commands are executed on this thread so they can be timed individually.
+    Settings::values.use_asynchronous_gpu_emulation = false;
+    Settings::values.use_macro_jit = use_macro_jit;
+
+    EmuWindow_Null emu_window;
+    Core::System& system{Core::System::GetInstance()};
+    if (system.InitGPU(std::make_unique<Null::RendererNull>(emu_window)) !=
+        Core::System::ResultStatus::Success) {
+        LOG_CRITICAL(Frontend, "Failed to initialize the GPU!");
+        return -1;
+    }
+
+    const ReplayResults throughput = Replay(system, *records, false);
+    const ReplayResults profile = Replay(system, *records, true);
+    PrintResults(throughput, profile);
+    return 0;
+}
@@ -42,6 +42,10 @@ use_accurate_gpu_emulation =
 # 0 : Off (slow), 1 (default): On (fast)
 use_asynchronous_gpu_emulation =
 
+# Whether to compile GPU macros to native code instead of interpreting them
+# 0 : Off (interpreter), 1 (default): On (JIT, x86-64 only)
+use_macro_jit =
+
 # The clear color for the renderer. What shows up on the sides of the bottom screen.
 # Must be in range of 0.0-1.0. Defaults to 1.0 for all.
 bg_red =
@@ -124,6 +128,9 @@ program_args=
 dump_exefs=false
 # Determines whether or not yuzu will dump all NSOs it attempts to load while loading them
 dump_nso=false
+# Records the GPU command lists submitted by the game to the dump directory, to be replayed with
+# yuzu-replay. Requires asynchronous GPU emulation.
+record_pushbuffers=false
 
 [WebService]
 # Whether or not to enable telemetry